@@ -26,9 +26,35 @@
 // Qt includes
 #include <QDateTime>
 #include <QDebug>
+#include <QFile>
 #include <QJsonDocument>
+#include <QMutex>
+#include <QtAlgorithms>
 #include <QUrl>
 
+// System includes
+#include <chrono>
+#include <cmath>
+#include <cstring>
+#include <ctime>
+#ifdef Q_OS_WIN
+#include <windows.h>
+#endif
+
+// Number of buckets in the call time histogram
+#define NUMBER_OF_TIME_BUCKETS 32
+
+// Instance registry: number of shards (power of 2), slots in the first
+// table of a shard (power of 2; each further table is twice as big), and
+// how far to look for a free slot before moving on to the next table
+#define NUMBER_OF_INSTANCE_SHARDS 64
+#define INSTANCE_SHARD_SIZE 1024
+#define MAX_INSTANCE_PROBES 32
+
+// Instance registry: special slot values
+#define EMPTY_INSTANCE_SLOT quintptr(0)
+#define DELETED_INSTANCE_SLOT quintptr(1)
+
 
 
 // CallTracer cannot utilize any methods in classes that utilize CallTracer
@@ -50,401 +76,1813 @@ CallTracer::CallTracer()
 
 
 ///////////////////////////////////////////////////////////////////////////////
-// Destructor
-CallTracer::~CallTracer()
+// Destructor
+CallTracer::~CallTracer()
+{
+    // Nothing to do
+}
+
+
+
+// ================================================================ Call Stack
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// Per-thread state
+struct CallTracer::ThreadState
+{
+    // Constructor
+    ThreadState();
+
+    // Destructor
+    ~ThreadState();
+
+    // Methods currently being executed
+    QList < CallRecord > m_CallStack;
+
+    // Number of this thread (for the history)
+    quint16 m_ThreadId;
+
+    // Time based sampling: time of the last sample and calls since then
+    qint64 m_LastSample;
+    int m_CallsSinceSample;
+
+    // Call counters; only this thread writes to them, other threads may
+    // read them while collecting statistics
+    std::atomic < CounterTable * > m_Counters;
+
+    // Number of counters in use
+    int m_NumberOfCounters;
+
+    // Tables replaced by a bigger one; other threads may still be reading
+    // them, so they are only deleted when the thread ends
+    QList < CounterTable * > m_ReplacedCounters;
+
+    // The state of this thread has been destroyed
+    static thread_local bool m_IsDestroyed;
+};
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// Call count and times of one pair of called and calling call site
+struct CallTracer::CallCounters
+{
+    // Set everything but the key to 0
+    void Reset()
+    {
+        m_CallCount.store(0, std::memory_order_relaxed);
+        m_InclusiveTime.store(0, std::memory_order_relaxed);
+        m_ExclusiveTime.store(0, std::memory_order_relaxed);
+        m_InclusiveCpuTime.store(0, std::memory_order_relaxed);
+        m_ExclusiveCpuTime.store(0, std::memory_order_relaxed);
+        for (int bucket = 0; bucket < NUMBER_OF_TIME_BUCKETS; bucket++)
+        {
+            m_TimeHistogram[bucket].store(0, std::memory_order_relaxed);
+        }
+    }
+
+    // Copy everything but the key
+    void CopyFrom(const CallCounters & mcrOther)
+    {
+        m_CallCount.store(mcrOther.m_CallCount.load(std::memory_order_relaxed),
+            std::memory_order_relaxed);
+        m_InclusiveTime.store(
+            mcrOther.m_InclusiveTime.load(std::memory_order_relaxed),
+            std::memory_order_relaxed);
+        m_ExclusiveTime.store(
+            mcrOther.m_ExclusiveTime.load(std::memory_order_relaxed),
+            std::memory_order_relaxed);
+        m_InclusiveCpuTime.store(
+            mcrOther.m_InclusiveCpuTime.load(std::memory_order_relaxed),
+            std::memory_order_relaxed);
+        m_ExclusiveCpuTime.store(
+            mcrOther.m_ExclusiveCpuTime.load(std::memory_order_relaxed),
+            std::memory_order_relaxed);
+        for (int bucket = 0; bucket < NUMBER_OF_TIME_BUCKETS; bucket++)
+        {
+            m_TimeHistogram[bucket].store(
+                mcrOther.m_TimeHistogram[bucket]
+                    .load(std::memory_order_relaxed),
+                std::memory_order_relaxed);
+        }
+    }
+
+    // Counter key (0 if unused)
+    std::atomic < quint64 > m_Key;
+
+    // Call count
+    std::atomic < qint64 > m_CallCount;
+
+    // Wall time (ns) including and excluding called methods
+    std::atomic < qint64 > m_InclusiveTime;
+    std::atomic < qint64 > m_ExclusiveTime;
+
+    // CPU time (ns) including and excluding called methods
+    std::atomic < qint64 > m_InclusiveCpuTime;
+    std::atomic < qint64 > m_ExclusiveCpuTime;
+
+    // Number of calls by inclusive wall time; bucket n counts calls taking
+    // less than 2^(n + 8) ns
+    std::atomic < qint32 > m_TimeHistogram[NUMBER_OF_TIME_BUCKETS];
+};
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// Combined (not atomic) call counters
+struct CallTracer::CallStatistics
+{
+    // Constructor
+    CallStatistics()
+    {
+        m_CallCount = 0;
+        m_InclusiveTime = 0;
+        m_ExclusiveTime = 0;
+        m_InclusiveCpuTime = 0;
+        m_ExclusiveCpuTime = 0;
+        for (int bucket = 0; bucket < NUMBER_OF_TIME_BUCKETS; bucket++)
+        {
+            m_TimeHistogram[bucket] = 0;
+        }
+    }
+
+    // Add counters of one thread
+    void Add(const CallCounters & mcrCounters)
+    {
+        m_CallCount += mcrCounters.m_CallCount.load(std::memory_order_relaxed);
+        m_InclusiveTime +=
+            mcrCounters.m_InclusiveTime.load(std::memory_order_relaxed);
+        m_ExclusiveTime +=
+            mcrCounters.m_ExclusiveTime.load(std::memory_order_relaxed);
+        m_InclusiveCpuTime +=
+            mcrCounters.m_InclusiveCpuTime.load(std::memory_order_relaxed);
+        m_ExclusiveCpuTime +=
+            mcrCounters.m_ExclusiveCpuTime.load(std::memory_order_relaxed);
+        for (int bucket = 0; bucket < NUMBER_OF_TIME_BUCKETS; bucket++)
+        {
+            m_TimeHistogram[bucket] += mcrCounters.m_TimeHistogram[bucket]
+                .load(std::memory_order_relaxed);
+        }
+    }
+
+    // Add other statistics
+    void Add(const CallStatistics & mcrOther)
+    {
+        m_CallCount += mcrOther.m_CallCount;
+        m_InclusiveTime += mcrOther.m_InclusiveTime;
+        m_ExclusiveTime += mcrOther.m_ExclusiveTime;
+        m_InclusiveCpuTime += mcrOther.m_InclusiveCpuTime;
+        m_ExclusiveCpuTime += mcrOther.m_ExclusiveCpuTime;
+        for (int bucket = 0; bucket < NUMBER_OF_TIME_BUCKETS; bucket++)
+        {
+            m_TimeHistogram[bucket] += mcrOther.m_TimeHistogram[bucket];
+        }
+    }
+
+    // Upper limit (ns) of the time a given fraction of calls takes
+    qint64 Percentile(const double mcFraction) const
+    {
+        qint64 total = 0;
+        for (int bucket = 0; bucket < NUMBER_OF_TIME_BUCKETS; bucket++)
+        {
+            total += m_TimeHistogram[bucket];
+        }
+        const qint64 target = qint64(std::ceil(mcFraction * total));
+        qint64 so_far = 0;
+        for (int bucket = 0; bucket < NUMBER_OF_TIME_BUCKETS; bucket++)
+        {
+            so_far += m_TimeHistogram[bucket];
+            if (so_far >= target)
+            {
+                return Q_INT64_C(1) << (bucket + 8);
+            }
+        }
+        return Q_INT64_C(1) << (NUMBER_OF_TIME_BUCKETS + 7);
+    }
+
+    // Same as in CallCounters
+    qint64 m_CallCount;
+    qint64 m_InclusiveTime;
+    qint64 m_ExclusiveTime;
+    qint64 m_InclusiveCpuTime;
+    qint64 m_ExclusiveCpuTime;
+    qint64 m_TimeHistogram[NUMBER_OF_TIME_BUCKETS];
+};
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// Hash table of counters (open addressing, linear probing)
+struct CallTracer::CounterTable
+{
+    // Constructor
+    CounterTable(const int mcCapacity)
+    {
+        m_Capacity = mcCapacity;
+        m_Counters = new CallCounters[mcCapacity];
+        for (int index = 0; index < mcCapacity; index++)
+        {
+            m_Counters[index].m_Key.store(0, std::memory_order_relaxed);
+            m_Counters[index].Reset();
+        }
+    }
+
+    // Destructor
+    ~CounterTable()
+    {
+        delete [] m_Counters;
+    }
+
+    // Number of slots (power of 2)
+    int m_Capacity;
+
+    // Slots
+    CallCounters * m_Counters;
+};
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// Thread state constructor
+CallTracer::ThreadState::ThreadState()
+{
+    m_Counters.store(new CounterTable(256), std::memory_order_release);
+    m_NumberOfCounters = 0;
+
+    static std::atomic < int > next_thread_id(1);
+    m_ThreadId = quint16(next_thread_id.fetch_add(1));
+
+    m_LastSample = 0;
+    m_CallsSinceSample = 0;
+
+    QMutexLocker lock(&m_ThreadsMutex);
+    m_Threads << this;
+}
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// Thread state destructor
+CallTracer::ThreadState::~ThreadState()
+{
+    // Functions called from here on (e.g. by other thread_local
+    // destructors or exit handlers) no longer find a state
+    m_IsDestroyed = true;
+
+    QMutexLocker lock(&m_ThreadsMutex);
+    m_Threads.removeAll(this);
+
+    // Keep statistics of this thread
+    CounterTable * table = m_Counters.load(std::memory_order_acquire);
+    for (int index = 0; index < table -> m_Capacity; index++)
+    {
+        const quint64 key =
+            table -> m_Counters[index].m_Key.load(std::memory_order_relaxed);
+        if (key != 0)
+        {
+            m_FinishedThreadsStatistics[key].Add(table -> m_Counters[index]);
+        }
+    }
+    m_Counters.store(nullptr, std::memory_order_release);
+    delete table;
+    qDeleteAll(m_ReplacedCounters);
+    m_ReplacedCounters.clear();
+}
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// Thread state has been destroyed (trivially destructible, so it can still
+// be read while the thread exits)
+thread_local bool CallTracer::ThreadState::m_IsDestroyed = false;
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// State of the current thread
+CallTracer::ThreadState * CallTracer::CurrentThread()
+{
+    if (ThreadState::m_IsDestroyed)
+    {
+        return nullptr;
+    }
+    thread_local ThreadState thread_state;
+    return &thread_state;
+}
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// Ring buffer of history events
+struct CallTracer::HistoryBuffer
+{
+    // Constructor
+    HistoryBuffer(const int mcCapacity)
+    {
+        m_Capacity = mcCapacity;
+        m_Events = new HistoryEvent[mcCapacity];
+    }
+
+    // Destructor
+    ~HistoryBuffer()
+    {
+        delete [] m_Events;
+    }
+
+    // Number of events
+    int m_Capacity;
+
+    // Events
+    HistoryEvent * m_Events;
+
+    static_assert(sizeof(HistoryEvent) == 16,
+        "History events are supposed to take 16 bytes");
+};
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// Reset history
+void CallTracer::ResetHistory()
+{
+    m_HistoryCount = 0;
+    ResetUsage();
+}
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// Set keeping all history
+void CallTracer::SetKeepAllHistory(const bool mcKeepHistory,
+    const int mcHistorySize)
+{
+    if (mcKeepHistory)
+    {
+        // Replace buffer if the size changes; other threads may still be
+        // writing to the old one, so it's kept around
+        static QMutex history_mutex;
+        static QList < HistoryBuffer * > replaced_buffers;
+        QMutexLocker lock(&history_mutex);
+        HistoryBuffer * buffer = m_History.load();
+        if (!buffer ||
+            buffer -> m_Capacity != mcHistorySize)
+        {
+            m_History = new HistoryBuffer(qMax(1, mcHistorySize));
+            m_HistoryCount = 0;
+            if (buffer)
+            {
+                replaced_buffers << buffer;
+            }
+        }
+    }
+    m_KeepAllHistory = mcKeepHistory;
+}
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// Add an event to the call history
+void CallTracer::AddHistoryEvent(const CallSite * mcpCallSite,
+    const qint64 mcTimestamp, const quint16 mcThreadId, const quint16 mcPhase)
+{
+    HistoryBuffer * buffer = m_History.load(std::memory_order_acquire);
+    const quint64 index =
+        m_HistoryCount.fetch_add(1, std::memory_order_relaxed);
+    HistoryEvent & event = buffer -> m_Events[index % buffer -> m_Capacity];
+    event.m_Timestamp = mcTimestamp;
+    event.m_CallSiteId = quint32(mcpCallSite -> m_Id);
+    event.m_ThreadId = mcThreadId;
+    event.m_Phase = mcPhase;
+}
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// Events in the call history, oldest first
+QList < CallTracer::HistoryEvent > CallTracer::GetHistory()
+{
+    QList < HistoryEvent > events;
+    const HistoryBuffer * buffer = m_History.load(std::memory_order_acquire);
+    if (!buffer)
+    {
+        return events;
+    }
+    const quint64 count = m_HistoryCount.load(std::memory_order_acquire);
+    const quint64 first =
+        (count > quint64(buffer -> m_Capacity) ?
+            count - buffer -> m_Capacity : 0);
+    events.reserve(int(count - first));
+    for (quint64 index = first; index < count; index++)
+    {
+        events << buffer -> m_Events[index % buffer -> m_Capacity];
+    }
+
+    return events;
+}
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// Export the call history in Chrome trace event format
+bool CallTracer::ExportChromeTrace(const QString & mcrFilename)
+{
+    // CallTracer can't use MessageLogger for errors (it's traced itself)
+    QFile out_file(mcrFilename);
+    if (!out_file.open(QIODevice::WriteOnly))
+    {
+        qDebug().noquote() << tr("CallTracer::ExportChromeTrace(): File "
+            "\"%1\" could not be opened.")
+            .arg(mcrFilename);
+        return false;
+    }
+
+    // Method names
+    const QList < HistoryEvent > events = GetHistory();
+    QList < QByteArray > method_names;
+    {
+        QMutexLocker lock(&m_CallSitesMutex);
+        for (const CallSite * call_site : m_CallSites)
+        {
+            QByteArray name = call_site -> m_Method.toUtf8();
+            name.replace('\\', "\\\\");
+            name.replace('"', "\\\"");
+            method_names << name;
+        }
+    }
+
+    // Events; leaving events whose entering event has already been
+    // overwritten in the ring buffer are dropped
+    QHash < quint16, int > depth;
+    const qint64 start = (events.isEmpty() ? 0 : events.first().m_Timestamp);
+    QByteArray json = "{\"displayTimeUnit\":\"ns\",\"traceEvents\":[\n";
+    bool is_first = true;
+    for (const HistoryEvent & event : events)
+    {
+        const bool is_enter = (event.m_Phase == 0);
+        if (!is_enter)
+        {
+            if (depth.value(event.m_ThreadId) == 0)
+            {
+                continue;
+            }
+            depth[event.m_ThreadId]--;
+        } else
+        {
+            depth[event.m_ThreadId]++;
+        }
+        if (!is_first)
+        {
+            json += ",\n";
+        }
+        is_first = false;
+        json += "{\"name\":\"" + method_names[int(event.m_CallSiteId)] +
+            "\",\"ph\":\"" + (is_enter ? "B" : "E") +
+            "\",\"ts\":" +
+            QByteArray::number((event.m_Timestamp - start) / 1000., 'f', 3) +
+            ",\"pid\":1,\"tid\":" + QByteArray::number(event.m_ThreadId) +
+            "}";
+
+        // Write in chunks
+        if (json.size() > (1 << 20))
+        {
+            out_file.write(json);
+            json.clear();
+        }
+    }
+
+    // Thread names
+    for (auto thread_iterator = depth.constBegin();
+         thread_iterator != depth.constEnd();
+         thread_iterator++)
+    {
+        const QByteArray thread_id =
+            QByteArray::number(thread_iterator.key());
+        if (!is_first)
+        {
+            json += ",\n";
+        }
+        is_first = false;
+        json += "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,"
+            "\"tid\":" + thread_id + ",\"args\":{\"name\":\"Thread " +
+            thread_id + "\"}}";
+    }
+    json += "\n]}\n";
+    out_file.write(json);
+    if (out_file.error() != QFileDevice::NoError)
+    {
+        qDebug().noquote() << tr("CallTracer::ExportChromeTrace(): File "
+            "\"%1\" could not be written.")
+            .arg(mcrFilename);
+        return false;
+    }
+
+    return true;
+}
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// Register call site
+const CallTracer::CallSite * CallTracer::RegisterCallSite(
+    const char * mcpFilename, const char * mcpFunction, const int mcLine)
+{
+    CallSite * call_site = new CallSite;
+    call_site -> m_Filename = mcpFilename;
+    call_site -> m_Function = mcpFunction;
+    call_site -> m_Line = mcLine;
+    call_site -> m_SampleCount = 0;
+    call_site -> m_Class = ClassName(mcpFilename);
+    call_site -> m_Method = QString("%1::%2")
+        .arg(call_site -> m_Class,
+             mcpFunction);
+    call_site -> m_IsConstructor = (call_site -> m_Class == mcpFunction);
+    call_site -> m_IsDestructor =
+        (QString("~%1").arg(call_site -> m_Class) == mcpFunction);
+
+    // Keep track of all of them (static initialization is thread-safe,
+    // but different call sites may be registered concurrently)
+    QMutexLocker lock(&m_CallSitesMutex);
+    call_site -> m_Id = m_CallSites.size();
+    m_CallSites << call_site;
+
+    return call_site;
+}
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// Enter function
+int CallTracer::EnterFunction(const CallSite * mcpCallSite,
+    const void * mcpParameters, QString (* mcpFormatParameters)(const void *))
+{
+    // Nothing to record once the thread state is gone
+    ThreadState * state_pointer = CurrentThread();
+    if (!state_pointer)
+    {
+        return -1;
+    }
+    ThreadState & state = *state_pointer;
+
+    // Originator (method that called the current method)
+    const CallSite * caller_site = nullptr;
+    if (!state.m_CallStack.isEmpty())
+    {
+        caller_site = state.m_CallStack.last().m_CallSite;
+    }
+
+    // Decide if this call is recorded in the statistics and the history;
+    // the call stack always has all of them
+    const qint64 timestamp = Now();
+    int weight = 1;
+    const qint64 sampling_interval =
+        m_SamplingInterval.load(std::memory_order_relaxed);
+    const int sampling_rate = m_SamplingRate.load(std::memory_order_relaxed);
+    if (sampling_interval > 0)
+    {
+        // Time based: first call after the interval, standing in for all
+        // calls since the last sample
+        state.m_CallsSinceSample++;
+        if (timestamp - state.m_LastSample < sampling_interval)
+        {
+            weight = 0;
+        } else
+        {
+            weight = state.m_CallsSinceSample;
+            state.m_CallsSinceSample = 0;
+            state.m_LastSample = timestamp;
+        }
+    } else if (sampling_rate > 1)
+    {
+        // Every n-th call of this call site
+        weight = (mcpCallSite -> m_SampleCount
+            .fetch_add(1, std::memory_order_relaxed) % sampling_rate == 0 ?
+                sampling_rate : 0);
+    }
+
+    // Call stack
+    CallRecord record;
+    record.m_CallSite = mcpCallSite;
+    record.m_Timestamp = timestamp;
+    record.m_Weight = weight;
+    record.m_CpuTimestamp = (weight > 0 &&
+        m_MeasureCpuTime.load(std::memory_order_relaxed) ? CpuNow() : 0);
+    record.m_ChildTime = 0;
+    record.m_ChildCpuTime = 0;
+    record.m_Parameters = mcpParameters;
+    record.m_FormatParameters = mcpFormatParameters;
+
+    // Verbose output needs the text right away
+    const bool is_verbose = m_IsVerbose.load(std::memory_order_relaxed);
+    if (is_verbose)
+    {
+        record.m_Text = mcpFormatParameters(mcpParameters);
+        record.m_Parameters = nullptr;
+    }
+    state.m_CallStack << record;
+    if (weight > 0)
+    {
+        if (m_KeepAllHistory.load(std::memory_order_relaxed))
+        {
+            AddHistoryEvent(mcpCallSite, timestamp, state.m_ThreadId, 0);
+        }
+
+        // Call count and originator (scaled if sampling)
+        GetCounters(state, CounterKey(mcpCallSite, caller_site))
+            .m_CallCount.fetch_add(weight, std::memory_order_relaxed);
+    }
+
+    // Print on screen if required
+    if (is_verbose)
+    {
+        qDebug().noquote() << tr("Enter: %1 %2(%3)")
+            .arg(FormatTimestamp(record.m_Timestamp),
+                mcpCallSite -> m_Method,
+                record.m_Text);
+    }
+
+    return state.m_CallStack.size() - 1;
+}
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// Evaluate parameters of an entry that outlives its function
+void CallTracer::ReleaseParameters(const void * mcpParameters,
+    const int mcDepth)
+{
+    ThreadState * state = CurrentThread();
+
+    // Usually, CALL_OUT() has removed the entry already
+    if (!state ||
+        mcDepth < 0 ||
+        mcDepth >= state -> m_CallStack.size())
+    {
+        return;
+    }
+    CallRecord & record = state -> m_CallStack[mcDepth];
+    if (record.m_Parameters == mcpParameters)
+    {
+        record.m_Text = record.m_FormatParameters(mcpParameters);
+        record.m_Parameters = nullptr;
+    }
+}
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// Exit function
+void CallTracer::ExitFunction(const char * mcpFilename,
+    const char * mcpFunction, const int mcLine, const QString & mcrReason)
+{
+    // Nothing to record once the thread state is gone
+    ThreadState * state_pointer = CurrentThread();
+    if (!state_pointer)
+    {
+        return;
+    }
+    ThreadState & state = *state_pointer;
+
+    // Check if we just ran out of stack
+    // (happens if we forget to have a CALL_IN() but we do a CALL_OUT()
+    if (state.m_CallStack.isEmpty())
+    {
+        // That shouldn't happen!
+        qDebug().noquote() << tr("CallTracer::ExitFunction(): Ran out of "
+            "stack when exiting \"%1::%2\" - probably a missing CALL_IN().")
+            .arg(ClassName(mcpFilename),
+                 mcpFunction);
+        return;
+    }
+
+    // Check if exiting function mathes last incoming method
+    // (__func__ is the same object throughout a function, so comparing
+    // pointers is usually enough)
+    const CallSite * call_site = state.m_CallStack.last().m_CallSite;
+    if (call_site -> m_Function != mcpFunction &&
+        (strcmp(call_site -> m_Function, mcpFunction) != 0 ||
+         strcmp(call_site -> m_Filename, mcpFilename) != 0))
+    {
+        // That shouldn't happen!
+        qDebug().noquote() << tr("CallTracer::ExitFunction(): Mismatching "
+            "method names exiting method %1::%2 (matching incoming method "
+            "is %3)")
+            .arg(ClassName(mcpFilename),
+                mcpFunction,
+                call_site -> m_Method);
+
+        // Methods above the one being exited were left without CALL_OUT();
+        // drop them
+        int match_index = state.m_CallStack.size() - 2;
+        while (match_index >= 0)
+        {
+            const CallSite * candidate =
+                state.m_CallStack[match_index].m_CallSite;
+            if (candidate -> m_Function == mcpFunction ||
+                (strcmp(candidate -> m_Function, mcpFunction) == 0 &&
+                 strcmp(candidate -> m_Filename, mcpFilename) == 0))
+            {
+                break;
+            }
+            match_index--;
+        }
+        if (match_index < 0)
+        {
+            // Not in the call stack at all (missing CALL_IN())
+            return;
+        }
+        state.m_CallStack.resize(match_index + 1);
+        call_site = state.m_CallStack.last().m_CallSite;
+    }
+
+    // Time spent
+    const qint64 timestamp = Now();
+    const CallRecord & entry = state.m_CallStack.last();
+    const qint64 inclusive_time = timestamp - entry.m_Timestamp;
+    const qint64 inclusive_cpu_time = (entry.m_CpuTimestamp > 0 ?
+        CpuNow() - entry.m_CpuTimestamp : 0);
+    const CallSite * caller_site = nullptr;
+    if (state.m_CallStack.size() > 1)
+    {
+        CallRecord & caller = state.m_CallStack[state.m_CallStack.size() - 2];
+        caller_site = caller.m_CallSite;
+        caller.m_ChildTime += inclusive_time;
+        caller.m_ChildCpuTime += inclusive_cpu_time;
+    }
+
+    // Statistics (scaled if sampling)
+    const int weight = entry.m_Weight;
+    if (weight > 0)
+    {
+        CallCounters & counters =
+            GetCounters(state, CounterKey(call_site, caller_site));
+        counters.m_InclusiveTime.fetch_add(weight * inclusive_time,
+            std::memory_order_relaxed);
+        counters.m_ExclusiveTime.fetch_add(
+            weight * (inclusive_time - entry.m_ChildTime),
+            std::memory_order_relaxed);
+        if (inclusive_cpu_time > 0)
+        {
+            counters.m_InclusiveCpuTime.fetch_add(
+                weight * inclusive_cpu_time,
+                std::memory_order_relaxed);
+            counters.m_ExclusiveCpuTime.fetch_add(
+                weight * (inclusive_cpu_time - entry.m_ChildCpuTime),
+                std::memory_order_relaxed);
+        }
+        const int bucket = qBound(0,
+            63 - qCountLeadingZeroBits(quint64(inclusive_time) | 1) - 7,
+            NUMBER_OF_TIME_BUCKETS - 1);
+        counters.m_TimeHistogram[bucket].fetch_add(weight,
+            std::memory_order_relaxed);
+    }
+
+    // Print on screen if required
+    if (m_IsVerbose.load(std::memory_order_relaxed))
+    {
+        if (mcrReason.isEmpty())
+        {
+            qDebug().noquote() << tr("Exit: %1 %2()")
+                .arg(FormatTimestamp(timestamp),
+                     call_site -> m_Method);
+        } else
+        {
+            qDebug().noquote() << tr("Exit: %1 %2(): %3")
+                .arg(FormatTimestamp(timestamp),
+                     call_site -> m_Method,
+                     mcrReason);
+        }
+    }
+
+    if (weight > 0 &&
+        m_KeepAllHistory.load(std::memory_order_relaxed))
+    {
+        AddHistoryEvent(call_site, timestamp, state.m_ThreadId,
+            quint16(qBound(1, mcLine + 1, 0xffff)));
+    }
+    state.m_CallStack.removeLast();
+}
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// Return stack
+QString CallTracer::GetCallTrace()
+{
+    // No call stack once the thread state is gone
+    const ThreadState * state_pointer = CurrentThread();
+    if (!state_pointer)
+    {
+        return QString();
+    }
+    const ThreadState & state = *state_pointer;
+    QString trace = tr("--------- Trace start\n");
+    if (m_KeepAllHistory)
+    {
+        // History of this thread
+        const QList < HistoryEvent > events = GetHistory();
+        QMutexLocker lock(&m_CallSitesMutex);
+        for (const HistoryEvent & event : events)
+        {
+            if (event.m_ThreadId != state.m_ThreadId)
+            {
+                continue;
+            }
+            const CallSite * call_site = m_CallSites[int(event.m_CallSiteId)];
+            if (event.m_Phase == 0)
+            {
+                // Entering
+                trace += QString("%1 %2()\n")
+                    .arg(FormatTimestamp(event.m_Timestamp),
+                        call_site -> m_Method);
+            } else
+            {
+                // Leaving
+                trace += QString("%1 %2 (%3)%4\n")
+                    .arg(FormatTimestamp(event.m_Timestamp),
+                        call_site -> m_Method,
+                        QString::number(event.m_Phase - 1),
+                        tr(": leaving"));
+            }
+        }
+    } else
+    {
+        // Work on a copy: evaluating parameters may call traced methods,
+        // which changes the call stack
+        const QList < CallRecord > records = state.m_CallStack;
+        for (const CallRecord & record : records)
+        {
+            trace += QString("%1 %2(%3)\n")
+                .arg(FormatTimestamp(record.m_Timestamp),
+                    record.m_CallSite -> m_Method,
+                    GetParameters(record));
+        }
+    }
+    trace += tr("--------- Trace end\n\n");
+
+    return trace;
+}
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// Class name
+QString CallTracer::ClassName(const QString mcFilename)
+{
+    // Using StringHelper::SplitFilename here will create and infitite loop
+    // since the function calls CALL_IN() which uses ClassName().
+    QString class_name;
+    const int index = mcFilename.lastIndexOf("/");
+    if (index != -1)
+    {
+        class_name = mcFilename.mid(index+1);
+    } else
+    {
+        class_name = mcFilename;
+    }
+    class_name.replace(".cpp", "");
+
+    return class_name;
+}
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// Parameter text of a call record
+QString CallTracer::GetParameters(const CallRecord & mcrRecord)
+{
+    if (mcrRecord.m_Parameters)
+    {
+        return mcrRecord.m_FormatParameters(mcrRecord.m_Parameters);
+    }
+    return mcrRecord.m_Text;
+}
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// Monotonic clock in nanoseconds
+qint64 CallTracer::Now()
+{
+    return std::chrono::duration_cast < std::chrono::nanoseconds >(
+        std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// CPU time of the current thread in nanoseconds
+qint64 CallTracer::CpuNow()
+{
+#ifdef Q_OS_WIN
+    FILETIME creation_time;
+    FILETIME exit_time;
+    FILETIME kernel_time;
+    FILETIME user_time;
+    GetThreadTimes(GetCurrentThread(), &creation_time, &exit_time,
+        &kernel_time, &user_time);
+    const quint64 kernel = (quint64(kernel_time.dwHighDateTime) << 32) |
+        kernel_time.dwLowDateTime;
+    const quint64 user = (quint64(user_time.dwHighDateTime) << 32) |
+        user_time.dwLowDateTime;
+
+    // 100 ns units
+    return qint64(kernel + user) * 100;
+#else
+    timespec now;
+    clock_gettime(CLOCK_THREAD_CPUTIME_ID, &now);
+    return qint64(now.tv_sec) * 1000000000 + now.tv_nsec;
+#endif
+}
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// Human readable date and time for a monotonic time stamp
+QString CallTracer::FormatTimestamp(const qint64 mcTimestamp)
+{
+    // Wall clock and monotonic clock at the same moment
+    static const QDateTime wall_clock_start = QDateTime::currentDateTime();
+    static const qint64 monotonic_start = Now();
+
+    return wall_clock_start
+        .addMSecs((mcTimestamp - monotonic_start) / 1000000)
+        .toString("yyyy-MM-dd hh:mm:ss.zzz");
+}
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// Call sites and threads
+QList < CallTracer::CallSite * > CallTracer::m_CallSites;
+QMutex CallTracer::m_CallSitesMutex;
+QList < CallTracer::ThreadState * > CallTracer::m_Threads;
+QMutex CallTracer::m_ThreadsMutex;
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// Keeping history
+std::atomic < bool > CallTracer::m_KeepAllHistory(false);
+std::atomic < CallTracer::HistoryBuffer * > CallTracer::m_History(nullptr);
+std::atomic < quint64 > CallTracer::m_HistoryCount(0);
+
+
+
+// =============================================================== Method usage
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// Key for a pair of called and calling call site
+quint64 CallTracer::CounterKey(const CallSite * mcpCalled,
+    const CallSite * mcpCaller)
+{
+    // 0 is reserved for unused counters
+    return (quint64(mcpCalled -> m_Id + 1) << 32) |
+        quint64(mcpCaller ? mcpCaller -> m_Id + 1 : 0);
+}
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// Counters of the current thread for a pair of call sites
+CallTracer::CallCounters & CallTracer::GetCounters(ThreadState & mrState,
+    const quint64 mcKey)
+{
+    // Only this thread ever writes to the table, so no locking is needed;
+    // the counters are atomic so other threads can read them at any time
+    CounterTable * table = mrState.m_Counters.load(std::memory_order_relaxed);
+    const int mask = table -> m_Capacity - 1;
+    int index = int((mcKey * Q_UINT64_C(0x9e3779b97f4a7c15)) >> 40) & mask;
+    while (true)
+    {
+        CallCounters & counters = table -> m_Counters[index];
+        const quint64 key = counters.m_Key.load(std::memory_order_relaxed);
+        if (key == mcKey)
+        {
+            return counters;
+        }
+        if (key == 0)
+        {
+            // New counter (all zero already)
+            counters.m_Key.store(mcKey, std::memory_order_release);
+            mrState.m_NumberOfCounters++;
+            break;
+        }
+        index = (index + 1) & mask;
+    }
+
+    // Grow table if it's getting crowded
+    if (mrState.m_NumberOfCounters * 4 < table -> m_Capacity * 3)
+    {
+        return table -> m_Counters[index];
+    }
+    CounterTable * new_table = new CounterTable(2 * table -> m_Capacity);
+    const int new_mask = new_table -> m_Capacity - 1;
+    int new_index_of_key = -1;
+    for (int old_index = 0; old_index < table -> m_Capacity; old_index++)
+    {
+        const CallCounters & old_counters = table -> m_Counters[old_index];
+        const quint64 key = old_counters.m_Key.load(std::memory_order_relaxed);
+        if (key == 0)
+        {
+            continue;
+        }
+        int new_index =
+            int((key * Q_UINT64_C(0x9e3779b97f4a7c15)) >> 40) & new_mask;
+        while (new_table -> m_Counters[new_index].m_Key
+            .load(std::memory_order_relaxed) != 0)
+        {
+            new_index = (new_index + 1) & new_mask;
+        }
+        new_table -> m_Counters[new_index].CopyFrom(old_counters);
+        new_table -> m_Counters[new_index].m_Key.store(key,
+            std::memory_order_relaxed);
+        if (key == mcKey)
+        {
+            new_index_of_key = new_index;
+        }
+    }
+    mrState.m_Counters.store(new_table, std::memory_order_release);
+
+    // Old table may still be read by CollectStatistics()
+    QMutexLocker lock(&m_ThreadsMutex);
+    mrState.m_ReplacedCounters << table;
+
+    return new_table -> m_Counters[new_index_of_key];
+}
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// Combine counters of all threads
+QHash < quint64, CallTracer::CallStatistics > CallTracer::CollectStatistics()
+{
+    QMutexLocker lock(&m_ThreadsMutex);
+    QHash < quint64, CallStatistics > statistics =
+        m_FinishedThreadsStatistics;
+    for (const ThreadState * state : m_Threads)
+    {
+        const CounterTable * table =
+            state -> m_Counters.load(std::memory_order_acquire);
+        for (int index = 0; index < table -> m_Capacity; index++)
+        {
+            const CallCounters & counters = table -> m_Counters[index];
+            const quint64 key =
+                counters.m_Key.load(std::memory_order_acquire);
+            if (key != 0)
+            {
+                statistics[key].Add(counters);
+            }
+        }
+    }
+
+    return statistics;
+}
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// Reset usage
+void CallTracer::ResetUsage(const QString mcClass, const QString mcMethod)
+{
+    // Call sites to reset
+    QSet < quint64 > reset_ids;
+    {
+        QMutexLocker lock(&m_CallSitesMutex);
+        for (const CallSite * call_site : m_CallSites)
+        {
+            if (mcClass.isEmpty() ||
+                (call_site -> m_Class == mcClass &&
+                 (mcMethod.isEmpty() ||
+                  mcMethod == call_site -> m_Function)))
+            {
+                reset_ids += quint64(call_site -> m_Id + 1);
+            }
+        }
+    }
+
+    // Counters are not removed (other threads own them), just set to 0
+    QMutexLocker lock(&m_ThreadsMutex);
+    for (const ThreadState * state : m_Threads)
+    {
+        CounterTable * table =
+            state -> m_Counters.load(std::memory_order_acquire);
+        for (int index = 0; index < table -> m_Capacity; index++)
+        {
+            CallCounters & counters = table -> m_Counters[index];
+            const quint64 key =
+                counters.m_Key.load(std::memory_order_acquire);
+            if (key != 0 &&
+                reset_ids.contains(key >> 32))
+            {
+                counters.Reset();
+            }
+        }
+    }
+    for (auto count_iterator = m_FinishedThreadsStatistics.begin();
+         count_iterator != m_FinishedThreadsStatistics.end();)
+    {
+        if (reset_ids.contains(count_iterator.key() >> 32))
+        {
+            count_iterator =
+                m_FinishedThreadsStatistics.erase(count_iterator);
+        } else
+        {
+            count_iterator++;
+        }
+    }
+}
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// Show message usage
+void CallTracer::ShowUsage(const QString mcClass, const QString mcMethod)
+{
+    if (IsSampling())
+    {
+        qDebug().noquote() << tr("(Sampling; call counts are estimates.)");
+    }
+
+    const QHash < quint64, CallStatistics > all_counts = CollectStatistics();
+    QMutexLocker lock(&m_CallSitesMutex);
+
+    // Call counts by class and method
+    QHash < QString, QHash < QString, qint64 > > call_count;
+    for (auto count_iterator = all_counts.constBegin();
+         count_iterator != all_counts.constEnd();
+         count_iterator++)
+    {
+        const CallSite * call_site =
+            m_CallSites[int(count_iterator.key() >> 32) - 1];
+        if (!mcClass.isEmpty() &&
+            call_site -> m_Class != mcClass)
+        {
+            continue;
+        }
+        call_count[call_site -> m_Class][call_site -> m_Function] +=
+            count_iterator.value().m_CallCount;
+    }
+
+    QList < QString > all_classes = call_count.keys();
+    std::sort(all_classes.begin(), all_classes.end());
+    for (auto class_iterator = all_classes.begin();
+         class_iterator != all_classes.end();
+         class_iterator++)
+    {
+        const QString class_name = *class_iterator;
+        QList < QString > all_methods = call_count[class_name].keys();
+        if (!mcMethod.isEmpty())
+        {
+            all_methods = QList < QString >({ mcMethod });
+        }
+        std::sort(all_methods.begin(), all_methods.end());
+        for (auto method_iterator = all_methods.begin();
+             method_iterator != all_methods.end();
+             method_iterator++)
+        {
+            const QString method_name = *method_iterator;
+            const QString count = "      " +
+                QString::number(call_count[class_name].value(method_name));
+            qDebug().noquote() << QString("%1: %2::%3()")
+                .arg(count.right(7),
+                     class_name,
+                     method_name);
+        }
+    }
+}
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// Show call originator analysis
+void CallTracer::ShowCallOriginators(const QString mcClass,
+    const QString mcMethod)
+{
+    // Check if we know this method
+    const QString called_method = QString("%1::%2")
+        .arg(mcClass,
+            mcMethod);
+
+    qDebug().noquote() << tr("Caller statistics for %1").arg(called_method);
+
+    // Originators by method name
+    const QHash < quint64, CallStatistics > all_counts = CollectStatistics();
+    QHash < QString, int > originator_count;
+    {
+        QMutexLocker lock(&m_CallSitesMutex);
+        for (auto count_iterator = all_counts.constBegin();
+             count_iterator != all_counts.constEnd();
+             count_iterator++)
+        {
+            const quint64 key = count_iterator.key();
+            const CallSite * call_site = m_CallSites[int(key >> 32) - 1];
+            if (call_site -> m_Method != called_method ||
+                count_iterator.value().m_CallCount == 0)
+            {
+                continue;
+            }
+            const int caller_id = int(key & 0xffffffff) - 1;
+            const QString calling_method = (caller_id >= 0 ?
+                m_CallSites[caller_id] -> m_Method : QString());
+            originator_count[calling_method] +=
+                int(count_iterator.value().m_CallCount);
+        }
+    }
+
+    if (originator_count.isEmpty())
+    {
+        qDebug().noquote() << tr("  This method has never been called.");
+        return;
+    }
+
+    // Sort by frequency
+    QList < QString > sorted_keys = StringHelper::SortHash(originator_count);
+    while (!sorted_keys.isEmpty())
+    {
+        const QString calling_method = sorted_keys.takeLast();
+        const QString count = "      " +
+            QString::number(originator_count[calling_method]);
+        qDebug().noquote() << QString("%1: %2()")
+            .arg(count.right(7),
+                 calling_method);
+    }
+}
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// Only record some calls
+void CallTracer::SetSampling(const int mcOneInN, const int mcIntervalUS)
 {
-    // Nothing to do
+    m_SamplingRate = qMax(1, mcOneInN);
+    m_SamplingInterval = qint64(qMax(0, mcIntervalUS)) * 1000;
 }
 
 
 
-// ================================================================ Call Stack
-
-
-
 ///////////////////////////////////////////////////////////////////////////////
-// Reset history
-void CallTracer::ResetHistory()
+// Check if only some calls are recorded
+bool CallTracer::IsSampling()
 {
-    m_CallStack_Time.clear();
-    m_CallStack_Method.clear();
-    m_CallStack_Text.clear();
-    m_CallCount.clear();
-    m_OriginatorCount.clear();
+    return m_SamplingRate > 1 ||
+        m_SamplingInterval > 0;
 }
 
 
 
 ///////////////////////////////////////////////////////////////////////////////
-// Set keeping all history
-void CallTracer::SetKeepAllHistory(const bool mcKeepHistory)
+// Measure CPU time in addition to wall time
+void CallTracer::SetMeasureCpuTime(const bool mcMeasureCpuTime)
 {
-    m_KeepAllHistory = mcKeepHistory;
+    m_MeasureCpuTime = mcMeasureCpuTime;
 }
 
 
 
 ///////////////////////////////////////////////////////////////////////////////
-// Enter function
-void CallTracer::EnterFunction(const QString mcFilename,
-    const QString mcFunction, const QString mcParameters)
+// Show time spent per method
+void CallTracer::ShowProfile(const int mcMaxMethods)
 {
-    const QString timestamp =
-        QDateTime::currentDateTime().toString("yyyy-MM-dd hh:mm:ss.zzz");
-    const QString class_name = ClassName(mcFilename);
+    // Statistics by method (any caller)
+    const QHash < quint64, CallStatistics > all_statistics =
+        CollectStatistics();
+    QHash < QString, CallStatistics > method_statistics;
+    qint64 total_time = 0;
+    {
+        QMutexLocker lock(&m_CallSitesMutex);
+        for (auto statistics_iterator = all_statistics.constBegin();
+             statistics_iterator != all_statistics.constEnd();
+             statistics_iterator++)
+        {
+            const CallSite * call_site =
+                m_CallSites[int(statistics_iterator.key() >> 32) - 1];
+            method_statistics[call_site -> m_Method]
+                .Add(statistics_iterator.value());
+            total_time += statistics_iterator.value().m_ExclusiveTime;
+        }
+    }
 
-    // Originator (method that called the current method)
-    QString caller_method;
-    if (!m_CallStack_Method.isEmpty())
+    // Sort by exclusive time
+    QList < QString > methods = method_statistics.keys();
+    std::sort(methods.begin(), methods.end(),
+        [&](const QString & mcrLeft, const QString & mcrRight)
+        {
+            return method_statistics[mcrLeft].m_ExclusiveTime >
+                method_statistics[mcrRight].m_ExclusiveTime;
+        });
+    if (mcMaxMethods > 0 &&
+        methods.size() > mcMaxMethods)
     {
-        caller_method = m_CallStack_Method.last();
+        methods = methods.mid(0, mcMaxMethods);
     }
 
-    // Call count
-    const QString called_method = QString("%1::%2")
-        .arg(class_name,
-            mcFunction);
-    m_CallStack_Time << timestamp;
-    m_CallStack_Method << called_method;
-    m_CallStack_Text << QString("(%1)").arg(mcParameters);
-    m_CallCount[class_name][mcFunction]++;
-
-    // Log originator
-    m_OriginatorCount[called_method][caller_method]++;
+    // Times in ms
+    auto format_time = [](const qint64 mcTime, const int mcWidth)
+    {
+        return QString::number(mcTime / 1e6, 'f', 3)
+            .rightJustified(mcWidth);
+    };
 
-    // Print on screen if required
-    if (m_IsVerbose)
+    qDebug().noquote() << tr("===== Profile (times in ms, percentiles of "
+        "inclusive time per call)");
+    if (IsSampling())
     {
-        qDebug().noquote() << tr("Enter: %1 %2%3")
-            .arg(m_CallStack_Time.last(),
-                m_CallStack_Method.last(),
-                m_CallStack_Text.last());
+        qDebug().noquote() << tr("(Sampling; counts and times are "
+            "estimates.)");
     }
+    qDebug().noquote() << tr("    excl      %  incl       cpu excl   "
+        "cpu incl     calls     p50      p90      p99  method");
+    for (const QString & method : methods)
+    {
+        const CallStatistics & statistics = method_statistics[method];
+        const double percent = (total_time > 0 ?
+            100. * statistics.m_ExclusiveTime / total_time : 0.);
+        qDebug().noquote() << QString("%1 %2 %3 %4 %5 %6 %7 %8 %9  %10")
+            .arg(format_time(statistics.m_ExclusiveTime, 9),
+                 QString::number(percent, 'f', 1).rightJustified(5),
+                 format_time(statistics.m_InclusiveTime, 10),
+                 format_time(statistics.m_ExclusiveCpuTime, 10),
+                 format_time(statistics.m_InclusiveCpuTime, 10),
+                 QString::number(statistics.m_CallCount).rightJustified(9),
+                 format_time(statistics.Percentile(0.5), 8),
+                 format_time(statistics.Percentile(0.9), 8),
+                 format_time(statistics.Percentile(0.99), 8))
+            .arg(method);
+    }
+    qDebug().noquote() << "\n";
 }
 
 
 
 ///////////////////////////////////////////////////////////////////////////////
-// Exit function
-void CallTracer::ExitFunction(const QString mcFilename,
-    const QString mcFunction, const int mcLine, const QString mcReason)
+// Show time spent per method as a tree of callers and callees
+void CallTracer::ShowProfileTree(const int mcMaxDepth,
+    const double mcMinPercent)
 {
-    // Full method name
-    const QString class_name = ClassName(mcFilename);
-    const QString full_method = QString("%1::%2")
-        .arg(class_name,
-            mcFunction);
-
-    // Check if we just ran out of stack
-    // (happens if we forget to have a CALL_IN() but we do a CALL_OUT()
-    if (m_CallStack_Method.isEmpty())
-    {
-        // That shouldn't happen!
-        qDebug().noquote() << tr("CallTracer::ExitFunction(): Ran out of "
-            "stack when exiting \"%1\" - probably a missing CALL_IN().")
-            .arg(full_method);
-        return;
+    // Statistics by calling and called call site
+    const QHash < quint64, CallStatistics > all_statistics =
+        CollectStatistics();
+    QHash < int, QHash < int, CallStatistics > > callees;
+    qint64 total_time = 0;
+    for (auto statistics_iterator = all_statistics.constBegin();
+         statistics_iterator != all_statistics.constEnd();
+         statistics_iterator++)
+    {
+        const quint64 key = statistics_iterator.key();
+        const int called_id = int(key >> 32) - 1;
+        const int caller_id = int(key & 0xffffffff) - 1;
+        callees[caller_id][called_id] = statistics_iterator.value();
+        if (caller_id == -1)
+        {
+            total_time += statistics_iterator.value().m_InclusiveTime;
+        }
     }
 
-    // Check if exiting function mathes last incoming method
-    if (m_CallStack_Method.last() != full_method)
+    qDebug().noquote() << tr("===== Profile tree (inclusive ms, exclusive "
+        "ms, calls)");
+    QList < int > path;
+    QMutexLocker lock(&m_CallSitesMutex);
+    ShowProfileTree(callees, -1, QString(), path, mcMaxDepth,
+        qint64(total_time * mcMinPercent / 100.));
+    qDebug().noquote() << "\n";
+}
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// Show one level of the profile tree
+void CallTracer::ShowProfileTree(
+    const QHash < int, QHash < int, CallStatistics > > & mcrCallees,
+    const int mcCallerId, const QString & mcrIndentation,
+    QList < int > & mrPath, const int mcMaxDepth, const qint64 mcMinTime)
+{
+    if (mrPath.size() >= mcMaxDepth ||
+        !mcrCallees.contains(mcCallerId))
     {
-        // That shouldn't happen!
-        qDebug().noquote() << tr("CallTracer::ExitFunction(): Mismatching "
-            "method names exiting method %1 (matching incoming method is %2)")
-            .arg(full_method,
-                m_CallStack_Method.last());
         return;
     }
 
-    // Print on screen if required
-    const QString timestamp = CALL_TIMESTAMP;
-    if (m_IsVerbose)
-    {
-        if (mcReason.isEmpty())
+    // Most expensive callees first (sorting iterators, so the statistics
+    // are not copied for every comparison)
+    const QHash < int, CallStatistics > & callees =
+        mcrCallees.constFind(mcCallerId).value();
+    typedef QHash < int, CallStatistics >::const_iterator CalleeIterator;
+    QList < CalleeIterator > sorted_callees;
+    sorted_callees.reserve(callees.size());
+    for (auto callee_iterator = callees.constBegin();
+         callee_iterator != callees.constEnd();
+         callee_iterator++)
+    {
+        sorted_callees << callee_iterator;
+    }
+    std::sort(sorted_callees.begin(), sorted_callees.end(),
+        [](const CalleeIterator & mcrLeft, const CalleeIterator & mcrRight)
         {
-            qDebug().noquote() << tr("Exit: %1 %2()")
-                .arg(timestamp,
-                     full_method);
-        } else
+            return mcrLeft.value().m_InclusiveTime >
+                mcrRight.value().m_InclusiveTime;
+        });
+    for (const CalleeIterator & callee_iterator : sorted_callees)
+    {
+        const int called_id = callee_iterator.key();
+        const CallStatistics & statistics = callee_iterator.value();
+        if (statistics.m_InclusiveTime < mcMinTime)
         {
-            qDebug().noquote() << tr("Exit: %1 %2(): %3")
-                .arg(timestamp,
-                     full_method,
-                     mcReason);
+            break;
         }
-    }
-
-    if (m_KeepAllHistory)
-    {
-        m_CallStack_Time << timestamp;
-        m_CallStack_Method << QString("%1 (%2)")
-            .arg(full_method,
-                 QString::number(mcLine));
-        if (mcReason.isEmpty())
-        {
-            m_CallStack_Text << tr(": leaving");
-        } else
+        qDebug().noquote() << QString("%1%2 (%3 ms, %4 ms, %5)")
+            .arg(mcrIndentation,
+                 m_CallSites[called_id] -> m_Method,
+                 QString::number(statistics.m_InclusiveTime / 1e6, 'f', 3),
+                 QString::number(statistics.m_ExclusiveTime / 1e6, 'f', 3),
+                 QString::number(statistics.m_CallCount));
+
+        // Don't follow recursion
+        if (mrPath.contains(called_id))
         {
-            m_CallStack_Text << tr(": leaving (%1)").arg(mcReason);
+            continue;
         }
-    } else
-    {
-        m_CallStack_Time.takeLast();
-        m_CallStack_Method.takeLast();
-        m_CallStack_Text.takeLast();
+        mrPath << called_id;
+        ShowProfileTree(mcrCallees, called_id, mcrIndentation + "  ", mrPath,
+            mcMaxDepth, mcMinTime);
+        mrPath.removeLast();
     }
 }
 
 
 
 ///////////////////////////////////////////////////////////////////////////////
-// Return stack
-QString CallTracer::GetCallTrace()
-{
-    QString trace = tr("--------- Trace start\n");
-    for (int index = 0; index < m_CallStack_Time.size(); index++)
-    {
-        trace += QString("%1 %2%3\n")
-            .arg(m_CallStack_Time[index],
-                m_CallStack_Method[index],
-                m_CallStack_Text[index]);
-    }
-    trace += tr("--------- Trace end\n\n");
-
-    return trace;
-}
+// Statistics of threads that have finished
+QHash < quint64, CallTracer::CallStatistics >
+    CallTracer::m_FinishedThreadsStatistics =
+        QHash < quint64, CallStatistics > ();
 
 
 
 ///////////////////////////////////////////////////////////////////////////////
-// Class name
-QString CallTracer::ClassName(const QString mcFilename)
-{
-    // Using StringHelper::SplitFilename here will create and infitite loop
-    // since the function calls CALL_IN() which uses ClassName().
-    QString class_name;
-    const int index = mcFilename.lastIndexOf("/");
-    if (index != -1)
-    {
-        class_name = mcFilename.mid(index+1);
-    } else
-    {
-        class_name = mcFilename;
-    }
-    class_name.replace(".cpp", "");
-
-    return class_name;
-}
+// Measuring CPU time
+std::atomic < bool > CallTracer::m_MeasureCpuTime(false);
 
 
 
 ///////////////////////////////////////////////////////////////////////////////
-// Call stacks
-QList < QString > CallTracer::m_CallStack_Time;
-QList < QString > CallTracer::m_CallStack_Method;
-QList < QString > CallTracer::m_CallStack_Text;
+// Sampling
+std::atomic < int > CallTracer::m_SamplingRate(1);
+std::atomic < qint64 > CallTracer::m_SamplingInterval(0);
 
 
 
 ///////////////////////////////////////////////////////////////////////////////
-// Keeping history
-bool CallTracer::m_KeepAllHistory = false;
+// Verbosity
+void CallTracer::SetVerbosity(const bool mcNewVerbosity)
+{
+    m_IsVerbose = mcNewVerbosity;
+}
 
 
 
-// =============================================================== Method usage
+///////////////////////////////////////////////////////////////////////////////
+// Verbosity
+std::atomic < bool > CallTracer::m_IsVerbose(false);
 
 
 
 ///////////////////////////////////////////////////////////////////////////////
-// Reset usage
-void CallTracer::ResetUsage(const QString mcClass, const QString mcMethod)
+// Print line for debugging purposes
+void CallTracer::DebugLine(const QString & mcrFile, const int mcLine)
 {
-    if (mcClass.isEmpty())
-    {
-        m_CallCount.clear();
-    } else
-    {
-        if (mcMethod.isEmpty())
-        {
-            m_CallCount[mcClass].clear();
-        } else
-        {
-            m_CallCount[mcClass].remove(mcMethod);
-        }
-    }
+    // Filename
+    const QPair < QString, QString > split_filename =
+        StringHelper::SplitFilename(mcrFile);
+    const QString now =
+        QDateTime::currentDateTime().toString("yyyy-MM-dd hh:mm:ss.zzz");
+
+    qDebug().noquote() << tr("%1 %2: line %3")
+        .arg(now,
+             split_filename.second,
+             QString::number(mcLine));
 }
 
 
 
 ///////////////////////////////////////////////////////////////////////////////
-// Show message usage
-void CallTracer::ShowUsage(const QString mcClass, const QString mcMethod)
+// Part of the instance registry: a chain of hash tables (open addressing,
+// lock-free); when the probe window of an instance is full in every table,
+// a table twice the size of the last one is added
+struct CallTracer::InstanceShard
 {
-    if (mcClass.isEmpty())
+    // Slot in a table
+    struct Slot
     {
-        QList < QString > all_classes = m_CallCount.keys();
-        std::sort(all_classes.begin(), all_classes.end());
-        for (auto class_iterator = all_classes.begin();
-             class_iterator != all_classes.end();
-             class_iterator++)
-        {
-            const QString class_name = *class_iterator;
-            ShowUsage(class_name);
-        }
-    } else
+        // Instance (or EMPTY_INSTANCE_SLOT/DELETED_INSTANCE_SLOT)
+        std::atomic < quintptr > m_Instance;
+
+        // Class ID
+        std::atomic < qint32 > m_ClassId;
+
+        // Call site ID + 1 of the method creating the instance; 0 if unknown
+        std::atomic < qint32 > m_CallerId;
+    };
+
+    // One table; tables are never deleted, so they can be read without
+    // locking at any time
+    struct Table
     {
-        if (mcMethod.isEmpty())
+        // Constructor
+        explicit Table(const int mcSize)
         {
-            QList < QString > all_methods = m_CallCount[mcClass].keys();
-            std::sort(all_methods.begin(), all_methods.end());
-            for (auto method_iterator = all_methods.begin();
-                 method_iterator != all_methods.end();
-                 method_iterator++)
+            m_Size = mcSize;
+            m_Slots = new Slot[mcSize];
+            for (int index = 0; index < mcSize; index++)
             {
-                const QString method_name = *method_iterator;
-                ShowUsage(mcClass, method_name);
+                m_Slots[index].m_Instance.store(EMPTY_INSTANCE_SLOT,
+                    std::memory_order_relaxed);
+                m_Slots[index].m_ClassId.store(-1, std::memory_order_relaxed);
+                m_Slots[index].m_CallerId.store(0, std::memory_order_relaxed);
             }
-        } else
-        {
-            const QString count =
-                "      " + QString::number(m_CallCount[mcClass][mcMethod]);
-            qDebug().noquote() << QString("%1: %2::%3()")
-                .arg(count.right(7),
-                     mcClass,
-                     mcMethod);
+            m_Next.store(nullptr, std::memory_order_relaxed);
         }
-    }
-}
 
+        // Destructor
+        ~Table()
+        {
+            delete [] m_Slots;
+        }
 
+        // Number of slots (power of 2)
+        int m_Size;
 
-///////////////////////////////////////////////////////////////////////////////
-// Show call originator analysis
-void CallTracer::ShowCallOriginators(const QString mcClass,
-    const QString mcMethod)
-{
-    // Check if we know this method
-    const QString called_method = QString("%1::%2")
-        .arg(mcClass,
-            mcMethod);
+        // Slots
+        Slot * m_Slots;
 
-    qDebug().noquote() << tr("Caller statistics for %1").arg(called_method);
+        // Next (bigger) table
+        std::atomic < Table * > m_Next;
+    };
 
-    if (!m_OriginatorCount.contains(called_method))
+    // Constructor
+    InstanceShard()
     {
-        qDebug().noquote() << tr("  This method has never been called.");
-        return;
+        m_First.store(nullptr, std::memory_order_relaxed);
     }
 
-    // Sort by frequency
-    QList < QString > sorted_keys =
-        StringHelper::SortHash(m_OriginatorCount[called_method]);
-    while (!sorted_keys.isEmpty())
+    // Table after mpTable (or the first one for nullptr), allocated on
+    // first use
+    Table * GetNextTable(Table * mpTable)
     {
-        const QString calling_method = sorted_keys.takeLast();
-        const QString count = "      " +
-            QString::number(m_OriginatorCount[called_method][calling_method]);
-        qDebug().noquote() << QString("%1: %2()")
-            .arg(count.right(7),
-                 calling_method);
-    }
-}
-
+        std::atomic < Table * > & next =
+            (mpTable ? mpTable -> m_Next : m_First);
+        Table * table = next.load(std::memory_order_acquire);
+        if (table)
+        {
+            return table;
+        }
+        Table * new_table = new Table(
+            mpTable ? 2 * mpTable -> m_Size : INSTANCE_SHARD_SIZE);
+        if (next.compare_exchange_strong(table, new_table,
+            std::memory_order_acq_rel))
+        {
+            return new_table;
+        }
 
+        // Somebody else was faster
+        delete new_table;
+        return table;
+    }
 
-///////////////////////////////////////////////////////////////////////////////
-// Call count
-QHash < QString, QHash < QString, int > > CallTracer::m_CallCount =
-    QHash < QString, QHash < QString, int > > ();
+    // Add an instance; false if it is already there
+    bool Insert(const quintptr mcInstance, const qint32 mcClassId,
+        const qint32 mcCallerId, const quint64 mcHash)
+    {
+        while (true)
+        {
+            // First free slot within the probe window of any table. Slots
+            // never become empty again, so if a window has an empty slot,
+            // the instance cannot be in a later table.
+            Slot * free_slot = nullptr;
+            quintptr free_value = EMPTY_INSTANCE_SLOT;
+            Table * table = GetNextTable(nullptr);
+            while (true)
+            {
+                const int mask = table -> m_Size - 1;
+                const int start = int(mcHash >> 32) & mask;
+                bool found_empty = false;
+                for (int probe = 0; probe < MAX_INSTANCE_PROBES; probe++)
+                {
+                    Slot & slot = table -> m_Slots[(start + probe) & mask];
+                    const quintptr current =
+                        slot.m_Instance.load(std::memory_order_acquire);
+                    if (current == EMPTY_INSTANCE_SLOT ||
+                        current == DELETED_INSTANCE_SLOT)
+                    {
+                        if (!free_slot)
+                        {
+                            free_slot = &slot;
+                            free_value = current;
+                        }
+                        if (current == EMPTY_INSTANCE_SLOT)
+                        {
+                            // Nothing beyond an empty slot
+                            found_empty = true;
+                            break;
+                        }
+                        continue;
+                    }
+                    if (current == mcInstance &&
+                        slot.m_ClassId.load(std::memory_order_acquire) ==
+                            mcClassId)
+                    {
+                        return false;
+                    }
+                }
+                if (found_empty)
+                {
+                    break;
+                }
+                Table * next = table -> m_Next.load(std::memory_order_acquire);
+                if (!next)
+                {
+                    if (free_slot)
+                    {
+                        break;
+                    }
+
+                    // All windows are full: add a bigger table
+                    next = GetNextTable(table);
+                }
+                table = next;
+            }
 
+            // Claim it (another thread may have been faster; try again)
+            if (free_slot -> m_Instance.compare_exchange_strong(free_value,
+                mcInstance, std::memory_order_acq_rel))
+            {
+                free_slot -> m_CallerId.store(mcCallerId,
+                    std::memory_order_relaxed);
+                free_slot -> m_ClassId.store(mcClassId,
+                    std::memory_order_release);
+                return true;
+            }
+        }
+    }
 
+    // Remove an instance; false if it isn't there
+    bool Remove(const quintptr mcInstance, const qint32 mcClassId,
+        const quint64 mcHash)
+    {
+        for (Table * table = m_First.load(std::memory_order_acquire);
+             table;
+             table = table -> m_Next.load(std::memory_order_acquire))
+        {
+            const int mask = table -> m_Size - 1;
+            const int start = int(mcHash >> 32) & mask;
+            for (int probe = 0; probe < MAX_INSTANCE_PROBES; probe++)
+            {
+                Slot & slot = table -> m_Slots[(start + probe) & mask];
+                quintptr current =
+                    slot.m_Instance.load(std::memory_order_acquire);
+                if (current == EMPTY_INSTANCE_SLOT)
+                {
+                    // Not in this table or any later one
+                    return false;
+                }
+                if (current == mcInstance &&
+                    slot.m_ClassId.load(std::memory_order_acquire) ==
+                        mcClassId &&
+                    slot.m_Instance.compare_exchange_strong(current,
+                        DELETED_INSTANCE_SLOT, std::memory_order_acq_rel))
+                {
+                    return true;
+                }
+            }
+        }
+        return false;
+    }
 
-///////////////////////////////////////////////////////////////////////////////
-// Originator count
-QHash < QString, QHash < QString, int > > CallTracer::m_OriginatorCount =
-    QHash < QString, QHash < QString, int > > ();
+    // First (smallest) table
+    std::atomic < Table * > m_First;
+};
 
 
 
 ///////////////////////////////////////////////////////////////////////////////
-// Verbosity
-void CallTracer::SetVerbosity(const bool mcNewVerbosity)
+// All shards of the instance registry
+CallTracer::InstanceShard * CallTracer::GetInstanceShards()
 {
-    m_IsVerbose = mcNewVerbosity;
+    // Never deleted; instances may be unregistered during exit
+    static InstanceShard * const shards =
+        new InstanceShard[NUMBER_OF_INSTANCE_SHARDS];
+    return shards;
 }
 
 
 
 ///////////////////////////////////////////////////////////////////////////////
-// Verbosity
-bool CallTracer::m_IsVerbose = false;
+// Shard an instance belongs to
+CallTracer::InstanceShard & CallTracer::GetInstanceShard(
+    const void * mcpInstance, const int mcClassId, quint64 & mrHash)
+{
+    mrHash = (quint64(quintptr(mcpInstance)) >> 3) ^
+        (quint64(mcClassId) << 48);
+    mrHash *= 0x9E3779B97F4A7C15ULL;
+    return GetInstanceShards()[(mrHash >> 52) &
+        (NUMBER_OF_INSTANCE_SHARDS - 1)];
+}
 
 
 
 ///////////////////////////////////////////////////////////////////////////////
-// Print line for debugging purposes
-void CallTracer::DebugLine(const QString & mcrFile, const int mcLine)
+// Create (or find) the descriptor for a class
+CallTracer::InstanceClass * CallTracer::RegisterInstanceClass(
+    const char * mcpFilename)
 {
-    // Filename
-    const QPair < QString, QString > split_filename =
-        StringHelper::SplitFilename(mcrFile);
-    const QString now =
-        QDateTime::currentDateTime().toString("yyyy-MM-dd hh:mm:ss.zzz");
+    const QString class_name = ClassName(mcpFilename);
 
-    qDebug().noquote() << tr("%1 %2: line %3")
-        .arg(now,
-             split_filename.second,
-             QString::number(mcLine));
+    // Classes may register instances in several constructors
+    QMutexLocker lock(&m_InstanceClassesMutex);
+    for (InstanceClass * instance_class : m_InstanceClasses)
+    {
+        if (instance_class -> m_Name == class_name)
+        {
+            return instance_class;
+        }
+    }
+
+    InstanceClass * instance_class = new InstanceClass;
+    instance_class -> m_Id = m_InstanceClasses.size();
+    instance_class -> m_Name = class_name;
+    instance_class -> m_Live = 0;
+    instance_class -> m_Peak = 0;
+    instance_class -> m_Total = 0;
+    m_InstanceClasses << instance_class;
+    return instance_class;
 }
 
 
 
 ///////////////////////////////////////////////////////////////////////////////
 // Register a new instance
-void CallTracer::RegisterInstance(void * mpInstance, const QString & mcrClass)
+void CallTracer::RegisterInstance(void * mpInstance, InstanceClass * mpClass)
 {
     // Registration can only be from a constructor
-    QStringList split_caller = m_CallStack_Method.last().split("::");
-    if (split_caller.size() != 2 ||
-        split_caller[0] != split_caller[1])
+    const ThreadState * state = CurrentThread();
+    if (!state)
+    {
+        return;
+    }
+    const QList < CallRecord > & call_stack = state -> m_CallStack;
+    if (call_stack.isEmpty())
+    {
+        qDebug().noquote() << tr("Attempted to register an instance of %1 "
+            "outside of a constructor.")
+            .arg(mpClass -> m_Name);
+        return;
+    }
+    if (!call_stack.last().m_CallSite -> m_IsConstructor)
     {
         const QString reason =
             tr("Attempted to register an instance from %1 which does not "
                 "appear to be a constructor.")
-                .arg(mcrClass);
+                .arg(mpClass -> m_Name);
         qDebug().noquote() << reason;
         return;
     }
 
-    // Check if instance is already registered
-    if (m_ClassToInstances[mcrClass].contains(mpInstance))
+    // Method creating the instance
+    qint32 caller_id = 0;
+    if (call_stack.size() > 1)
+    {
+        caller_id =
+            call_stack.at(call_stack.size() - 2).m_CallSite -> m_Id + 1;
+    }
+
+    // Register it (unless it already is)
+    quint64 hash;
+    InstanceShard & shard =
+        GetInstanceShard(mpInstance, mpClass -> m_Id, hash);
+    if (!shard.Insert(quintptr(mpInstance), mpClass -> m_Id, caller_id,
+        hash))
     {
         const QString reason =
             tr("Instance %1 of class %2 has alread been registered.")
             .arg(CALL_SHOW(mpInstance),
-                 mcrClass);
+                 mpClass -> m_Name);
         qDebug().noquote() << reason;
         return;
     }
 
-    if (false)
-    {
-        qDebug().noquote() << tr("Registered instance %1 of class %2")
-            .arg(CALL_SHOW(mpInstance),
-                 mcrClass);
-    }
-
-    // Register it.
-    m_ClassToInstances[mcrClass] += mpInstance;
-    if (m_CallStack_Method.size() > 1)
-    {
-        m_InstanceToCallingMethod[mpInstance] =
-            m_CallStack_Method.at(m_CallStack_Method.size() - 2);
-    } else
+    // Counts
+    const qint64 live =
+        mpClass -> m_Live.fetch_add(1, std::memory_order_relaxed) + 1;
+    mpClass -> m_Total.fetch_add(1, std::memory_order_relaxed);
+    qint64 peak = mpClass -> m_Peak.load(std::memory_order_relaxed);
+    while (live > peak &&
+        !mpClass -> m_Peak.compare_exchange_weak(peak, live,
+            std::memory_order_relaxed))
     {
-        m_InstanceToCallingMethod[mpInstance] = "";
+        // Try again
     }
 }
 
@@ -452,56 +1890,80 @@ void CallTracer::RegisterInstance(void * mpInstance, const QString & mcrClass)
 
 ///////////////////////////////////////////////////////////////////////////////
 // Unregister an instance
-void CallTracer::UnregisterInstance(void * mpInstance, const QString & mcrClass)
+void CallTracer::UnregisterInstance(void * mpInstance,
+    InstanceClass * mpClass)
 {
     // Unregistration can only be from a destructor
-    QStringList split_caller = m_CallStack_Method.last().split("::~");
-    if (split_caller.size() != 2 ||
-        split_caller[0] != split_caller[1])
+    const ThreadState * state = CurrentThread();
+    if (!state)
+    {
+        return;
+    }
+    const QList < CallRecord > & call_stack = state -> m_CallStack;
+    if (call_stack.isEmpty())
+    {
+        qDebug().noquote() << tr("Attempted to unregister an instance of %1 "
+            "outside of a destructor.")
+            .arg(mpClass -> m_Name);
+        return;
+    }
+    if (!call_stack.last().m_CallSite -> m_IsDestructor)
     {
         const QString reason =
             tr("Attempted to unregister an instance from %1 which does not "
                 "appear to be a destructor.")
-                .arg(mcrClass);
+                .arg(mpClass -> m_Name);
         qDebug().noquote() << reason;
         return;
     }
 
     // Check if instance is actually registered
-    if (!m_ClassToInstances[mcrClass].contains(mpInstance))
+    quint64 hash;
+    InstanceShard & shard =
+        GetInstanceShard(mpInstance, mpClass -> m_Id, hash);
+    if (!shard.Remove(quintptr(mpInstance), mpClass -> m_Id, hash))
     {
         const QString reason =
             tr("Instance %1 of class %2 has never been registered.")
             .arg(CALL_SHOW(mpInstance),
-                 mcrClass);
+                 mpClass -> m_Name);
         qDebug().noquote() << reason;
         return;
     }
 
-    if (false)
-    {
-        qDebug().noquote() << tr("Unregister instance %1 of class %2")
-            .arg(CALL_SHOW(mpInstance),
-                 mcrClass);
-    }
+    mpClass -> m_Live.fetch_sub(1, std::memory_order_relaxed);
+}
 
-    // Register it.
-    m_ClassToInstances[mcrClass] -= mpInstance;
-    if (m_ClassToInstances[mcrClass].isEmpty())
-    {
-        m_ClassToInstances.remove(mcrClass);
+
+
+///////////////////////////////////////////////////////////////////////////////
+// Instance counts of all classes
+QList < CallTracer::InstanceCounts > CallTracer::GetInstanceCounts()
+{
+    QMutexLocker lock(&m_InstanceClassesMutex);
+    QList < InstanceCounts > counts;
+    for (const InstanceClass * instance_class : m_InstanceClasses)
+    {
+        InstanceCounts class_counts;
+        class_counts.m_Class = instance_class -> m_Name;
+        class_counts.m_Live =
+            instance_class -> m_Live.load(std::memory_order_relaxed);
+        class_counts.m_Peak =
+            instance_class -> m_Peak.load(std::memory_order_relaxed);
+        class_counts.m_Total =
+            instance_class -> m_Total.load(std::memory_order_relaxed);
+        counts << class_counts;
     }
-    m_InstanceToCallingMethod.remove(mpInstance);
+    return counts;
 }
 
 
 
 ///////////////////////////////////////////////////////////////////////////////
-// Record keepers
-QHash < QString, QSet < void * > > CallTracer::m_ClassToInstances =
-    QHash < QString, QSet < void * > >();
-QHash < void *, QString > CallTracer::m_InstanceToCallingMethod =
-    QHash < void *, QString >();
+// Classes
+QList < CallTracer::InstanceClass * > CallTracer::m_InstanceClasses =
+    QList < CallTracer::InstanceClass * >();
+QMutex CallTracer::m_InstanceClassesMutex;
 
 
 
@@ -510,12 +1972,17 @@ QHash < void *, QString > CallTracer::m_InstanceToCallingMethod =
 void CallTracer::ShowUnregisteredInstances()
 {
     QHash < QString, int > frequency;
-    for (auto class_iterator = m_ClassToInstances.keyBegin();
-         class_iterator != m_ClassToInstances.keyEnd();
-         class_iterator++)
+    QHash < QString, QString > counts;
+    for (const InstanceCounts & class_counts : GetInstanceCounts())
     {
-        const QString & this_class = *class_iterator;
-        frequency[this_class] = m_ClassToInstances[this_class].size();
+        if (class_counts.m_Live == 0)
+        {
+            continue;
+        }
+        frequency[class_counts.m_Class] = int(class_counts.m_Live);
+        counts[class_counts.m_Class] = tr("(peak %1, total %2)")
+            .arg(QString::number(class_counts.m_Peak),
+                 QString::number(class_counts.m_Total));
     }
 
     qDebug().noquote() << tr("===== Undeleted instances statistics per class");
@@ -527,9 +1994,10 @@ void CallTracer::ShowUnregisteredInstances()
          class_iterator++)
     {
         const QString & this_class = *class_iterator;
-        qDebug().noquote() << QString("%1: %2")
+        qDebug().noquote() << QString("%1: %2 %3")
             .arg(QString::number(frequency[this_class]),
-                 this_class);
+                 this_class,
+                 counts[this_class]);
     }
     qDebug().noquote() << "\n";
 }
@@ -540,14 +2008,62 @@ void CallTracer::ShowUnregisteredInstances()
 // Summary of unreleased instances
 void CallTracer::ShowUnregisteredInstancesCallers(const QString & mcrClass)
 {
+    // Find class
+    int class_id = -1;
+    {
+        QMutexLocker lock(&m_InstanceClassesMutex);
+        for (const InstanceClass * instance_class : m_InstanceClasses)
+        {
+            if (instance_class -> m_Name == mcrClass)
+            {
+                class_id = instance_class -> m_Id;
+                break;
+            }
+        }
+    }
+
+    // Collect callers from all shards
+    QHash < qint32, int > caller_frequency;
+    InstanceShard * shards = GetInstanceShards();
+    for (int shard_index = 0;
+         shard_index < NUMBER_OF_INSTANCE_SHARDS;
+         shard_index++)
+    {
+        for (const InstanceShard::Table * table =
+                shards[shard_index].m_First.load(std::memory_order_acquire);
+             table;
+             table = table -> m_Next.load(std::memory_order_acquire))
+        {
+            for (int index = 0; index < table -> m_Size; index++)
+            {
+                const InstanceShard::Slot & slot = table -> m_Slots[index];
+                if (slot.m_Instance.load(std::memory_order_acquire) >
+                        DELETED_INSTANCE_SLOT &&
+                    slot.m_ClassId.load(std::memory_order_acquire) ==
+                        class_id)
+                {
+                    caller_frequency[slot.m_CallerId.load(
+                        std::memory_order_relaxed)]++;
+                }
+            }
+        }
+    }
+
+    // Call site IDs to method names
     QHash < QString, int > frequency;
-    for (auto instance_iterator = m_ClassToInstances[mcrClass].begin();
-         instance_iterator != m_ClassToInstances[mcrClass].end();
-         instance_iterator++)
     {
-        void * instance = *instance_iterator;
-        const QString caller = m_InstanceToCallingMethod[instance];
-        frequency[caller]++;
+        QMutexLocker lock(&m_CallSitesMutex);
+        for (auto caller_iterator = caller_frequency.constBegin();
+             caller_iterator != caller_frequency.constEnd();
+             caller_iterator++)
+        {
+            const qint32 caller_id = caller_iterator.key();
+            const QString caller =
+                (caller_id > 0 && caller_id <= m_CallSites.size())
+                ? m_CallSites[caller_id - 1] -> m_Method
+                : QString();
+            frequency[caller] += caller_iterator.value();
+        }
     }
 
     qDebug().noquote() << tr("===== Undeleted instances of class %1: "
@@ -5,8 +5,9 @@
   * Used for keeping track of methods and functions being called while the
   * program is running, to be used as a call stack for debugging purposes.
   *
-  * This class is at this point not designed to be thread-safe, but it should
-  * be rather straight forward, and it's on the list of future improvements.
+  * Every thread has its own call stack (and history), so methods can be
+  * traced while running in parallel. Call counts are kept per thread as
+  * well and only combined when they are shown.
   *
   * Users of this class would use it mostly through the macros defined below,
   * using \link CALL_IN()\endlink as the first thing when entering a function,
@@ -27,7 +28,9 @@
   *
   * This class also counts calls to methods/functions and the methods/functions
   * calling them; see \link ShowUsage()\endlink and
-  * \link ShowCallOriginators()\endlink functions.
+  * \link ShowCallOriginators()\endlink functions. It also measures the time
+  * spent in them; see \link ShowProfile()\endlink and
+  * \link ShowProfileTree()\endlink.
   *
   * Functionality can be turned off by setting \c DEPLOY to \c true in
   * Deploy.h
@@ -44,10 +47,14 @@
 #include <QJsonArray>
 #include <QJsonObject>
 #include <QList>
+#include <QMutex>
 #include <QObject>
 #include <QPixmap>
 #include <QString>
 
+// System includes
+#include <atomic>
+
 
 // The following a luckily documented in
 // https://lists.qt-project.org/pipermail/interest/2015-January/014617.html
@@ -85,8 +92,20 @@
     #define CALL_METHOD (CALL_CLASS + "::" + __func__)
 
     /** \brief Saves information when entering a function or method
+     * The call site descriptor is created once, on the first call; after
+     * that, entering a function does not involve any string handling.
+     * The parameter text \c p is not evaluated here but only when the call
+     * stack is printed (or right away in verbose mode and when keeping the
+     * full history), so it shows the values at that time. If the function
+     * is left without \c CALL_OUT(), the text is evaluated on the way out.
      */
-    #define CALL_IN(p) CallTracer::EnterFunction(__FILE__, __func__, p)
+    #define CALL_IN(p) \
+        static const CallTracer::CallSite * const call_tracer_site = \
+            CallTracer::RegisterCallSite(__FILE__, __func__, __LINE__); \
+        const auto call_tracer_parameters = \
+            [&]() -> QString { return QString(p); }; \
+        const CallTracer::ParameterGuard call_tracer_guard( \
+            call_tracer_site, call_tracer_parameters)
 
     /** \brief Saves information when exiting a function or method
      */
@@ -114,13 +133,23 @@
     #define DEBUG_LINE CallTracer::DebugLine(__FILE__, __LINE__)
 
    /** \brief Register new instance of an object
+    * The class descriptor is created once, on the first call.
     */
-    #define REGISTER_INSTANCE CallTracer::RegisterInstance(this, CALL_CLASS)
+    #define REGISTER_INSTANCE \
+        { \
+            static CallTracer::InstanceClass * const call_tracer_class = \
+                CallTracer::RegisterInstanceClass(__FILE__); \
+            CallTracer::RegisterInstance(this, call_tracer_class); \
+        }
 
    /** \brief Unregister instance
     */
     #define UNREGISTER_INSTANCE \
-        CallTracer::UnregisterInstance(this, CALL_CLASS)
+        { \
+            static CallTracer::InstanceClass * const call_tracer_class = \
+                CallTracer::RegisterInstanceClass(__FILE__); \
+            CallTracer::UnregisterInstance(this, call_tracer_class); \
+        }
 #endif
 
 // Define class
@@ -156,39 +185,157 @@ public:
 
     /** \brief Start or stop keeping the entire call history.
       * By default, only the call stack is maintained, not the full history.
+      * The history is a ring buffer of 16 bytes per event (entering or
+      * leaving a method); once it is full, the oldest events are
+      * overwritten. Parameters and exit reasons are not part of the history.
       * \param mcKeepHistory \c true if you want to keep the full history,
       * \c false if you don't.
-      */
-    static void SetKeepAllHistory(const bool mcKeepHistory);
+      * \param mcHistorySize Number of events to keep
+      */
+    static void SetKeepAllHistory(const bool mcKeepHistory,
+        const int mcHistorySize = 1 << 20);
+
+    /** \brief Export the call history in Chrome trace event format.
+      * The file can be loaded in chrome://tracing or Perfetto.
+      * \param mcrFilename Name of the JSON file to write
+      * \returns \c true on success
+      */
+    static bool ExportChromeTrace(const QString & mcrFilename);
+
+    /** \brief Description of a place where a function is entered.
+      * There is one (static) instance per \link CALL_IN()\endlink, so
+      * class and method names only need to be worked out once.
+      */
+    struct CallSite
+    {
+        /** \brief Source file (\c __FILE__)
+          */
+        const char * m_Filename;
+        /** \brief Function (\c __func__)
+          */
+        const char * m_Function;
+        /** \brief Line of \link CALL_IN()\endlink
+          */
+        int m_Line;
+        /** \brief Index in the list of call sites
+          */
+        int m_Id;
+        /** \brief Number of calls, for sampling one in n calls
+          */
+        mutable std::atomic < quint32 > m_SampleCount;
+        /** \brief Class name, derived from the filename
+          */
+        QString m_Class;
+        /** \brief Class and method name, "Class::method"
+          */
+        QString m_Method;
+        /** \brief Function is a constructor of the class
+          */
+        bool m_IsConstructor;
+        /** \brief Function is a destructor of the class
+          */
+        bool m_IsDestructor;
+    };
+
+    /** \brief Creates the descriptor for a call site.
+      * Called once per \link CALL_IN()\endlink, the first time it is
+      * reached.
+      * \param mcpFilename Name of the source code file (\c __FILE__)
+      * \param mcpFunction Name of the function (\c __func__)
+      * \param mcLine Line in the source file (\c __LINE__)
+      * \returns The descriptor; it is never deleted.
+      */
+    static const CallSite * RegisterCallSite(const char * mcpFilename,
+        const char * mcpFunction, const int mcLine);
 
     /** \brief Records when a function is entered.
-      * \param mcFilename Name of the source code file; \c __FILE__
-      * is a good choice here
-      * \param mcFunction Name of the function/method being entered. Ususally,
-      * use \c __func__.
-      * \param mcParameters List of parameters and their values. Best practice
-      * if to use \c CALL_SHOW() to show the parameter value
-      */
-    static void EnterFunction(const QString mcFilename,
-        const QString mcFunction, const QString mcParameters);
+      * \param mcpCallSite Call site descriptor, see
+      * \link RegisterCallSite()\endlink
+      * \param mcrParameters Function object returning the list of
+      * parameters and their values. Best practice if to use \c CALL_SHOW()
+      * to show the parameter value. It has to stay alive until the
+      * function is exited.
+      */
+    template < typename T >
+    static int EnterFunction(const CallSite * mcpCallSite,
+        const T & mcrParameters)
+    {
+        return EnterFunction(mcpCallSite, &mcrParameters,
+            &FormatParameters < T >);
+    }
+
+    /** \brief Records when a function is entered.
+      * \param mcpCallSite Call site descriptor
+      * \param mcpParameters Opaque pointer to the parameter function object
+      * \param mcpFormatParameters Produces the parameter text from
+      * \c mcpParameters
+      * \returns Position of the new entry in the call stack
+      */
+    static int EnterFunction(const CallSite * mcpCallSite,
+        const void * mcpParameters,
+        QString (* mcpFormatParameters)(const void *));
+
+    /** \brief Enters a function and makes sure the call stack never refers
+      * to its parameter function object after the function has been left
+      * \details Functions that return or throw without \c CALL_OUT() leave
+      * their entry in the call stack; the destructor evaluates the
+      * parameter text of that entry while the function object still exists.
+      */
+    class ParameterGuard
+    {
+    public:
+        /** \brief Constructor; enters the function
+          */
+        template < typename T >
+        ParameterGuard(const CallSite * mcpCallSite, const T & mcrParameters)
+        {
+            m_Parameters = &mcrParameters;
+            m_Depth = EnterFunction(mcpCallSite, mcrParameters);
+        }
+
+        /** \brief Destructor
+          */
+        ~ParameterGuard()
+        {
+            ReleaseParameters(m_Parameters, m_Depth);
+        }
+
+    private:
+        /** \brief Parameter function object
+          */
+        const void * m_Parameters;
+
+        /** \brief Position of the entry in the call stack
+          */
+        int m_Depth;
+    };
+
+    /** \brief Evaluates the parameter text of a call stack entry that is
+      * still there when its function is left
+      * \param mcpParameters Parameter function object of the function
+      * \param mcDepth Position of the entry in the call stack
+      */
+    static void ReleaseParameters(const void * mcpParameters,
+        const int mcDepth);
 
     /** \brief Records when a function is exited.
-      * \param mcFilename Name of the source code file; \c __FILE__
+      * \param mcpFilename Name of the source code file; \c __FILE__
       * macro is a good choice here
-      * \param mcFunction Name of the function/method being entered. Ususally,
-      * use \c __func__ macro.
+      * \param mcpFunction Name of the function/method being entered.
+      * Ususally, use \c __func__ macro.
       * \param mcLine Line in the source file for pinpointing location of the
       * exit point. Usually, use \c __LINE__ macro.
-      * \param mcReason The reason why the function/method was left. This is
+      * \param mcrReason The reason why the function/method was left. This is
       * helpful to track error handling. Use an empty string for normal exit.
       */
-    static void ExitFunction(const QString mcFilename,
-        const QString mcFunction, const int mcLine, const QString mcReason);
+    static void ExitFunction(const char * mcpFilename,
+        const char * mcpFunction, const int mcLine,
+        const QString & mcrReason);
 
     /** \brief Returns the call trace.
       * Depending on your choices in \link SetKeepAllHistory()\endlink, this
       * is either the call stack or the full history.
-      * \returns A single string with the call trace.
+      * \returns A single string with the call trace of the current thread.
       */
     static QString GetCallTrace();
 
@@ -202,22 +349,135 @@ public:
     static QString ClassName(const QString mcFilename);
 
 private:
-    /** \brief Time stamp when a function/method was called.
+    /** \brief Entry in the call stack or the call history.
       */
-    static QList < QString > m_CallStack_Time;
-    /** \brief Name of the method that had been called.
+    struct CallRecord
+    {
+        /** \brief Where the function was entered
+          */
+        const CallSite * m_CallSite;
+        /** \brief Monotonic time stamp (ns), see \link Now()\endlink
+          */
+        qint64 m_Timestamp;
+        /** \brief Number of calls this one stands for in the statistics;
+          * 0 if it is not recorded (see \link SetSampling()\endlink)
+          */
+        int m_Weight;
+        /** \brief Thread CPU time (ns) when entering, see
+          * \link CpuNow()\endlink
+          */
+        qint64 m_CpuTimestamp;
+        /** \brief Wall time (ns) spent in methods called from here
+          */
+        qint64 m_ChildTime;
+        /** \brief CPU time (ns) spent in methods called from here
+          */
+        qint64 m_ChildCpuTime;
+        /** \brief Parameter text, if already evaluated
+          */
+        QString m_Text;
+        /** \brief Parameter function object of a function not yet
+          * evaluated, or \c nullptr if \c m_Text is valid
+          */
+        const void * m_Parameters;
+        /** \brief Evaluates \c m_Parameters
+          */
+        QString (* m_FormatParameters)(const void *);
+    };
+
+    /** \brief Evaluate a parameter function object
       */
-    static QList < QString > m_CallStack_Method;
-    /** \brief Text (usually the list of arguments and their content) for the
-      * call of the function/method
+    template < typename T >
+    static QString FormatParameters(const void * mcpParameters)
+    {
+        return (*static_cast < const T * >(mcpParameters))();
+    }
+
+    /** \brief Parameter text of a call record
       */
-    static QList < QString > m_CallStack_Text;
+    static QString GetParameters(const CallRecord & mcrRecord);
+
+    /** \brief Monotonic clock in nanoseconds
+      */
+    static qint64 Now();
+
+    /** \brief CPU time of the current thread in nanoseconds
+      */
+    static qint64 CpuNow();
+
+    /** \brief Human readable date and time for a monotonic time stamp
+      */
+    static QString FormatTimestamp(const qint64 mcTimestamp);
+
+    /** \brief All call sites seen so far, in order of CallSite::m_Id
+      */
+    static QList < CallSite * > m_CallSites;
+    /** \brief Protects m_CallSites
+      */
+    static QMutex m_CallSitesMutex;
+
+    /** \brief Call stack, history and counters of one thread
+      */
+    struct ThreadState;
+
+    /** \brief State of the current thread
+      * \returns \c nullptr once the state has been destroyed, i.e. while
+      * the thread (or, for the main thread, the program) exits
+      */
+    static ThreadState * CurrentThread();
+
+    /** \brief States of all running threads
+      */
+    static QList < ThreadState * > m_Threads;
+    /** \brief Protects m_Threads
+      */
+    static QMutex m_ThreadsMutex;
 
     /** \brief Flag indicating if we want to keep the full call history or just
       * the call stack.
       * Set it with \link SetKeepAllHistory()\endlink.
       */
-    static bool m_KeepAllHistory;
+    static std::atomic < bool > m_KeepAllHistory;
+
+    /** \brief Entering or leaving a method, as kept in the call history
+      */
+    struct HistoryEvent
+    {
+        /** \brief Monotonic time stamp (ns), see \link Now()\endlink
+          */
+        qint64 m_Timestamp;
+        /** \brief CallSite::m_Id
+          */
+        quint32 m_CallSiteId;
+        /** \brief Thread number, see ThreadState
+          */
+        quint16 m_ThreadId;
+        /** \brief 0 when entering, otherwise 1 + line of the exit point
+          */
+        quint16 m_Phase;
+    };
+
+    /** \brief Ring buffer of history events
+      */
+    struct HistoryBuffer;
+
+    /** \brief Add an event to the call history
+      */
+    static void AddHistoryEvent(const CallSite * mcpCallSite,
+        const qint64 mcTimestamp, const quint16 mcThreadId,
+        const quint16 mcPhase);
+
+    /** \brief Events in the call history, oldest first
+      */
+    static QList < HistoryEvent > GetHistory();
+
+    /** \brief Current history buffer
+      */
+    static std::atomic < HistoryBuffer * > m_History;
+
+    /** \brief Number of events added to the history since the last reset
+      */
+    static std::atomic < quint64 > m_HistoryCount;
 
 
 
@@ -246,15 +506,102 @@ public:
     static void ShowCallOriginators(const QString mcClass,
         const QString mcMethod);
 
+    /** \brief Measure CPU time in addition to wall time
+      * Reading the CPU time of a thread is a lot more expensive than reading
+      * the wall clock, so it is off by default.
+      * \param mcMeasureCpuTime \c true to measure CPU time
+      */
+    static void SetMeasureCpuTime(const bool mcMeasureCpuTime);
+
+    /** \brief Only record some calls in the statistics and the history.
+      * Recorded calls are weighted so that counts and times in
+      * \link ShowUsage()\endlink and \link ShowProfile()\endlink are
+      * estimates of the real values. The call stack always contains all
+      * calls, so error reports are not affected.
+      * \param mcOneInN Record every n-th call of each method; \c 1 records
+      * all calls
+      * \param mcIntervalUS If larger than 0, record the first call after
+      * this many microseconds in each thread instead, standing in for all
+      * calls since the previous recorded one
+      */
+    static void SetSampling(const int mcOneInN, const int mcIntervalUS = 0);
+
+    /** \brief Check if only some calls are recorded
+      */
+    static bool IsSampling();
+
+    /** \brief Show time spent per method
+      * Methods are sorted by exclusive wall time (time spent in the method
+      * itself, not in methods it called). Percentiles are for the inclusive
+      * wall time of a single call and are accurate to a factor of 2.
+      * \param mcMaxMethods Maximum number of methods to show; \c 0 shows all
+      */
+    static void ShowProfile(const int mcMaxMethods = 0);
+
+    /** \brief Show time spent per method as a tree of callers and callees
+      * \param mcMaxDepth Maximum depth of the tree
+      * \param mcMinPercent Calls taking less than this percentage of the
+      * total time are not shown
+      */
+    static void ShowProfileTree(const int mcMaxDepth = 10,
+        const double mcMinPercent = 1.);
+
 private:
-    /** \brief Counts what class and method is called how often
-      * Maps class + method to call count.
+    /** \brief Call count and times of one pair of called and calling call
+      * site
+      */
+    struct CallCounters;
+
+    /** \brief Combined (not atomic) CallCounters
+      */
+    struct CallStatistics;
+
+    /** \brief Show one level of \link ShowProfileTree()\endlink
+      */
+    static void ShowProfileTree(
+        const QHash < int, QHash < int, CallStatistics > > & mcrCallees,
+        const int mcCallerId, const QString & mcrIndentation,
+        QList < int > & mrPath, const int mcMaxDepth,
+        const qint64 mcMinTime);
+
+    /** \brief Measuring CPU time
+      */
+    static std::atomic < bool > m_MeasureCpuTime;
+
+    /** \brief Sampling one in n calls per call site
+      */
+    static std::atomic < int > m_SamplingRate;
+
+    /** \brief Time based sampling interval (ns); 0 if not used
       */
-    static QHash < QString, QHash < QString, int > > m_CallCount;
-    /** \brief Counts what method is called by what other method, and how often
-      * maps called method + calling method to call count.
+    static std::atomic < qint64 > m_SamplingInterval;
+
+    /** \brief Hash table of CallCounters, owned by one thread
+      */
+    struct CounterTable;
+
+    /** \brief Key for a pair of called and calling call site
+      * \param mcpCalled Call site being entered
+      * \param mcpCaller Call site of the calling method, or \c nullptr
+      */
+    static quint64 CounterKey(const CallSite * mcpCalled,
+        const CallSite * mcpCaller);
+
+    /** \brief Counters of the current thread for a pair of call sites
+      * \details Creates the counters if necessary. The reference is only
+      * valid until the next call, which may grow the table.
+      */
+    static CallCounters & GetCounters(ThreadState & mrState,
+        const quint64 mcKey);
+
+    /** \brief Combine counters of all threads
+      * \returns Counter key to statistics
+      */
+    static QHash < quint64, CallStatistics > CollectStatistics();
+
+    /** \brief Statistics of threads that have finished
       */
-    static QHash < QString, QHash < QString, int > > m_OriginatorCount;
+    static QHash < quint64, CallStatistics > m_FinishedThreadsStatistics;
 
 public:
     /** \brief Set verbosity of operations
@@ -265,7 +612,7 @@ public:
 private:
     /** \brief Verbosity
       */
-    static bool m_IsVerbose;
+    static std::atomic < bool > m_IsVerbose;
 
 public:
     /** \brief Print line for debugging purposes
@@ -274,21 +621,89 @@ public:
       */
     static void DebugLine(const QString & mcrFilename, const int mcLine);
 
+    /** \brief Class whose instances are tracked, with its live and peak
+      * instance counts. There is one per class, created by
+      * \link RegisterInstanceClass()\endlink.
+      */
+    struct InstanceClass
+    {
+        /** \brief Index in the list of classes
+          */
+        int m_Id;
+        /** \brief Class name, derived from the filename
+          */
+        QString m_Name;
+        /** \brief Instances currently registered
+          */
+        std::atomic < qint64 > m_Live;
+        /** \brief Maximum of m_Live so far
+          */
+        std::atomic < qint64 > m_Peak;
+        /** \brief Instances registered in total
+          */
+        std::atomic < qint64 > m_Total;
+    };
+
+    /** \brief Creates (or finds) the descriptor for a class
+      * \param mcpFilename Name of the source code file (\c __FILE__)
+      * \returns The descriptor; it is never deleted.
+      */
+    static InstanceClass * RegisterInstanceClass(const char * mcpFilename);
+
     /** \brief Register a new instance
+      * \details Lock-free unless a shard of the registry is full.
       * \param mpInstance pointer to identify the instance
-      * \param mpClass name of the class
+      * \param mpClass class descriptor
       */
-    static void RegisterInstance(void * mpInstance, const QString & mcrClass);
+    static void RegisterInstance(void * mpInstance, InstanceClass * mpClass);
 
     /** \brief Unregister an instance
       * \param mpInstance pointer to identify the instance
-      * \param mpClass name of the class
+      * \param mpClass class descriptor
       */
     static void UnregisterInstance(void * mpInstance,
-        const QString & mcrClass);
+        InstanceClass * mpClass);
+
+    /** \brief Live, peak and total instance counts of a class
+      */
+    struct InstanceCounts
+    {
+        /** \brief Class name
+          */
+        QString m_Class;
+        /** \brief Instances currently registered
+          */
+        qint64 m_Live;
+        /** \brief Maximum number of instances at any time
+          */
+        qint64 m_Peak;
+        /** \brief Instances registered in total
+          */
+        qint64 m_Total;
+    };
+
+    /** \brief Instance counts of all classes (cheap; no registry scan)
+      */
+    static QList < InstanceCounts > GetInstanceCounts();
+
 private:
-    static QHash < QString, QSet < void * > > m_ClassToInstances;
-    static QHash < void *, QString > m_InstanceToCallingMethod;
+    /** \brief Part of the instance registry
+      */
+    struct InstanceShard;
+
+    /** \brief All shards of the instance registry
+      */
+    static InstanceShard * GetInstanceShards();
+
+    /** \brief Shard an instance belongs to, and its hash
+      */
+    static InstanceShard & GetInstanceShard(const void * mcpInstance,
+        const int mcClassId, quint64 & mrHash);
+
+    /** \brief All classes, by ID
+      */
+    static QList < InstanceClass * > m_InstanceClasses;
+    static QMutex m_InstanceClassesMutex;
 
 public:
     // Summary of unreleased instances
@@ -21,15 +21,24 @@
 // Project includes
 #include "CallTracer.h"
 #include "Email.h"
+#include "EmailDeduplicator.h"
 #include "MessageLogger.h"
 #include "NavigatedTextFile.h"
 #include "StringHelper.h"
 
 // Qt includes
+#include <QBuffer>
 #include <QDateTime>
 #include <QDebug>
+#include <QDir>
+#include <QDirIterator>
 #include <QFile>
+#include <QFileInfo>
 #include <QRegularExpression>
+#include <QSet>
+#include <QThread>
+#include <QThreadPool>
+#include <QtConcurrent>
 
 // Debug mode
 #define DEBUG false
@@ -56,6 +65,9 @@ Email::Email(const QString mcFilename)
 
     // No error line
     m_ErrorLine = -1;
+
+    // No trailing plist
+    m_EMLXPropertiesParsed = false;
     
     // See if file exists
     if (!QFile::exists(mcFilename))
@@ -67,6 +79,7 @@ Email::Email(const QString mcFilename)
     
     // Open file
     NavigatedTextFile file(mcFilename);
+    m_Filename = mcFilename;
     
     // Not an MBox or EMLX file
     m_IsMBox = false;
@@ -126,6 +139,9 @@ Email::Email(NavigatedTextFile & mrEmailFile, const QString mcType)
     m_IsMBox = (mcType == "mbox");
     m_IsEMLX = (mcType == "emlx");
 
+    // Trailing plist is only parsed on demand
+    m_EMLXPropertiesParsed = false;
+
     // Read header
     ReadHeader(mrEmailFile);
 
@@ -155,10 +171,12 @@ Email::Email(NavigatedTextFile & mrEmailFile, const QString mcType)
 
 ///////////////////////////////////////////////////////////////////////////////
 // MBoxes may contain multiple emails
-QList < Email * > Email::ImportFromMBox(const QString mcFilename)
+QList < Email * > Email::ImportFromMBox(const QString mcFilename,
+    EmailDeduplicator * mpDeduplicator)
 {
-    CALL_IN(QString("mcFilename=%1")
-        .arg(CALL_SHOW_FULL(mcFilename)));
+    CALL_IN(QString("mcFilename=%1, mpDeduplicator=%2")
+        .arg(CALL_SHOW_FULL(mcFilename),
+             CALL_SHOW(mpDeduplicator)));
 
     // Debugging
     if (DEBUG)
@@ -188,9 +206,28 @@ QList < Email * > Email::ImportFromMBox(const QString mcFilename)
     
     // Read mbox
     QList < Email * > ret;
+    int duplicates = 0;
     while (!file.AtEnd())
     {
-        ret << new Email(file, "mbox");
+        Email * email = new Email(file, "mbox");
+
+        // Drop emails we have seen before
+        if (mpDeduplicator &&
+            mpDeduplicator -> IsDuplicate(email))
+        {
+            delete email;
+            duplicates++;
+            continue;
+        }
+        ret << email;
+    }
+    if (duplicates > 0)
+    {
+        const QString message =
+            tr("Dropped %1 duplicate email(s) from \"%2\".")
+                .arg(QString::number(duplicates),
+                     mcFilename);
+        MessageLogger::Message(CALL_METHOD, message);
     }
     
     // Done
@@ -202,10 +239,12 @@ QList < Email * > Email::ImportFromMBox(const QString mcFilename)
 
 ///////////////////////////////////////////////////////////////////////////////
 // AppleMail .emlx file
-QList < Email * > Email::ImportFromEMLXFile(const QString mcFilename)
+QList < Email * > Email::ImportFromEMLXFile(const QString mcFilename,
+    EmailDeduplicator * mpDeduplicator)
 {
-    CALL_IN(QString("mcFilename=%1")
-        .arg(CALL_SHOW_FULL(mcFilename)));
+    CALL_IN(QString("mcFilename=%1, mpDeduplicator=%2")
+        .arg(CALL_SHOW_FULL(mcFilename),
+             CALL_SHOW(mpDeduplicator)));
 
     // Debugging
     if (DEBUG)
@@ -235,9 +274,28 @@ QList < Email * > Email::ImportFromEMLXFile(const QString mcFilename)
     
     // Read EMLX file
     QList < Email * > ret;
+    int duplicates = 0;
     while (!file.AtEnd())
     {
-        ret << new Email(file, "emlx");
+        Email * email = new Email(file, "emlx");
+
+        // Drop emails we have seen before
+        if (mpDeduplicator &&
+            mpDeduplicator -> IsDuplicate(email))
+        {
+            delete email;
+            duplicates++;
+            continue;
+        }
+        ret << email;
+    }
+    if (duplicates > 0)
+    {
+        const QString message =
+            tr("Dropped %1 duplicate email(s) from \"%2\".")
+                .arg(QString::number(duplicates),
+                     mcFilename);
+        MessageLogger::Message(CALL_METHOD, message);
     }
     
     // Done
@@ -247,6 +305,151 @@ QList < Email * > Email::ImportFromEMLXFile(const QString mcFilename)
 
 
 
+///////////////////////////////////////////////////////////////////////////////
+// Import all AppleMail .emlx files in a directory tree
+QList < Email * > Email::ImportFromEMLXDirectory(const QString mcDirectory,
+    EmailDeduplicator * mpDeduplicator, const int mcMaxThreads)
+{
+    CALL_IN(QString("mcDirectory=%1, mpDeduplicator=%2, mcMaxThreads=%3")
+        .arg(CALL_SHOW_FULL(mcDirectory),
+             CALL_SHOW(mpDeduplicator),
+             CALL_SHOW(mcMaxThreads)));
+
+    // Debugging
+    if (DEBUG)
+    {
+        qDebug().noquote() << CALL_METHOD;
+    }
+
+    // See if directory exists
+    if (!QFileInfo(mcDirectory).isDir())
+    {
+        const QString reason =
+            tr("Could not open directory \"%1\".").arg(mcDirectory);
+        MessageLogger::Error(CALL_METHOD, reason);
+        CALL_OUT(reason);
+        return QList < Email * >();
+    }
+
+    // Find all emlx files
+    QStringList filenames;
+    QDirIterator file_iterator(mcDirectory, QStringList("*.emlx"),
+        QDir::Files, QDirIterator::Subdirectories);
+    while (file_iterator.hasNext())
+    {
+        filenames << file_iterator.next();
+    }
+    std::sort(filenames.begin(), filenames.end());
+
+    // Split into batches
+    const int batch_size = 32;
+    QList < QStringList > batches;
+    for (int index = 0; index < filenames.size(); index += batch_size)
+    {
+        batches << filenames.mid(index, batch_size);
+    }
+
+    // Bounded thread pool
+    QThreadPool pool;
+    pool.setMaxThreadCount(
+        mcMaxThreads > 0 ? mcMaxThreads : QThread::idealThreadCount());
+
+    // Import in parallel
+    QThread * target_thread = QThread::currentThread();
+    const QList < QList < Email * > > batch_emails =
+        QtConcurrent::blockingMapped < QList < QList < Email * > > >(&pool,
+            batches,
+            [target_thread](const QStringList & mcrBatch)
+            {
+                return ImportFromEMLXBatch(mcrBatch, target_thread);
+            });
+
+    // Collect results (in order), drop duplicates
+    QList < Email * > ret;
+    int duplicates = 0;
+    for (const QList < Email * > & emails : batch_emails)
+    {
+        for (Email * email : emails)
+        {
+            if (mpDeduplicator &&
+                mpDeduplicator -> IsDuplicate(email))
+            {
+                delete email;
+                duplicates++;
+                continue;
+            }
+            ret << email;
+        }
+    }
+    if (duplicates > 0)
+    {
+        const QString message =
+            tr("Dropped %1 duplicate email(s) from \"%2\".")
+                .arg(QString::number(duplicates),
+                     mcDirectory);
+        MessageLogger::Message(CALL_METHOD, message);
+    }
+
+    // Done
+    CALL_OUT("");
+    return ret;
+}
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// Import a batch of .emlx files (called on a worker thread)
+QList < Email * > Email::ImportFromEMLXBatch(const QStringList & mcrFilenames,
+    QThread * mpTargetThread)
+{
+    CALL_IN(QString("mcrFilenames=%1, mpTargetThread=%2")
+        .arg(CALL_SHOW(mcrFilenames),
+             CALL_SHOW(mpTargetThread)));
+
+    // Read all files of the batch first...
+    QList < QByteArray > contents;
+    for (const QString & filename : mcrFilenames)
+    {
+        QFile in_file(filename);
+        if (!in_file.open(QIODevice::ReadOnly))
+        {
+            const QString reason =
+                tr("Could not open AppleMail EMLX file \"%1\".")
+                    .arg(filename);
+            MessageLogger::Error(CALL_METHOD, reason);
+            contents << QByteArray();
+            continue;
+        }
+        contents << in_file.readAll();
+    }
+
+    // ...then parse them
+    QList < Email * > ret;
+    for (int index = 0; index < mcrFilenames.size(); index++)
+    {
+        if (contents[index].isNull())
+        {
+            // Error has already been reported
+            continue;
+        }
+        NavigatedTextFile file(mcrFilenames[index], contents[index]);
+        contents[index].clear();
+        while (!file.AtEnd())
+        {
+            Email * email = new Email(file, "emlx");
+
+            // Hand over to the thread that will use the email
+            email -> moveToThread(mpTargetThread);
+            ret << email;
+        }
+    }
+
+    CALL_OUT("");
+    return ret;
+}
+
+
+
 ///////////////////////////////////////////////////////////////////////////////
 // Destructor
 Email::~Email()
@@ -307,6 +510,25 @@ void Email::ReadHeader(NavigatedTextFile & mrEmailFile)
             CALL_OUT(m_Error);
             return;
         }
+
+        // The number is the length of the message in bytes; everything
+        // after that is the trailing plist
+        const qint64 message_start =
+            mrEmailFile.GetLineOffset(mrEmailFile.GetCurrentLineNumber());
+        const qint64 message_end = message_start + line.toLongLong();
+        if (message_end > mrEmailFile.GetContentSize())
+        {
+            const QString reason =
+                tr("Message length %1 exceeds size of EMLX file \"%2\".")
+                    .arg(line,
+                         mrEmailFile.GetFilename());
+            MessageLogger::Error(CALL_METHOD, reason);
+        } else
+        {
+            m_EMLXPlist = mrEmailFile.GetRawContent(message_end);
+            mrEmailFile.SetEndLine(
+                mrEmailFile.GetLineNumberFromOffset(message_end));
+        }
         line = mrEmailFile.ReadLine();
     }
     
@@ -689,10 +911,9 @@ void Email::ReadHeader(NavigatedTextFile & mrEmailFile)
         } else
         {
             // Unknown header (non-fatal)
-            const QString reason = tr("Unknown header item: %1: %2")
-                .arg(item_tag,
-                     item_body);
-            MessageLogger::Error(CALL_METHOD, reason);
+            MessageLogger::Error(CALL_METHOD,
+                tr("Unknown header item: %1: %2"),
+                QStringList() << item_tag << item_body);
         }
         
         // Check if there was an error
@@ -1730,9 +1951,9 @@ void Email::ReadHeader_ContentType(const QString mcBody)
     // Any rest?
     if (!rest.isEmpty())
     {
-        const QString reason = tr("Residual information \"%1\"")
-            .arg(rest);
-        MessageLogger::Error(CALL_METHOD, reason);
+        MessageLogger::Error(CALL_METHOD,
+            tr("Residual information \"%1\""),
+            QStringList() << rest);
     }
 
     CALL_OUT("");
@@ -3893,9 +4114,9 @@ QHash < QString, QString > Email::ParseDate(const QString mcDate)
     }
 
     // Translate month name
-    static QHash < QString, QString > month_en;
-    if (month_en.isEmpty())
+    static const QHash < QString, QString > month_en = []()
     {
+        QHash < QString, QString > month_en;
         month_en["jan"] = "01";
         month_en["feb"] = "02";
         month_en["mar"] = "03";
@@ -3908,12 +4129,13 @@ QHash < QString, QString > Email::ParseDate(const QString mcDate)
         month_en["oct"] = "10";
         month_en["nov"] = "11";
         month_en["dec"] = "12";
-    }
+        return month_en;
+    }();
     
     // Translate time zones to UTC
-    static QHash < QString, int > timezone_to_utc;
-    if (timezone_to_utc.isEmpty())
+    static const QHash < QString, int > timezone_to_utc = []()
     {
+        QHash < QString, int > timezone_to_utc;
         timezone_to_utc["CDT"] = -(5 * 60 + 0);
         timezone_to_utc["CEST"] = +(2 * 60 + 0);
         timezone_to_utc["CET"] = +(1 * 60 + 0);
@@ -3929,7 +4151,8 @@ QHash < QString, QString > Email::ParseDate(const QString mcDate)
         timezone_to_utc["MEZ"] = +(1 * 60 + 0);
         timezone_to_utc["PDT"] = -(7 * 60 + 0);
         timezone_to_utc["PST"] = -(8 * 60 + 0);
-    }
+        return timezone_to_utc;
+    }();
     
     // Trim date
     const QString date = mcDate.trimmed();
@@ -4486,9 +4709,9 @@ void Email::ReadBody_Part(NavigatedTextFile & mrEmailFile,
     }
     
     // Read part
-    static QSet < QString > simple_types;
-    if (simple_types.isEmpty())
+    static const QSet < QString > simple_types = []()
     {
+        QSet < QString > simple_types;
         simple_types
            << "application/applefile"
            << "application/ics"
@@ -4564,7 +4787,8 @@ void Email::ReadBody_Part(NavigatedTextFile & mrEmailFile,
            << "video/mp4"
            << "video/mpeg"
            << "video/quicktime";
-    }
+        return simple_types;
+    }();
     if (!mcPartHeader.contains("content-type") ||
         mcPartHeader["content-type"].isEmpty())
     {
@@ -4901,6 +5125,16 @@ void Email::ReadBody_SavePart(NavigatedTextFile & mrEmailFile,
                  data.join(", "));
     }
     
+    // Remember where the raw part starts in the file
+    const qint64 raw_start =
+        mrEmailFile.GetLineOffset(mrEmailFile.GetCurrentLineNumber());
+
+    // Only text is kept in memory; other parts (attachments) are decoded
+    // from the source file when they are needed
+    const QString content_type = mcPartHeader["content-type"];
+    const bool is_text = content_type.isEmpty() ||
+        content_type.startsWith("text");
+
     QByteArray body;
     while (true)
     {
@@ -4938,65 +5172,25 @@ void Email::ReadBody_SavePart(NavigatedTextFile & mrEmailFile,
             }
         }
         
-        // Check for end of .emlx email
-        if (m_IsEMLX)
+        // Other than that - normal data line
+        if (is_text)
         {
-            // AppleMail .emlx file
-            int rewind_to = mrEmailFile.GetCurrentLineNumber();
-            if (line == "<?XML version=\"1.0\" encoding=\"UTF-8\"?>")
-            {
-                // End of email body, start of trailing plist
-                QString next_line = mrEmailFile.ReadLine();
-                if (next_line.startsWith("<!DOCTYPE plist PUBLIC"))
-                {
-                    next_line = mrEmailFile.ReadLine();
-                    if (next_line == "<plist version=\"1.0\">")
-                    {
-                        // Skip trailing plist
-                        if (DEBUG)
-                        {
-                            qDebug().noquote() << 
-                                tr("Line %1: Skipping trailing plist in EMLX "
-                                    "file").arg(rewind_to);
-                        }
-                        while (true)
-                        {
-                            // Check for end of plist
-                            if (next_line == "</plist>")
-                            {
-                                // End of .emlx email reached
-                                break;
-                            }
-                            
-                            // Check for end of file
-                            // (which would be before <plist> is closed)
-                            if (mrEmailFile.AtEnd())
-                            {
-                                // That was unexpected!
-                                m_ErrorLine =
-                                    mrEmailFile.GetCurrentLineNumber();
-                                m_Error = tr("Unexpected end of EMLX file.");
-                                break;
-                            }
-                            
-                            // Skip to next line
-                            next_line = mrEmailFile.ReadLine();
-                        }
-                        break;
-                    }
-                }
-            }
-            mrEmailFile.MoveTo(rewind_to);
+            body += line_raw;
+            body += '\n';
         }
-        
-        // Other than that - normal data line
-        body += line_raw;
-        body += '\n';
     }
     
+    // ...and where it ends
+    const qint64 raw_end =
+        mrEmailFile.GetLineOffset(mrEmailFile.GetCurrentLineNumber());
+
     // Undo text encoding
-    const QByteArray decoded = StringHelper::DecodeText(body,
-        mcPartHeader["charset"], mcPartHeader["transfer-encoding"]);
+    QByteArray decoded;
+    if (is_text)
+    {
+        decoded = StringHelper::DecodeText(body,
+            mcPartHeader["charset"], mcPartHeader["transfer-encoding"]);
+    }
 
     // Store it
     const int this_id = m_BodyData_Part.size();
@@ -5009,6 +5203,7 @@ void Email::ReadBody_SavePart(NavigatedTextFile & mrEmailFile,
     m_BodyData_Type << mcPartHeader["content-type"];
     m_BodyData_ParentId << mcParentId;
     m_BodyData_PartInfo << mcPartHeader;
+    m_BodyData_RawRange << QPair < qint64, qint64 >(raw_start, raw_end);
 
     // This part has no children for now
     m_BodyData_ChildIds[this_id] = QList < int >();
@@ -5074,6 +5269,7 @@ void Email::ReadBody_Multipart(NavigatedTextFile & mrEmailFile,
     m_BodyData_PartInfo << QHash < QString, QString >();
     m_BodyData_Type << mcParentPartHeader["content-type"];
     m_BodyData_ParentId << mcParentId;
+    m_BodyData_RawRange << QPair < qint64, qint64 >(-1, -1);
     if (DEBUG)
     {
         qDebug().noquote() << tr("Line %1: Stored multipart %2 part as ID %3")
@@ -5161,62 +5357,6 @@ void Email::ReadBody_Multipart(NavigatedTextFile & mrEmailFile,
         ReadBody_Part(mrEmailFile, mcParentPartHeader, part_info, part_id);
     }
     
-    // Check for trailing plist in .emlx email
-    if (m_IsEMLX)
-    {
-        // AppleMail .emlx file
-        int rewind_to = mrEmailFile.GetCurrentLineNumber();
-        QString line = mrEmailFile.ReadLine();
-        if (line == "<?XML version=\"1.0\" encoding=\"UTF-8\"?>")
-        {
-            // End of email body, start of trailing plist
-            line = mrEmailFile.ReadLine();
-            if (line.startsWith("<!DOCTYPE plist PUBLIC"))
-            {
-                line = mrEmailFile.ReadLine();
-                if (line == "<plist version=\"1.0\">")
-                {
-                    // Skip trailing plist
-                    if (DEBUG)
-                    {
-                        qDebug().noquote() << 
-                            tr("Line %1: Skipping trailing plist in EMLX file")
-                                .arg(rewind_to);
-                    }
-                    while (true)
-                    {
-                        // Check for end of plist
-                        if (line == "</plist>")
-                        {
-                            // End of .emlx email reached
-                            break;
-                        }
-                        
-                        // Check for end of file
-                        // (which would be before <plist> is closed)
-                        if (mrEmailFile.AtEnd())
-                        {
-                            // That was unexpected!
-                            m_ErrorLine = mrEmailFile.GetCurrentLineNumber();
-                            m_Error = tr("Unexpected end of EMLX file.");
-                            break;
-                        }
-                            
-                        // Skip to next line
-                        line = mrEmailFile.ReadLine();
-                    }
-                    rewind_to = -1;
-                }
-            }
-        }
-        
-        // Check if this wasn't the plist we were looking for
-        if (rewind_to != -1)
-        {
-            mrEmailFile.MoveTo(rewind_to);
-        }
-    }
-        
     if (DEBUG)
     {
         qDebug().noquote() << tr("Line %1: End of %2 part")
@@ -5323,6 +5463,132 @@ int Email::GetErrorLine() const
 
 
 
+///////////////////////////////////////////////////////////////////////////////
+// Check if the email has Apple Mail properties
+bool Email::HasEMLXProperties() const
+{
+    CALL_IN("");
+
+    CALL_OUT("");
+    return !m_EMLXPlist.isEmpty();
+}
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// Get all Apple Mail properties
+QHash < QString, QString > Email::GetEMLXProperties() const
+{
+    CALL_IN("");
+
+    ParseEMLXProperties();
+
+    CALL_OUT("");
+    return m_EMLXProperties;
+}
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// Get Apple Mail flags
+qint64 Email::GetEMLXFlags() const
+{
+    CALL_IN("");
+
+    ParseEMLXProperties();
+    bool ok = false;
+    const qint64 flags = m_EMLXProperties.value("flags").toLongLong(&ok);
+
+    CALL_OUT("");
+    return (ok ? flags : -1);
+}
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// Get the date Apple Mail received the email
+QDateTime Email::GetEMLXDateReceived() const
+{
+    CALL_IN("");
+
+    ParseEMLXProperties();
+    // Stored as <integer> or, by newer versions of Mail, as <real>
+    bool ok = false;
+    const qint64 seconds =
+        qint64(m_EMLXProperties.value("date-received").toDouble(&ok));
+    if (!ok)
+    {
+        CALL_OUT("");
+        return QDateTime();
+    }
+
+    CALL_OUT("");
+    return QDateTime::fromSecsSinceEpoch(seconds);
+}
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// Parse trailing plist (on first access)
+void Email::ParseEMLXProperties() const
+{
+    CALL_IN("");
+
+    // Only once
+    if (m_EMLXPropertiesParsed)
+    {
+        CALL_OUT("");
+        return;
+    }
+    m_EMLXPropertiesParsed = true;
+    if (m_EMLXPlist.isEmpty())
+    {
+        CALL_OUT("");
+        return;
+    }
+
+    // Parse XML
+    QDomDocument plist;
+    const QDomDocument::ParseResult result = plist.setContent(m_EMLXPlist);
+    if (!result)
+    {
+        const QString reason = tr("Trailing plist of \"%1\" could not be "
+            "parsed: %2 (line %3)")
+            .arg(m_Filename,
+                 result.errorMessage,
+                 QString::number(result.errorLine));
+        MessageLogger::Error(CALL_METHOD, reason);
+        CALL_OUT(reason);
+        return;
+    }
+
+    // <plist><dict><key>...</key><integer>...</integer>...</dict></plist>
+    const QDomElement dict =
+        plist.documentElement().firstChildElement("dict");
+    QDomElement key = dict.firstChildElement("key");
+    while (!key.isNull())
+    {
+        const QDomElement value = key.nextSiblingElement();
+        if (value.isNull())
+        {
+            break;
+        }
+        if (value.tagName() == "true" ||
+            value.tagName() == "false")
+        {
+            m_EMLXProperties[key.text()] = value.tagName();
+        } else
+        {
+            m_EMLXProperties[key.text()] = value.text();
+        }
+        key = value.nextSiblingElement("key");
+    }
+
+    CALL_OUT("");
+}
+
+
+
 ///////////////////////////////////////////////////////////////////////////////
 // Check if a certain header item is available
 bool Email::HasHeaderItem(const QString mcHeaderItem) const
@@ -5751,6 +6017,26 @@ QByteArray Email::GetPart(const int mcIndex) const
         return QByteArray();
     }
     
+    // Parts other than text are not kept in memory; decode them from the
+    // source file
+    const QString type = m_BodyData_Type[mcIndex];
+    if (!type.isEmpty() &&
+        !type.startsWith("text") &&
+        m_BodyData_RawRange[mcIndex].first >= 0)
+    {
+        QBuffer buffer;
+        buffer.open(QIODevice::WriteOnly);
+        if (!ExtractPart(mcIndex, buffer))
+        {
+            const QString reason = tr("Could not decode body part %1.")
+                .arg(QString::number(mcIndex));
+            CALL_OUT(reason);
+            return QByteArray();
+        }
+        CALL_OUT("");
+        return buffer.data();
+    }
+    
     // Okay
     CALL_OUT("");
     return m_BodyData_Part[mcIndex];
@@ -5884,6 +6170,185 @@ QList < int > Email::GetPartChildIds(const int mcIndex) const
 
 
 
+///////////////////////////////////////////////////////////////////////////////
+// Extract a part directly from the source file
+bool Email::ExtractPart(const int mcIndex, QIODevice & mrOutput) const
+{
+    CALL_IN(QString("mcIndex=%1, mrOutput=...")
+        .arg(CALL_SHOW(mcIndex)));
+
+    // Debugging
+    if (DEBUG)
+    {
+        qDebug().noquote() << CALL_METHOD;
+    }
+
+    // Check if index is within bounds
+    if (mcIndex < 0 || mcIndex >= m_BodyData_RawRange.size())
+    {
+        const QString reason =
+            tr("Email does not have a body part %1 (has %2 only)")
+                .arg(QString::number(mcIndex),
+                     QString::number(m_BodyData_RawRange.size()));
+        MessageLogger::Error(CALL_METHOD, reason);
+        CALL_OUT(reason);
+        return false;
+    }
+
+    // Check if part has content (multiparts don't)
+    const QPair < qint64, qint64 > raw_range = m_BodyData_RawRange[mcIndex];
+    if (raw_range.first < 0)
+    {
+        const QString reason =
+            tr("Body part %1 is a %2 part and has no content of its own.")
+                .arg(QString::number(mcIndex),
+                     m_BodyData_Type[mcIndex]);
+        MessageLogger::Error(CALL_METHOD, reason);
+        CALL_OUT(reason);
+        return false;
+    }
+
+    // Open source file
+    QFile in_file(m_Filename);
+    if (!in_file.open(QIODevice::ReadOnly) ||
+        !in_file.seek(raw_range.first))
+    {
+        const QString reason =
+            tr("Could not read body part %1 from \"%2\".")
+                .arg(QString::number(mcIndex),
+                     m_Filename);
+        MessageLogger::Error(CALL_METHOD, reason);
+        CALL_OUT(reason);
+        return false;
+    }
+
+    // Decode
+    const bool success = StringHelper::DecodeTransferEncoding(in_file,
+        raw_range.second - raw_range.first,
+        m_BodyData_PartInfo[mcIndex].value("transfer-encoding"), mrOutput);
+
+    CALL_OUT("");
+    return success;
+}
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// Extract a part directly from the source file into a file
+bool Email::ExtractPart(const int mcIndex, const QString mcFilename) const
+{
+    CALL_IN(QString("mcIndex=%1, mcFilename=%2")
+        .arg(CALL_SHOW(mcIndex),
+             CALL_SHOW_FULL(mcFilename)));
+
+    // Debugging
+    if (DEBUG)
+    {
+        qDebug().noquote() << CALL_METHOD;
+    }
+
+    // Open output file
+    QFile out_file(mcFilename);
+    if (!out_file.open(QIODevice::WriteOnly))
+    {
+        const QString reason = tr("File \"%1\" could not be opened.")
+            .arg(mcFilename);
+        MessageLogger::Error(CALL_METHOD, reason);
+        CALL_OUT(reason);
+        return false;
+    }
+
+    // Extract
+    const bool success = ExtractPart(mcIndex, out_file);
+    out_file.close();
+    if (!success)
+    {
+        out_file.remove();
+    }
+
+    CALL_OUT("");
+    return success;
+}
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// Extract all parts of a given type into a directory
+QStringList Email::ExtractParts(const QString mcContentType,
+    const QString mcDirectory) const
+{
+    CALL_IN(QString("mcContentType=%1, mcDirectory=%2")
+        .arg(CALL_SHOW(mcContentType),
+             CALL_SHOW_FULL(mcDirectory)));
+
+    // Debugging
+    if (DEBUG)
+    {
+        qDebug().noquote() << CALL_METHOD;
+    }
+
+    // Check content type
+    if (mcContentType.isEmpty())
+    {
+        const QString reason = tr("No content type given.");
+        MessageLogger::Error(CALL_METHOD, reason);
+        CALL_OUT(reason);
+        return QStringList();
+    }
+
+    // "image/*" matches all images
+    const bool is_wildcard = mcContentType.endsWith("/*");
+    QString type_prefix;
+    if (is_wildcard)
+    {
+        type_prefix = mcContentType.chopped(2).toLower() + "/";
+    }
+
+    QStringList ret;
+    QSet < QString > used_names;
+    const QDir directory(mcDirectory);
+    for (int index = 0; index < m_BodyData_Type.size(); index++)
+    {
+        // Check type
+        const QString type = m_BodyData_Type[index];
+        if (m_BodyData_RawRange[index].first < 0 ||
+            (is_wildcard && !type.startsWith(type_prefix)) ||
+            (!is_wildcard && type != mcContentType.toLower()))
+        {
+            continue;
+        }
+
+        // Pick a file name; avoid path components and name clashes
+        QString name = m_BodyData_PartInfo[index].value("filename");
+        if (name.isEmpty())
+        {
+            name = m_BodyData_PartInfo[index].value("name");
+        }
+        name = QFileInfo(name).fileName();
+        if (name.isEmpty())
+        {
+            name = QString("part_%1").arg(index);
+        }
+        if (used_names.contains(name))
+        {
+            name = QString("%1_%2").arg(QString::number(index), name);
+        }
+        used_names += name;
+
+        // Extract
+        const QString filename = directory.filePath(name);
+        if (ExtractPart(index, filename))
+        {
+            ret << filename;
+        }
+    }
+
+    CALL_OUT("");
+    return ret;
+}
+
+
+
 // ======================================================================== XML
 
 
@@ -6450,7 +6915,7 @@ void Email::ToXML_BodyPart(QDomElement & mrDomParent, const int mcId)
         } else
         {
             // Binary
-            const QString base64 = m_BodyData_Part[mcId].toBase64();
+            const QString base64 = GetPart(mcId).toBase64();
             QDomText dom_part_text = xml.createTextNode(base64);
             dom_part.appendChild(dom_part_text);
         }
@@ -6576,7 +7041,7 @@ void Email::Dump()
         qDebug().noquote() << tr("======= Part %1 (%2, parent %3)").arg(idx)
             .arg(m_BodyData_Type[idx],
                  m_BodyData_ParentId[idx]);
-        qDebug().noquote() << m_BodyData_Part[idx];
+        qDebug().noquote() << GetPart(idx);
         qDebug().noquote() << tr("======= End Part %1").arg(idx);
     }
 
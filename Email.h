@@ -35,13 +35,19 @@
 
 // Qt includes
 #include <QByteArray>
+#include <QDateTime>
 #include <QDomElement>
 #include <QHash>
+#include <QIODevice>
 #include <QObject>
+#include <QPair>
 #include <QString>
+#include <QStringList>
 
 // Forward declarations
+class EmailDeduplicator;
 class NavigatedTextFile;
+class QThread;
 
 // Class definition
 class Email :
@@ -81,16 +87,48 @@ public:
       * mbox files may contain multiple emails that can be imported in a
       * single pass.
       * \param mcFilename Filename of the mbox file
+      * \param mpDeduplicator If given, emails that have been seen before
+      * (in this or any other file) are dropped during import.
       */
-	static QList < Email * > ImportFromMBox(const QString mcFilename);
+	static QList < Email * > ImportFromMBox(const QString mcFilename,
+        EmailDeduplicator * mpDeduplicator = nullptr);
 	
     /** \brief Import multiple emails from an Apple Mail emlx file
       * \details
       * emlx files may contain multiple emails that can be imported in a
       * single pass.
       * \param mcFilename Filename of the emlx file
+      * \param mpDeduplicator If given, emails that have been seen before
+      * are dropped during import.
       */
-    static QList < Email * > ImportFromEMLXFile(const QString mcFilename);
+    static QList < Email * > ImportFromEMLXFile(const QString mcFilename,
+        EmailDeduplicator * mpDeduplicator = nullptr);
+
+    /** \brief Import all Apple Mail emlx files in a directory tree
+      * \details
+      * Apple Mail keeps one email per emlx file in deeply nested directories.
+      * Files are imported in parallel on a bounded thread pool; every task
+      * first reads a batch of files, then parses them.
+      * Emails are returned in the order of their (sorted) filenames.
+      * \param mcDirectory Top-level directory to search for emlx files
+      * \param mpDeduplicator If given, emails that have been seen before
+      * are dropped.
+      * \param mcMaxThreads Maximum number of parallel imports; \c 0 uses
+      * the number of CPU cores.
+      */
+    static QList < Email * > ImportFromEMLXDirectory(const QString mcDirectory,
+        EmailDeduplicator * mpDeduplicator = nullptr,
+        const int mcMaxThreads = 0);
+
+private:
+    /** \brief Import a batch of emlx files (called on a worker thread)
+      * \param mcrFilenames emlx files to import
+      * \param mpTargetThread Thread the new Email objects are moved to
+      */
+    static QList < Email * > ImportFromEMLXBatch(
+        const QStringList & mcrFilenames, QThread * mpTargetThread);
+
+public:
 	
     /** \brief Destructor
       */
@@ -923,6 +961,44 @@ private:
       */
     int m_ErrorLine;
 
+public:
+    /** \brief Check if the email has Apple Mail properties
+      * \details
+      * emlx files end with a plist holding properties like flags and
+      * dates. It is only parsed when its content is first requested.
+      * \returns \c true if there was a trailing plist
+      */
+    bool HasEMLXProperties() const;
+
+    /** \brief Get all Apple Mail properties
+      * \returns Property name (e.g. "flags", "date-received") and its
+      * value as text
+      */
+    QHash < QString, QString > GetEMLXProperties() const;
+
+    /** \brief Get Apple Mail flags (read, flagged, replied etc.)
+      * \returns Bit field, or \c -1 if unavailable
+      */
+    qint64 GetEMLXFlags() const;
+
+    /** \brief Get the date Apple Mail received the email
+      * \returns Date and time, or an invalid date if unavailable
+      */
+    QDateTime GetEMLXDateReceived() const;
+private:
+    /** \brief Parse trailing plist (on first access)
+      */
+    void ParseEMLXProperties() const;
+
+    /** \brief Raw trailing plist of an emlx file
+      */
+    QByteArray m_EMLXPlist;
+
+    /** \brief Parsed properties
+      */
+    mutable QHash < QString, QString > m_EMLXProperties;
+    mutable bool m_EMLXPropertiesParsed;
+
 public:
     /** \brief Check if email has a certaint header item
       * \param mcHeaderItem Header item bein considered
@@ -1029,12 +1105,49 @@ public:
     QString GetPartType(const int mcIndex) const;
     int GetPartParentId(const int mcIndex) const;
     QList < int > GetPartChildIds(const int mcIndex) const;
+
+    /** \brief Extract a part directly from the source file
+      * \details
+      * The raw part is read from the file the email was imported from and
+      * its transfer encoding (base64, quoted-printable) is reversed chunk by
+      * chunk, so memory use does not depend on the size of the part. The
+      * character set is not converted. Several emails can be extracted
+      * concurrently.
+      * \param mcIndex Index of the part
+      * \param mrOutput Open device the decoded part is written to
+      * \returns \c true on success
+      */
+    bool ExtractPart(const int mcIndex, QIODevice & mrOutput) const;
+
+    /** \brief Extract a part directly from the source file into a file
+      * \param mcIndex Index of the part
+      * \param mcFilename File to write the decoded part to
+      * \returns \c true on success
+      */
+    bool ExtractPart(const int mcIndex, const QString mcFilename) const;
+
+    /** \brief Extract all parts of a given type into a directory
+      * \param mcContentType MIME type, e.g. "application/pdf"; "image/*"
+      * matches all images.
+      * \param mcDirectory Directory to save the parts in. File names are
+      * taken from the part information where available.
+      * \returns Names of the files that have been written
+      */
+    QStringList ExtractParts(const QString mcContentType,
+        const QString mcDirectory) const;
 private:
+    /** \brief Decoded text parts; empty for other parts, which GetPart()
+      * decodes from the source file
+      */
     QList < QByteArray > m_BodyData_Part;
     QList < QHash < QString, QString > > m_BodyData_PartInfo;
     QList < QString > m_BodyData_Type;
     QList < int > m_BodyData_ParentId;
     QHash < int, QList < int > > m_BodyData_ChildIds;
+
+    /** \brief Byte range of the (still encoded) part in the source file
+      */
+    QList < QPair < qint64, qint64 > > m_BodyData_RawRange;
     
     
     
@@ -0,0 +1,409 @@
+// Copyright (C) 2025 Chris von Toerne
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+//
+// Contact the author by email: christian.vontoerne@gmail.com
+
+// EmailDeduplicator.cpp
+// Class implementation file
+
+// Project includes
+#include "CallTracer.h"
+#include "Email.h"
+#include "EmailDeduplicator.h"
+#include "MD5Sum.h"
+#include "MessageLogger.h"
+
+// Qt includes
+#include <QDataStream>
+#include <QFile>
+#include <QSaveFile>
+
+// Store file format
+#define STORE_MAGIC 0x45444450
+#define STORE_VERSION 1
+
+
+
+// ================================================================== Lifecycle
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// Constructor
+EmailDeduplicator::EmailDeduplicator(const QString mcStoreFilename)
+{
+    CALL_IN(QString("mcStoreFilename=%1")
+        .arg(CALL_SHOW_FULL(mcStoreFilename)));
+    REGISTER_INSTANCE;
+
+    // Initialize
+    m_StoreFilename = mcStoreFilename;
+    m_NumberOfDuplicates = 0;
+    m_IsModified = false;
+
+    // Load previously known fingerprints
+    if (!m_StoreFilename.isEmpty() &&
+        QFile::exists(m_StoreFilename))
+    {
+        Load();
+    }
+
+    CALL_OUT("");
+}
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// Destructor
+EmailDeduplicator::~EmailDeduplicator()
+{
+    CALL_IN("");
+    UNREGISTER_INSTANCE;
+
+    // Don't lose anything
+    if (m_IsModified)
+    {
+        Save();
+    }
+
+    CALL_OUT("");
+}
+
+
+
+// ================================================================ Fingerprint
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// Compute the fingerprint of an email
+QString EmailDeduplicator::ComputeFingerprint(const Email * mcpEmail)
+{
+    CALL_IN(QString("mcpEmail=%1")
+        .arg(CALL_SHOW(mcpEmail)));
+
+    // Identify email by Message-ID; fall back to sender and date
+    QString id;
+    if (mcpEmail -> HasHeaderItem("Message-Id", "id"))
+    {
+        id = mcpEmail -> GetHeaderItem("Message-Id", "id").toLower();
+    } else
+    {
+        if (mcpEmail -> HasHeaderItem("From", "raw"))
+        {
+            id += mcpEmail -> GetHeaderItem("From", "raw");
+        }
+        id += "|";
+        if (mcpEmail -> HasHeaderItem("Date", "raw"))
+        {
+            id += mcpEmail -> GetHeaderItem("Date", "raw");
+        }
+    }
+
+    // Hash body parts; every part hash seeds the next one, so the order
+    // of the parts matters
+    quint64 hash = 0;
+    for (int part_index = 0;
+         part_index < mcpEmail -> GetNumberOfParts();
+         part_index++)
+    {
+        const QString type = mcpEmail -> GetPartType(part_index);
+        if (type.startsWith("multipart"))
+        {
+            // Container only
+            continue;
+        }
+        const QByteArray part =
+            NormalizePart(mcpEmail -> GetPart(part_index), type);
+        hash = MD5Sum::ComputeXXHash64(part, hash);
+    }
+
+    const QString fingerprint = QString("%1/%2")
+        .arg(id,
+             QString::number(hash, 16).rightJustified(16, '0'));
+
+    CALL_OUT("");
+    return fingerprint;
+}
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// Normalize a body part before hashing
+QByteArray EmailDeduplicator::NormalizePart(const QByteArray & mcrPart,
+    const QString & mcrType)
+{
+    CALL_IN(QString("mcrPart=%1, mcrType=%2")
+        .arg(CALL_SHOW(mcrPart),
+             CALL_SHOW(mcrType)));
+
+    // Binary parts are hashed as they are
+    if (!mcrType.startsWith("text"))
+    {
+        CALL_OUT("");
+        return mcrPart;
+    }
+
+    // Text: unify line endings, drop trailing white space
+    QByteArray normalized;
+    normalized.reserve(mcrPart.size());
+    QByteArray pending_white_space;
+    for (int index = 0; index < mcrPart.size(); index++)
+    {
+        char this_char = mcrPart.at(index);
+        if (this_char == '\r')
+        {
+            // CR LF is one line break; a lone CR is a line break, too
+            if (index + 1 < mcrPart.size() &&
+                mcrPart.at(index + 1) == '\n')
+            {
+                continue;
+            }
+            this_char = '\n';
+        }
+        if (this_char == ' ' ||
+            this_char == '\t')
+        {
+            pending_white_space += this_char;
+            continue;
+        }
+        if (this_char != '\n')
+        {
+            normalized += pending_white_space;
+        }
+        pending_white_space.clear();
+        normalized += this_char;
+    }
+
+    // Drop trailing empty lines
+    while (normalized.endsWith('\n'))
+    {
+        normalized.chop(1);
+    }
+
+    CALL_OUT("");
+    return normalized;
+}
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// Check if an email has been seen before
+bool EmailDeduplicator::IsDuplicate(const Email * mcpEmail)
+{
+    CALL_IN(QString("mcpEmail=%1")
+        .arg(CALL_SHOW(mcpEmail)));
+
+    const QString fingerprint = ComputeFingerprint(mcpEmail);
+    const QString origin = QString("%1:%2")
+        .arg(mcpEmail -> GetFilename(),
+             QString::number(mcpEmail -> GetStartLineNumber()));
+
+    // Check if we know this one
+    if (m_FingerprintToOrigin.contains(fingerprint))
+    {
+        m_NumberOfDuplicates++;
+        const QString reason =
+            tr("Email at %1 is a duplicate of email at %2.")
+                .arg(origin,
+                     m_FingerprintToOrigin[fingerprint]);
+        CALL_OUT(reason);
+        return true;
+    }
+
+    // New email
+    m_FingerprintToOrigin[fingerprint] = origin;
+    m_IsModified = true;
+
+    CALL_OUT("");
+    return false;
+}
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// Remove duplicates from a list of emails
+QList < Email * > EmailDeduplicator::DropDuplicates(QList < Email * > mEmails,
+    const bool mcDeleteDuplicates)
+{
+    CALL_IN(QString("mEmails=..., mcDeleteDuplicates=%1")
+        .arg(CALL_SHOW(mcDeleteDuplicates)));
+
+    QList < Email * > unique_emails;
+    int dropped = 0;
+    for (Email * email : mEmails)
+    {
+        if (!IsDuplicate(email))
+        {
+            unique_emails << email;
+            continue;
+        }
+
+        // Duplicate
+        dropped++;
+        if (mcDeleteDuplicates)
+        {
+            delete email;
+        }
+    }
+
+    // Report
+    if (dropped > 0)
+    {
+        const QString message = tr("Dropped %1 duplicate email(s) of %2.")
+            .arg(QString::number(dropped),
+                 QString::number(mEmails.size()));
+        MessageLogger::Message(CALL_METHOD, message);
+    }
+
+    CALL_OUT("");
+    return unique_emails;
+}
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// Number of duplicates found so far
+int EmailDeduplicator::GetNumberOfDuplicates() const
+{
+    CALL_IN("");
+
+    CALL_OUT("");
+    return m_NumberOfDuplicates;
+}
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// Where an email with a given fingerprint was first seen
+QString EmailDeduplicator::GetOrigin(const QString & mcrFingerprint) const
+{
+    CALL_IN(QString("mcrFingerprint=%1")
+        .arg(CALL_SHOW(mcrFingerprint)));
+
+    CALL_OUT("");
+    return m_FingerprintToOrigin.value(mcrFingerprint);
+}
+
+
+
+// ================================================================ Persistence
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// Load fingerprints from the store file
+bool EmailDeduplicator::Load()
+{
+    CALL_IN("");
+
+    // Open file
+    QFile in_file(m_StoreFilename);
+    if (!in_file.open(QIODevice::ReadOnly))
+    {
+        const QString reason = tr("File \"%1\" could not be opened.")
+            .arg(m_StoreFilename);
+        MessageLogger::Error(CALL_METHOD, reason);
+        CALL_OUT(reason);
+        return false;
+    }
+
+    // Check format
+    QDataStream in(&in_file);
+    quint32 magic = 0;
+    qint32 version = 0;
+    in >> magic >> version;
+    if (magic != STORE_MAGIC ||
+        version != STORE_VERSION)
+    {
+        const QString reason =
+            tr("File \"%1\" is not a fingerprint store (or has an "
+                "incompatible version).")
+                .arg(m_StoreFilename);
+        MessageLogger::Error(CALL_METHOD, reason);
+        CALL_OUT(reason);
+        return false;
+    }
+
+    // Read fingerprints
+    QHash < QString, QString > fingerprint_to_origin;
+    in >> fingerprint_to_origin;
+    if (in.status() != QDataStream::Ok)
+    {
+        const QString reason = tr("File \"%1\" is corrupt.")
+            .arg(m_StoreFilename);
+        MessageLogger::Error(CALL_METHOD, reason);
+        CALL_OUT(reason);
+        return false;
+    }
+
+    // Merge (fingerprints seen in this session take precedence)
+    for (auto fingerprint_iterator = fingerprint_to_origin.constBegin();
+         fingerprint_iterator != fingerprint_to_origin.constEnd();
+         fingerprint_iterator++)
+    {
+        if (!m_FingerprintToOrigin.contains(fingerprint_iterator.key()))
+        {
+            m_FingerprintToOrigin[fingerprint_iterator.key()] =
+                fingerprint_iterator.value();
+        }
+    }
+
+    CALL_OUT("");
+    return true;
+}
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// Save fingerprints to the store file
+bool EmailDeduplicator::Save()
+{
+    CALL_IN("");
+
+    // Nothing to do if we only keep fingerprints in memory
+    if (m_StoreFilename.isEmpty())
+    {
+        CALL_OUT("");
+        return true;
+    }
+
+    // Write to a temporary file first so a crash does not corrupt the store
+    QSaveFile out_file(m_StoreFilename);
+    if (!out_file.open(QIODevice::WriteOnly))
+    {
+        const QString reason = tr("File \"%1\" could not be opened.")
+            .arg(m_StoreFilename);
+        MessageLogger::Error(CALL_METHOD, reason);
+        CALL_OUT(reason);
+        return false;
+    }
+    QDataStream out(&out_file);
+    out << quint32(STORE_MAGIC) << qint32(STORE_VERSION);
+    out << m_FingerprintToOrigin;
+    if (!out_file.commit())
+    {
+        const QString reason = tr("File \"%1\" could not be written.")
+            .arg(m_StoreFilename);
+        MessageLogger::Error(CALL_METHOD, reason);
+        CALL_OUT(reason);
+        return false;
+    }
+
+    m_IsModified = false;
+
+    CALL_OUT("");
+    return true;
+}
@@ -0,0 +1,123 @@
+// EmailDeduplicator.h
+// Class definition file
+
+/** \class EmailDeduplicator
+  * Detects emails that have already been imported
+  *
+  * The same email frequently shows up in several files (sent mail, inbox,
+  * archives). This class computes a fingerprint for each email, consisting
+  * of the Message-ID and a fast non-cryptographic hash of the normalized
+  * body parts, and remembers which fingerprints have been seen so far.
+  * Fingerprints can be stored in a file so they survive between runs.
+  */
+
+// Just include once
+#ifndef EMAILDEDUPLICATOR_H
+#define EMAILDEDUPLICATOR_H
+
+// Qt includes
+#include <QByteArray>
+#include <QHash>
+#include <QList>
+#include <QObject>
+#include <QString>
+
+// Forward declarations
+class Email;
+
+// Class definition
+class EmailDeduplicator :
+    public QObject
+{
+    Q_OBJECT
+
+
+
+    // ============================================================== Lifecycle
+public:
+    /** \brief Constructor
+      * \param mcStoreFilename Filename of the persistent fingerprint store.
+      * If the file exists, known fingerprints are loaded from it. Leave
+      * empty to keep fingerprints in memory only.
+      */
+    EmailDeduplicator(const QString mcStoreFilename = QString());
+
+    /** \brief Destructor
+      */
+    ~EmailDeduplicator();
+
+
+
+    // =========================================================== Fingerprint
+public:
+    /** \brief Compute the fingerprint of an email
+      * \param mcpEmail Email to compute the fingerprint for
+      * \returns Message-ID (or sender and date if there is none) and the
+      * hash of the normalized body parts
+      */
+    static QString ComputeFingerprint(const Email * mcpEmail);
+
+private:
+    /** \brief Normalize a body part before hashing
+      * \details Text parts are stripped of line ending and trailing white
+      * space differences introduced by different mail clients.
+      */
+    static QByteArray NormalizePart(const QByteArray & mcrPart,
+        const QString & mcrType);
+
+public:
+    /** \brief Check if an email has been seen before
+      * \details Unknown emails are registered, so the next identical email
+      * will be reported as a duplicate.
+      * \param mcpEmail Email to check
+      * \returns \c true if the email is a duplicate
+      */
+    bool IsDuplicate(const Email * mcpEmail);
+
+    /** \brief Remove duplicates from a list of emails
+      * \param mEmails Emails to check
+      * \param mcDeleteDuplicates If \c true, duplicate emails are deleted.
+      * \returns Emails that have not been seen before
+      */
+    QList < Email * > DropDuplicates(QList < Email * > mEmails,
+        const bool mcDeleteDuplicates = true);
+
+    /** \brief Number of duplicates found so far
+      */
+    int GetNumberOfDuplicates() const;
+
+    /** \brief Where an email with a given fingerprint was first seen
+      * \returns "filename:line" of the first occurrence
+      */
+    QString GetOrigin(const QString & mcrFingerprint) const;
+
+private:
+    // Fingerprint to first occurrence
+    QHash < QString, QString > m_FingerprintToOrigin;
+
+    // Duplicates found
+    int m_NumberOfDuplicates;
+
+
+
+    // ============================================================ Persistence
+public:
+    /** \brief Load fingerprints from the store file
+      * \returns \c true on success
+      */
+    bool Load();
+
+    /** \brief Save fingerprints to the store file
+      * \returns \c true on success
+      */
+    bool Save();
+
+private:
+    // Filename of the store
+    QString m_StoreFilename;
+
+    // Fingerprints changed since last save
+    bool m_IsModified;
+};
+
+#endif
@@ -0,0 +1,759 @@
+// Copyright (C) 2025 Chris von Toerne
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+//
+// Contact the author by email: christian.vontoerne@gmail.com
+
+// EmailSearchIndex.cpp
+// Class implementation file
+
+// Project includes
+#include "CallTracer.h"
+#include "Email.h"
+#include "EmailSearchIndex.h"
+#include "MessageLogger.h"
+
+// Qt includes
+#include <QDataStream>
+#include <QFile>
+#include <QRegularExpression>
+#include <QSaveFile>
+#include <QThreadPool>
+#include <QtConcurrent>
+
+// System includes
+#include <algorithm>
+
+// Index file format
+#define INDEX_MAGIC 0x45534958
+#define INDEX_VERSION 1
+
+
+
+// ================================================================== Lifecycle
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// Constructor
+EmailSearchIndex::EmailSearchIndex(const QString mcIndexFilename)
+{
+    CALL_IN(QString("mcIndexFilename=%1")
+        .arg(CALL_SHOW_FULL(mcIndexFilename)));
+    REGISTER_INSTANCE;
+
+    // Initialize
+    m_IndexFilename = mcIndexFilename;
+    m_IsModified = false;
+
+    // Load existing index
+    if (!m_IndexFilename.isEmpty() &&
+        QFile::exists(m_IndexFilename))
+    {
+        Load();
+    }
+
+    CALL_OUT("");
+}
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// Destructor
+EmailSearchIndex::~EmailSearchIndex()
+{
+    CALL_IN("");
+    UNREGISTER_INSTANCE;
+
+    // Don't lose anything
+    if (m_IsModified)
+    {
+        Save();
+    }
+
+    CALL_OUT("");
+}
+
+
+
+// =================================================================== Indexing
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// Key identifying an email in the index
+QString EmailSearchIndex::GetEmailKey(const Email * mcpEmail)
+{
+    CALL_IN(QString("mcpEmail=%1")
+        .arg(CALL_SHOW(mcpEmail)));
+
+    const QString key = QString("%1:%2")
+        .arg(mcpEmail -> GetFilename(),
+             QString::number(mcpEmail -> GetStartLineNumber()));
+
+    CALL_OUT("");
+    return key;
+}
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// Add a single email to the index
+void EmailSearchIndex::AddEmail(const Email * mcpEmail)
+{
+    CALL_IN(QString("mcpEmail=%1")
+        .arg(CALL_SHOW(mcpEmail)));
+
+    // Check if we know this one already
+    const QString key = GetEmailKey(mcpEmail);
+    if (m_IndexedEmails.contains(key))
+    {
+        CALL_OUT("");
+        return;
+    }
+
+    // Add all text parts
+    const QList < QPair < int, QHash < QString, QList < int > > > > parts =
+        ExtractTerms(mcpEmail);
+    for (const QPair < int, QHash < QString, QList < int > > > & part : parts)
+    {
+        AddDocument(key, part.first, part.second);
+    }
+    m_IndexedEmails += key;
+    m_IsModified = true;
+
+    CALL_OUT("");
+}
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// Add several emails to the index
+void EmailSearchIndex::AddEmails(const QList < Email * > & mcrEmails,
+    const int mcMaxThreads)
+{
+    CALL_IN(QString("mcrEmails=..., mcMaxThreads=%1")
+        .arg(CALL_SHOW(mcMaxThreads)));
+
+    // Only new emails
+    QList < const Email * > new_emails;
+    QSet < QString > new_keys;
+    for (const Email * email : mcrEmails)
+    {
+        const QString key = GetEmailKey(email);
+        if (!m_IndexedEmails.contains(key) &&
+            !new_keys.contains(key))
+        {
+            new_emails << email;
+            new_keys += key;
+        }
+    }
+
+    // Extract terms
+    const int max_threads =
+        (mcMaxThreads > 0 ? mcMaxThreads : QThread::idealThreadCount());
+    QList < QList < QPair < int, QHash < QString, QList < int > > > > >
+        all_terms;
+    if (max_threads == 1 ||
+        new_emails.size() < 2)
+    {
+        // In this thread
+        for (const Email * email : new_emails)
+        {
+            all_terms << ExtractTerms(email);
+        }
+    } else
+    {
+        // In parallel; CallTracer keeps its call stacks per thread
+        QThreadPool pool;
+        pool.setMaxThreadCount(max_threads);
+        all_terms = QtConcurrent::blockingMapped <
+            QList < QList < QPair < int, QHash < QString,
+                QList < int > > > > > >(&pool, new_emails, &ExtractTerms);
+    }
+
+    // Merge in order
+    for (int index = 0; index < new_emails.size(); index++)
+    {
+        const QString key = GetEmailKey(new_emails[index]);
+        for (const QPair < int, QHash < QString, QList < int > > > & part :
+            all_terms[index])
+        {
+            AddDocument(key, part.first, part.second);
+        }
+        m_IndexedEmails += key;
+    }
+    if (!new_emails.isEmpty())
+    {
+        m_IsModified = true;
+    }
+
+    CALL_OUT("");
+}
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// Check if an email has already been indexed
+bool EmailSearchIndex::ContainsEmail(const QString & mcrEmailKey) const
+{
+    CALL_IN(QString("mcrEmailKey=%1")
+        .arg(CALL_SHOW(mcrEmailKey)));
+
+    CALL_OUT("");
+    return m_IndexedEmails.contains(mcrEmailKey);
+}
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// Number of indexed email parts
+int EmailSearchIndex::GetNumberOfDocuments() const
+{
+    CALL_IN("");
+
+    CALL_OUT("");
+    return m_Documents.size();
+}
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// Number of distinct words
+int EmailSearchIndex::GetNumberOfTerms() const
+{
+    CALL_IN("");
+
+    CALL_OUT("");
+    return m_Postings.size();
+}
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// Split text into case-folded words
+QStringList EmailSearchIndex::Tokenize(const QString & mcrText)
+{
+    CALL_IN(QString("mcrText=%1")
+        .arg(CALL_SHOW(mcrText)));
+
+    QStringList tokens;
+    qsizetype word_start = -1;
+    for (qsizetype index = 0; index <= mcrText.size(); index++)
+    {
+        const bool is_word_character = (index < mcrText.size() &&
+            mcrText.at(index).isLetterOrNumber());
+        if (is_word_character &&
+            word_start == -1)
+        {
+            word_start = index;
+        } else if (!is_word_character &&
+            word_start != -1)
+        {
+            tokens << mcrText.mid(word_start, index - word_start)
+                .toCaseFolded();
+            word_start = -1;
+        }
+    }
+
+    CALL_OUT("");
+    return tokens;
+}
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// Remove HTML tags, scripts, styles and common entities
+QString EmailSearchIndex::StripTags(const QString & mcrHTML)
+{
+    CALL_IN(QString("mcrHTML=%1")
+        .arg(CALL_SHOW(mcrHTML)));
+
+    // Common entities
+    static const QHash < QString, QChar > entities = {
+        { "amp", '&' },
+        { "apos", '\'' },
+        { "gt", '>' },
+        { "lt", '<' },
+        { "nbsp", ' ' },
+        { "quot", '"' }
+    };
+
+    QString text;
+    text.reserve(mcrHTML.size());
+    qsizetype index = 0;
+    while (index < mcrHTML.size())
+    {
+        const QChar this_char = mcrHTML.at(index);
+
+        // Tags are replaced by a blank so words don't run together
+        if (this_char == '<')
+        {
+            const qsizetype tag_end = mcrHTML.indexOf('>', index);
+            if (tag_end == -1)
+            {
+                break;
+            }
+            const QString tag =
+                mcrHTML.mid(index + 1, qMin(tag_end - index - 1, 6))
+                    .toLower();
+            index = tag_end + 1;
+
+            // Skip content of scripts and styles entirely
+            if (tag.startsWith("script") ||
+                tag.startsWith("style"))
+            {
+                const QString closing_tag =
+                    (tag.startsWith("script") ? "</script" : "</style");
+                const qsizetype closing_index =
+                    mcrHTML.indexOf(closing_tag, index, Qt::CaseInsensitive);
+                if (closing_index == -1)
+                {
+                    break;
+                }
+                index = closing_index;
+                continue;
+            }
+            text += ' ';
+            continue;
+        }
+
+        // Entities
+        if (this_char == '&')
+        {
+            const qsizetype entity_end = mcrHTML.indexOf(';', index);
+            if (entity_end != -1 &&
+                entity_end - index <= 8)
+            {
+                const QString entity =
+                    mcrHTML.mid(index + 1, entity_end - index - 1);
+                if (entities.contains(entity))
+                {
+                    text += entities[entity];
+                    index = entity_end + 1;
+                    continue;
+                }
+                if (entity.startsWith('#'))
+                {
+                    bool ok = false;
+                    const uint code = (entity.startsWith("#x") ?
+                        entity.mid(2).toUInt(&ok, 16) :
+                        entity.mid(1).toUInt(&ok));
+                    if (ok)
+                    {
+                        text += QString::fromUcs4(
+                            reinterpret_cast < const char32_t * >(&code), 1);
+                        index = entity_end + 1;
+                        continue;
+                    }
+                }
+            }
+        }
+
+        // Regular text
+        text += this_char;
+        index++;
+    }
+
+    CALL_OUT("");
+    return text;
+}
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// Words and their positions, for every text part of an email
+QList < QPair < int, QHash < QString, QList < int > > > >
+    EmailSearchIndex::ExtractTerms(const Email * mcpEmail)
+{
+    CALL_IN(QString("mcpEmail=%1")
+        .arg(CALL_SHOW(mcpEmail)));
+
+    QList < QPair < int, QHash < QString, QList < int > > > > ret;
+    for (int part_index = 0;
+         part_index < mcpEmail -> GetNumberOfParts();
+         part_index++)
+    {
+        // Get text
+        const QString type = mcpEmail -> GetPartType(part_index);
+        QString text;
+        if (type == "text/plain" ||
+            type == "text")
+        {
+            text = QString::fromUtf8(mcpEmail -> GetPart(part_index));
+        } else if (type == "text/html")
+        {
+            text = StripTags(QString::fromUtf8(
+                mcpEmail -> GetPart(part_index)));
+        } else
+        {
+            // Not indexed
+            continue;
+        }
+
+        // Words and positions
+        const QStringList tokens = Tokenize(text);
+        QHash < QString, QList < int > > terms;
+        for (int position = 0; position < tokens.size(); position++)
+        {
+            terms[tokens[position]] << position;
+        }
+        if (!terms.isEmpty())
+        {
+            ret << QPair < int, QHash < QString, QList < int > > >(
+                part_index, terms);
+        }
+    }
+
+    CALL_OUT("");
+    return ret;
+}
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// Add terms of one part to the index
+void EmailSearchIndex::AddDocument(const QString & mcrEmailKey,
+    const int mcPart, const QHash < QString, QList < int > > & mcrTerms)
+{
+    CALL_IN(QString("mcrEmailKey=%1, mcPart=%2, mcrTerms=...")
+        .arg(CALL_SHOW(mcrEmailKey),
+             CALL_SHOW(mcPart)));
+
+    // New document
+    const int document_id = m_Documents.size();
+    m_Documents << QPair < QString, int >(mcrEmailKey, mcPart);
+
+    // Postings format per document:
+    // document ID delta, number of positions, position deltas
+    for (auto term_iterator = mcrTerms.constBegin();
+         term_iterator != mcrTerms.constEnd();
+         term_iterator++)
+    {
+        const QString & term = term_iterator.key();
+        const QList < int > & positions = term_iterator.value();
+        QByteArray & postings = m_Postings[term];
+        const int last_document = m_LastDocument.value(term, -1);
+        AppendVarInt(postings, quint32(document_id - last_document));
+        AppendVarInt(postings, quint32(positions.size()));
+        int last_position = 0;
+        for (const int position : positions)
+        {
+            AppendVarInt(postings, quint32(position - last_position));
+            last_position = position;
+        }
+        m_LastDocument[term] = document_id;
+    }
+
+    CALL_OUT("");
+}
+
+
+
+// ===================================================================== Search
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// Search the index
+QList < QPair < QString, int > > EmailSearchIndex::Search(
+    const QString mcQuery) const
+{
+    CALL_IN(QString("mcQuery=%1")
+        .arg(CALL_SHOW(mcQuery)));
+
+    // Split query into phrases (quoted) and single words
+    QList < QStringList > phrases;
+    QString rest = mcQuery;
+    static const QRegularExpression format_phrase("\"([^\"]*)\"");
+    QRegularExpressionMatchIterator phrase_iterator =
+        format_phrase.globalMatch(mcQuery);
+    while (phrase_iterator.hasNext())
+    {
+        const QRegularExpressionMatch match = phrase_iterator.next();
+        const QStringList terms = Tokenize(match.captured(1));
+        if (!terms.isEmpty())
+        {
+            phrases << terms;
+        }
+    }
+    rest.remove(format_phrase);
+    const QStringList words = Tokenize(rest);
+    for (const QString & word : words)
+    {
+        phrases << QStringList(word);
+    }
+    if (phrases.isEmpty())
+    {
+        CALL_OUT("");
+        return QList < QPair < QString, int > >();
+    }
+
+    // All phrases have to match
+    QSet < int > documents = SearchPhrase(phrases.first());
+    for (int index = 1;
+         index < phrases.size() && !documents.isEmpty();
+         index++)
+    {
+        documents &= SearchPhrase(phrases[index]);
+    }
+
+    // Hits in index order
+    QList < int > sorted_documents(documents.begin(), documents.end());
+    std::sort(sorted_documents.begin(), sorted_documents.end());
+    QList < QPair < QString, int > > hits;
+    for (const int document_id : sorted_documents)
+    {
+        hits << m_Documents[document_id];
+    }
+
+    CALL_OUT("");
+    return hits;
+}
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// Decode postings of a term
+QHash < int, QList < int > > EmailSearchIndex::DecodePostings(
+    const QString & mcrTerm) const
+{
+    CALL_IN(QString("mcrTerm=%1")
+        .arg(CALL_SHOW(mcrTerm)));
+
+    QHash < int, QList < int > > ret;
+    const QByteArray postings = m_Postings.value(mcrTerm);
+    int position = 0;
+    int document_id = -1;
+    while (position < postings.size())
+    {
+        document_id += int(ReadVarInt(postings, position));
+        const int count = int(ReadVarInt(postings, position));
+        QList < int > & positions = ret[document_id];
+        positions.reserve(count);
+        int word_position = 0;
+        for (int index = 0; index < count; index++)
+        {
+            word_position += int(ReadVarInt(postings, position));
+            positions << word_position;
+        }
+    }
+
+    CALL_OUT("");
+    return ret;
+}
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// Documents containing the words at consecutive positions
+QSet < int > EmailSearchIndex::SearchPhrase(const QStringList & mcrTerms) const
+{
+    CALL_IN(QString("mcrTerms=%1")
+        .arg(CALL_SHOW(mcrTerms)));
+
+    // Postings of all words
+    QList < QHash < int, QList < int > > > postings;
+    for (const QString & term : mcrTerms)
+    {
+        if (!m_Postings.contains(term))
+        {
+            // Word is nowhere
+            CALL_OUT("");
+            return QSet < int >();
+        }
+        postings << DecodePostings(term);
+    }
+
+    // Documents with all words; for phrases, word n has to follow word n-1
+    QSet < int > ret;
+    for (auto document_iterator = postings.first().constBegin();
+         document_iterator != postings.first().constEnd();
+         document_iterator++)
+    {
+        const int document_id = document_iterator.key();
+        QSet < int > candidates(document_iterator.value().begin(),
+            document_iterator.value().end());
+        for (int index = 1;
+             index < postings.size() && !candidates.isEmpty();
+             index++)
+        {
+            if (!postings[index].contains(document_id))
+            {
+                candidates.clear();
+                break;
+            }
+            const QList < int > & positions = postings[index][document_id];
+            QSet < int > next_candidates;
+            for (const int word_position : positions)
+            {
+                if (candidates.contains(word_position - 1))
+                {
+                    next_candidates += word_position;
+                }
+            }
+            candidates = next_candidates;
+        }
+        if (!candidates.isEmpty())
+        {
+            ret += document_id;
+        }
+    }
+
+    CALL_OUT("");
+    return ret;
+}
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// Append variable length integer (7 bits per byte, high bit = more)
+void EmailSearchIndex::AppendVarInt(QByteArray & mrData, quint32 mValue)
+{
+    while (mValue >= 0x80)
+    {
+        mrData += char((mValue & 0x7f) | 0x80);
+        mValue >>= 7;
+    }
+    mrData += char(mValue);
+}
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// Read variable length integer
+quint32 EmailSearchIndex::ReadVarInt(const QByteArray & mcrData,
+    int & mrPosition)
+{
+    quint32 value = 0;
+    int shift = 0;
+    while (mrPosition < mcrData.size())
+    {
+        const quint8 this_byte = quint8(mcrData.at(mrPosition++));
+        value |= quint32(this_byte & 0x7f) << shift;
+        if (!(this_byte & 0x80))
+        {
+            break;
+        }
+        shift += 7;
+    }
+    return value;
+}
+
+
+
+// ================================================================ Persistence
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// Load the index from the index file
+bool EmailSearchIndex::Load()
+{
+    CALL_IN("");
+
+    // Open file
+    QFile in_file(m_IndexFilename);
+    if (!in_file.open(QIODevice::ReadOnly))
+    {
+        const QString reason = tr("File \"%1\" could not be opened.")
+            .arg(m_IndexFilename);
+        MessageLogger::Error(CALL_METHOD, reason);
+        CALL_OUT(reason);
+        return false;
+    }
+
+    // Check format
+    QDataStream in(&in_file);
+    quint32 magic = 0;
+    qint32 version = 0;
+    in >> magic >> version;
+    if (magic != INDEX_MAGIC ||
+        version != INDEX_VERSION)
+    {
+        const QString reason =
+            tr("File \"%1\" is not a search index (or has an incompatible "
+                "version).")
+                .arg(m_IndexFilename);
+        MessageLogger::Error(CALL_METHOD, reason);
+        CALL_OUT(reason);
+        return false;
+    }
+
+    // Read index
+    QList < QPair < QString, int > > documents;
+    QSet < QString > indexed_emails;
+    QHash < QString, QByteArray > postings;
+    QHash < QString, int > last_document;
+    in >> documents >> indexed_emails >> postings >> last_document;
+    if (in.status() != QDataStream::Ok)
+    {
+        const QString reason = tr("File \"%1\" is corrupt.")
+            .arg(m_IndexFilename);
+        MessageLogger::Error(CALL_METHOD, reason);
+        CALL_OUT(reason);
+        return false;
+    }
+    m_Documents = documents;
+    m_IndexedEmails = indexed_emails;
+    m_Postings = postings;
+    m_LastDocument = last_document;
+    m_IsModified = false;
+
+    CALL_OUT("");
+    return true;
+}
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// Save the index to the index file
+bool EmailSearchIndex::Save()
+{
+    CALL_IN("");
+
+    // Nothing to do if we only keep the index in memory
+    if (m_IndexFilename.isEmpty())
+    {
+        CALL_OUT("");
+        return true;
+    }
+
+    // Write to a temporary file first so a crash does not corrupt the index
+    QSaveFile out_file(m_IndexFilename);
+    if (!out_file.open(QIODevice::WriteOnly))
+    {
+        const QString reason = tr("File \"%1\" could not be opened.")
+            .arg(m_IndexFilename);
+        MessageLogger::Error(CALL_METHOD, reason);
+        CALL_OUT(reason);
+        return false;
+    }
+    QDataStream out(&out_file);
+    out << quint32(INDEX_MAGIC) << qint32(INDEX_VERSION);
+    out << m_Documents << m_IndexedEmails << m_Postings << m_LastDocument;
+    if (!out_file.commit())
+    {
+        const QString reason = tr("File \"%1\" could not be written.")
+            .arg(m_IndexFilename);
+        MessageLogger::Error(CALL_METHOD, reason);
+        CALL_OUT(reason);
+        return false;
+    }
+
+    m_IsModified = false;
+
+    CALL_OUT("");
+    return true;
+}
@@ -0,0 +1,171 @@
+// EmailSearchIndex.h
+// Class definition file
+
+/** \class EmailSearchIndex
+  * Full-text search index over email bodies
+  *
+  * Text parts of emails (text/plain directly, text/html after stripping
+  * tags) are split into case-folded words. For every word, the index keeps
+  * a postings list of the parts it appears in and at which positions, so
+  * that both AND queries and phrase queries can be answered without
+  * scanning any email text.
+  *
+  * Postings are kept compressed (delta-encoded variable length integers),
+  * both in memory and in the index file. Emails can be added at any time;
+  * emails that are already in the index are skipped.
+  */
+
+// Just include once
+#ifndef EMAILSEARCHINDEX_H
+#define EMAILSEARCHINDEX_H
+
+// Qt includes
+#include <QByteArray>
+#include <QHash>
+#include <QList>
+#include <QObject>
+#include <QPair>
+#include <QSet>
+#include <QString>
+#include <QStringList>
+
+// Forward declarations
+class Email;
+
+// Class definition
+class EmailSearchIndex :
+    public QObject
+{
+    Q_OBJECT
+
+
+
+    // ============================================================== Lifecycle
+public:
+    /** \brief Constructor
+      * \param mcIndexFilename Filename of the index. If the file exists, the
+      * index is loaded from it. Leave empty to keep the index in memory only.
+      */
+    EmailSearchIndex(const QString mcIndexFilename = QString());
+
+    /** \brief Destructor
+      */
+    ~EmailSearchIndex();
+
+
+
+    // =============================================================== Indexing
+public:
+    /** \brief Key identifying an email in the index
+      * \returns Source filename and line number of the email
+      */
+    static QString GetEmailKey(const Email * mcpEmail);
+
+    /** \brief Add a single email to the index
+      * \param mcpEmail Email to add; ignored if already indexed
+      */
+    void AddEmail(const Email * mcpEmail);
+
+    /** \brief Add several emails to the index
+      * \details Text extraction and tokenization run in parallel; the
+      * results are merged into the index in the order of the list.
+      * \param mcrEmails Emails to add; emails already indexed are ignored
+      * \param mcMaxThreads Maximum number of threads; \c 0 uses the number
+      * of CPU cores, \c 1 extracts in the calling thread
+      */
+    void AddEmails(const QList < Email * > & mcrEmails,
+        const int mcMaxThreads = 0);
+
+    /** \brief Check if an email has already been indexed
+      */
+    bool ContainsEmail(const QString & mcrEmailKey) const;
+
+    /** \brief Number of indexed email parts
+      */
+    int GetNumberOfDocuments() const;
+
+    /** \brief Number of distinct words
+      */
+    int GetNumberOfTerms() const;
+
+    /** \brief Split text into case-folded words
+      */
+    static QStringList Tokenize(const QString & mcrText);
+
+    /** \brief Remove HTML tags, scripts, styles and common entities
+      * \details Single pass over the text, unlike
+      * StringHelper::StripHTMLTags().
+      */
+    static QString StripTags(const QString & mcrHTML);
+
+private:
+    /** \brief Words and their positions, for every text part of an email
+      */
+    static QList < QPair < int, QHash < QString, QList < int > > > >
+        ExtractTerms(const Email * mcpEmail);
+
+    /** \brief Add terms of one part to the index
+      */
+    void AddDocument(const QString & mcrEmailKey, const int mcPart,
+        const QHash < QString, QList < int > > & mcrTerms);
+
+    // Document ID to email key and part
+    QList < QPair < QString, int > > m_Documents;
+
+    // Emails in the index
+    QSet < QString > m_IndexedEmails;
+
+    // Compressed postings per term
+    QHash < QString, QByteArray > m_Postings;
+
+    // Last document ID per term (for delta encoding)
+    QHash < QString, int > m_LastDocument;
+
+    // Modified since last save
+    bool m_IsModified;
+
+
+
+    // ================================================================= Search
+public:
+    /** \brief Search the index
+      * \param mcQuery Words that must all appear; text in double quotes
+      * must appear as a phrase, e.g. <tt>invoice "order number"</tt>
+      * \returns Email keys and part indices of all matching parts
+      */
+    QList < QPair < QString, int > > Search(const QString mcQuery) const;
+
+private:
+    /** \brief Decode postings of a term
+      * \returns Document ID to positions
+      */
+    QHash < int, QList < int > > DecodePostings(const QString & mcrTerm) const;
+
+    /** \brief Documents containing the words at consecutive positions
+      */
+    QSet < int > SearchPhrase(const QStringList & mcrTerms) const;
+
+    // Variable length integer encoding
+    static void AppendVarInt(QByteArray & mrData, quint32 mValue);
+    static quint32 ReadVarInt(const QByteArray & mcrData, int & mrPosition);
+
+
+
+    // ============================================================ Persistence
+public:
+    /** \brief Load the index from the index file
+      * \returns \c true on success
+      */
+    bool Load();
+
+    /** \brief Save the index to the index file
+      * \returns \c true on success
+      */
+    bool Save();
+
+private:
+    // Filename of the index
+    QString m_IndexFilename;
+};
+
+#endif
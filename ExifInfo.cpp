@@ -7,20 +7,32 @@
 #include "ExifInfo.h"
 
 // Qt includes
+#include <QDataStream>
 #include <QDateTime>
 #include <QDebug>
+#include <QFile>
+#include <QFileInfo>
 #include <QImage>
 #include <QObject>
 #include <QRegularExpression>
+#include <QThread>
+#include <QThreadPool>
+#include <QtConcurrent>
+#include <QtEndian>
 
 // Exiv info
 #include <exiv2/exiv2.hpp>
 
 // System includes
 #include <cmath>
+#include <cstring>
+#include <limits>
 
 // STL includes
+#include <algorithm>
+#include <iterator>
 #include <string>
+#include <string_view>
 
 
 
@@ -28,6 +40,10 @@
 #define DEBUG false
 #define DEBUG_LEVEL 1
 
+// Cache file format (version 3: ISO rating of multi-valued entries)
+#define CACHE_MAGIC 0x45584946
+#define CACHE_VERSION 3
+
 
 
 // ================================================================== Lifecycle
@@ -36,7 +52,8 @@
 
 ///////////////////////////////////////////////////////////////////////////////
 // Constructor (never to be called from the outside)
-ExifInfo::ExifInfo()
+ExifInfo::ExifInfo() :
+    m_HasCompressedTags(false)
 {
     CALL_IN("");
     REGISTER_INSTANCE;
@@ -64,66 +81,92 @@ ExifInfo::~ExifInfo()
 
 ///////////////////////////////////////////////////////////////////////////////
 // Factory
-ExifInfo * ExifInfo::CreateExifInfo(const QString & mcrFilename)
+ExifInfo * ExifInfo::CreateExifInfo(const QString & mcrFilename,
+    const bool mcIncludeMakerNotes)
 {
-    CALL_IN(QString("mcFilename=%1")
-        .arg(CALL_SHOW(mcrFilename)));
+    CALL_IN(QString("mcFilename=%1, mcIncludeMakerNotes=%2")
+        .arg(CALL_SHOW(mcrFilename),
+             CALL_SHOW(mcIncludeMakerNotes)));
 
     ExifInfo * info = nullptr;
-    try
+
+    // Try reading the file ourselves first
+    if (!mcIncludeMakerNotes)
     {
-        auto image =
-            Exiv2::ImageFactory::open(mcrFilename.toLocal8Bit().data());
-        image -> readMetadata();
-        if (!image -> good())
+        info = new ExifInfo();
+        info -> m_Filename = mcrFilename;
+        if (!info -> ReadNativeExif())
         {
-            // Something didn't work reading the file; probably not an image
-            CALL_OUT("");
-            return nullptr;
+            // Not a format we can read; Exiv2 may do better
+            delete info;
+            info = nullptr;
+        } else if (info -> NeedsMakerNotes())
+        {
+            // Some getters use maker notes of this camera
+            delete info;
+            info = nullptr;
         }
+    }
 
-        Exiv2::ExifData & data = image -> exifData();
-        if (data.empty())
+    if (!info)
+    {
+        try
         {
-            // Not really an error, just no EXIF data
-            CALL_OUT("");
-            return nullptr;
-        }
+            auto image =
+                Exiv2::ImageFactory::open(mcrFilename.toLocal8Bit().data());
+            image -> readMetadata();
+            if (!image -> good())
+            {
+                // Something didn't work reading the file; probably not an
+                // image
+                CALL_OUT("");
+                return nullptr;
+            }
 
-        // Return value
-        info = new ExifInfo();
+            Exiv2::ExifData & data = image -> exifData();
+            if (data.empty())
+            {
+                // Not really an error, just no EXIF data
+                CALL_OUT("");
+                return nullptr;
+            }
 
-        // Store filename
-        info -> m_Filename = mcrFilename;
+            // Return value
+            info = new ExifInfo();
 
-        // MIME type
-        info -> m_MIMEType = image -> mimeType().c_str();
+            // Store filename
+            info -> m_Filename = mcrFilename;
 
-        // Get all tags
-        for (auto tag_iterator = data.begin();
-             tag_iterator != data.end();
-             tag_iterator++)
+            // MIME type
+            info -> m_MIMEType = image -> mimeType().c_str();
+
+            // Get all tags
+            for (auto tag_iterator = data.begin();
+                 tag_iterator != data.end();
+                 tag_iterator++)
+            {
+                const QString group = tag_iterator -> groupName().c_str();
+                const QString tag = tag_iterator -> tagName().c_str();
+                const QString type = tag_iterator -> typeName();
+                const QString value =
+                    tag_iterator -> value().toString().c_str();
+                info -> m_ExifTypes[group][tag] = type;
+                info -> m_ExifData[group][tag] = value;
+            }
+
+        }
+        catch (Exiv2::Error error)
         {
-            const QString group = tag_iterator -> groupName().c_str();
-            const QString tag = tag_iterator -> tagName().c_str();
-            const QString type = tag_iterator -> typeName();
-            const QString value = tag_iterator -> value().toString().c_str();
-            info -> m_ExifTypes[group][tag] = type;
-            info -> m_ExifData[group][tag] = value;
+            // A (fatal) error while reading the file
+            const QString reason =
+                tr("An error occurred while reading the EXIF info of "
+                    "\"%1\":\n\t%2")
+                    .arg(mcrFilename,
+                         error.what());
+            MessageLogger::Error(CALL_METHOD, reason);
+            CALL_OUT(reason);
+            return nullptr;
         }
-
-    }
-    catch (Exiv2::Error error)
-    {
-        // A (fatal) error while reading the file
-        const QString reason =
-            tr("An error occurred while reading the EXIF info of \"%1\":\n"
-                "\t%2")
-                .arg(mcrFilename,
-                     error.what());
-        MessageLogger::Error(CALL_METHOD, reason);
-        CALL_OUT(reason);
-        return nullptr;
     }
 
     if (DEBUG &&
@@ -132,8 +175,14 @@ ExifInfo * ExifInfo::CreateExifInfo(const QString & mcrFilename)
         info -> Dump();
     }
 
+    // Decode frequently used values
+    info -> DecodeRecord();
+
     // Register all tags
-    info -> RegisterData();
+    if (m_CollectStatistics.load(std::memory_order_relaxed))
+    {
+        info -> RegisterData();
+    }
 
     // No info if there are no data
     if (info -> m_ExifData.isEmpty())
@@ -148,6 +197,624 @@ ExifInfo * ExifInfo::CreateExifInfo(const QString & mcrFilename)
 
 
 
+// ============================================================== Native Reader
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// TIFF structure being read
+struct ExifInfo::TIFFData
+{
+    // Start of the TIFF header (all offsets are relative to it)
+    const uchar * m_Data;
+
+    // Size of the TIFF structure
+    quint32 m_Size;
+
+    // Byte order ("MM" vs. "II")
+    bool m_IsBigEndian;
+
+    // Unsigned 16 bit value at an offset
+    quint16 Get16(const quint32 mcOffset) const
+    {
+        return m_IsBigEndian ?
+            qFromBigEndian < quint16 >(m_Data + mcOffset) :
+            qFromLittleEndian < quint16 >(m_Data + mcOffset);
+    }
+
+    // Unsigned 32 bit value at an offset
+    quint32 Get32(const quint32 mcOffset) const
+    {
+        return m_IsBigEndian ?
+            qFromBigEndian < quint32 >(m_Data + mcOffset) :
+            qFromLittleEndian < quint32 >(m_Data + mcOffset);
+    }
+
+    // Check if a range lies within the TIFF structure
+    bool Contains(const quint32 mcOffset, const quint64 mcLength) const
+    {
+        return mcOffset + mcLength <= m_Size;
+    }
+};
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// Read standard EXIF tags without Exiv2
+bool ExifInfo::ReadNativeExif()
+{
+    CALL_IN("");
+
+    // MIME types (as reported by Exiv2) of the TIFF based formats we read
+    static const QHash < QString, QString > tiff_mime_types
+    {
+        { "tif", "image/tiff" },
+        { "tiff", "image/tiff" },
+        { "arw", "image/x-sony-arw" },
+        { "cr2", "image/x-canon-cr2" },
+        { "dng", "image/x-adobe-dng" },
+        { "nef", "image/x-nikon-nef" },
+        { "pef", "image/x-pentax-pef" },
+        { "srw", "image/x-samsung-srw" },
+    };
+    const QString suffix = QFileInfo(m_Filename).suffix().toLower();
+    const bool is_jpeg = (suffix == "jpg" || suffix == "jpeg");
+    if (!is_jpeg &&
+        !tiff_mime_types.contains(suffix))
+    {
+        // Leave it to Exiv2
+        CALL_OUT("");
+        return false;
+    }
+
+    // Map the file; only the pages we actually look at will be read
+    QFile file(m_Filename);
+    if (!file.open(QIODevice::ReadOnly))
+    {
+        CALL_OUT("");
+        return false;
+    }
+    const qint64 file_size = file.size();
+    if (file_size < 8 ||
+        file_size > std::numeric_limits < quint32 >::max())
+    {
+        CALL_OUT("");
+        return false;
+    }
+    const uchar * data = file.map(0, file_size);
+    if (!data)
+    {
+        CALL_OUT("");
+        return false;
+    }
+
+    // Locate the TIFF structure
+    TIFFData tiff;
+    tiff.m_Data = nullptr;
+    tiff.m_Size = 0;
+    tiff.m_IsBigEndian = false;
+    if (is_jpeg)
+    {
+        if (data[0] != 0xff ||
+            data[1] != 0xd8)
+        {
+            // Not a JPEG file after all
+            CALL_OUT("");
+            return false;
+        }
+
+        // Walk the segments up to the image data, looking for APP1 "Exif"
+        qint64 position = 2;
+        while (position + 4 <= file_size)
+        {
+            if (data[position] != 0xff)
+            {
+                // Corrupt; let Exiv2 deal with it
+                CALL_OUT("");
+                return false;
+            }
+            const uchar marker = data[position + 1];
+            if (marker == 0xff)
+            {
+                // Fill byte
+                position++;
+                continue;
+            }
+            if (marker == 0x01 ||
+                (marker >= 0xd0 && marker <= 0xd8))
+            {
+                // Markers without a payload
+                position += 2;
+                continue;
+            }
+            if (marker == 0xd9 ||
+                marker == 0xda)
+            {
+                // End of image or start of scan: no EXIF data
+                break;
+            }
+            const quint16 length = qFromBigEndian < quint16 >(
+                data + position + 2);
+            if (length < 2 ||
+                position + 2 + length > file_size)
+            {
+                CALL_OUT("");
+                return false;
+            }
+            if (marker == 0xe1 &&
+                length >= 16 &&
+                memcmp(data + position + 4, "Exif\0\0", 6) == 0)
+            {
+                tiff.m_Data = data + position + 10;
+                tiff.m_Size = length - 8;
+                break;
+            }
+            position += 2 + length;
+        }
+        m_MIMEType = "image/jpeg";
+
+        if (!tiff.m_Data)
+        {
+            // A JPEG file without EXIF data
+            CALL_OUT("");
+            return true;
+        }
+    } else
+    {
+        tiff.m_Data = data;
+        tiff.m_Size = quint32(file_size);
+        m_MIMEType = tiff_mime_types[suffix];
+    }
+
+    // TIFF header: byte order, magic number 42, offset of IFD0
+    if (tiff.m_Size < 8)
+    {
+        CALL_OUT("");
+        return false;
+    }
+    if (tiff.m_Data[0] == 'M' &&
+        tiff.m_Data[1] == 'M')
+    {
+        tiff.m_IsBigEndian = true;
+    } else if (tiff.m_Data[0] == 'I' &&
+        tiff.m_Data[1] == 'I')
+    {
+        tiff.m_IsBigEndian = false;
+    } else
+    {
+        CALL_OUT("");
+        return false;
+    }
+    if (tiff.Get16(2) != 42)
+    {
+        // Includes TIFF variants like ORF and RW2
+        CALL_OUT("");
+        return false;
+    }
+
+    // IFD0 and the EXIF and GPS IFDs it points to
+    if (!ReadNativeIFD(tiff, tiff.Get32(4), "Image"))
+    {
+        CALL_OUT("");
+        return false;
+    }
+    const QHash < QString, QString > image = m_ExifData.value("Image");
+    if (image.contains("ExifTag") &&
+        !ReadNativeIFD(tiff, image["ExifTag"].toUInt(), "Photo"))
+    {
+        CALL_OUT("");
+        return false;
+    }
+    if (image.contains("GPSTag") &&
+        !ReadNativeIFD(tiff, image["GPSTag"].toUInt(), "GPSInfo"))
+    {
+        CALL_OUT("");
+        return false;
+    }
+
+    CALL_OUT("");
+    return true;
+}
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// Check if getters need maker notes, which only Exiv2 reads
+bool ExifInfo::NeedsMakerNotes() const
+{
+    CALL_IN("");
+
+    // Lens, subject distance and camera temperature of Canon and Nikon
+    // cameras come from the maker notes (CanonCs, CanonCs2, CanonSi, Nikon3)
+    const QString make = m_ExifData.value("Image").value("Make").trimmed();
+    const bool needs_maker_notes =
+        make.startsWith("Canon", Qt::CaseInsensitive) ||
+        make.startsWith("Nikon", Qt::CaseInsensitive);
+
+    CALL_OUT("");
+    return needs_maker_notes;
+}
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// Read tags of one IFD
+bool ExifInfo::ReadNativeIFD(const TIFFData & mcrTIFF, const quint32 mcOffset,
+    const QString & mcrGroup)
+{
+    CALL_IN(QString("mcrTIFF=..., mcOffset=%1, mcrGroup=%2")
+        .arg(CALL_SHOW(qint64(mcOffset)),
+             CALL_SHOW(mcrGroup)));
+
+    // Size of one value per TIFF type
+    static const int type_sizes[] = { 0, 1, 1, 2, 4, 8, 1, 1, 2, 4, 8, 4, 8 };
+    static const char * const type_names[] = { "", "Byte", "Ascii", "Short",
+        "Long", "Rational", "SByte", "Undefined", "SShort", "SLong",
+        "SRational", "Float", "Double" };
+    const int number_of_types = sizeof(type_sizes) / sizeof(type_sizes[0]);
+
+    if (!mcrTIFF.Contains(mcOffset, 2))
+    {
+        CALL_OUT("");
+        return false;
+    }
+    const quint16 number_of_entries = mcrTIFF.Get16(mcOffset);
+    if (!mcrTIFF.Contains(mcOffset + 2, number_of_entries * 12))
+    {
+        CALL_OUT("");
+        return false;
+    }
+
+    for (quint16 entry = 0; entry < number_of_entries; entry++)
+    {
+        const quint32 entry_offset = mcOffset + 2 + entry * 12;
+        const quint16 tag = mcrTIFF.Get16(entry_offset);
+        const quint16 type = mcrTIFF.Get16(entry_offset + 2);
+        const quint32 count = mcrTIFF.Get32(entry_offset + 4);
+        if (type == 0 ||
+            type >= number_of_types)
+        {
+            // Unknown type; Exiv2 skips these, too
+            continue;
+        }
+
+        // Maker notes are left to Exiv2 (see CreateExifInfo())
+        if (mcrGroup == "Photo" &&
+            tag == 0x927c)
+        {
+            continue;
+        }
+
+        // Values of up to 4 bytes are stored in the entry itself
+        const quint64 length = quint64(count) * type_sizes[type];
+        const quint32 value_offset =
+            (length <= 4 ? entry_offset + 8 : mcrTIFF.Get32(entry_offset + 8));
+        if (!mcrTIFF.Contains(value_offset, length))
+        {
+            // Broken entry; ignore it
+            continue;
+        }
+
+        const QString name = GetNativeTagName(mcrGroup, tag);
+        m_ExifTypes[mcrGroup][name] = type_names[type];
+        m_ExifData[mcrGroup][name] =
+            FormatNativeValue(mcrTIFF, type, count, value_offset);
+    }
+
+    CALL_OUT("");
+    return true;
+}
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// Tag value, formatted like Exiv2 does
+QString ExifInfo::FormatNativeValue(const TIFFData & mcrTIFF,
+    const quint16 mcType, const quint32 mcCount, const quint32 mcOffset)
+{
+    CALL_IN(QString("mcrTIFF=..., mcType=%1, mcCount=%2, mcOffset=%3")
+        .arg(CALL_SHOW(mcType),
+             CALL_SHOW(qint64(mcCount)),
+             CALL_SHOW(qint64(mcOffset))));
+
+    const uchar * value = mcrTIFF.m_Data + mcOffset;
+
+    // Strings end at the first NUL
+    if (mcType == 2)
+    {
+        const char * text = reinterpret_cast < const char * >(value);
+        const int length = int(qstrnlen(text, mcCount));
+        CALL_OUT("");
+        return QString::fromUtf8(text, length);
+    }
+
+    // Everything else is a list of numbers
+    QStringList values;
+    for (quint32 index = 0; index < mcCount; index++)
+    {
+        switch (mcType)
+        {
+        case 1:
+            // Byte
+            // Falls thru
+        case 7:
+            // Undefined
+            values << QString::number(value[index]);
+            break;
+
+        case 3:
+            // Short
+            values << QString::number(mcrTIFF.Get16(mcOffset + 2 * index));
+            break;
+
+        case 4:
+            // Long
+            values << QString::number(mcrTIFF.Get32(mcOffset + 4 * index));
+            break;
+
+        case 5:
+            // Rational
+            values << QString("%1/%2")
+                .arg(QString::number(mcrTIFF.Get32(mcOffset + 8 * index)),
+                     QString::number(
+                         mcrTIFF.Get32(mcOffset + 8 * index + 4)));
+            break;
+
+        case 6:
+            // SByte
+            values << QString::number(qint8(value[index]));
+            break;
+
+        case 8:
+            // SShort
+            values << QString::number(
+                qint16(mcrTIFF.Get16(mcOffset + 2 * index)));
+            break;
+
+        case 9:
+            // SLong
+            values << QString::number(
+                qint32(mcrTIFF.Get32(mcOffset + 4 * index)));
+            break;
+
+        case 10:
+            // SRational
+            values << QString("%1/%2")
+                .arg(QString::number(
+                         qint32(mcrTIFF.Get32(mcOffset + 8 * index))),
+                     QString::number(
+                         qint32(mcrTIFF.Get32(mcOffset + 8 * index + 4))));
+            break;
+
+        case 11:
+        {
+            // Float
+            const quint32 bits = mcrTIFF.Get32(mcOffset + 4 * index);
+            float number;
+            memcpy(&number, &bits, sizeof(number));
+            values << QString::number(number);
+            break;
+        }
+
+        case 12:
+        {
+            // Double
+            const quint64 bits =
+                (quint64(mcrTIFF.Get32(mcOffset + 8 * index +
+                    (mcrTIFF.m_IsBigEndian ? 0 : 4))) << 32) |
+                mcrTIFF.Get32(mcOffset + 8 * index +
+                    (mcrTIFF.m_IsBigEndian ? 4 : 0));
+            double number;
+            memcpy(&number, &bits, sizeof(number));
+            values << QString::number(number);
+            break;
+        }
+        }
+    }
+
+    CALL_OUT("");
+    return values.join(" ");
+}
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// Tag name, as used by Exiv2
+QString ExifInfo::GetNativeTagName(const QString & mcrGroup,
+    const quint16 mcTag)
+{
+    CALL_IN(QString("mcrGroup=%1, mcTag=%2")
+        .arg(CALL_SHOW(mcrGroup),
+             CALL_SHOW(mcTag)));
+
+    // Tag numbers and names (sorted by number)
+    struct TagName
+    {
+        quint16 m_Tag;
+        const char * m_Name;
+    };
+    static const TagName image_tags[] =
+    {
+        { 0x00fe, "NewSubfileType" },
+        { 0x0100, "ImageWidth" },
+        { 0x0101, "ImageLength" },
+        { 0x0102, "BitsPerSample" },
+        { 0x0103, "Compression" },
+        { 0x0106, "PhotometricInterpretation" },
+        { 0x010e, "ImageDescription" },
+        { 0x010f, "Make" },
+        { 0x0110, "Model" },
+        { 0x0111, "StripOffsets" },
+        { 0x0112, "Orientation" },
+        { 0x0115, "SamplesPerPixel" },
+        { 0x0116, "RowsPerStrip" },
+        { 0x0117, "StripByteCounts" },
+        { 0x011a, "XResolution" },
+        { 0x011b, "YResolution" },
+        { 0x011c, "PlanarConfiguration" },
+        { 0x0128, "ResolutionUnit" },
+        { 0x0131, "Software" },
+        { 0x0132, "DateTime" },
+        { 0x013b, "Artist" },
+        { 0x013e, "WhitePoint" },
+        { 0x013f, "PrimaryChromaticities" },
+        { 0x014a, "SubIFDs" },
+        { 0x0201, "JPEGInterchangeFormat" },
+        { 0x0202, "JPEGInterchangeFormatLength" },
+        { 0x0211, "YCbCrCoefficients" },
+        { 0x0213, "YCbCrPositioning" },
+        { 0x0214, "ReferenceBlackWhite" },
+        { 0x02bc, "XMLPacket" },
+        { 0x8298, "Copyright" },
+        { 0x83bb, "IPTCNAA" },
+        { 0x8769, "ExifTag" },
+        { 0x8825, "GPSTag" },
+        { 0xc4a5, "PrintImageMatching" },
+        { 0xc612, "DNGVersion" },
+        { 0xc613, "DNGBackwardVersion" },
+        { 0xc614, "UniqueCameraModel" },
+    };
+    static const TagName photo_tags[] =
+    {
+        { 0x829a, "ExposureTime" },
+        { 0x829d, "FNumber" },
+        { 0x8822, "ExposureProgram" },
+        { 0x8824, "SpectralSensitivity" },
+        { 0x8827, "ISOSpeedRatings" },
+        { 0x8830, "SensitivityType" },
+        { 0x8831, "StandardOutputSensitivity" },
+        { 0x8832, "RecommendedExposureIndex" },
+        { 0x8833, "ISOSpeed" },
+        { 0x9000, "ExifVersion" },
+        { 0x9003, "DateTimeOriginal" },
+        { 0x9004, "DateTimeDigitized" },
+        { 0x9010, "OffsetTime" },
+        { 0x9011, "OffsetTimeOriginal" },
+        { 0x9012, "OffsetTimeDigitized" },
+        { 0x9101, "ComponentsConfiguration" },
+        { 0x9102, "CompressedBitsPerPixel" },
+        { 0x9201, "ShutterSpeedValue" },
+        { 0x9202, "ApertureValue" },
+        { 0x9203, "BrightnessValue" },
+        { 0x9204, "ExposureBiasValue" },
+        { 0x9205, "MaxApertureValue" },
+        { 0x9206, "SubjectDistance" },
+        { 0x9207, "MeteringMode" },
+        { 0x9208, "LightSource" },
+        { 0x9209, "Flash" },
+        { 0x920a, "FocalLength" },
+        { 0x9214, "SubjectArea" },
+        { 0x927c, "MakerNote" },
+        { 0x9286, "UserComment" },
+        { 0x9290, "SubSecTime" },
+        { 0x9291, "SubSecTimeOriginal" },
+        { 0x9292, "SubSecTimeDigitized" },
+        { 0xa000, "FlashpixVersion" },
+        { 0xa001, "ColorSpace" },
+        { 0xa002, "PixelXDimension" },
+        { 0xa003, "PixelYDimension" },
+        { 0xa004, "RelatedSoundFile" },
+        { 0xa005, "InteroperabilityTag" },
+        { 0xa20e, "FocalPlaneXResolution" },
+        { 0xa20f, "FocalPlaneYResolution" },
+        { 0xa210, "FocalPlaneResolutionUnit" },
+        { 0xa215, "ExposureIndex" },
+        { 0xa217, "SensingMethod" },
+        { 0xa300, "FileSource" },
+        { 0xa301, "SceneType" },
+        { 0xa302, "CFAPattern" },
+        { 0xa401, "CustomRendered" },
+        { 0xa402, "ExposureMode" },
+        { 0xa403, "WhiteBalance" },
+        { 0xa404, "DigitalZoomRatio" },
+        { 0xa405, "FocalLengthIn35mmFilm" },
+        { 0xa406, "SceneCaptureType" },
+        { 0xa407, "GainControl" },
+        { 0xa408, "Contrast" },
+        { 0xa409, "Saturation" },
+        { 0xa40a, "Sharpness" },
+        { 0xa40c, "SubjectDistanceRange" },
+        { 0xa420, "ImageUniqueID" },
+        { 0xa430, "CameraOwnerName" },
+        { 0xa431, "BodySerialNumber" },
+        { 0xa432, "LensSpecification" },
+        { 0xa433, "LensMake" },
+        { 0xa434, "LensModel" },
+        { 0xa435, "LensSerialNumber" },
+    };
+    static const TagName gps_tags[] =
+    {
+        { 0x0000, "GPSVersionID" },
+        { 0x0001, "GPSLatitudeRef" },
+        { 0x0002, "GPSLatitude" },
+        { 0x0003, "GPSLongitudeRef" },
+        { 0x0004, "GPSLongitude" },
+        { 0x0005, "GPSAltitudeRef" },
+        { 0x0006, "GPSAltitude" },
+        { 0x0007, "GPSTimeStamp" },
+        { 0x0008, "GPSSatellites" },
+        { 0x0009, "GPSStatus" },
+        { 0x000a, "GPSMeasureMode" },
+        { 0x000b, "GPSDOP" },
+        { 0x000c, "GPSSpeedRef" },
+        { 0x000d, "GPSSpeed" },
+        { 0x000e, "GPSTrackRef" },
+        { 0x000f, "GPSTrack" },
+        { 0x0010, "GPSImgDirectionRef" },
+        { 0x0011, "GPSImgDirection" },
+        { 0x0012, "GPSMapDatum" },
+        { 0x0013, "GPSDestLatitudeRef" },
+        { 0x0014, "GPSDestLatitude" },
+        { 0x0015, "GPSDestLongitudeRef" },
+        { 0x0016, "GPSDestLongitude" },
+        { 0x0017, "GPSDestBearingRef" },
+        { 0x0018, "GPSDestBearing" },
+        { 0x0019, "GPSDestDistanceRef" },
+        { 0x001a, "GPSDestDistance" },
+        { 0x001b, "GPSProcessingMethod" },
+        { 0x001c, "GPSAreaInformation" },
+        { 0x001d, "GPSDateStamp" },
+        { 0x001e, "GPSDifferential" },
+        { 0x001f, "GPSHPositioningError" },
+    };
+
+    // Pick table
+    const TagName * first = nullptr;
+    const TagName * last = nullptr;
+    if (mcrGroup == "Image")
+    {
+        first = std::begin(image_tags);
+        last = std::end(image_tags);
+    } else if (mcrGroup == "Photo")
+    {
+        first = std::begin(photo_tags);
+        last = std::end(photo_tags);
+    } else if (mcrGroup == "GPSInfo")
+    {
+        first = std::begin(gps_tags);
+        last = std::end(gps_tags);
+    }
+
+    // Look up tag
+    const TagName * found = std::lower_bound(first, last, mcTag,
+        [](const TagName & mcrTagName, const quint16 mcValue)
+        {
+            return mcrTagName.m_Tag < mcValue;
+        });
+    if (found != last &&
+        found -> m_Tag == mcTag)
+    {
+        CALL_OUT("");
+        return QString(found -> m_Name);
+    }
+
+    // Unknown tags are named by number (like Exiv2 does)
+    CALL_OUT("");
+    return QString("0x%1").arg(mcTag, 4, 16, QChar('0'));
+}
+
+
+
 // =========================================================== EXIF Data Access
 
 
@@ -158,6 +825,8 @@ QString ExifInfo::GetMIMEType() const
 {
     CALL_IN("");
 
+    LoadTags();
+
     CALL_OUT("");
     return m_MIMEType;
 }
@@ -172,6 +841,8 @@ bool ExifInfo::HasTag(const QString & mcrGroup, const QString & mcrTag) const
         .arg(CALL_SHOW(mcrGroup),
              CALL_SHOW(mcrTag)));
 
+    LoadTags();
+
     const bool exists =
         m_ExifData.contains(mcrGroup) &&
         m_ExifData[mcrGroup].contains(mcrTag);
@@ -192,6 +863,8 @@ QString ExifInfo::GetValue(const QString & mcrGroup,
              CALL_SHOW(mcrTag),
              CALL_SHOW(mcrDefault)));
 
+    LoadTags();
+
     QString value = mcrDefault;
     if (m_ExifData.contains(mcrGroup) &&
         m_ExifData[mcrGroup].contains(mcrTag))
@@ -215,6 +888,8 @@ QString ExifInfo::GetCameraMaker() const
 {
     CALL_IN("");
 
+    LoadTags();
+
     if (!m_ExifData.contains("Image") ||
         !m_ExifData["Image"].contains("Make"))
     {
@@ -234,10 +909,11 @@ QString ExifInfo::GetCameraMaker() const
     }
 
     // Post-Process
-    if (m_CameraMakerMapper.contains(make))
+    QString mapped_make;
+    if (LookUpMapper(MapperCameraMaker, make, mapped_make))
     {
         // Known camera maker
-        make = m_CameraMakerMapper[make];
+        make = mapped_make;
     } else
     {
         // Check unknown maker
@@ -259,6 +935,8 @@ QString ExifInfo::GetCameraModel() const
 {
     CALL_IN("");
 
+    LoadTags();
+
     if (!m_ExifData.contains("Image") ||
         !m_ExifData["Image"].contains("Model"))
     {
@@ -279,10 +957,11 @@ QString ExifInfo::GetCameraModel() const
     }
 
     // Post-Process
-    if (m_CameraModelMapper.contains(model))
+    QString mapped_model;
+    if (LookUpMapper(MapperCameraModel, model, mapped_model))
     {
         // Known camera model
-        model = m_CameraModelMapper[model];
+        model = mapped_model;
     } else
     {
         // Check unknown model
@@ -304,6 +983,8 @@ bool ExifInfo::IsCameraModelKnown() const
 {
     CALL_IN("");
 
+    LoadTags();
+
     // Make
     if (!m_ExifData.contains("Image") ||
         !m_ExifData["Image"].contains("Make"))
@@ -314,7 +995,7 @@ bool ExifInfo::IsCameraModelKnown() const
         return true;
     }
     const QString make = m_ExifData["Image"]["Make"].trimmed();
-    if (!m_CameraMakerMapper.contains(make))
+    if (!IsInMapper(MapperCameraMaker, make))
     {
         // Unknown camera make
         CALL_OUT("");
@@ -331,7 +1012,7 @@ bool ExifInfo::IsCameraModelKnown() const
     }
     QString model =
         GetCameraMaker() + "." + m_ExifData["Image"]["Model"].trimmed();
-    if (!m_CameraModelMapper.contains(model))
+    if (!IsInMapper(MapperCameraModel, model))
     {
         // Unknown camera model
         CALL_OUT("");
@@ -355,6 +1036,8 @@ QString ExifInfo::GetLensMaker() const
 {
     CALL_IN("");
 
+    LoadTags();
+
     if (!m_ExifData.contains("Photo") ||
         !m_ExifData["Photo"].contains("LensMake"))
     {
@@ -374,10 +1057,11 @@ QString ExifInfo::GetLensMaker() const
     }
 
     // Post-Process
-    if (m_LensMakerMapper.contains(make))
+    QString mapped_make;
+    if (LookUpMapper(MapperLensMaker, make, mapped_make))
     {
         // Known lens maker
-        make = m_LensMakerMapper[make];
+        make = mapped_make;
     } else
     {
         // Check unknown maker
@@ -399,6 +1083,8 @@ QString ExifInfo::GetLensModel() const
 {
     CALL_IN("");
 
+    LoadTags();
+
     if (!m_ExifData.contains("Photo") ||
         !m_ExifData["Photo"].contains("LensModel"))
     {
@@ -424,10 +1110,11 @@ QString ExifInfo::GetLensModel() const
     }
 
     // Post-Process
-    if (m_LensModelMapper.contains(model))
+    QString mapped_model;
+    if (LookUpMapper(MapperLensModel, model, mapped_model))
     {
         // Known lens model
-        model = m_LensModelMapper[model];
+        model = mapped_model;
     } else
     {
         // Check unknown model
@@ -449,87 +1136,11 @@ QString ExifInfo::GetLensMinFocalLength() const
 {
     CALL_IN("");
 
-    // Canon
-    if (m_ExifData.contains("CanonCs") &&
-        m_ExifData["CanonCs"].contains("Lens"))
+    // Decoded when the file was read
+    if (m_Record.m_LensMinFocalLength.IsValid())
     {
-        // Format
-        static const QRegularExpression format_lens("^([0-9]+) ([0-9]+) 1$");
-        const QRegularExpressionMatch match_lens =
-            format_lens.match(m_ExifData["CanonCs"]["Lens"]);
-        if (!match_lens.hasMatch())
-        {
-            const QString reason =
-                tr("%1: Lens information has incorrect format: \"%2\"")
-                .arg(m_Filename,
-                     m_ExifData["CanonCs"]["Lens"]);
-            MessageLogger::Error(CALL_METHOD, reason);
-            CALL_OUT(reason);
-            return QString();
-        }
-
-        const int min_length = match_lens.captured(1).toInt();
-        const int max_length = match_lens.captured(2).toInt();
-        if (min_length > max_length)
-        {
-            // Not a problem, but noteworthy
-            const QString reason = tr("%1: Min and max focal length of the "
-                "lens are incorrectly ordered: \"%2\"")
-                .arg(m_Filename,
-                     m_ExifData["CanonCs"]["Lens"]);
-            MessageLogger::Error(CALL_METHOD, reason);
-            CALL_OUT(reason);
-            return QString();
-        }
-        CALL_OUT("");
-        return QString::number(min_length);
-    }
-
-    // Others
-    QString lens_spec;
-    if (m_ExifData.contains("Photo") &&
-        m_ExifData["Photo"].contains("LensSpecification"))
-    {
-        lens_spec = m_ExifData["Photo"]["LensSpecification"];
-    }
-
-    // Nikon
-    if (m_ExifData.contains("Nikon3") &&
-        m_ExifData["Nikon3"].contains("Lens"))
-    {
-        lens_spec = m_ExifData["Nikon3"]["Lens"];
-    }
-
-    // Anything with a zero denominator is invalid and is ignored
-    if (lens_spec.endsWith("/0"))
-    {
-        lens_spec = "";
-    }
-
-    if (!lens_spec.isEmpty())
-    {
-        // Format
-        // 180/10 2700/10 35/10 63/10
-        static const QRegularExpression format_lens(
-            "^([0-9]+/[0-9]+) "
-            "([0-9]+/[0-9]+) "
-            "([0-9]+/[0-9]+) "
-            "([0-9]+/[0-9]+)$");
-        const QRegularExpressionMatch match_lens =
-            format_lens.match(lens_spec);
-        if (!match_lens.hasMatch())
-        {
-            const QString reason =
-                tr("%1: Lens information has incorrect format: \"%2\"")
-                .arg(m_Filename,
-                     lens_spec);
-            MessageLogger::Error(CALL_METHOD, reason);
-            CALL_OUT(reason);
-            return QString();
-        }
-
-        const QString focal_length = ConvertRational(match_lens.captured(1));
-
+        const QString focal_length =
+            ConvertRational(m_Record.m_LensMinFocalLength);
         CALL_OUT("");
         return focal_length;
     }
@@ -553,86 +1164,11 @@ QString ExifInfo::GetLensMaxFocalLength() const
 {
     CALL_IN("");
 
-    if (m_ExifData.contains("CanonCs") &&
-        m_ExifData["CanonCs"].contains("Lens"))
-    {
-        // Format
-        static const QRegularExpression format_lens("^([0-9]+) ([0-9]+) 1$");
-        const QRegularExpressionMatch match_lens =
-            format_lens.match(m_ExifData["CanonCs"]["Lens"]);
-        if (!match_lens.hasMatch())
-        {
-            const QString reason =
-                tr("%1: Lens information has incorrect format: \"%2\"")
-                .arg(m_Filename,
-                     m_ExifData["CanonCs"]["Lens"]);
-            MessageLogger::Error(CALL_METHOD, reason);
-            CALL_OUT(reason);
-            return QString();
-        }
-
-        const int min_length = match_lens.captured(1).toInt();
-        const int max_length = match_lens.captured(2).toInt();
-        if (min_length > max_length)
-        {
-            // Not a problem, but noteworthy
-            const QString reason = tr("%1: Min and max focal length of the "
-                "lens are incorrectly ordered: \"%2\"")
-                .arg(m_Filename,
-                     m_ExifData["CanonCs"]["Lens"]);
-            MessageLogger::Error(CALL_METHOD, reason);
-            CALL_OUT(reason);
-            return QString();
-        }
-        CALL_OUT("");
-        return QString::number(max_length);
-    }
-
-    // Others
-    QString lens_spec;
-    if (m_ExifData.contains("Photo") &&
-        m_ExifData["Photo"].contains("LensSpecification"))
-    {
-        lens_spec = m_ExifData["Photo"]["LensSpecification"];
-    }
-
-    // Nikon
-    if (m_ExifData.contains("Nikon3") &&
-        m_ExifData["Nikon3"].contains("Lens"))
-    {
-        lens_spec = m_ExifData["Nikon3"]["Lens"];
-    }
-
-    // Anything with a zero denominator is invalid and is ignored
-    if (lens_spec.endsWith("/0"))
-    {
-        lens_spec = "";
-    }
-
-    if (!lens_spec.isEmpty())
+    // Decoded when the file was read
+    if (m_Record.m_LensMaxFocalLength.IsValid())
     {
-        // Format
-        // 180/10 2700/10 35/10 63/10
-        static const QRegularExpression format_lens(
-            "^([0-9]+/[0-9]+) "
-            "([0-9]+/[0-9]+) "
-            "([0-9]+/[0-9]+) "
-            "([0-9]+/[0-9]+)$");
-        const QRegularExpressionMatch match_lens =
-            format_lens.match(lens_spec);
-        if (!match_lens.hasMatch())
-        {
-            const QString reason =
-                tr("%1: Lens information has incorrect format: \"%2\"")
-                .arg(m_Filename,
-                     lens_spec);
-            MessageLogger::Error(CALL_METHOD, reason);
-            CALL_OUT(reason);
-            return QString();
-        }
-
-        const QString focal_length = ConvertRational(match_lens.captured(2));
-
+        const QString focal_length =
+            ConvertRational(m_Record.m_LensMaxFocalLength);
         CALL_OUT("");
         return focal_length;
     }
@@ -656,51 +1192,11 @@ QString ExifInfo::GetLensMinFStopAtMinFocalLength() const
 {
     CALL_IN("");
 
-    // Others
-    QString lens_spec;
-    if (m_ExifData.contains("Photo") &&
-        m_ExifData["Photo"].contains("LensSpecification"))
-    {
-        lens_spec = m_ExifData["Photo"]["LensSpecification"];
-    }
-
-    // Nikon
-    if (m_ExifData.contains("Nikon3") &&
-        m_ExifData["Nikon3"].contains("Lens"))
-    {
-        lens_spec = m_ExifData["Nikon3"]["Lens"];
-    }
-
-    // Anything with a zero denominator is invalid and is ignored
-    if (lens_spec.endsWith("/0"))
-    {
-        lens_spec = "";
-    }
-
-    if (!lens_spec.isEmpty())
+    // Decoded when the file was read
+    if (m_Record.m_LensMinFStopAtMinFocalLength.IsValid())
     {
-        // Format
-        // 180/10 2700/10 35/10 63/10
-        static const QRegularExpression format_lens(
-            "^([0-9]+/[0-9]+) "
-            "([0-9]+/[0-9]+) "
-            "([0-9]+/[0-9]+) "
-            "([0-9]+/[0-9]+)$");
-        const QRegularExpressionMatch match_lens =
-            format_lens.match(lens_spec);
-        if (!match_lens.hasMatch())
-        {
-            const QString reason =
-                tr("%1: Lens information has incorrect format: \"%2\"")
-                .arg(m_Filename,
-                     lens_spec);
-            MessageLogger::Error(CALL_METHOD, reason);
-            CALL_OUT(reason);
-            return QString();
-        }
-
-        const QString f_stop = ConvertRational(match_lens.captured(3));
-
+        const QString f_stop =
+            ConvertRational(m_Record.m_LensMinFStopAtMinFocalLength);
         CALL_OUT("");
         return f_stop;
     }
@@ -724,45 +1220,11 @@ QString ExifInfo::GetLensMinFStopAtMaxFocalLength() const
 {
     CALL_IN("");
 
-    // Others
-    QString lens_spec;
-    if (m_ExifData.contains("Photo") &&
-        m_ExifData["Photo"].contains("LensSpecification"))
-    {
-        lens_spec = m_ExifData["Photo"]["LensSpecification"];
-    }
-
-    // Nikon
-    if (m_ExifData.contains("Nikon3") &&
-        m_ExifData["Nikon3"].contains("Lens"))
-    {
-        lens_spec = m_ExifData["Nikon3"]["Lens"];
-    }
-
-    if (!lens_spec.isEmpty())
+    // Decoded when the file was read
+    if (m_Record.m_LensMinFStopAtMaxFocalLength.IsValid())
     {
-        // Format
-        // 180/10 2700/10 35/10 63/10
-        static const QRegularExpression format_lens(
-            "^([0-9]+/[0-9]+) "
-            "([0-9]+/[0-9]+) "
-            "([0-9]+/[0-9]+) "
-            "([0-9]+/[0-9]+)$");
-        const QRegularExpressionMatch match_lens =
-            format_lens.match(lens_spec);
-        if (!match_lens.hasMatch())
-        {
-            const QString reason =
-                tr("%1: Lens information has incorrect format: \"%2\"")
-                .arg(m_Filename,
-                     lens_spec);
-            MessageLogger::Error(CALL_METHOD, reason);
-            CALL_OUT(reason);
-            return QString();
-        }
-
-        const QString f_stop = ConvertRational(match_lens.captured(4));
-
+        const QString f_stop =
+            ConvertRational(m_Record.m_LensMinFStopAtMaxFocalLength);
         CALL_OUT("");
         return f_stop;
     }
@@ -790,16 +1252,8 @@ QString ExifInfo::GetExposureDateTime() const
 {
     CALL_IN("");
 
-    QString date_time_str;
-    if (m_ExifData.contains("Photo") &&
-        m_ExifData["Photo"].contains("DateTimeOriginal"))
-    {
-        date_time_str = m_ExifData["Photo"]["DateTimeOriginal"];
-    } else if (m_ExifData.contains("Image") &&
-        m_ExifData["Image"].contains("DateTime"))
-    {
-        date_time_str = m_ExifData["Image"]["DateTime"];
-    } else
+    // Decoded when the file was read
+    if (!m_Record.m_ExposureDateTime.isValid())
     {
         // No date time information
         if (DEBUG)
@@ -811,44 +1265,8 @@ QString ExifInfo::GetExposureDateTime() const
         return QString();
     }
 
-    // Catch the known invalids
-    if (date_time_str.isEmpty() ||
-        date_time_str == "0000:00:00 00:00:00" ||
-        date_time_str == "    :  :     :  :  " ||
-        date_time_str == "                   ")
-    {
-        // No date time
-        CALL_OUT("");
-        return QString();
-    }
-
-    QDateTime date_time =
-        QDateTime::fromString(date_time_str, "yyyy:MM:dd hh:mm:ss");
-    if (!date_time.isValid())
-    {
-        date_time =
-            QDateTime::fromString(date_time_str, "yyyy/MM/dd hh:mm:ss");
-        if (!date_time.isValid())
-        {
-            // "2009:09:24 21:16: 9"
-            date_time =
-                QDateTime::fromString(date_time_str, "yyyy:MM:dd hh:mm: s");
-        }
-    }
-
-    if (!date_time.isValid())
-    {
-        // Could not be converted
-        const QString reason =
-            tr("%1: Date/time does not have the correct format: \"%2\"")
-            .arg(m_Filename,
-                 m_ExifData["Photo"]["DateTimeOriginal"]);
-        MessageLogger::Error(CALL_METHOD, reason);
-        CALL_OUT(reason);
-        return QString();
-    }
-
-    const QString dt_str = date_time.toString("yyyy-MM-dd hh:mm:ss");
+    const QString dt_str =
+        m_Record.m_ExposureDateTime.toString("yyyy-MM-dd hh:mm:ss");
 
     CALL_OUT("");
     return dt_str;
@@ -862,20 +1280,19 @@ QString ExifInfo::GetExposureFocalLength() const
 {
     CALL_IN("");
 
-    if (m_ExifData.contains("Photo") &&
-        m_ExifData["Photo"].contains("FocalLength"))
+    // Decoded when the file was read; the tags are not needed
+    const Rational & focal_length = m_Record.m_FocalLength;
+    if (focal_length.IsValid())
     {
-        QString length = m_ExifData["Photo"]["FocalLength"];
-        if (m_FocalLengthMapper.contains(length))
-        {
-            length = m_FocalLengthMapper[length];
-        } else
+        const QString raw_length = FormatRational(focal_length);
+        QString length;
+        if (!LookUpMapper(MapperFocalLength, raw_length, length))
         {
             const QString reason = tr("%1: Focal length not in mapper: \"%2\"")
                 .arg(m_Filename,
-                     length);
+                     raw_length);
             MessageLogger::Message(CALL_METHOD, reason);
-            length = ConvertRational(length);
+            length = ConvertRational(focal_length);
         }
 
         CALL_OUT("");
@@ -903,30 +1320,23 @@ QString ExifInfo::GetExposureFStop() const
 {
     CALL_IN("");
 
-    if (m_ExifData.contains("Photo") &&
-        m_ExifData["Photo"].contains("FNumber"))
+    // Decoded when the file was read; the tags are not needed
+    const Rational & f_stop = m_Record.m_FStop;
+    if (f_stop.IsValid())
     {
-        // Get F stop
-        const QString f_stop = m_ExifData["Photo"]["FNumber"];
-
-        // Check for missing info
-        if (f_stop.isEmpty())
-        {
-            CALL_OUT("");
-            return QString();
-        }
-
         // Use mapper
-        if (m_FStopMapper.contains(f_stop))
+        const QString raw_f_stop = FormatRational(f_stop);
+        QString mapped_f_stop;
+        if (LookUpMapper(MapperFStop, raw_f_stop, mapped_f_stop))
         {
             CALL_OUT("");
-            return "f/" + m_FStopMapper[f_stop];
+            return "f/" + mapped_f_stop;
         } else
         {
             // Should be in mapper
             const QString reason = tr("%1: F Stop \"%2\" is not in mapper.")
                 .arg(m_Filename,
-                     f_stop);
+                     raw_f_stop);
             MessageLogger::Message(CALL_METHOD, reason);
 
             // Convert rational
@@ -962,31 +1372,25 @@ QString ExifInfo::GetExposureTime() const
 {
     CALL_IN("");
 
-    if (m_ExifData.contains("Photo") &&
-        m_ExifData["Photo"].contains("ExposureTime"))
+    // Decoded when the file was read; the tags are not needed
+    const Rational & exposure_time = m_Record.m_ExposureTime;
+    if (exposure_time.IsValid())
     {
-        // Get exposure time
-        const QString exposure = m_ExifData["Photo"]["ExposureTime"];
-
-        // Check for missing info
-        if (exposure.isEmpty())
-        {
-            CALL_OUT("");
-            return QString();
-        }
+        const QString exposure = FormatRational(exposure_time);
 
         // Deal with "1/n" exposure times separately
-        if (exposure.startsWith("1/"))
+        if (exposure_time.m_Numerator == 1)
         {
             CALL_OUT("");
             return exposure;
         }
 
         // Use mapper
-        if (m_ExposureTimeMapper.contains(exposure))
+        QString mapped_exposure;
+        if (LookUpMapper(MapperExposureTime, exposure, mapped_exposure))
         {
             CALL_OUT("");
-            return m_ExposureTimeMapper[exposure];
+            return mapped_exposure;
         }
 
         // Should be in mapper
@@ -997,7 +1401,7 @@ QString ExifInfo::GetExposureTime() const
         MessageLogger::Message(CALL_METHOD, reason);
 
         // Convert rational
-        QString rational = ConvertRational(exposure);
+        QString rational = ConvertRational(exposure_time);
         CALL_OUT("");
         return rational;
     }
@@ -1023,19 +1427,10 @@ QString ExifInfo::GetExposureBias() const
 {
     CALL_IN("");
 
-    if (m_ExifData.contains("Photo") &&
-        m_ExifData["Photo"].contains("ExposureBiasValue"))
+    // Decoded when the file was read; the tags are not needed
+    if (m_Record.m_ExposureBias.IsValid())
     {
-        const QString bias = m_ExifData["Photo"]["ExposureBiasValue"];
-
-        // Check for missing info
-        if (bias.isEmpty())
-        {
-            CALL_OUT("");
-            return QString();
-        }
-
-        QString rational = ConvertRational(bias);
+        QString rational = ConvertRational(m_Record.m_ExposureBias);
         if (rational.size() == 1)
         {
             rational += ".00";
@@ -1068,24 +1463,19 @@ QString ExifInfo::GetISORating() const
 {
     CALL_IN("");
 
-    static QSet < QString > acceptable_values;
-    if (acceptable_values.isEmpty())
+    // (initialized once, also when called from several threads)
+    static const QSet < QString > acceptable_values
     {
-        // Initialize acceptable values
-        acceptable_values
-            << "16" << "32" << "64" << "125" << "250" << "500" << "1000"
-            << "2000"
-            << "20" << "40" << "80" << "160" << "320" << "640" << "1280"
-            << "2500" << "5000"
-            << "25" << "50" << "100" << "200" << "400" << "800" << "1600"
-            << "3200" << "6400" << "12800";
-    }
-
-    // Check if we have this information
-    if (m_ExifData.contains("Photo") &&
-        m_ExifData["Photo"].contains("ISOSpeedRatings"))
+        "16", "32", "64", "125", "250", "500", "1000", "2000",
+        "20", "40", "80", "160", "320", "640", "1280", "2500", "5000",
+        "25", "50", "100", "200", "400", "800", "1600", "3200", "6400",
+        "12800"
+    };
+
+    // Decoded when the file was read; the tags are not needed
+    if (m_Record.m_ISORating > 0)
     {
-        const QString iso = m_ExifData["Photo"]["ISOSpeedRatings"];
+        const QString iso = QString::number(m_Record.m_ISORating);
         if (!acceptable_values.contains(iso))
         {
             const QString reason = tr("Unknown ISO speed rating: %1 (%2)")
@@ -1122,6 +1512,8 @@ QString ExifInfo::GetExposureSubjectDistance() const
 {
     CALL_IN("");
 
+    LoadTags();
+
     if (m_ExifData.contains("CanonCs2") &&
         m_ExifData["CanonCs2"].contains("SubjectDistance"))
     {
@@ -1160,29 +1552,19 @@ QString ExifInfo::GetFlashFired() const
 {
     CALL_IN("");
 
-    if (m_ExifData.contains("Photo") &&
-        m_ExifData["Photo"].contains("Flash"))
+    // Decoded when the file was read
+    switch (m_Record.m_Flash)
     {
-        const QString flash = m_ExifData["Photo"]["Flash"];
-
-        // Check for missing info
-        if (flash.isEmpty())
-        {
-            CALL_OUT("");
-            return QString();
-        }
-
-        // This field is made up of bits:
-        //  Bit 0: Flash fired (0: No, 1: Yes)
-        //  Bit 1,2: Flash return
-        //  Bit 3,4: Flash mode
-        //  Bit 5: Flash function
-        //  Bit 6: Red-eye reduction
-        // We use only bit 0 here.
+    case FlashFired:
+        CALL_OUT("");
+        return "yes";
 
-        // Check value
+    case FlashNotFired:
         CALL_OUT("");
-        return (flash.toInt() & 1) ? "yes" : "no";
+        return "no";
+
+    case FlashUnknown:
+        break;
     }
 
     // No flash info
@@ -1248,6 +1630,8 @@ QString ExifInfo::GetRealPictureWidth() const
 {
     CALL_IN("");
 
+    LoadTags();
+
     if (m_ExifData.contains("Photo") &&
         m_ExifData["Photo"].contains("PixelXDimension"))
     {
@@ -1275,6 +1659,8 @@ QString ExifInfo::GetRealPictureHeight() const
 {
     CALL_IN("");
 
+    LoadTags();
+
     if (m_ExifData.contains("Photo") &&
         m_ExifData["Photo"].contains("PixelYDimension"))
     {
@@ -1302,57 +1688,16 @@ int ExifInfo::GetOrientation() const
 {
     CALL_IN("");
 
-    if (m_ExifData.contains("Image") &&
-        m_ExifData["Image"].contains("Orientation"))
-    {
-        const int orientation = m_ExifData["Image"]["Orientation"].toInt();
-        switch (orientation)
-        {
-        case 1:
-            // Falls thru
-        case 2:
-            CALL_OUT("");
-            return 0;
-
-        case 3:
-            // Falls thru
-        case 4:
-            CALL_OUT("");
-            return 180;
-
-        case 5:
-            // Falls thru
-        case 6:
-            CALL_OUT("");
-            return 90;
-
-        case 7:
-            // Falls thru
-        case 8:
-            CALL_OUT("");
-            return 270;
-
-        default:
-        {
-            const QString reason = tr("%1: Unknown orientation %2")
-                .arg(m_Filename,
-                    QString::number(orientation));
-            MessageLogger::Error(CALL_METHOD, reason);
-            CALL_OUT("");
-            return -1;
-        }
-        }
-    }
-
-    // No orientation found
-    if (DEBUG)
+    // Decoded when the file was read
+    if (m_Record.m_Orientation < 0 &&
+        DEBUG)
     {
         qDebug().noquote() << QString("%1: No orientation")
             .arg(m_Filename);
     }
 
     CALL_OUT("");
-    return -1;
+    return m_Record.m_Orientation;
 }
 
 
@@ -1382,6 +1727,8 @@ QString ExifInfo::GetSoftware() const
 {
     CALL_IN("");
 
+    LoadTags();
+
     if (m_ExifData.contains("Image") &&
         m_ExifData["Image"].contains("Software"))
     {
@@ -1413,6 +1760,8 @@ QString ExifInfo::GetOwner() const
 {
     CALL_IN("");
 
+    LoadTags();
+
     if (m_ExifData.contains("Photo") &&
         m_ExifData["Photo"].contains("CameraOwnerName"))
     {
@@ -1441,6 +1790,8 @@ QString ExifInfo::GetCameraSerialNumber() const
 {
     CALL_IN("");
 
+    LoadTags();
+
     if (m_ExifData.contains("Photo") &&
         m_ExifData["Photo"].contains("BodySerialNumber"))
     {
@@ -1472,167 +1823,461 @@ double ExifInfo::GetGPSLatitude() const
 {
     CALL_IN("");
 
-    // Check if tags exist
-    if (!m_ExifData.contains("GPSInfo") ||
-        !m_ExifData["GPSInfo"].contains("GPSLatitude") ||
-        !m_ExifData["GPSInfo"].contains("GPSLatitudeRef"))
-    {
-        // Nope.
-        if (DEBUG)
-        {
-            qDebug().noquote() << QString("%1: No GPS latitude")
-                .arg(m_Filename);
-        }
+    // Decoded when the file was read
+    CALL_OUT("");
+    return m_Record.m_GPSLatitude;
+}
 
-        CALL_OUT("");
-        return NAN;
-    }
 
-    // Parse it.
-    static const QRegularExpression parse(
-        "^([0-9]+)/([0-9]+) ([0-9]+)/([0-9]+) ([0-9]+)/([0-9]+)$");
-    QRegularExpressionMatch parse_match =
-        parse.match(m_ExifData["GPSInfo"]["GPSLatitude"]);
-    if (!parse_match.hasMatch())
-    {
-        const QString reason =
-            tr("%1: Unknown GPS Latitude format: \"%2\". Ignored.")
-                .arg(m_Filename,
-                    m_ExifData["GPSInfo"]["GPSLatitude"]);
-        MessageLogger::Error(CALL_METHOD, reason);
-        CALL_OUT(reason);
-        return NAN;
-    }
 
-    // Matches
-    const int deg_ctr = parse_match.captured(1).toInt();
-    const int deg_den = parse_match.captured(2).toInt();
-    const int min_ctr = parse_match.captured(3).toInt();
-    const int min_den = parse_match.captured(4).toInt();
-    const int sec_ctr = parse_match.captured(5).toInt();
-    const int sec_den = parse_match.captured(6).toInt();
+///////////////////////////////////////////////////////////////////////////////
+// Longitude
+double ExifInfo::GetGPSLongitude() const
+{
+    CALL_IN("");
+
+    // Decoded when the file was read
+    CALL_OUT("");
+    return m_Record.m_GPSLongitude;
+}
 
-    // Check for zero denominators
-    // ("0/0" is okay for the last group)
-    if (deg_den == 0 ||
-        min_den == 0 ||
-        (sec_den == 0 && sec_ctr != 0))
+
+
+///////////////////////////////////////////////////////////////////////////////
+// Elevation
+double ExifInfo::GetGPSElevation() const
+{
+    CALL_IN("");
+
+    // Decoded when the file was read
+    CALL_OUT("");
+    return m_Record.m_GPSElevation;
+}
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// Direction
+double ExifInfo::GetGPSDirection() const
+{
+    CALL_IN("");
+
+    // No GPS direction
+    if (DEBUG)
     {
-        const QString reason =
-            tr("%1: Zero denominators in GPS Latitude: \"%2\". Ignored.")
-                .arg(m_Filename,
-                    m_ExifData["GPSInfo"]["GPSLatitude"]);
-        MessageLogger::Error(CALL_METHOD, reason);
-        CALL_OUT(reason);
-        return NAN;
+        qDebug().noquote() << QString("%1: No GPS direction")
+            .arg(m_Filename);
     }
 
-    // Convert
-    const double degrees = deg_ctr * 1. / deg_den;
-    const double minutes = min_ctr * 1. / min_den;;
-    const double seconds = (sec_den == 0 ? 0. : sec_ctr * 1./ sec_den);
-    const double deg = degrees + minutes/60 + seconds/3600;
-    const QString ns = m_ExifData["GPSInfo"]["GPSLatitudeRef"];
-    if (ns == "S")
+    CALL_OUT("");
+    return NAN;
+}
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// Temperature
+double ExifInfo::GetCameraTemperature() const
+{
+    CALL_IN("");
+
+    LoadTags();
+
+    // This is acutally the DIGIC processor temperature (in F)
+    if (m_ExifData.contains("CanonSi") &&
+        m_ExifData["CanonSi"].contains("CameraTemperature"))
     {
+        const double temperature_f =
+            m_ExifData["CanonSi"]["CameraTemperature"].toInt();
+        const double temperature_c = (temperature_f - 32.) * 5./9.;
         CALL_OUT("");
-        return -deg;
-    } else if (ns == "N")
+        return temperature_c;
+    }
+
+    // No temperature
+    if (DEBUG)
     {
-        CALL_OUT("");
-        return deg;
+        qDebug().noquote() << QString("%1: No temperature")
+            .arg(m_Filename);
     }
 
-    const QString reason = tr("%1: Invalid hemisphere (N/S): \"%2\".")
-        .arg(m_Filename,
-            ns);
-    MessageLogger::Error(CALL_METHOD, reason);
-    CALL_OUT(reason);
+    CALL_OUT("");
     return NAN;
 }
 
 
 
+// =============================================================== Typed Values
+
+
+
 ///////////////////////////////////////////////////////////////////////////////
-// Longitude
-double ExifInfo::GetGPSLongitude() const
+// Typed values
+const ExifInfo::Record & ExifInfo::GetRecord() const
 {
     CALL_IN("");
 
+    CALL_OUT("");
+    return m_Record;
+}
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// Decode typed values from the tags
+void ExifInfo::DecodeRecord()
+{
+    CALL_IN("");
+
+    m_Record = Record();
+
+    // Exposure date & time
+    const QString date_time_str = HasTag("Photo", "DateTimeOriginal") ?
+        GetValue("Photo", "DateTimeOriginal") :
+        GetValue("Image", "DateTime");
+
+    // (catch the known invalids)
+    if (!date_time_str.isEmpty() &&
+        date_time_str != "0000:00:00 00:00:00" &&
+        date_time_str != "    :  :     :  :  " &&
+        date_time_str != "                   ")
+    {
+        QDateTime date_time =
+            QDateTime::fromString(date_time_str, "yyyy:MM:dd hh:mm:ss");
+        if (!date_time.isValid())
+        {
+            date_time =
+                QDateTime::fromString(date_time_str, "yyyy/MM/dd hh:mm:ss");
+            if (!date_time.isValid())
+            {
+                // "2009:09:24 21:16: 9"
+                date_time = QDateTime::fromString(date_time_str,
+                    "yyyy:MM:dd hh:mm: s");
+            }
+        }
+        if (date_time.isValid())
+        {
+            m_Record.m_ExposureDateTime = date_time;
+        } else
+        {
+            // Could not be converted
+            const QString reason =
+                tr("%1: Date/time does not have the correct format: \"%2\"")
+                .arg(m_Filename,
+                     date_time_str);
+            MessageLogger::Error(CALL_METHOD, reason);
+        }
+    }
+
+    // Exposure
+    auto decode_rational = [this](const QString & mcrTag,
+        Rational & mrRational)
+    {
+        const QList < Rational > values =
+            ParseRationals(GetValue("Photo", mcrTag));
+        if (values.size() == 1)
+        {
+            mrRational = values.first();
+        }
+    };
+    decode_rational("FocalLength", m_Record.m_FocalLength);
+    decode_rational("FNumber", m_Record.m_FStop);
+    decode_rational("ExposureTime", m_Record.m_ExposureTime);
+    decode_rational("ExposureBiasValue", m_Record.m_ExposureBias);
+
+    // ISO rating; some cameras repeat it ("100 100"), use the first one
+    const QString iso = GetValue("Photo", "ISOSpeedRatings");
+    if (!iso.isEmpty())
+    {
+        bool ok = false;
+        m_Record.m_ISORating =
+            iso.section(' ', 0, 0, QString::SectionSkipEmpty).toInt(&ok);
+        if (!ok)
+        {
+            const QString reason =
+                tr("%1: ISO speed rating is not a number: \"%2\"")
+                .arg(m_Filename,
+                     iso);
+            MessageLogger::Error(CALL_METHOD, reason);
+        }
+    }
+
+    // Flash; this field is made up of bits:
+    //  Bit 0: Flash fired (0: No, 1: Yes)
+    //  Bit 1,2: Flash return
+    //  Bit 3,4: Flash mode
+    //  Bit 5: Flash function
+    //  Bit 6: Red-eye reduction
+    // We use only bit 0 here.
+    const QString flash = GetValue("Photo", "Flash");
+    if (!flash.isEmpty())
+    {
+        m_Record.m_Flash = (flash.toInt() & 1) ? FlashFired : FlashNotFired;
+    }
+
+    // Orientation
+    if (HasTag("Image", "Orientation"))
+    {
+        const int orientation = GetValue("Image", "Orientation").toInt();
+        switch (orientation)
+        {
+        case 1:
+            // Falls thru
+        case 2:
+            m_Record.m_Orientation = 0;
+            break;
+
+        case 3:
+            // Falls thru
+        case 4:
+            m_Record.m_Orientation = 180;
+            break;
+
+        case 5:
+            // Falls thru
+        case 6:
+            m_Record.m_Orientation = 90;
+            break;
+
+        case 7:
+            // Falls thru
+        case 8:
+            m_Record.m_Orientation = 270;
+            break;
+
+        default:
+        {
+            const QString reason = tr("%1: Unknown orientation %2")
+                .arg(m_Filename,
+                    QString::number(orientation));
+            MessageLogger::Error(CALL_METHOD, reason);
+            break;
+        }
+        }
+    }
+
+    // Lens: Canon has min and max focal length in its maker note
+    const bool has_canon_lens = HasTag("CanonCs", "Lens");
+    if (has_canon_lens)
+    {
+        const QString lens = GetValue("CanonCs", "Lens");
+        static const QRegularExpression format_lens("^([0-9]+) ([0-9]+) 1$");
+        const QRegularExpressionMatch match_lens = format_lens.match(lens);
+        if (!match_lens.hasMatch())
+        {
+            const QString reason =
+                tr("%1: Lens information has incorrect format: \"%2\"")
+                .arg(m_Filename,
+                     lens);
+            MessageLogger::Error(CALL_METHOD, reason);
+        } else if (match_lens.captured(1).toInt() >
+            match_lens.captured(2).toInt())
+        {
+            // Not a problem, but noteworthy
+            const QString reason = tr("%1: Min and max focal length of the "
+                "lens are incorrectly ordered: \"%2\"")
+                .arg(m_Filename,
+                     lens);
+            MessageLogger::Error(CALL_METHOD, reason);
+        } else
+        {
+            m_Record.m_LensMinFocalLength.m_Numerator =
+                match_lens.captured(1).toInt();
+            m_Record.m_LensMinFocalLength.m_Denominator = 1;
+            m_Record.m_LensMaxFocalLength.m_Numerator =
+                match_lens.captured(2).toInt();
+            m_Record.m_LensMaxFocalLength.m_Denominator = 1;
+        }
+    }
+
+    // Lens: others (e.g. "180/10 2700/10 35/10 63/10"); Nikon has its own
+    QString lens_spec = HasTag("Nikon3", "Lens") ?
+        GetValue("Nikon3", "Lens") :
+        GetValue("Photo", "LensSpecification");
+
+    // Anything with a zero denominator is invalid and is ignored
+    if (lens_spec.endsWith("/0"))
+    {
+        lens_spec.clear();
+    }
+
+    const QList < Rational > lens = ParseRationals(lens_spec);
+    if (lens.size() == 4)
+    {
+        if (!has_canon_lens)
+        {
+            m_Record.m_LensMinFocalLength = lens[0];
+            m_Record.m_LensMaxFocalLength = lens[1];
+        }
+        m_Record.m_LensMinFStopAtMinFocalLength = lens[2];
+        m_Record.m_LensMinFStopAtMaxFocalLength = lens[3];
+    } else if (!lens_spec.isEmpty())
+    {
+        const QString reason =
+            tr("%1: Lens information has incorrect format: \"%2\"")
+            .arg(m_Filename,
+                 lens_spec);
+        MessageLogger::Error(CALL_METHOD, reason);
+    }
+
+    // GPS position
+    m_Record.m_GPSLatitude = ParseGPSCoordinate("GPSLatitude", "N", "S");
+    m_Record.m_GPSLongitude = ParseGPSCoordinate("GPSLongitude", "E", "W");
+    if (HasTag("GPSInfo", "GPSAltitude") &&
+        HasTag("GPSInfo", "GPSAltitudeRef"))
+    {
+        const QString altitude_str = GetValue("GPSInfo", "GPSAltitude");
+        const QList < Rational > altitude = ParseRationals(altitude_str);
+        if (altitude.size() != 1)
+        {
+            const QString reason =
+                tr("Unknown GPS altitude format: \"%1\". Ignored.")
+                    .arg(altitude_str);
+            MessageLogger::Error(CALL_METHOD, reason);
+        } else if (!altitude.first().IsValid())
+        {
+            const QString reason =
+                tr("Zero denominators in GPS altitude: \"%1\". Ignored.")
+                    .arg(altitude_str);
+            MessageLogger::Error(CALL_METHOD, reason);
+        } else
+        {
+            const double elevation = altitude.first().ToDouble();
+            m_Record.m_GPSElevation =
+                (GetValue("GPSInfo", "GPSAltitudeRef").toInt() == 1 ?
+                    -elevation : elevation);
+        }
+    }
+
+    CALL_OUT("");
+}
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// Parse a list of rationals ("n/d n/d ...")
+QList < ExifInfo::Rational > ExifInfo::ParseRationals(
+    const QString & mcrValue) const
+{
+    CALL_IN(QString("mcrValue=%1")
+        .arg(CALL_SHOW(mcrValue)));
+
+    QList < Rational > rationals;
+    for (const QStringView part :
+         QStringView(mcrValue).split(' ', Qt::SkipEmptyParts))
+    {
+        const qsizetype slash = part.indexOf('/');
+        bool numerator_ok = false;
+        bool denominator_ok = false;
+        Rational rational;
+        if (slash > 0)
+        {
+            rational.m_Numerator =
+                part.left(slash).toLongLong(&numerator_ok);
+            rational.m_Denominator =
+                part.mid(slash + 1).toLongLong(&denominator_ok);
+        }
+        if (!numerator_ok ||
+            !denominator_ok ||
+            rational.m_Denominator < 0)
+        {
+            // Not a rational
+            const QString reason =
+                tr("%1: %2 is not valid rational value.")
+                .arg(m_Filename,
+                     mcrValue);
+            MessageLogger::Error(CALL_METHOD, reason);
+            CALL_OUT(reason);
+            return QList < Rational >();
+        }
+        rationals << rational;
+    }
+
+    CALL_OUT("");
+    return rationals;
+}
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// Parse GPS latitude or longitude
+double ExifInfo::ParseGPSCoordinate(const QString & mcrTag,
+    const QString & mcrPositive, const QString & mcrNegative) const
+{
+    CALL_IN(QString("mcrTag=%1, mcrPositive=%2, mcrNegative=%3")
+        .arg(CALL_SHOW(mcrTag),
+             CALL_SHOW(mcrPositive),
+             CALL_SHOW(mcrNegative)));
+
     // Check if tags exist
-    if (!m_ExifData.contains("GPSInfo") ||
-        !m_ExifData["GPSInfo"].contains("GPSLongitude") ||
-        !m_ExifData["GPSInfo"].contains("GPSLongitudeRef"))
+    const QString ref_tag = mcrTag + "Ref";
+    if (!HasTag("GPSInfo", mcrTag) ||
+        !HasTag("GPSInfo", ref_tag))
     {
         // Nope.
         if (DEBUG)
         {
-            qDebug().noquote() << QString("%1: No GPS longitude")
-                .arg(m_Filename);
+            qDebug().noquote() << QString("%1: No %2")
+                .arg(m_Filename,
+                     mcrTag);
         }
 
         CALL_OUT("");
         return NAN;
     }
 
-    // Parse it.
-    static const QRegularExpression parse(
-        "^([0-9]+)/([0-9]+) ([0-9]+)/([0-9]+) ([0-9]+)/([0-9]+)$");
-    QRegularExpressionMatch parse_match =
-        parse.match(m_ExifData["GPSInfo"]["GPSLongitude"]);
-    if (!parse_match.hasMatch())
+    // Parse it: degrees, minutes, seconds
+    const QString value = GetValue("GPSInfo", mcrTag);
+    const QList < Rational > parts = ParseRationals(value);
+    if (parts.size() != 3)
     {
         const QString reason =
-            tr("%1: Unknown GPS longitude format: \"%2\". Ignored.")
+            tr("%1: Unknown %2 format: \"%3\". Ignored.")
                 .arg(m_Filename,
-                    m_ExifData["GPSInfo"]["GPSLongitude"]);
+                     mcrTag,
+                     value);
         MessageLogger::Error(CALL_METHOD, reason);
         CALL_OUT(reason);
         return NAN;
     }
 
-    // Matches
-    const int deg_ctr = parse_match.captured(1).toInt();
-    const int deg_den = parse_match.captured(2).toInt();
-    const int min_ctr = parse_match.captured(3).toInt();
-    const int min_den = parse_match.captured(4).toInt();
-    const int sec_ctr = parse_match.captured(5).toInt();
-    const int sec_den = parse_match.captured(6).toInt();
-
     // Check for zero denominators
     // ("0/0" is okay for the last group)
-    if (deg_den == 0 ||
-        min_den == 0 ||
-        (sec_den == 0 && sec_ctr != 0))
+    if (!parts[0].IsValid() ||
+        !parts[1].IsValid() ||
+        (!parts[2].IsValid() && parts[2].m_Numerator != 0))
     {
         const QString reason =
-            tr("%1: Zero denominators in GPS Longitude: \"%2\". Ignored.")
+            tr("%1: Zero denominators in %2: \"%3\". Ignored.")
                 .arg(m_Filename,
-                    m_ExifData["GPSInfo"]["GPSLongitude"]);
+                     mcrTag,
+                     value);
         MessageLogger::Error(CALL_METHOD, reason);
         CALL_OUT(reason);
         return NAN;
     }
 
     // Convert
-    const double degrees = deg_ctr * 1. / deg_den;
-    const double minutes = min_ctr * 1. / min_den;;
-    const double seconds = (sec_den == 0 ? 0. : sec_ctr * 1./ sec_den);
+    const double degrees = parts[0].ToDouble();
+    const double minutes = parts[1].ToDouble();
+    const double seconds = (parts[2].IsValid() ? parts[2].ToDouble() : 0.);
     const double deg = degrees + minutes/60 + seconds/3600;
-    const QString ew = m_ExifData["GPSInfo"]["GPSLongitudeRef"];
-    if (ew == "W")
+    const QString hemisphere = GetValue("GPSInfo", ref_tag);
+    if (hemisphere == mcrNegative)
     {
         CALL_OUT("");
         return -deg;
-    } else if (ew == "E")
+    } else if (hemisphere == mcrPositive)
     {
         CALL_OUT("");
         return deg;
     }
 
-    const QString reason = tr("%1: Invalid hemisphere (E/W): \"%2\".")
+    const QString reason = tr("%1: Invalid hemisphere (%2/%3): \"%4\".")
         .arg(m_Filename,
-            ew);
+            mcrPositive,
+            mcrNegative,
+            hemisphere);
     MessageLogger::Error(CALL_METHOD, reason);
     CALL_OUT(reason);
     return NAN;
@@ -1641,1790 +2286,1935 @@ double ExifInfo::GetGPSLongitude() const
 
 
 ///////////////////////////////////////////////////////////////////////////////
-// Elevation
-double ExifInfo::GetGPSElevation() const
+// Convert rational to string
+QString ExifInfo::ConvertRational(const Rational & mcrValue) const
 {
-    CALL_IN("");
+    CALL_IN(QString("mcrValue=%1/%2")
+        .arg(CALL_SHOW(mcrValue.m_Numerator),
+             CALL_SHOW(mcrValue.m_Denominator)));
 
-    // Check if tags exist
-    if (!m_ExifData.contains("GPSInfo") ||
-        !m_ExifData["GPSInfo"].contains("GPSAltitude") ||
-        !m_ExifData["GPSInfo"].contains("GPSAltitudeRef"))
+    // Denominator cannot be zero
+    if (!mcrValue.IsValid())
     {
-        // Nope.
-        if (DEBUG)
+        // 0/0 is also what we keep for values we could not decode; these
+        // have been reported already
+        if (mcrValue.m_Numerator == 0)
         {
-            qDebug().noquote() << QString("%1: No GPS elevation")
-                .arg(m_Filename);
+            CALL_OUT("");
+            return QString();
         }
 
+        const QString reason = tr("%1/%2 has a zero denominator.")
+            .arg(QString::number(mcrValue.m_Numerator),
+                 QString::number(mcrValue.m_Denominator));
+        MessageLogger::Error(CALL_METHOD, reason);
+        CALL_OUT(reason);
+        return QString();
+    }
+
+    // Convert
+    if (mcrValue.m_Numerator % mcrValue.m_Denominator == 0)
+    {
+        // Integer result
         CALL_OUT("");
-        return NAN;
+        return QString::number(mcrValue.m_Numerator / mcrValue.m_Denominator);
+    } else
+    {
+        // Decimal result
+        CALL_OUT("");
+        return QString::number(mcrValue.ToDouble(), 'f', 1);
     }
 
-    // Parse it.
-    static const QRegularExpression parse("^([0-9]+)/([0-9]+)$");
-    QRegularExpressionMatch parse_match =
-        parse.match(m_ExifData["GPSInfo"]["GPSAltitude"]);
-    if (!parse_match.hasMatch())
+    // We never get here
+}
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// Rational as stored in the file
+QString ExifInfo::FormatRational(const Rational & mcrValue) const
+{
+    CALL_IN(QString("mcrValue=%1/%2")
+        .arg(CALL_SHOW(mcrValue.m_Numerator),
+             CALL_SHOW(mcrValue.m_Denominator)));
+
+    // Same text as the tag value the rational was parsed from
+    CALL_OUT("");
+    return QString("%1/%2")
+        .arg(QString::number(mcrValue.m_Numerator),
+             QString::number(mcrValue.m_Denominator));
+}
+
+
+
+// ============================================================== Batch Reading
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// Read EXIF info of several files in parallel
+QHash < QString, ExifInfo * > ExifInfo::CreateExifInfos(
+    const QStringList & mcrFilenames, const bool mcIncludeMakerNotes,
+    const int mcMaxThreads)
+{
+    CALL_IN(QString("mcrFilenames=%1, mcIncludeMakerNotes=%2, "
+        "mcMaxThreads=%3")
+        .arg(CALL_SHOW(mcrFilenames),
+             CALL_SHOW(mcIncludeMakerNotes),
+             CALL_SHOW(mcMaxThreads)));
+
+    // Cached EXIF info
+    QHash < QString, ExifInfo * > filename_to_info;
+    QStringList to_read;
+    QSet < QString > to_read_set;
+    QList < FileCacheBase::FileIdentity > identities;
+    for (const QString & filename : mcrFilenames)
     {
-        const QString reason =
-            tr("Unknown GPS altitude format: \"%1\". Ignored.")
-                .arg(m_ExifData["GPSInfo"]["GPSAltitude"]);
-        MessageLogger::Error(CALL_METHOD, reason);
-        CALL_OUT(reason);
-        return NAN;
+        if (filename_to_info.contains(filename) ||
+            to_read_set.contains(filename))
+        {
+            continue;
+        }
+        const QString absolute_filename =
+            QFileInfo(filename).absoluteFilePath();
+        const FileCacheBase::FileIdentity identity =
+            FileCacheBase::GetFileIdentity(absolute_filename);
+        CacheEntry entry;
+        if (LookUpCache(absolute_filename, identity, mcIncludeMakerNotes,
+            entry))
+        {
+            if (entry.m_HasExifInfo)
+            {
+                filename_to_info[filename] =
+                    CreateExifInfoFromCache(filename, entry);
+            }
+        } else
+        {
+            to_read << filename;
+            to_read_set += filename;
+            identities << identity;
+        }
     }
 
-    // Check for zero denominators
-    if (parse_match.captured(2).toInt() == 0)
+    // Exiv2 needs this before it is used from several threads
+    Exiv2::XmpParser::initialize();
+
+    // Read the rest; EXIF info objects are handed over to our thread
+    QThreadPool pool;
+    pool.setMaxThreadCount(mcMaxThreads > 0 ?
+        mcMaxThreads : QThread::idealThreadCount());
+    QThread * const caller_thread = QThread::currentThread();
+    const QList < ExifInfo * > infos =
+        QtConcurrent::blockingMapped < QList < ExifInfo * > >(
+            &pool, to_read,
+            [caller_thread, mcIncludeMakerNotes](const QString & mcrFilename)
+            {
+                ExifInfo * info =
+                    CreateExifInfo(mcrFilename, mcIncludeMakerNotes);
+                if (info)
+                {
+                    info -> moveToThread(caller_thread);
+                }
+                return info;
+            });
+
+    // Collect results
+    for (int index = 0; index < to_read.size(); index++)
     {
-        const QString reason =
-            tr("Zero denominators in GPS altitude: \"%1\". Ignored.")
-                .arg(m_ExifData["GPSInfo"]["GPSAltitude"]);
-        MessageLogger::Error(CALL_METHOD, reason);
-        CALL_OUT(reason);
-        return NAN;
+        StoreInCache(QFileInfo(to_read[index]).absoluteFilePath(),
+            identities[index], mcIncludeMakerNotes, infos[index]);
+        if (infos[index])
+        {
+            filename_to_info[to_read[index]] = infos[index];
+        }
     }
 
-    // Convert
-    const double elevation = parse_match.captured(1).toDouble() /
-        parse_match.captured(2).toDouble();
-    if (m_ExifData["GPSInfo"]["GPSAltitudeRef"].toInt() == 1)
+    CALL_OUT("");
+    return filename_to_info;
+}
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// Keep the EXIF cache in a file
+void ExifInfo::SetCacheFilename(const QString mcFilename)
+{
+    CALL_IN(QString("mcFilename=%1")
+        .arg(CALL_SHOW_FULL(mcFilename)));
+
+    m_Cache.SetFilename(mcFilename);
+
+    CALL_OUT("");
+}
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// Look up a file in the cache
+bool ExifInfo::LookUpCache(const QString & mcrFilename,
+    const FileCacheBase::FileIdentity & mcrIdentity,
+    const bool mcIncludeMakerNotes, CacheEntry & mrEntry)
+{
+    CALL_IN(QString("mcrFilename=%1, mcrIdentity=..., "
+        "mcIncludeMakerNotes=%2, mrEntry=...")
+        .arg(CALL_SHOW(mcrFilename),
+             CALL_SHOW(mcIncludeMakerNotes)));
+
+    // The entry only counts if the file has not changed since (and has
+    // been read with maker notes if we need them)
+    CacheEntry entry;
+    if (!m_Cache.LookUp(mcrFilename, mcrIdentity, entry) ||
+        (mcIncludeMakerNotes && !entry.m_IncludesMakerNotes))
     {
         CALL_OUT("");
-        return -elevation;
-    } else
+        return false;
+    }
+    mrEntry = entry;
+
+    CALL_OUT("");
+    return true;
+}
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// Add a file to the cache
+void ExifInfo::StoreInCache(const QString & mcrFilename,
+    const FileCacheBase::FileIdentity & mcrIdentity,
+    const bool mcIncludeMakerNotes, const ExifInfo * mcpInfo)
+{
+    CALL_IN(QString("mcrFilename=%1, mcrIdentity=..., "
+        "mcIncludeMakerNotes=%2, mcpInfo=%3")
+        .arg(CALL_SHOW(mcrFilename),
+             CALL_SHOW(mcIncludeMakerNotes),
+             CALL_SHOW(mcpInfo)));
+
+    CacheEntry entry;
+    entry.m_IncludesMakerNotes = mcIncludeMakerNotes;
+    entry.m_HasExifInfo = (mcpInfo != nullptr);
+    if (mcpInfo)
     {
-        CALL_OUT("");
-        return elevation;
+        entry.m_Record = mcpInfo -> m_Record;
+
+        // Tags are only needed when somebody asks for them, so they are
+        // kept compressed
+        mcpInfo -> LoadTags();
+        QByteArray data;
+        QDataStream out(&data, QIODevice::WriteOnly);
+        out << mcpInfo -> m_MIMEType
+            << mcpInfo -> m_ExifTypes
+            << mcpInfo -> m_ExifData;
+        entry.m_Data = qCompress(data);
     }
+    m_Cache.Store(mcrFilename, mcrIdentity, entry);
 
-    // We never get here
+    CALL_OUT("");
 }
 
 
 
 ///////////////////////////////////////////////////////////////////////////////
-// Direction
-double ExifInfo::GetGPSDirection() const
+// EXIF info from a cache entry
+ExifInfo * ExifInfo::CreateExifInfoFromCache(const QString & mcrFilename,
+    const CacheEntry & mcrEntry)
 {
-    CALL_IN("");
+    CALL_IN(QString("mcrFilename=%1, mcrEntry=...")
+        .arg(CALL_SHOW(mcrFilename)));
 
-    // No GPS direction
-    if (DEBUG)
+    // Tags are decompressed when they are first needed (see LoadTags())
+    ExifInfo * info = new ExifInfo();
+    info -> m_Filename = mcrFilename;
+    info -> m_Record = mcrEntry.m_Record;
+    info -> m_CompressedTags = mcrEntry.m_Data;
+    info -> m_HasCompressedTags.store(!mcrEntry.m_Data.isEmpty(),
+        std::memory_order_release);
+
+    // Register all tags
+    if (m_CollectStatistics.load(std::memory_order_relaxed))
     {
-        qDebug().noquote() << QString("%1: No GPS direction")
-            .arg(m_Filename);
+        info -> RegisterData();
     }
 
     CALL_OUT("");
-    return NAN;
+    return info;
 }
 
 
 
 ///////////////////////////////////////////////////////////////////////////////
-// Temperature
-double ExifInfo::GetCameraTemperature() const
+// Decompress tags of EXIF info taken from the cache
+void ExifInfo::LoadTags() const
 {
     CALL_IN("");
 
-    // This is acutally the DIGIC processor temperature (in F)
-    if (m_ExifData.contains("CanonSi") &&
-        m_ExifData["CanonSi"].contains("CameraTemperature"))
+    // Nothing to do (not from the cache, or done already)
+    if (!m_HasCompressedTags.load(std::memory_order_acquire))
     {
-        const double temperature_f =
-            m_ExifData["CanonSi"]["CameraTemperature"].toInt();
-        const double temperature_c = (temperature_f - 32.) * 5./9.;
         CALL_OUT("");
-        return temperature_c;
+        return;
     }
 
-    // No temperature
-    if (DEBUG)
+    // Several threads may use the same EXIF info; only one decompresses
+    QMutexLocker lock(&m_LoadTagsMutex);
+    if (!m_HasCompressedTags.load(std::memory_order_relaxed))
     {
-        qDebug().noquote() << QString("%1: No temperature")
-            .arg(m_Filename);
+        CALL_OUT("");
+        return;
     }
 
+    // Tags don't change what the EXIF info is, so getters may load them
+    ExifInfo * info = const_cast < ExifInfo * >(this);
+    QDataStream in(qUncompress(m_CompressedTags));
+    in >> info -> m_MIMEType
+        >> info -> m_ExifTypes
+        >> info -> m_ExifData;
+    m_CompressedTags.clear();
+    m_HasCompressedTags.store(false, std::memory_order_release);
+
+    CALL_OUT("");
+}
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// Typed values in the cache file
+void ExifInfo::WriteRecord(QDataStream & mrOut, const Record & mcrRecord)
+{
+    CALL_IN("mrOut=..., mcrRecord=...");
+
+    auto write_rational = [&mrOut](const Rational & mcrRational)
+    {
+        mrOut << mcrRational.m_Numerator << mcrRational.m_Denominator;
+    };
+
+    mrOut << mcrRecord.m_ExposureDateTime;
+    write_rational(mcrRecord.m_FocalLength);
+    write_rational(mcrRecord.m_FStop);
+    write_rational(mcrRecord.m_ExposureTime);
+    write_rational(mcrRecord.m_ExposureBias);
+    mrOut << mcrRecord.m_ISORating
+        << qint32(mcrRecord.m_Flash)
+        << mcrRecord.m_Orientation;
+    write_rational(mcrRecord.m_LensMinFocalLength);
+    write_rational(mcrRecord.m_LensMaxFocalLength);
+    write_rational(mcrRecord.m_LensMinFStopAtMinFocalLength);
+    write_rational(mcrRecord.m_LensMinFStopAtMaxFocalLength);
+    mrOut << mcrRecord.m_GPSLatitude
+        << mcrRecord.m_GPSLongitude
+        << mcrRecord.m_GPSElevation;
+
     CALL_OUT("");
-    return NAN;
 }
 
 
 
 ///////////////////////////////////////////////////////////////////////////////
-// Convert rational to string
-QString ExifInfo::ConvertRational(const QString & mcrValue) const
+// Typed values in the cache file
+void ExifInfo::ReadRecord(QDataStream & mrIn, Record & mrRecord)
 {
-    CALL_IN(QString("mcrValue=%1")
-        .arg(CALL_SHOW(mcrValue)));
+    CALL_IN("mrIn=..., mrRecord=...");
 
-    static const QRegularExpression format_rational(
-        "^((\\+|-)?[0-9]+)/([0-9]+)$");
-    const QRegularExpressionMatch match_rational =
-        format_rational.match(mcrValue);
-    if (!match_rational.hasMatch())
+    auto read_rational = [&mrIn](Rational & mrRational)
     {
-        // Not a rational
-        const QString reason = tr("%1 is not valid rational value.")
-            .arg(mcrValue);
-        MessageLogger::Error(CALL_METHOD, reason);
-        CALL_OUT(reason);
-        return QString();
-    }
+        mrIn >> mrRational.m_Numerator >> mrRational.m_Denominator;
+    };
+
+    qint32 flash = FlashUnknown;
+    mrIn >> mrRecord.m_ExposureDateTime;
+    read_rational(mrRecord.m_FocalLength);
+    read_rational(mrRecord.m_FStop);
+    read_rational(mrRecord.m_ExposureTime);
+    read_rational(mrRecord.m_ExposureBias);
+    mrIn >> mrRecord.m_ISORating
+        >> flash
+        >> mrRecord.m_Orientation;
+    mrRecord.m_Flash = FlashMode(flash);
+    read_rational(mrRecord.m_LensMinFocalLength);
+    read_rational(mrRecord.m_LensMaxFocalLength);
+    read_rational(mrRecord.m_LensMinFStopAtMinFocalLength);
+    read_rational(mrRecord.m_LensMinFStopAtMaxFocalLength);
+    mrIn >> mrRecord.m_GPSLatitude
+        >> mrRecord.m_GPSLongitude
+        >> mrRecord.m_GPSElevation;
+
+    CALL_OUT("");
+}
 
-    const int counter = match_rational.captured(1).toInt();
-    const int denominator = match_rational.captured(3).toInt();
 
-    // Denominator cannot be zero
-    if (denominator == 0)
+
+///////////////////////////////////////////////////////////////////////////////
+// Cache entries in the cache file
+QDataStream & operator<<(QDataStream & mrOut,
+    const ExifInfo::CacheEntry & mcrEntry)
+{
+    mrOut << mcrEntry.m_IncludesMakerNotes
+        << mcrEntry.m_HasExifInfo;
+    if (mcrEntry.m_HasExifInfo)
     {
-        const QString reason = tr("%1 has a zero denominator.")
-            .arg(mcrValue);
-        MessageLogger::Error(CALL_METHOD, reason);
-        CALL_OUT(reason);
-        return QString();
+        ExifInfo::WriteRecord(mrOut, mcrEntry.m_Record);
+        mrOut << mcrEntry.m_Data;
     }
+    return mrOut;
+}
 
-    // Convert
-    if (counter % denominator == 0)
-    {
-        // Integer result
-        CALL_OUT("");
-        return QString("%1").arg(counter / denominator);
-    } else
+
+
+///////////////////////////////////////////////////////////////////////////////
+// Cache entries in the cache file
+QDataStream & operator>>(QDataStream & mrIn, ExifInfo::CacheEntry & mrEntry)
+{
+    mrIn >> mrEntry.m_IncludesMakerNotes
+        >> mrEntry.m_HasExifInfo;
+    if (mrEntry.m_HasExifInfo)
     {
-        // Decimal result
-        CALL_OUT("");
-        return QString("%1").arg(counter * 1. / denominator, 0, 'f', 1);
+        ExifInfo::ReadRecord(mrIn, mrEntry.m_Record);
+        mrIn >> mrEntry.m_Data;
     }
+    return mrIn;
+}
 
-    // We never get here
+
+
+///////////////////////////////////////////////////////////////////////////////
+// Save the EXIF cache
+bool ExifInfo::SaveCache()
+{
+    CALL_IN("");
+
+    const bool success = m_Cache.Save();
+
+    CALL_OUT("");
+    return success;
 }
 
 
 
+///////////////////////////////////////////////////////////////////////////////
+// Cache
+FileCache < QString, ExifInfo::CacheEntry > ExifInfo::m_Cache(CACHE_MAGIC,
+    CACHE_VERSION, "an EXIF cache");
+
+
+
 // ============================================================== Known Cameras
 
 
 
 ///////////////////////////////////////////////////////////////////////////////
-// Initialize all mappers
-bool ExifInfo::InitializeMappers()
+// Mapper entry: value as found in the file, normalized value
+struct MapperEntry
 {
-    CALL_IN("");
+    std::string_view m_Key;
+    std::string_view m_Value;
+};
 
-    Init_CameraMakerMapper();
-    Init_CameraModelMapper();
-    Init_LensMakerMapper();
-    Init_LensModelMapper();
-    Init_FStopMapper();
-    Init_FocalLengthMapper();
-    Init_ExposureTimeMapper();
 
-    CALL_OUT("");
+
+///////////////////////////////////////////////////////////////////////////////
+// Check if a mapper is sorted (lookup uses binary search)
+template < std::size_t N >
+constexpr bool IsSorted(const MapperEntry (& mcrMapper)[N])
+{
+    for (std::size_t index = 1; index < N; index++)
+    {
+        if (!(mcrMapper[index - 1].m_Key < mcrMapper[index].m_Key))
+        {
+            return false;
+        }
+    }
     return true;
 }
 
-const bool ExifInfo::m_MappersInitialized = ExifInfo::InitializeMappers();
-
 
 
 ///////////////////////////////////////////////////////////////////////////////
-// Camera maker mapper
-void ExifInfo::Init_CameraMakerMapper()
+// Find a value in a mapper
+template < std::size_t N >
+const MapperEntry * FindInMapper(const MapperEntry (& mcrMapper)[N],
+    const std::string_view mcKey)
 {
-    CALL_IN("");
+    const MapperEntry * found = std::lower_bound(std::begin(mcrMapper),
+        std::end(mcrMapper), mcKey,
+        [](const MapperEntry & mcrEntry, const std::string_view mcValue)
+        {
+            return mcrEntry.m_Key < mcValue;
+        });
+    if (found == std::end(mcrMapper) ||
+        found -> m_Key != mcKey)
+    {
+        return nullptr;
+    }
+    return found;
+}
 
-    // Add makers
-    m_CameraMakerMapper["Apple"] = "Apple";
-    m_CameraMakerMapper["Canon"] = "Canon";
-    m_CameraMakerMapper["CASIO"] = "Casio";
-    m_CameraMakerMapper["CASIO COMPUTER CO.,LTD"] = "Casio";
-    m_CameraMakerMapper["CASIO COMPUTER CO.,LTD."] = "Casio";
-    m_CameraMakerMapper["CONCORD  OPTICAL CO,LTD"] = "Concord";
-    m_CameraMakerMapper["Cruse Scanner"] = "Cruse Scanner";
-    m_CameraMakerMapper["EASTMAN KODAK COMPANY"] = "Kodak";
-    m_CameraMakerMapper["Eastman Kodak Company"] = "Kodak";
-    m_CameraMakerMapper["EPSON"] = "Epson";
-    m_CameraMakerMapper["FUJIFILM"] = "Fujifilm";
-    m_CameraMakerMapper["FUJIFILM Corporation"] = "Fujifilm";
-    m_CameraMakerMapper["Gateway"] = "Gateway";
-    m_CameraMakerMapper["General Imaging Co."] = "General Imaging";
-    m_CameraMakerMapper["Google"] = "Google";
-    m_CameraMakerMapper["Hasselblad"] = "Hasselblad";
-    m_CameraMakerMapper["Hewlett-Packard"] = "Hewlett-Packard";
-    m_CameraMakerMapper["Hewlett-Packard"] = "Hewlett-Packard";
-    m_CameraMakerMapper["HP"] = "Hewlett-Packard";
-    m_CameraMakerMapper["HTC"] = "HTC";
-    m_CameraMakerMapper["HUAWEI"] = "Huawei";
-    m_CameraMakerMapper["KONICA"] = "Konica";
-    m_CameraMakerMapper["KONICA MINOLTA"] = "Konica Minolta";
-    m_CameraMakerMapper["KONICA MINOLTA"] = "Konica Minolta";
-    m_CameraMakerMapper["Konica Minolta Camera, Inc."] = "Konica Minolta";
-    m_CameraMakerMapper["KYOCERA"] = "Kyocera";
-    m_CameraMakerMapper["LEICA"] = "Leica";
-    m_CameraMakerMapper["Leica Camera AG"] = "Leica";
-    m_CameraMakerMapper["LG Electronics"] = "LG Electronics";
-    m_CameraMakerMapper["Microsoft"] = "Microsoft";
-    m_CameraMakerMapper["MINOLTA CO.,LTD"] = "Minolta";
-    m_CameraMakerMapper["Minolta Co., Ltd"] = "Minolta";
-    m_CameraMakerMapper["Minolta Co., Ltd."] = "Minolta";
-    m_CameraMakerMapper["Motorola"] = "Motorola";
-    m_CameraMakerMapper["motorola"] = "Motorola";
-    m_CameraMakerMapper["NIKON"] = "Nikon";
-    m_CameraMakerMapper["NIKON CORPORATION"] = "Nikon";
-    m_CameraMakerMapper["Nikon Inc.."] = "Nikon";
-    m_CameraMakerMapper["Nokia"] = "Nokia";
-    m_CameraMakerMapper["OLYMPUS CORPORATION"] = "Olympus";
-    m_CameraMakerMapper["OLYMPUS CORPORATION"] = "Olympus";
-    m_CameraMakerMapper["OLYMPUS IMAGING CORP."] = "Olympus";
-    m_CameraMakerMapper["OLYMPUS IMAGING CORP."] = "Olympus";
-    m_CameraMakerMapper["OLYMPUS OPTICAL CO.,LTD"] = "Olympus";
-    m_CameraMakerMapper["PENTAX"] = "Pentax";
-    m_CameraMakerMapper["PENTAX"] = "Pentax";
-    m_CameraMakerMapper["PENTAX Corporation"] = "Pentax";
-    m_CameraMakerMapper["PENTAX Corporation"] = "Pentax";
-    m_CameraMakerMapper["Panasonic"] = "Panasonic";
-    m_CameraMakerMapper["Phase One"] = "Phase One";
-    m_CameraMakerMapper["Polaroid"] = "Polaroid";
-    m_CameraMakerMapper["RICOH"] = "Ricoh";
-    m_CameraMakerMapper["SAMSUNG"] = "Samsung";
-    m_CameraMakerMapper["samsung"] = "Samsung";
-    m_CameraMakerMapper["Samsung Techwin"] = "Samsung";
-    m_CameraMakerMapper["SAMSUNG TECHWIN CO., LTD."] = "Samsung";
-    m_CameraMakerMapper["SANYO Electric Co.,Ltd."] = "Sanyo";
-    m_CameraMakerMapper["SONY"] = "Sony";
-    m_CameraMakerMapper["Sony"] = "Sony";
-    m_CameraMakerMapper["SONY"] = "Sony";
-    m_CameraMakerMapper["Sony Ericsson"] = "Sony Ericsson";
-    m_CameraMakerMapper["Supra"] = "Supra";
-    m_CameraMakerMapper["TECNO"] = "TECNO";
-    m_CameraMakerMapper["TOSHIBA"] = "Toshiba";
-    m_CameraMakerMapper["Xiaomi"] = "Xiaomi";
-    m_CameraMakerMapper["ZTE"] = "ZTE";
 
-    CALL_OUT("");
-}
+
+///////////////////////////////////////////////////////////////////////////////
+// Camera maker mapper
+static constexpr MapperEntry CAMERA_MAKER_MAPPER[] =
+{
+    { "Apple", "Apple" },
+    { "CASIO", "Casio" },
+    { "CASIO COMPUTER CO.,LTD", "Casio" },
+    { "CASIO COMPUTER CO.,LTD.", "Casio" },
+    { "CONCORD  OPTICAL CO,LTD", "Concord" },
+    { "Canon", "Canon" },
+    { "Cruse Scanner", "Cruse Scanner" },
+    { "EASTMAN KODAK COMPANY", "Kodak" },
+    { "EPSON", "Epson" },
+    { "Eastman Kodak Company", "Kodak" },
+    { "FUJIFILM", "Fujifilm" },
+    { "FUJIFILM Corporation", "Fujifilm" },
+    { "Gateway", "Gateway" },
+    { "General Imaging Co.", "General Imaging" },
+    { "Google", "Google" },
+    { "HP", "Hewlett-Packard" },
+    { "HTC", "HTC" },
+    { "HUAWEI", "Huawei" },
+    { "Hasselblad", "Hasselblad" },
+    { "Hewlett-Packard", "Hewlett-Packard" },
+    { "KONICA", "Konica" },
+    { "KONICA MINOLTA", "Konica Minolta" },
+    { "KYOCERA", "Kyocera" },
+    { "Konica Minolta Camera, Inc.", "Konica Minolta" },
+    { "LEICA", "Leica" },
+    { "LG Electronics", "LG Electronics" },
+    { "Leica Camera AG", "Leica" },
+    { "MINOLTA CO.,LTD", "Minolta" },
+    { "Microsoft", "Microsoft" },
+    { "Minolta Co., Ltd", "Minolta" },
+    { "Minolta Co., Ltd.", "Minolta" },
+    { "Motorola", "Motorola" },
+    { "NIKON", "Nikon" },
+    { "NIKON CORPORATION", "Nikon" },
+    { "Nikon Inc..", "Nikon" },
+    { "Nokia", "Nokia" },
+    { "OLYMPUS CORPORATION", "Olympus" },
+    { "OLYMPUS IMAGING CORP.", "Olympus" },
+    { "OLYMPUS OPTICAL CO.,LTD", "Olympus" },
+    { "PENTAX", "Pentax" },
+    { "PENTAX Corporation", "Pentax" },
+    { "Panasonic", "Panasonic" },
+    { "Phase One", "Phase One" },
+    { "Polaroid", "Polaroid" },
+    { "RICOH", "Ricoh" },
+    { "SAMSUNG", "Samsung" },
+    { "SAMSUNG TECHWIN CO., LTD.", "Samsung" },
+    { "SANYO Electric Co.,Ltd.", "Sanyo" },
+    { "SONY", "Sony" },
+    { "Samsung Techwin", "Samsung" },
+    { "Sony", "Sony" },
+    { "Sony Ericsson", "Sony Ericsson" },
+    { "Supra", "Supra" },
+    { "TECNO", "TECNO" },
+    { "TOSHIBA", "Toshiba" },
+    { "Xiaomi", "Xiaomi" },
+    { "ZTE", "ZTE" },
+    { "motorola", "Motorola" },
+    { "samsung", "Samsung" },
+};
+static_assert(IsSorted(CAMERA_MAKER_MAPPER),
+    "CAMERA_MAKER_MAPPER must be sorted");
 
 
 
 ///////////////////////////////////////////////////////////////////////////////
 // Camera model mapper
-void ExifInfo::Init_CameraModelMapper()
+// (key is "<normalized maker>.<model as found in the file>")
+static constexpr MapperEntry CAMERA_MODEL_MAPPER[] =
 {
-    CALL_IN("");
-
-    // No model
-    m_CameraModelMapper["."] = "";
+    // No maker
+    { ".", "" },
 
     // Apple
-    m_CameraModelMapper["Apple.iPad"] = "iPad";
-    m_CameraModelMapper["Apple.iPad mini"] = "iPad mini";
-    m_CameraModelMapper["Apple.iPhone 3GS"] = "iPhone 3GS";
-    m_CameraModelMapper["Apple.iPhone 4"] = "iPhone 4";
-    m_CameraModelMapper["Apple.iPhone 4S"] = "iPhone 4S";
-    m_CameraModelMapper["Apple.iPhone 5"] = "iPhone 5";
-    m_CameraModelMapper["Apple.iPhone 5s"] = "iPhone 5s";
-    m_CameraModelMapper["Apple.iPhone 6"] = "iPhone 6";
-    m_CameraModelMapper["Apple.iPhone 6s"] = "iPhone 6s";
-    m_CameraModelMapper["Apple.iPhone 6s Plus"] = "iPhone 6s Plus";
-    m_CameraModelMapper["Apple.iPhone 7"] = "iPhone 7";
-    m_CameraModelMapper["Apple.iPhone 8"] = "iPhone 8";
-    m_CameraModelMapper["Apple.iPhone 11"] = "iPhone 11";
-    m_CameraModelMapper["Apple.iPhone 11 Pro Max"] = "iPhone 11 Pro Max";
-    m_CameraModelMapper["Apple.iPhone 12"] = "iPhone 12";
-    m_CameraModelMapper["Apple.iPhone 12 Pro"] = "iPhone 12 Pro";
-    m_CameraModelMapper["Apple.iPhone 12 Pro Max"] = "iPhone 12 Pro Max";
-    m_CameraModelMapper["Apple.iPhone 15"] = "iPhone 15";
-    m_CameraModelMapper["Apple.iPhone 15 Pro"] = "iPhone 15 Pro";
-    m_CameraModelMapper["Apple.iPhone 15 Pro Max"] = "iPhone 15 Pro Max";
-    m_CameraModelMapper["Apple.iPhone 16"] = "iPhone 16";
-    m_CameraModelMapper["Apple.iPhone 16e"] = "iPhone 16e";
-    m_CameraModelMapper["Apple.iPhone 16 Pro Max"] = "iPhone 16 Pro Max";
-    m_CameraModelMapper["Apple.iPhone SE (2nd generation)"] = "iPhone SE 2";
-    m_CameraModelMapper["Apple.iPhone SE (3rd generation)"] = "iPhone SE 3";
+    { "Apple.iPad", "iPad" },
+    { "Apple.iPad mini", "iPad mini" },
+    { "Apple.iPhone 11", "iPhone 11" },
+    { "Apple.iPhone 11 Pro Max", "iPhone 11 Pro Max" },
+    { "Apple.iPhone 12", "iPhone 12" },
+    { "Apple.iPhone 12 Pro", "iPhone 12 Pro" },
+    { "Apple.iPhone 12 Pro Max", "iPhone 12 Pro Max" },
+    { "Apple.iPhone 15", "iPhone 15" },
+    { "Apple.iPhone 15 Pro", "iPhone 15 Pro" },
+    { "Apple.iPhone 15 Pro Max", "iPhone 15 Pro Max" },
+    { "Apple.iPhone 16", "iPhone 16" },
+    { "Apple.iPhone 16 Pro Max", "iPhone 16 Pro Max" },
+    { "Apple.iPhone 16e", "iPhone 16e" },
+    { "Apple.iPhone 3GS", "iPhone 3GS" },
+    { "Apple.iPhone 4", "iPhone 4" },
+    { "Apple.iPhone 4S", "iPhone 4S" },
+    { "Apple.iPhone 5", "iPhone 5" },
+    { "Apple.iPhone 5s", "iPhone 5s" },
+    { "Apple.iPhone 6", "iPhone 6" },
+    { "Apple.iPhone 6s", "iPhone 6s" },
+    { "Apple.iPhone 6s Plus", "iPhone 6s Plus" },
+    { "Apple.iPhone 7", "iPhone 7" },
+    { "Apple.iPhone 8", "iPhone 8" },
+    { "Apple.iPhone SE (2nd generation)", "iPhone SE 2" },
+    { "Apple.iPhone SE (3rd generation)", "iPhone SE 3" },
 
     // Canon
-    m_CameraModelMapper["Canon.CanoScan 5600F"] = "CanoScan 5600F";
-    m_CameraModelMapper["Canon.CanoScan LiDE 25"] = "CanoScan LiDE 25";
-    m_CameraModelMapper["Canon.CanoScan LiDE 100"] = "CanoScan LiDE 100";
-    m_CameraModelMapper["Canon.CanoScan LiDE 120"] = "CanoScan LiDE 120";
-    m_CameraModelMapper["Canon.CanoScan LiDE 400"] = "CanoScan LiDE 400";
-    m_CameraModelMapper["Canon.CanoScan LiDE 700F"] = "CanoScan LiDE 700F";
-
-    m_CameraModelMapper["Canon.Canon DC20"] = "DC20";
-
-    m_CameraModelMapper["Canon.Canon DIGITAL IXUS 110 IS"] =
-        "Digital Ixus 110 IS";
-    m_CameraModelMapper["Canon.Canon DIGITAL IXUS v2"] = "Digital Ixus V2";
-    m_CameraModelMapper["Canon.Canon IXUS 240 HS"] = "Ixus 240 HS";
-
-    m_CameraModelMapper["Canon.Canon EOS-1D Mark II"] = "EOS 1D Mark II";
-    m_CameraModelMapper["Canon.Canon EOS-1DS"] = "EOS 1Ds";
-    m_CameraModelMapper["Canon.Canon EOS-1Ds Mark II"] = "EOS 1Ds Mark II";
-    m_CameraModelMapper["Canon.Canon EOS-1Ds Mark III"] = "EOS 1Ds Mark III";
-    m_CameraModelMapper["Canon.Canon EOS-1D Mark III"] = "EOS 1D Mark III";
-    m_CameraModelMapper["Canon.Canon EOS-1D Mark IV"] = "EOS 1D Mark IV";
-    m_CameraModelMapper["Canon.Canon EOS-1D X"] = "EOS 1D X";
-    m_CameraModelMapper["Canon.Canon EOS 5D"] = "EOS 5D";
-    m_CameraModelMapper["Canon.Canon EOS 5D Mark II"] = "EOS 5D Mark II";
-    m_CameraModelMapper["Canon.Canon EOS 5D Mark III"] = "EOS 5D Mark III";
-    m_CameraModelMapper["Canon.Canon EOS 5D Mark IV"] = "EOS 5D Mark IV";
-    m_CameraModelMapper["Canon.Canon EOS 6D"] = "EOS 6D";
-    m_CameraModelMapper["Canon.Canon EOS 6D Mark II"] = "EOD 6D Mark II";
-    m_CameraModelMapper["Canon.Canon EOS 7D"] = "EOS 7D";
-    m_CameraModelMapper["Canon.Canon EOS 7D Mark II"] = "EOS 7D Mark II";
-    m_CameraModelMapper["Canon.Canon EOS Rebel T6s"] = "EOS Rebel T6s";
-    m_CameraModelMapper["Canon.Canon EOS 10D"] = "EOS 10D";
-    m_CameraModelMapper["Canon.Canon EOS 20D"] = "EOS 20D";
-    m_CameraModelMapper["Canon.Canon EOS 30D"] = "EOS 30D";
-    m_CameraModelMapper["Canon.Canon EOS 40D"] = "EOS 40D";
-    m_CameraModelMapper["Canon.Canon EOS 50D"] = "EOS 50D";
-    m_CameraModelMapper["Canon.Canon EOS 60D"] = "EOS 60D";
-    m_CameraModelMapper["Canon.Canon EOS 70D"] = "EOS 70D";
-    m_CameraModelMapper["Canon.Canon EOS 77D"] = "EOS 77D";
-    m_CameraModelMapper["Canon.Canon EOS 80D"] = "EOS 80D";
-    m_CameraModelMapper["Canon.Canon EOS 90D"] = "EOS 90D";
-    m_CameraModelMapper["Canon.Canon EOS 300D DIGITAL"] = "EOS 300D";
-    m_CameraModelMapper["Canon.Canon EOS 350D DIGITAL"] = "EOS 350D";
-    m_CameraModelMapper["Canon.Canon EOS 400D DIGITAL"] = "EOS 400D";
-    m_CameraModelMapper["Canon.Canon EOS 450D"] = "EOS 450D";
-    m_CameraModelMapper["Canon.Canon EOS 500D"] = "EOS 500D";
-    m_CameraModelMapper["Canon.Canon EOS 550D"] = "EOS 550D";
-    m_CameraModelMapper["Canon.Canon EOS 600D"] = "EOS 600D";
-    m_CameraModelMapper["Canon.Canon EOS 700D"] = "EOS 700D";
-    m_CameraModelMapper["Canon.Canon EOS 760D"] = "EOS 760D";
-    m_CameraModelMapper["Canon.Canon EOS 1000D"] = "EOS 1000D";
-    m_CameraModelMapper["Canon.Canon EOS 1100D"] = "EOS 1100D";
-    m_CameraModelMapper["Canon.Canon EOS 1200D"] = "EOS 1200D";
-    m_CameraModelMapper["Canon.Canon EOS D30"] = "EOS D30";
-    m_CameraModelMapper["Canon.Canon EOS DIGITAL REBEL"] = "EOS Digital Rebel";
-    m_CameraModelMapper["Canon.Canon EOS DIGITAL REBEL XS"] =
-        "EOS Digital Rebel XS";
-    m_CameraModelMapper["Canon.Canon EOS DIGITAL REBEL XSi"] =
-        "EOS Digital Rebel XSi";
-    m_CameraModelMapper["Canon.Canon EOS DIGITAL REBEL XT"] =
-        "EOS Digital Rebel XT";
-    m_CameraModelMapper["Canon.Canon EOS DIGITAL REBEL XTi"] =
-        "EOS Digital Rebel XTi";
-    m_CameraModelMapper["Canon.Canon EOS Kiss X4"] =
-        "EOS Kiss X4"; // Same as 550D
-    m_CameraModelMapper["Canon.Canon EOS M50"] = "EOS M50";
-    m_CameraModelMapper["Canon.Canon EOS M50m2"] = "EOS M50 Mark II";
-    m_CameraModelMapper["Canon.Canon EOS R6"] = "EOS R6";
-    m_CameraModelMapper["Canon.Canon EOS R6m2"] = "EOS R6 Mark II";
-    m_CameraModelMapper["Canon.Canon EOS REBEL T1i"] = "EOS Digital Rebel T1i";
-    m_CameraModelMapper["Canon.Canon EOS REBEL T3"] = "EOS Digital Rebel T3";
-    m_CameraModelMapper["Canon.Canon EOS REBEL T2i"] = "EOS Digital Rebel T2i";
-    m_CameraModelMapper["Canon.Canon EOS REBEL T3i"] = "EOS Digital Rebel T3i";
-
-    m_CameraModelMapper["Canon.Canon MF3200 Series"] = "imageCLASS MF3200";
-    m_CameraModelMapper["Canon.Canon MG6200 series"] = "imageCLASS MG6200";
-    m_CameraModelMapper["Canon.MP250 series"] = "PIXMA MP250";
-    m_CameraModelMapper["Canon.MP610 series"] = "PIXMA MP610";
-    m_CameraModelMapper["Canon.MP560 series"] = "PIXMA MP560";
-    m_CameraModelMapper["Canon.MX330 series"] = "PIXMA MX330";
-    m_CameraModelMapper["Canon.MX450 series"] = "PIXMA MX450";
-    m_CameraModelMapper["Canon.MX870 series"] = "PIXMA MX870";
-
-    m_CameraModelMapper["Canon.Canon PowerShot A60"] = "PowerShot A60";
-    m_CameraModelMapper["Canon.Canon PowerShot A70"] = "PowerShot A70";
-    m_CameraModelMapper["Canon.Canon PowerShot A75"] = "PowerShot A75";
-    m_CameraModelMapper["Canon.Canon PowerShot A80"] = "PowerShot A80";
-    m_CameraModelMapper["Canon.Canon PowerShot A95"] = "PowerShot A95";
-    m_CameraModelMapper["Canon.Canon PowerShot A400"] = "PowerShot A400";
-    m_CameraModelMapper["Canon.Canon PowerShot A410"] = "PowerShot A410";
-    m_CameraModelMapper["Canon.Canon PowerShot A430"] = "PowerShot A430";
-    m_CameraModelMapper["Canon.Canon PowerShot A510"] = "PowerShot A510";
-    m_CameraModelMapper["Canon.Canon PowerShot A520"] = "PowerShot A520";
-    m_CameraModelMapper["Canon.Canon PowerShot A530"] = "PowerShot A530";
-    m_CameraModelMapper["Canon.Canon PowerShot A550"] = "PowerShot A550";
-    m_CameraModelMapper["Canon.Canon PowerShot A560"] = "PowerShot A560";
-    m_CameraModelMapper["Canon.Canon PowerShot A570 IS"] = "PowerShot A570 IS";
-    m_CameraModelMapper["Canon.Canon PowerShot A610"] = "PowerShot A610";
-    m_CameraModelMapper["Canon.Canon PowerShot A620"] = "PowerShot A620";
-    m_CameraModelMapper["Canon.Canon PowerShot A650 IS"] = "PowerShot A650 IS";
-    m_CameraModelMapper["Canon.Canon PowerShot A720 IS"] = "PowerShot A720 IS";
-    m_CameraModelMapper["Canon.Canon PowerShot A800"] = "PowerShot A800";
-    m_CameraModelMapper["Canon.Canon PowerShot A3100 IS"] =
-        "PowerShot A3100 IS";
-    m_CameraModelMapper["Canon.Canon PowerShot A4000 IS"] =
-        "PowerShot A4000 IS";
-    m_CameraModelMapper["Canon.Canon PowerShot G2"] = "PowerShot G2";
-    m_CameraModelMapper["Canon.Canon PowerShot G6"] = "PowerShot G6";
-    m_CameraModelMapper["Canon.Canon PowerShot G9"] = "PowerShot G9";
-    m_CameraModelMapper["Canon.Canon PowerShot G11"] = "PowerShot G11";
-    m_CameraModelMapper["Canon.Canon PowerShot G12"] = "PowerShot G12";
-    m_CameraModelMapper["Canon.Canon PowerShot S1 IS"] = "PowerShot S1 IS";
-    m_CameraModelMapper["Canon.Canon PowerShot S2 IS"] = "PowerShot S2 IS";
-    m_CameraModelMapper["Canon.Canon PowerShot S3 IS"] = "PowerShot S3 IS";
-    m_CameraModelMapper["Canon.Canon PowerShot S5 IS"] = "PowerShot S5 IS";
-    m_CameraModelMapper["Canon.Canon PowerShot S30"] = "PowerShot S30";
-    m_CameraModelMapper["Canon.Canon PowerShot S50"] = "PowerShot S50";
-    m_CameraModelMapper["Canon.Canon PowerShot S60"] = "PowerShot S60";
-    m_CameraModelMapper["Canon.Canon PowerShot S90"] = "PowerShot S90";
-    m_CameraModelMapper["Canon.Canon PowerShot SD780 IS"] =
-        "PowerShot SD780 IS";
-    m_CameraModelMapper["Canon.Canon PowerShot SD800 IS"] =
-        "PowerShot SD800 IS";
-    m_CameraModelMapper["Canon.Canon PowerShot SD900"] = "PowerShot SD900";
-    m_CameraModelMapper["Canon.Canon PowerShot SD1400 IS"] =
-        "PowerShot SD1400 IS";
-    m_CameraModelMapper["Canon.Canon PowerShot SX10 IS"] = "PowerShot SX10 IS";
-    m_CameraModelMapper["Canon.Canon PowerShot SX20 IS"] = "PowerShot SX20 IS";
-    m_CameraModelMapper["Canon.Canon PowerShot SX100 IS"] =
-        "PowerShot SX100 IS";
-    m_CameraModelMapper["Canon.Canon PowerShot SX120 IS"] =
-        "PowerShot SX120 IS";
-    m_CameraModelMapper["Canon.Canon PowerShot SX130 IS"] =
-        "PowerShot SX130 IS";
-    m_CameraModelMapper["Canon.Canon PowerShot SX160 IS"] =
-        "PowerShot SX160 IS";
-    m_CameraModelMapper["Canon.Canon PowerShot SX200 IS"] =
-        "PowerShot SX200 IS";
-    m_CameraModelMapper["Canon.Canon PowerShot SX210 IS"] =
-        "PowerShot SX210 IS";
-    m_CameraModelMapper["Canon.Canon PowerShot SX260 HS"] =
-        "PowerShot SX260 HS";
+    { "Canon.CanoScan 5600F", "CanoScan 5600F" },
+    { "Canon.CanoScan LiDE 100", "CanoScan LiDE 100" },
+    { "Canon.CanoScan LiDE 120", "CanoScan LiDE 120" },
+    { "Canon.CanoScan LiDE 25", "CanoScan LiDE 25" },
+    { "Canon.CanoScan LiDE 400", "CanoScan LiDE 400" },
+    { "Canon.CanoScan LiDE 700F", "CanoScan LiDE 700F" },
+    { "Canon.Canon DC20", "DC20" },
+    { "Canon.Canon DIGITAL IXUS 110 IS", "Digital Ixus 110 IS" },
+    { "Canon.Canon DIGITAL IXUS v2", "Digital Ixus V2" },
+    { "Canon.Canon EOS 1000D", "EOS 1000D" },
+    { "Canon.Canon EOS 10D", "EOS 10D" },
+    { "Canon.Canon EOS 1100D", "EOS 1100D" },
+    { "Canon.Canon EOS 1200D", "EOS 1200D" },
+    { "Canon.Canon EOS 20D", "EOS 20D" },
+    { "Canon.Canon EOS 300D DIGITAL", "EOS 300D" },
+    { "Canon.Canon EOS 30D", "EOS 30D" },
+    { "Canon.Canon EOS 350D DIGITAL", "EOS 350D" },
+    { "Canon.Canon EOS 400D DIGITAL", "EOS 400D" },
+    { "Canon.Canon EOS 40D", "EOS 40D" },
+    { "Canon.Canon EOS 450D", "EOS 450D" },
+    { "Canon.Canon EOS 500D", "EOS 500D" },
+    { "Canon.Canon EOS 50D", "EOS 50D" },
+    { "Canon.Canon EOS 550D", "EOS 550D" },
+    { "Canon.Canon EOS 5D", "EOS 5D" },
+    { "Canon.Canon EOS 5D Mark II", "EOS 5D Mark II" },
+    { "Canon.Canon EOS 5D Mark III", "EOS 5D Mark III" },
+    { "Canon.Canon EOS 5D Mark IV", "EOS 5D Mark IV" },
+    { "Canon.Canon EOS 600D", "EOS 600D" },
+    { "Canon.Canon EOS 60D", "EOS 60D" },
+    { "Canon.Canon EOS 6D", "EOS 6D" },
+    { "Canon.Canon EOS 6D Mark II", "EOD 6D Mark II" },
+    { "Canon.Canon EOS 700D", "EOS 700D" },
+    { "Canon.Canon EOS 70D", "EOS 70D" },
+    { "Canon.Canon EOS 760D", "EOS 760D" },
+    { "Canon.Canon EOS 77D", "EOS 77D" },
+    { "Canon.Canon EOS 7D", "EOS 7D" },
+    { "Canon.Canon EOS 7D Mark II", "EOS 7D Mark II" },
+    { "Canon.Canon EOS 80D", "EOS 80D" },
+    { "Canon.Canon EOS 90D", "EOS 90D" },
+    { "Canon.Canon EOS D30", "EOS D30" },
+    { "Canon.Canon EOS DIGITAL REBEL", "EOS Digital Rebel" },
+    { "Canon.Canon EOS DIGITAL REBEL XS", "EOS Digital Rebel XS" },
+    { "Canon.Canon EOS DIGITAL REBEL XSi", "EOS Digital Rebel XSi" },
+    { "Canon.Canon EOS DIGITAL REBEL XT", "EOS Digital Rebel XT" },
+    { "Canon.Canon EOS DIGITAL REBEL XTi", "EOS Digital Rebel XTi" },
+    { "Canon.Canon EOS Kiss X4", "EOS Kiss X4" },
+    { "Canon.Canon EOS M50", "EOS M50" },
+    { "Canon.Canon EOS M50m2", "EOS M50 Mark II" },
+    { "Canon.Canon EOS R6", "EOS R6" },
+    { "Canon.Canon EOS R6m2", "EOS R6 Mark II" },
+    { "Canon.Canon EOS REBEL T1i", "EOS Digital Rebel T1i" },
+    { "Canon.Canon EOS REBEL T2i", "EOS Digital Rebel T2i" },
+    { "Canon.Canon EOS REBEL T3", "EOS Digital Rebel T3" },
+    { "Canon.Canon EOS REBEL T3i", "EOS Digital Rebel T3i" },
+    { "Canon.Canon EOS Rebel T6s", "EOS Rebel T6s" },
+    { "Canon.Canon EOS-1D Mark II", "EOS 1D Mark II" },
+    { "Canon.Canon EOS-1D Mark III", "EOS 1D Mark III" },
+    { "Canon.Canon EOS-1D Mark IV", "EOS 1D Mark IV" },
+    { "Canon.Canon EOS-1D X", "EOS 1D X" },
+    { "Canon.Canon EOS-1DS", "EOS 1Ds" },
+    { "Canon.Canon EOS-1Ds Mark II", "EOS 1Ds Mark II" },
+    { "Canon.Canon EOS-1Ds Mark III", "EOS 1Ds Mark III" },
+    { "Canon.Canon IXUS 240 HS", "Ixus 240 HS" },
+    { "Canon.Canon MF3200 Series", "imageCLASS MF3200" },
+    { "Canon.Canon MG6200 series", "imageCLASS MG6200" },
+    { "Canon.Canon PowerShot A3100 IS", "PowerShot A3100 IS" },
+    { "Canon.Canon PowerShot A400", "PowerShot A400" },
+    { "Canon.Canon PowerShot A4000 IS", "PowerShot A4000 IS" },
+    { "Canon.Canon PowerShot A410", "PowerShot A410" },
+    { "Canon.Canon PowerShot A430", "PowerShot A430" },
+    { "Canon.Canon PowerShot A510", "PowerShot A510" },
+    { "Canon.Canon PowerShot A520", "PowerShot A520" },
+    { "Canon.Canon PowerShot A530", "PowerShot A530" },
+    { "Canon.Canon PowerShot A550", "PowerShot A550" },
+    { "Canon.Canon PowerShot A560", "PowerShot A560" },
+    { "Canon.Canon PowerShot A570 IS", "PowerShot A570 IS" },
+    { "Canon.Canon PowerShot A60", "PowerShot A60" },
+    { "Canon.Canon PowerShot A610", "PowerShot A610" },
+    { "Canon.Canon PowerShot A620", "PowerShot A620" },
+    { "Canon.Canon PowerShot A650 IS", "PowerShot A650 IS" },
+    { "Canon.Canon PowerShot A70", "PowerShot A70" },
+    { "Canon.Canon PowerShot A720 IS", "PowerShot A720 IS" },
+    { "Canon.Canon PowerShot A75", "PowerShot A75" },
+    { "Canon.Canon PowerShot A80", "PowerShot A80" },
+    { "Canon.Canon PowerShot A800", "PowerShot A800" },
+    { "Canon.Canon PowerShot A95", "PowerShot A95" },
+    { "Canon.Canon PowerShot G11", "PowerShot G11" },
+    { "Canon.Canon PowerShot G12", "PowerShot G12" },
+    { "Canon.Canon PowerShot G2", "PowerShot G2" },
+    { "Canon.Canon PowerShot G6", "PowerShot G6" },
+    { "Canon.Canon PowerShot G9", "PowerShot G9" },
+    { "Canon.Canon PowerShot S1 IS", "PowerShot S1 IS" },
+    { "Canon.Canon PowerShot S2 IS", "PowerShot S2 IS" },
+    { "Canon.Canon PowerShot S3 IS", "PowerShot S3 IS" },
+    { "Canon.Canon PowerShot S30", "PowerShot S30" },
+    { "Canon.Canon PowerShot S5 IS", "PowerShot S5 IS" },
+    { "Canon.Canon PowerShot S50", "PowerShot S50" },
+    { "Canon.Canon PowerShot S60", "PowerShot S60" },
+    { "Canon.Canon PowerShot S90", "PowerShot S90" },
+    { "Canon.Canon PowerShot SD1400 IS", "PowerShot SD1400 IS" },
+    { "Canon.Canon PowerShot SD780 IS", "PowerShot SD780 IS" },
+    { "Canon.Canon PowerShot SD800 IS", "PowerShot SD800 IS" },
+    { "Canon.Canon PowerShot SD900", "PowerShot SD900" },
+    { "Canon.Canon PowerShot SX10 IS", "PowerShot SX10 IS" },
+    { "Canon.Canon PowerShot SX100 IS", "PowerShot SX100 IS" },
+    { "Canon.Canon PowerShot SX120 IS", "PowerShot SX120 IS" },
+    { "Canon.Canon PowerShot SX130 IS", "PowerShot SX130 IS" },
+    { "Canon.Canon PowerShot SX160 IS", "PowerShot SX160 IS" },
+    { "Canon.Canon PowerShot SX20 IS", "PowerShot SX20 IS" },
+    { "Canon.Canon PowerShot SX200 IS", "PowerShot SX200 IS" },
+    { "Canon.Canon PowerShot SX210 IS", "PowerShot SX210 IS" },
+    { "Canon.Canon PowerShot SX260 HS", "PowerShot SX260 HS" },
+    { "Canon.MP250 series", "PIXMA MP250" },
+    { "Canon.MP560 series", "PIXMA MP560" },
+    { "Canon.MP610 series", "PIXMA MP610" },
+    { "Canon.MX330 series", "PIXMA MX330" },
+    { "Canon.MX450 series", "PIXMA MX450" },
+    { "Canon.MX870 series", "PIXMA MX870" },
 
     // Casio
-    m_CameraModelMapper["Casio.EX-FH20"] = "Exilim EX-FH20";
-    m_CameraModelMapper["Casio.EX-P505"] = "Exilim EX-P505";
-    m_CameraModelMapper["Casio.EX-S600"] = "Exilim EX-S600";
-    m_CameraModelMapper["Casio.EX-Z15"] = "Exilim EX-Z15";
-    m_CameraModelMapper["Casio.EX-Z29"] = "Exilim EX-Z29";
-    m_CameraModelMapper["Casio.EX-Z33"] = "Exilim EX-Z33";
-    m_CameraModelMapper["Casio.EX-Z40"] = "Exilim EX-Z40";
-    m_CameraModelMapper["Casio.EX-Z120"] = "Exilim EX-Z120";
-    m_CameraModelMapper["Casio.EX-Z400"] = "Exilim EX-Z400";
-    m_CameraModelMapper["Casio.QV-3500EX"] = "Exilim QV-3500EX";
+    { "Casio.EX-FH20", "Exilim EX-FH20" },
+    { "Casio.EX-P505", "Exilim EX-P505" },
+    { "Casio.EX-S600", "Exilim EX-S600" },
+    { "Casio.EX-Z120", "Exilim EX-Z120" },
+    { "Casio.EX-Z15", "Exilim EX-Z15" },
+    { "Casio.EX-Z29", "Exilim EX-Z29" },
+    { "Casio.EX-Z33", "Exilim EX-Z33" },
+    { "Casio.EX-Z40", "Exilim EX-Z40" },
+    { "Casio.EX-Z400", "Exilim EX-Z400" },
+    { "Casio.QV-3500EX", "Exilim QV-3500EX" },
 
     // Concord
-    m_CameraModelMapper["Concord.41Z0"] = "41Z0";
+    { "Concord.41Z0", "41Z0" },
 
     // Cruse Scanner
-    m_CameraModelMapper["Cruse Scanner."] = "";
-
-    // Epson
-    m_CameraModelMapper["Epson.Expression 12000XL"] = "Expression 12000XL";
-
-    // Google
-    m_CameraModelMapper["Google.Pixel 6 Pro"] = "Pixel 6 Pro";
-    m_CameraModelMapper["Google.Pixel 10"] = "Pixel 10";
-
-    // Kodak
-    m_CameraModelMapper["Kodak.KODAK EASYSHARE C182 Digital Camera"] =
-        "EasyShare C182";
-    m_CameraModelMapper["Kodak.KODAK CX4200 DIGITAL CAMERA"] =
-        "EasyShare CX4200";
-    m_CameraModelMapper["Kodak.KODAK CX6330 ZOOM DIGITAL CAMERA"] =
-        "EasyShare CX6330 Zoom";
-    m_CameraModelMapper["Kodak.KODAK CX7330 ZOOM DIGITAL CAMERA"] =
-        "EasyShare CX7330 Zoom";
-    m_CameraModelMapper["Kodak.KODAK CX7530 ZOOM DIGITAL CAMERA"] =
-        "EasyShare CX7530 Zoom";
-    m_CameraModelMapper["Kodak.KODAK DX4330 DIGITAL CAMERA"] =
-        "EasyShare DX4330";
-    m_CameraModelMapper["Kodak.KODAK DX6490 ZOOM DIGITAL CAMERA"] =
-        "EasyShare DX6490 Zoom";
-    m_CameraModelMapper["Kodak.KODAK DX7440 ZOOM DIGITAL CAMERA"] =
-        "EasyShare DX7440 Zoom";
-    m_CameraModelMapper["Kodak.KODAK EASYSHARE C300 DIGITAL CAMERA"] =
-        "EasyShare C300";
-    m_CameraModelMapper["Kodak.KODAK EASYSHARE C743 ZOOM DIGITAL CAMERA"] =
-        "EasyShare C743 Zoom";
-    m_CameraModelMapper["Kodak.KODAK EASYSHARE C813 ZOOM DIGITAL CAMERA"] =
-        "EasyShare C813 Zoom";
-    m_CameraModelMapper["Kodak.KODAK EASYSHARE Camera, C1450"] =
-        "EasyShare C1450";
-    m_CameraModelMapper["Kodak.KODAK EASYSHARE M340 Digital Camera"] =
-        "EasyShare M340";
-    m_CameraModelMapper["Kodak.KODAK EASYSHARE M1063 DIGITAL CAMERA"] =
-        "EasyShare M1063";
-    m_CameraModelMapper["Kodak.KODAK EASYSHARE V1003 ZOOM DIGITAL CAMERA"] =
-        "EasyShare V1003 Zoom";
-    m_CameraModelMapper["Kodak.KODAK EASYSHARE V1073 DIGITAL CAMERA"] =
-        "EasyShare V1073";
-    m_CameraModelMapper["Kodak.KODAK EASYSHARE Z710 ZOOM DIGITAL CAMERA"] =
-        "EasyShare Z710 Zoom";
-    m_CameraModelMapper["Kodak.KODAK Z712 IS ZOOM DIGITAL CAMERA"] =
-        "EasyShare Z712 IS Zoom";
-    m_CameraModelMapper["Kodak.KODAK Z760 ZOOM DIGITAL CAMERA"] =
-        "EasyShare Z760 Zoom";
-    m_CameraModelMapper["Kodak.KODAK EASYSHARE Z915 DIGITAL CAMERA"] =
-        "EasyShare Z915 Zoom";
-    m_CameraModelMapper["Kodak.KODAK Z7590 ZOOM DIGITAL CAMERA"] =
-        "EasyShare Z7590 Zoom";
+    { "Cruse Scanner.", "" },
 
     // Epson
-    m_CameraModelMapper["Epson.Expression 1640XL"] = "Expression 1640 XL";
-    m_CameraModelMapper["Epson.GT-15000"] = "GT-15000";
+    { "Epson.Expression 12000XL", "Expression 12000XL" },
+    { "Epson.Expression 1640XL", "Expression 1640 XL" },
+    { "Epson.GT-15000", "GT-15000" },
 
     // Fujifilm
-    m_CameraModelMapper["Fujifilm.DS-7"] = "DS-7";
-    m_CameraModelMapper["Fujifilm.FinePix2600Zoom"] = "FinePix 2600 Zoom";
-    m_CameraModelMapper["Fujifilm.FinePix2650"] = "FinePix 2650";
-    m_CameraModelMapper["Fujifilm.FinePix2800ZOOM"] = "FinePix 2800 Zoom";
-    m_CameraModelMapper["Fujifilm.FinePixA101"] = "FinePix A101";
-    m_CameraModelMapper["Fujifilm.FinePix A203"] = "FinePix A203";
-    m_CameraModelMapper["Fujifilm.FinePix A330"] = "FinePix A330";
-    m_CameraModelMapper["Fujifilm.FinePix A340"] = "FinePix A340";
-    m_CameraModelMapper["Fujifilm.FinePix F470"] = "FinePix F470";
-    m_CameraModelMapper["Fujifilm.FinePix JZ300"] = "FinePix JZ300";
-    m_CameraModelMapper["Fujifilm.FinePix S5Pro"] = "FinePix S5 Pro";
-    m_CameraModelMapper["Fujifilm.FinePix S602 ZOOM"] = "FinPix S602 Zoom";
-    m_CameraModelMapper["Fujifilm.FinePix S1500"] = "FinePix S1500";
-    m_CameraModelMapper["Fujifilm.FinePix S2000HD S2100HD"] =
-        "FinePix S200HD or S2100HD";
-    m_CameraModelMapper["Fujifilm.FinePix S3500"] = "FinePix S3500";
-    m_CameraModelMapper["Fujifilm.FinePix S5500"] = "FinePix S5500";
-    m_CameraModelMapper["Fujifilm.FinePix S5700 S700"] =
-        "FinePix S5700 or S700";
-    m_CameraModelMapper["Fujifilm.FinePix S5800 S800"] =
-        "FinePix S5800 or S800";
-    m_CameraModelMapper["Fujifilm.FinePix XP10"] = "FinePix XP10";
-    m_CameraModelMapper["Fujifilm.FinePix XP20"] = "FinePix XP20";
-    m_CameraModelMapper["Fujifilm.FinePix Z5fd"] = "FinePix Z5fd";
-    m_CameraModelMapper["Fujifilm.FinePix Z20fd"] = "FinePix Z20fd";
-    m_CameraModelMapper["Fujifilm.Frontier SP-3000"] =
-        "Frontier Film Scanner SP-3000";
-    m_CameraModelMapper["Fujifilm.X-T1"] = "X-T1";
+    { "Fujifilm.DS-7", "DS-7" },
+    { "Fujifilm.FinePix A203", "FinePix A203" },
+    { "Fujifilm.FinePix A330", "FinePix A330" },
+    { "Fujifilm.FinePix A340", "FinePix A340" },
+    { "Fujifilm.FinePix F470", "FinePix F470" },
+    { "Fujifilm.FinePix JZ300", "FinePix JZ300" },
+    { "Fujifilm.FinePix S1500", "FinePix S1500" },
+    { "Fujifilm.FinePix S2000HD S2100HD", "FinePix S200HD or S2100HD" },
+    { "Fujifilm.FinePix S3500", "FinePix S3500" },
+    { "Fujifilm.FinePix S5500", "FinePix S5500" },
+    { "Fujifilm.FinePix S5700 S700", "FinePix S5700 or S700" },
+    { "Fujifilm.FinePix S5800 S800", "FinePix S5800 or S800" },
+    { "Fujifilm.FinePix S5Pro", "FinePix S5 Pro" },
+    { "Fujifilm.FinePix S602 ZOOM", "FinPix S602 Zoom" },
+    { "Fujifilm.FinePix XP10", "FinePix XP10" },
+    { "Fujifilm.FinePix XP20", "FinePix XP20" },
+    { "Fujifilm.FinePix Z20fd", "FinePix Z20fd" },
+    { "Fujifilm.FinePix Z5fd", "FinePix Z5fd" },
+    { "Fujifilm.FinePix2600Zoom", "FinePix 2600 Zoom" },
+    { "Fujifilm.FinePix2650", "FinePix 2650" },
+    { "Fujifilm.FinePix2800ZOOM", "FinePix 2800 Zoom" },
+    { "Fujifilm.FinePixA101", "FinePix A101" },
+    { "Fujifilm.Frontier SP-3000", "Frontier Film Scanner SP-3000" },
+    { "Fujifilm.X-T1", "X-T1" },
 
     // Gateway
-    m_CameraModelMapper["Gateway.DC-M42"] = "DC-M42";
+    { "Gateway.DC-M42", "DC-M42" },
 
     // General Imaging
-    m_CameraModelMapper["General Imaging.E1035"] = "E1035";
+    { "General Imaging.E1035", "E1035" },
 
     // Google
-    m_CameraModelMapper["Google.Nexus One"] = "Nexus One";
-    m_CameraModelMapper["Google.Pixel 2"] = "Pixel 2";
+    { "Google.Nexus One", "Nexus One" },
+    { "Google.Pixel 10", "Pixel 10" },
+    { "Google.Pixel 2", "Pixel 2" },
+    { "Google.Pixel 6 Pro", "Pixel 6 Pro" },
+
+    // HTC
+    { "HTC.HTC Desire 626", "Desire 626" },
+    { "HTC.HTC One", "One" },
+    { "HTC.myTouch_4G_Slide", "myTouch 4G Slide" },
 
     // Hasselblad
-    m_CameraModelMapper["Hasselblad.Hasselblad H3D-39"] = "H3D-39";
+    { "Hasselblad.Hasselblad H3D-39", "H3D-39" },
 
     // Hewlett-Packard
-    m_CameraModelMapper["Hewlett-Packard.HP PhotoSmart 215"] =
-        "PhotoSmart 215";
-    m_CameraModelMapper["Hewlett-Packard.HP Photosmart M437"] =
-        "PhotoSmart M437";
-    m_CameraModelMapper["Hewlett-Packard.HP Photosmart M440"] =
-        "PhotoSmart M440";
-    m_CameraModelMapper["Hewlett-Packard.HP PhotoSmart R707 (V01.00)"] =
-        "PhotoSmart R707";
-    m_CameraModelMapper["Hewlett-Packard.HP psc1300"] = "PhotoSmart C1300";
-    m_CameraModelMapper["Hewlett-Packard.HP psc1400"] = "PhotoSmart C1400";
-    m_CameraModelMapper["Hewlett-Packard.HP psc1500"] = "PhotoSmart C1500";
-    m_CameraModelMapper["Hewlett-Packard.HP psc1600"] = "PhotoSmart C1600";
-    m_CameraModelMapper["Hewlett-Packard.HP pstc4200"] = "PhotoSmart C4200";
-    m_CameraModelMapper["Hewlett-Packard.HP pstc4400"] = "PhotoSmart C4400";
-    m_CameraModelMapper["Hewlett-Packard.HP pstc6200"] = "PhotoSmart C6200";
-    m_CameraModelMapper["Hewlett-Packard.HP pstc7200"] = "PhotoSmart C7200";
-    m_CameraModelMapper["Hewlett-Packard.HP ScanJet 2400"] = "Scanjet 2400";
-    m_CameraModelMapper["Hewlett-Packard.HP Scanjet 4370"] = "Scanjet 4370";
-    m_CameraModelMapper["Hewlett-Packard.HP ScanJet 4600"] = "Scanjet 4600";
-    m_CameraModelMapper["Hewlett-Packard.HP Scanjet a909g"] =
-        "Officejet Pro 8500 Premier";
-    m_CameraModelMapper["Hewlett-Packard.HP Scanjet djf300"] = "Deskjet F300";
-    m_CameraModelMapper["Hewlett-Packard.HP Scanjet djf2100"] =
-        "Deskjet F2100";
-    m_CameraModelMapper["Hewlett-Packard.HP Scanjet djf4100"] =
-        "Deskjet F4100";
-    m_CameraModelMapper["Hewlett-Packard.HP Scanjet djf4200"] =
-        "Deskjet F4200";
-    m_CameraModelMapper["Hewlett-Packard.HP Scanjet e709n"] = "Scanjet 6500";
-
-    // HTC
-    m_CameraModelMapper["HTC.HTC Desire 626"] = "Desire 626";
-    m_CameraModelMapper["HTC.HTC One"] = "One";
-    m_CameraModelMapper["HTC.myTouch_4G_Slide"] = "myTouch 4G Slide";
+    { "Hewlett-Packard.HP PhotoSmart 215", "PhotoSmart 215" },
+    { "Hewlett-Packard.HP PhotoSmart R707 (V01.00)", "PhotoSmart R707" },
+    { "Hewlett-Packard.HP Photosmart M437", "PhotoSmart M437" },
+    { "Hewlett-Packard.HP Photosmart M440", "PhotoSmart M440" },
+    { "Hewlett-Packard.HP ScanJet 2400", "Scanjet 2400" },
+    { "Hewlett-Packard.HP ScanJet 4600", "Scanjet 4600" },
+    { "Hewlett-Packard.HP Scanjet 4370", "Scanjet 4370" },
+    { "Hewlett-Packard.HP Scanjet a909g", "Officejet Pro 8500 Premier" },
+    { "Hewlett-Packard.HP Scanjet djf2100", "Deskjet F2100" },
+    { "Hewlett-Packard.HP Scanjet djf300", "Deskjet F300" },
+    { "Hewlett-Packard.HP Scanjet djf4100", "Deskjet F4100" },
+    { "Hewlett-Packard.HP Scanjet djf4200", "Deskjet F4200" },
+    { "Hewlett-Packard.HP Scanjet e709n", "Scanjet 6500" },
+    { "Hewlett-Packard.HP psc1300", "PhotoSmart C1300" },
+    { "Hewlett-Packard.HP psc1400", "PhotoSmart C1400" },
+    { "Hewlett-Packard.HP psc1500", "PhotoSmart C1500" },
+    { "Hewlett-Packard.HP psc1600", "PhotoSmart C1600" },
+    { "Hewlett-Packard.HP pstc4200", "PhotoSmart C4200" },
+    { "Hewlett-Packard.HP pstc4400", "PhotoSmart C4400" },
+    { "Hewlett-Packard.HP pstc6200", "PhotoSmart C6200" },
+    { "Hewlett-Packard.HP pstc7200", "PhotoSmart C7200" },
 
     // Huawei
-    m_CameraModelMapper["Huawei.HUAWEI GRA-L09"] = "P8 GRA-L09";
+    { "Huawei.HUAWEI GRA-L09", "P8 GRA-L09" },
 
     // Kodak
-    m_CameraModelMapper["Kodak.DC200      (V02.20)"] = "DC200";
-    m_CameraModelMapper["Kodak.KODAK DC280 ZOOM DIGITAL CAMERA"] =
-        "DC280 Zoom";
-    m_CameraModelMapper["Kodak.KODAK DC3800 DIGITAL CAMERA"] =
-        "EasyShare DC3800";
-    m_CameraModelMapper["Kodak.KODAK EASYSHARE Z1012 IS Digital Camera"] =
-        "EasyShare Z1012 IS";
-    m_CameraModelMapper["Kodak.KODAK V530 ZOOM DIGITAL CAMERA"] =
-        "EasyShare V530 Zoom";
-    m_CameraModelMapper["Kodak.KODAK Z650 ZOOM DIGITAL CAMERA"] =
-        "EasyShare Z650 Zoom";
-    m_CameraModelMapper["Kodak.PIXPRO FZ151"] = "PixPro FZ151";
-
-    // Konica
-    m_CameraModelMapper["Konica.KD-300Z"] = "KD-300 Zoom";
+    { "Kodak.DC200      (V02.20)", "DC200" },
+    { "Kodak.KODAK CX4200 DIGITAL CAMERA", "EasyShare CX4200" },
+    { "Kodak.KODAK CX6330 ZOOM DIGITAL CAMERA", "EasyShare CX6330 Zoom" },
+    { "Kodak.KODAK CX7330 ZOOM DIGITAL CAMERA", "EasyShare CX7330 Zoom" },
+    { "Kodak.KODAK CX7530 ZOOM DIGITAL CAMERA", "EasyShare CX7530 Zoom" },
+    { "Kodak.KODAK DC280 ZOOM DIGITAL CAMERA", "DC280 Zoom" },
+    { "Kodak.KODAK DC3800 DIGITAL CAMERA", "EasyShare DC3800" },
+    { "Kodak.KODAK DX4330 DIGITAL CAMERA", "EasyShare DX4330" },
+    { "Kodak.KODAK DX6490 ZOOM DIGITAL CAMERA", "EasyShare DX6490 Zoom" },
+    { "Kodak.KODAK DX7440 ZOOM DIGITAL CAMERA", "EasyShare DX7440 Zoom" },
+    { "Kodak.KODAK EASYSHARE C182 Digital Camera", "EasyShare C182" },
+    { "Kodak.KODAK EASYSHARE C300 DIGITAL CAMERA", "EasyShare C300" },
+    { "Kodak.KODAK EASYSHARE C743 ZOOM DIGITAL CAMERA",
+        "EasyShare C743 Zoom" },
+    { "Kodak.KODAK EASYSHARE C813 ZOOM DIGITAL CAMERA",
+        "EasyShare C813 Zoom" },
+    { "Kodak.KODAK EASYSHARE Camera, C1450", "EasyShare C1450" },
+    { "Kodak.KODAK EASYSHARE M1063 DIGITAL CAMERA", "EasyShare M1063" },
+    { "Kodak.KODAK EASYSHARE M340 Digital Camera", "EasyShare M340" },
+    { "Kodak.KODAK EASYSHARE V1003 ZOOM DIGITAL CAMERA",
+        "EasyShare V1003 Zoom" },
+    { "Kodak.KODAK EASYSHARE V1073 DIGITAL CAMERA", "EasyShare V1073" },
+    { "Kodak.KODAK EASYSHARE Z1012 IS Digital Camera", "EasyShare Z1012 IS" },
+    { "Kodak.KODAK EASYSHARE Z710 ZOOM DIGITAL CAMERA",
+        "EasyShare Z710 Zoom" },
+    { "Kodak.KODAK EASYSHARE Z915 DIGITAL CAMERA", "EasyShare Z915 Zoom" },
+    { "Kodak.KODAK V530 ZOOM DIGITAL CAMERA", "EasyShare V530 Zoom" },
+    { "Kodak.KODAK Z650 ZOOM DIGITAL CAMERA", "EasyShare Z650 Zoom" },
+    { "Kodak.KODAK Z712 IS ZOOM DIGITAL CAMERA", "EasyShare Z712 IS Zoom" },
+    { "Kodak.KODAK Z7590 ZOOM DIGITAL CAMERA", "EasyShare Z7590 Zoom" },
+    { "Kodak.KODAK Z760 ZOOM DIGITAL CAMERA", "EasyShare Z760 Zoom" },
+    { "Kodak.PIXPRO FZ151", "PixPro FZ151" },
 
     // Konica Minolta
-    m_CameraModelMapper["Konica Minolta.DiMAGE X50"] = "DiMAGE X50";
-    m_CameraModelMapper["Konica Minolta.DiMAGE Z2"] = "DiMAGE Z2";
-    m_CameraModelMapper["Konica Minolta.DiMAGE Z5"] = "DiMAGE Z5";
-    m_CameraModelMapper["Konica Minolta.DiMAGE Z10"] = "DiMAGE Z10";
-    m_CameraModelMapper["Konica Minolta.DiMAGE Z20"] = "DiMAGE Z20";
+    { "Konica Minolta.DiMAGE X50", "DiMAGE X50" },
+    { "Konica Minolta.DiMAGE Z10", "DiMAGE Z10" },
+    { "Konica Minolta.DiMAGE Z2", "DiMAGE Z2" },
+    { "Konica Minolta.DiMAGE Z20", "DiMAGE Z20" },
+    { "Konica Minolta.DiMAGE Z5", "DiMAGE Z5" },
 
-    // Kyocera
-    m_CameraModelMapper["Kyocera.KC-S701"] = "Torque KC-S701";
+    // Konica
+    { "Konica.KD-300Z", "KD-300 Zoom" },
 
-    // Leica
-    m_CameraModelMapper["Leica.D-LUX 3"] = "D-LUX 3";
-    m_CameraModelMapper["Leica.D-LUX 5"] = "D-LUX 5";
-    m_CameraModelMapper["Leica.M8 Digital Camera"] = "M8";
+    // Kyocera
+    { "Kyocera.KC-S701", "Torque KC-S701" },
 
     // LG Electronics
-    m_CameraModelMapper["LG Electronics.LG-D410"] = "D410";
-    m_CameraModelMapper["LG Electronics.LG-K428"] = "K428";
-    m_CameraModelMapper["LG Electronics.LGLS775"] = "Stylo 2 LS775";
-    m_CameraModelMapper["LG Electronics.LGUS991"] = "US991";
+    { "LG Electronics.LG-D410", "D410" },
+    { "LG Electronics.LG-K428", "K428" },
+    { "LG Electronics.LGLS775", "Stylo 2 LS775" },
+    { "LG Electronics.LGUS991", "US991" },
+
+    // Leica
+    { "Leica.D-LUX 3", "D-LUX 3" },
+    { "Leica.D-LUX 5", "D-LUX 5" },
+    { "Leica.M8 Digital Camera", "M8" },
 
     // Microsoft
-    m_CameraModelMapper["Microsoft.Lumia 950 XL Dual SIM"] =
-        "Lumia 950 XL Dual SIM";
+    { "Microsoft.Lumia 950 XL Dual SIM", "Lumia 950 XL Dual SIM" },
 
     // Minolta
-    m_CameraModelMapper["Minolta.Dimage 2330 Zoom"] = "DiMAGE 2330 Zoom";
-    m_CameraModelMapper["Minolta.DiMAGE S414"] = "DiMAGE S414";
-    m_CameraModelMapper["Minolta.DiMAGE X"] = "DiMAGE X";
+    { "Minolta.DiMAGE S414", "DiMAGE S414" },
+    { "Minolta.DiMAGE X", "DiMAGE X" },
+    { "Minolta.Dimage 2330 Zoom", "DiMAGE 2330 Zoom" },
 
     // Motorola
-    m_CameraModelMapper["Motorola.moto g stylus 5G"] = "Moto G Stylus 5G";
-    m_CameraModelMapper["Motorola.Nexus 6"] = "Nexus 6";
-    m_CameraModelMapper["Motorola.XT1080"] = "DROID Ultra";
-    m_CameraModelMapper["Motorola.XT1254"] = "DROID Turbo";
-    m_CameraModelMapper["Motorola.XT1585"] = "DROID Turbo 2";
+    { "Motorola.Nexus 6", "Nexus 6" },
+    { "Motorola.XT1080", "DROID Ultra" },
+    { "Motorola.XT1254", "DROID Turbo" },
+    { "Motorola.XT1585", "DROID Turbo 2" },
+    { "Motorola.moto g stylus 5G", "Moto G Stylus 5G" },
 
     // Nikon
-    m_CameraModelMapper["Nikon.NIKON D2X"] = "D2X";
-    m_CameraModelMapper["Nikon.NIKON D2Xs"] = "D2Xs";
-    m_CameraModelMapper["Nikon.NIKON D3S"] = "D3s";
-    m_CameraModelMapper["Nikon.NIKON D4"] = "D4";
-    m_CameraModelMapper["Nikon.NIKON D5"] = "D5";
-    m_CameraModelMapper["Nikon.NIKON D6"] = "D6";
-    m_CameraModelMapper["Nikon.NIKON D40"] = "D40";
-    m_CameraModelMapper["Nikon.NIKON D40X"] = "D40X";
-    m_CameraModelMapper["Nikon.NIKON D50"] = "D50";
-    m_CameraModelMapper["Nikon.NIKON D70"] = "D70";
-    m_CameraModelMapper["Nikon.NIKON D80"] = "D80";
-    m_CameraModelMapper["Nikon.NIKON D90"] = "D90";
-    m_CameraModelMapper["Nikon.NIKON D100"] = "D100";
-    m_CameraModelMapper["Nikon.NIKON D200"] = "D200";
-    m_CameraModelMapper["Nikon.NIKON D300"] = "D300";
-    m_CameraModelMapper["Nikon.NIKON D300S"] = "D300S";
-    m_CameraModelMapper["Nikon.NIKON D600"] = "D600";
-    m_CameraModelMapper["Nikon.NIKON D700"] = "D700";
-    m_CameraModelMapper["Nikon.NIKON D800"] = "D800";
-    m_CameraModelMapper["Nikon.NIKON D800E"] = "D800E";
-    m_CameraModelMapper["Nikon.NIKON D810"] = "D810";
-    m_CameraModelMapper["Nikon.NIKON D850"] = "D850";
-    m_CameraModelMapper["Nikon.NIKON D3000"] = "D3000";
-    m_CameraModelMapper["Nikon.NIKON D3100"] = "D3100";
-    m_CameraModelMapper["Nikon.NIKON D3200"] = "D3200";
-    m_CameraModelMapper["Nikon.NIKON D3300"] = "D3300";
-    m_CameraModelMapper["Nikon.NIKON D5000"] = "D5000";
-    m_CameraModelMapper["Nikon.NIKON D5100"] = "D5100";
-    m_CameraModelMapper["Nikon.NIKON D5200"] = "D5200";
-    m_CameraModelMapper["Nikon.NIKON D7000"] = "D7000";
-    m_CameraModelMapper["Nikon.NIKON D7100"] = "D7100";
-    m_CameraModelMapper["Nikon.E880"] = "Coolpix 880";
-    m_CameraModelMapper["Nikon.E885"] = "Coolpix 885";
-    m_CameraModelMapper["Nikon.E900"] = "Coolpix 900";
-    m_CameraModelMapper["Nikon.E950"] = "Coolpix 950";
-    m_CameraModelMapper["Nikon.E995"] = "Coolpix 995";
-    m_CameraModelMapper["Nikon.E2000"] = "Coolpix 2000";
-    m_CameraModelMapper["Nikon.E3200"] = "Coolpix 3200";
-    m_CameraModelMapper["Nikon.E4300"] = "Coolpix 4300";
-    m_CameraModelMapper["Nikon.E4600"] = "Coolpix 4600";
-    m_CameraModelMapper["Nikon.E5200"] = "Coolpix 5200";
-    m_CameraModelMapper["Nikon.COOLPIX L1"] = "Coolpix L1";
-    m_CameraModelMapper["Nikon.COOLPIX L18"] = "Coolpix L18";
-    m_CameraModelMapper["Nikon.COOLPIX L320"] = "Coolpix L320";
-    m_CameraModelMapper["Nikon.COOLPIX L810"] = "Coolpix L810";
-    m_CameraModelMapper["Nikon.COOLPIX P510"] = "Collpix P510";
-    m_CameraModelMapper["Nikon.COOLPIX P520"] = "Coolpix P520";
-    m_CameraModelMapper["Nikon.COOLPIX P5000"] = "Coolpix P5000";
-    m_CameraModelMapper["Nikon.COOLPIX P5100"] = "Coolpix P5100";
-    m_CameraModelMapper["Nikon.COOLPIX S550"] = "Coolpix S550";
-    m_CameraModelMapper["Nikon.COOLPIX S6100"] = "Coolpix S6100";
-    m_CameraModelMapper["Nikon.COOLPIX S6300"] = "Coolpix S6300";
-    m_CameraModelMapper["Nikon.COOLPIX S8100"] = "Coolpix S8100";
-    m_CameraModelMapper["Nikon.COOLPIX S8200"] = "Coolpix S8200";
-    m_CameraModelMapper["Nikon.COOLPIX S9100"] = "Coolpix S9100";
-    m_CameraModelMapper["Nikon.COOLPIX S9300"] = "Coolpix S9300";
+    { "Nikon.COOLPIX L1", "Coolpix L1" },
+    { "Nikon.COOLPIX L18", "Coolpix L18" },
+    { "Nikon.COOLPIX L320", "Coolpix L320" },
+    { "Nikon.COOLPIX L810", "Coolpix L810" },
+    { "Nikon.COOLPIX P5000", "Coolpix P5000" },
+    { "Nikon.COOLPIX P510", "Collpix P510" },
+    { "Nikon.COOLPIX P5100", "Coolpix P5100" },
+    { "Nikon.COOLPIX P520", "Coolpix P520" },
+    { "Nikon.COOLPIX S550", "Coolpix S550" },
+    { "Nikon.COOLPIX S6100", "Coolpix S6100" },
+    { "Nikon.COOLPIX S6300", "Coolpix S6300" },
+    { "Nikon.COOLPIX S8100", "Coolpix S8100" },
+    { "Nikon.COOLPIX S8200", "Coolpix S8200" },
+    { "Nikon.COOLPIX S9100", "Coolpix S9100" },
+    { "Nikon.COOLPIX S9300", "Coolpix S9300" },
+    { "Nikon.E2000", "Coolpix 2000" },
+    { "Nikon.E3200", "Coolpix 3200" },
+    { "Nikon.E4300", "Coolpix 4300" },
+    { "Nikon.E4600", "Coolpix 4600" },
+    { "Nikon.E5200", "Coolpix 5200" },
+    { "Nikon.E880", "Coolpix 880" },
+    { "Nikon.E885", "Coolpix 885" },
+    { "Nikon.E900", "Coolpix 900" },
+    { "Nikon.E950", "Coolpix 950" },
+    { "Nikon.E995", "Coolpix 995" },
+    { "Nikon.NIKON D100", "D100" },
+    { "Nikon.NIKON D200", "D200" },
+    { "Nikon.NIKON D2X", "D2X" },
+    { "Nikon.NIKON D2Xs", "D2Xs" },
+    { "Nikon.NIKON D300", "D300" },
+    { "Nikon.NIKON D3000", "D3000" },
+    { "Nikon.NIKON D300S", "D300S" },
+    { "Nikon.NIKON D3100", "D3100" },
+    { "Nikon.NIKON D3200", "D3200" },
+    { "Nikon.NIKON D3300", "D3300" },
+    { "Nikon.NIKON D3S", "D3s" },
+    { "Nikon.NIKON D4", "D4" },
+    { "Nikon.NIKON D40", "D40" },
+    { "Nikon.NIKON D40X", "D40X" },
+    { "Nikon.NIKON D5", "D5" },
+    { "Nikon.NIKON D50", "D50" },
+    { "Nikon.NIKON D5000", "D5000" },
+    { "Nikon.NIKON D5100", "D5100" },
+    { "Nikon.NIKON D5200", "D5200" },
+    { "Nikon.NIKON D6", "D6" },
+    { "Nikon.NIKON D600", "D600" },
+    { "Nikon.NIKON D70", "D70" },
+    { "Nikon.NIKON D700", "D700" },
+    { "Nikon.NIKON D7000", "D7000" },
+    { "Nikon.NIKON D7100", "D7100" },
+    { "Nikon.NIKON D80", "D80" },
+    { "Nikon.NIKON D800", "D800" },
+    { "Nikon.NIKON D800E", "D800E" },
+    { "Nikon.NIKON D810", "D810" },
+    { "Nikon.NIKON D850", "D850" },
+    { "Nikon.NIKON D90", "D90" },
 
     // Nokia
-    m_CameraModelMapper["Nokia.5300"] = "5300";
-    m_CameraModelMapper["Nokia.6555b"] = "6555b";
-    m_CameraModelMapper["Nokia.E71"] = "E71";
-    m_CameraModelMapper["Nokia.Lumia 630"] = "Lumia 630";
-    m_CameraModelMapper["Nokia.Lumia 1020"] = "Lumia 1020";
-    m_CameraModelMapper["Nokia.N8-00"] = "N8-00";
-    m_CameraModelMapper["Nokia.N82"] = "N82";
-    m_CameraModelMapper["Nokia.N95"] = "N95";
+    { "Nokia.5300", "5300" },
+    { "Nokia.6555b", "6555b" },
+    { "Nokia.E71", "E71" },
+    { "Nokia.Lumia 1020", "Lumia 1020" },
+    { "Nokia.Lumia 630", "Lumia 630" },
+    { "Nokia.N8-00", "N8-00" },
+    { "Nokia.N82", "N82" },
+    { "Nokia.N95", "N95" },
 
     // Olympus
-    m_CameraModelMapper["Olympus.C180,D435"] = "Camedia C-180, Camedia D-435";
-    m_CameraModelMapper["Olympus.C300Z,D550Z"] =
-        "Camedia C-300 Zoom, Camedia D-500 Zoom";
-    m_CameraModelMapper["Olympus.C860L,D360L"] =
-        "Camedia C860L, Camedia D360L";
-    m_CameraModelMapper["Olympus.C900Z,D400Z"] =
-        "Camedia C900 Zoom, Camedia D400 Zoom";
-    m_CameraModelMapper["Olympus.C2000Z"] = "Camedia C2000 Zoom";
-    m_CameraModelMapper["Olympus.C2040Z"] = "Camedia C2040 Zoom";
-    m_CameraModelMapper["Olympus.C2100UZ"] = "Camedia C2100 UltraZoom";
-    m_CameraModelMapper["Olympus.C3000Z"] = "Camedia C3000 Zoom";
-    m_CameraModelMapper["Olympus.C3030Z"] = "Camedia C3030 Zoom";
-    m_CameraModelMapper["Olympus.C3040Z"] = "Camedia C3040 Zoom";
-    m_CameraModelMapper["Olympus.C4100Z,C4000Z"] =
-        "Camedia C4100Z, Camedia C4000Z Zoom";
-    m_CameraModelMapper["Olympus.C-5000Z"] = "Camedia C5000 Zoom";
-    m_CameraModelMapper["Olympus.C5050Z"] = "Camedia C5050 Zoom";
-    m_CameraModelMapper["Olympus.D555Z,C315Z"] =
-        "Camedia D555 Zoom, C315 Zoom";
-    m_CameraModelMapper["Olympus.E-300"] = "Evolt E-300";
-    m_CameraModelMapper["Olympus.E-M1"] = "Evolt E-M1";
-    m_CameraModelMapper["Olympus.E-M5"] = "Evolt E-M5";
-    m_CameraModelMapper["Olympus.E-M10"] = "Evolt E-M10";
-    m_CameraModelMapper["Olympus.E-PL1"] = "Evolt E-PL1";
-    m_CameraModelMapper["Olympus.SP510UZ"] = "SP-510 UltraZoom";
-    m_CameraModelMapper["Olympus.SP560UZ"] = "SP-560 UltraZoom";
-    m_CameraModelMapper["Olympus.SZ-20"] = "SZ-20";
-    m_CameraModelMapper["Olympus.SZ-30MR"] = "SZ-30MR";
-    m_CameraModelMapper["Olympus.TG-5"] = "Tough TG-5";
-    m_CameraModelMapper["Olympus.uD800,S800"] = "uD800, S800";
-    m_CameraModelMapper["Olympus.X300,D565Z,C450Z"] =
-        "X300, Camedia D565 Zoom, Camedia C450 Zoom";
+    { "Olympus.C-5000Z", "Camedia C5000 Zoom" },
+    { "Olympus.C180,D435", "Camedia C-180, Camedia D-435" },
+    { "Olympus.C2000Z", "Camedia C2000 Zoom" },
+    { "Olympus.C2040Z", "Camedia C2040 Zoom" },
+    { "Olympus.C2100UZ", "Camedia C2100 UltraZoom" },
+    { "Olympus.C3000Z", "Camedia C3000 Zoom" },
+    { "Olympus.C300Z,D550Z", "Camedia C-300 Zoom, Camedia D-500 Zoom" },
+    { "Olympus.C3030Z", "Camedia C3030 Zoom" },
+    { "Olympus.C3040Z", "Camedia C3040 Zoom" },
+    { "Olympus.C4100Z,C4000Z", "Camedia C4100Z, Camedia C4000Z Zoom" },
+    { "Olympus.C5050Z", "Camedia C5050 Zoom" },
+    { "Olympus.C860L,D360L", "Camedia C860L, Camedia D360L" },
+    { "Olympus.C900Z,D400Z", "Camedia C900 Zoom, Camedia D400 Zoom" },
+    { "Olympus.D555Z,C315Z", "Camedia D555 Zoom, C315 Zoom" },
+    { "Olympus.E-300", "Evolt E-300" },
+    { "Olympus.E-M1", "Evolt E-M1" },
+    { "Olympus.E-M10", "Evolt E-M10" },
+    { "Olympus.E-M5", "Evolt E-M5" },
+    { "Olympus.E-PL1", "Evolt E-PL1" },
+    { "Olympus.SP510UZ", "SP-510 UltraZoom" },
+    { "Olympus.SP560UZ", "SP-560 UltraZoom" },
+    { "Olympus.SZ-20", "SZ-20" },
+    { "Olympus.SZ-30MR", "SZ-30MR" },
+    { "Olympus.TG-5", "Tough TG-5" },
+    { "Olympus.X300,D565Z,C450Z",
+        "X300, Camedia D565 Zoom, Camedia C450 Zoom" },
+    { "Olympus.uD800,S800", "uD800, S800" },
 
     // Panasonic
-    m_CameraModelMapper["Panasonic.DMC-F2"] = "Lumix DMC-F 2";
-    m_CameraModelMapper["Panasonic.DMC-FH20"] = "Lumix DMC-FH 20";
-    m_CameraModelMapper["Panasonic.DMC-FP3"] = "Lumix DMC-FP 3";
-    m_CameraModelMapper["Panasonic.DMC-FS10"] = "Lumix DMC-FS 10";
-    m_CameraModelMapper["Panasonic.DMC-FS35"] = "Lumix DMC-FS 35";
-    m_CameraModelMapper["Panasonic.DMC-FS45"] = "Lumix DMC-FS 45";
-    m_CameraModelMapper["Panasonic.DMC-FS62"] = "Lumix DMC-FS 62";
-    m_CameraModelMapper["Panasonic.DMC-FX8"] = "Lumix DMC-FX 8";
-    m_CameraModelMapper["Panasonic.DMC-FZ8"] = "Lumix DMC-FZ 8";
-    m_CameraModelMapper["Panasonic.DMC-FZ38"] = "Lumix DMC-FZ 38";
-    m_CameraModelMapper["Panasonic.DMC-FZ100"] = "Lumix DMC-FZ 100";
-    m_CameraModelMapper["Panasonic.DMC-FZ200"] = "Lumix DMC-FZ 200";
-    m_CameraModelMapper["Panasonic.DMC-FZ1000"] = "Lumix DMC-FZ 1000";
-    m_CameraModelMapper["Panasonic.DMC-G3"] = "Lumix DMC-G 3";
-    m_CameraModelMapper["Panasonic.DMC-G5"] = "Lumix DMC-G 5";
-    m_CameraModelMapper["Panasonic.DMC-GF1"] = "Lumix DMC-GF 1";
-    m_CameraModelMapper["Panasonic.DMC-LS75"] = "Lumix DMC-LS 75";
-    m_CameraModelMapper["Panasonic.DMC-LZ6"] = "Lumix DMC-LZ 6";
-    m_CameraModelMapper["Panasonic.DMC-LZ8"] = "Lumix DMC-LZ 8";
-    m_CameraModelMapper["Panasonic.DMC-TS1"] = "Lumix DMC-TS 1";
-    m_CameraModelMapper["Panasonic.DMC-TZ3"] = "Lumix DMC-TZ 3";
-    m_CameraModelMapper["Panasonic.DMC-TZ5"] = "Lumix DMC-TZ 5";
-    m_CameraModelMapper["Panasonic.DMC-TZ10"] = "Lumix DMC-TZ 10";
-    m_CameraModelMapper["Panasonic.DMC-ZS10"] = "Lumix DMC-ZS 10";
+    { "Panasonic.DMC-F2", "Lumix DMC-F 2" },
+    { "Panasonic.DMC-FH20", "Lumix DMC-FH 20" },
+    { "Panasonic.DMC-FP3", "Lumix DMC-FP 3" },
+    { "Panasonic.DMC-FS10", "Lumix DMC-FS 10" },
+    { "Panasonic.DMC-FS35", "Lumix DMC-FS 35" },
+    { "Panasonic.DMC-FS45", "Lumix DMC-FS 45" },
+    { "Panasonic.DMC-FS62", "Lumix DMC-FS 62" },
+    { "Panasonic.DMC-FX8", "Lumix DMC-FX 8" },
+    { "Panasonic.DMC-FZ100", "Lumix DMC-FZ 100" },
+    { "Panasonic.DMC-FZ1000", "Lumix DMC-FZ 1000" },
+    { "Panasonic.DMC-FZ200", "Lumix DMC-FZ 200" },
+    { "Panasonic.DMC-FZ38", "Lumix DMC-FZ 38" },
+    { "Panasonic.DMC-FZ8", "Lumix DMC-FZ 8" },
+    { "Panasonic.DMC-G3", "Lumix DMC-G 3" },
+    { "Panasonic.DMC-G5", "Lumix DMC-G 5" },
+    { "Panasonic.DMC-GF1", "Lumix DMC-GF 1" },
+    { "Panasonic.DMC-LS75", "Lumix DMC-LS 75" },
+    { "Panasonic.DMC-LZ6", "Lumix DMC-LZ 6" },
+    { "Panasonic.DMC-LZ8", "Lumix DMC-LZ 8" },
+    { "Panasonic.DMC-TS1", "Lumix DMC-TS 1" },
+    { "Panasonic.DMC-TZ10", "Lumix DMC-TZ 10" },
+    { "Panasonic.DMC-TZ3", "Lumix DMC-TZ 3" },
+    { "Panasonic.DMC-TZ5", "Lumix DMC-TZ 5" },
+    { "Panasonic.DMC-ZS10", "Lumix DMC-ZS 10" },
 
     // Pentax
-    m_CameraModelMapper["Pentax.PENTAX K-5"] = "K-5";
-    m_CameraModelMapper["Pentax.PENTAX K-5 II s"] = "K-5 IIS";
-    m_CameraModelMapper["Pentax.PENTAX K20D"] = "K20D";
-    m_CameraModelMapper["Pentax.PENTAX K10D"] = "K10D";
-    m_CameraModelMapper["Pentax.PENTAX K100D"] = "K100D";
-    m_CameraModelMapper["Pentax.PENTAX K-m"] = "K-m";
-    m_CameraModelMapper["Pentax.PENTAX K-x"] = "K-x";
-    m_CameraModelMapper["Pentax.PENTAX Optio 33WR"] = "Optio 33WR";
-    m_CameraModelMapper["Pentax.PENTAX Optio 60"] = "Optio 60";
-    m_CameraModelMapper["Pentax.PENTAX Optio MX"] = "Optio MX";
-    m_CameraModelMapper["Pentax.PENTAX Optio T30"] = "Optio T30";
-    m_CameraModelMapper["Pentax.PENTAX Optio W20"] = "Optio W20";
-    m_CameraModelMapper["Pentax.PENTAX *ist D"] = "*ist D";
+    { "Pentax.PENTAX *ist D", "*ist D" },
+    { "Pentax.PENTAX K-5", "K-5" },
+    { "Pentax.PENTAX K-5 II s", "K-5 IIS" },
+    { "Pentax.PENTAX K-m", "K-m" },
+    { "Pentax.PENTAX K-x", "K-x" },
+    { "Pentax.PENTAX K100D", "K100D" },
+    { "Pentax.PENTAX K10D", "K10D" },
+    { "Pentax.PENTAX K20D", "K20D" },
+    { "Pentax.PENTAX Optio 33WR", "Optio 33WR" },
+    { "Pentax.PENTAX Optio 60", "Optio 60" },
+    { "Pentax.PENTAX Optio MX", "Optio MX" },
+    { "Pentax.PENTAX Optio T30", "Optio T30" },
+    { "Pentax.PENTAX Optio W20", "Optio W20" },
 
     // Phase One
-    m_CameraModelMapper["Phase One.P40+"] = "P40+";
+    { "Phase One.P40+", "P40+" },
 
     // Polaroid
-    m_CameraModelMapper["Polaroid.i1037"] = "i1037";
+    { "Polaroid.i1037", "i1037" },
 
     // Ricoh
-    m_CameraModelMapper["Ricoh.Caplio G4"] = "Caplio G4";
+    { "Ricoh.Caplio G4", "Caplio G4" },
 
     // Samsung
-    m_CameraModelMapper["Samsung.Digimax L60"] = "Digimax L60";
-    m_CameraModelMapper["Samsung.Galaxy S23 Ultra"] = "Galaxy S23 Ultra";
-    m_CameraModelMapper["Samsung.Galaxy S24 Ultra"] = "Galaxy S24 Ultra";
-    m_CameraModelMapper["Samsung.Galaxy S25 FE"] = "Galaxy S25 FE";
-    m_CameraModelMapper["Samsung.Galaxy S25 Ultra"] = "Galaxy S25 Ultra";
-    m_CameraModelMapper["Samsung.GT-I9100"] = "Galaxy S II GT-I9100";
-    m_CameraModelMapper["Samsung.GT-I9295"] = "Galaxy S IV Active GT-I9295";
-    m_CameraModelMapper["Samsung.GT-I9300"] = "Galaxy S III GT-I9300";
-    m_CameraModelMapper["Samsung.GT-P5110"] = "Galaxy Tab 2 GT-P5110";
-    m_CameraModelMapper["Samsung.GT-S7272"] = "Galaxy Ace 3";
-    m_CameraModelMapper["Samsung.NX100"] = "NX100";
-    m_CameraModelMapper["Samsung.SAMSUNG-SGH-I337"] = "Galaxy S4 SGH-I337";
-    m_CameraModelMapper["Samsung.SAMSUNG-SM-G900A"] = "Galaxy S6 SM-G900A";
-    m_CameraModelMapper["Samsung.SAMSUNG-SM-G928A"] =
-        "Galaxy S6 Edge+ SM-G928A";
-    m_CameraModelMapper["Samsung.SAMSUNG-SM-G935A"] = "Galaxy S7 Edge (AT&T)";
-    m_CameraModelMapper["Samsung.SGH-M919"] = "Galaxy S4 SGH-M919";
-    m_CameraModelMapper["Samsung.SGH-T989"] = "Galaxy S II SGH-T989";
-    m_CameraModelMapper["Samsung.SM-A217F"] = "Galaxy A21s SM-A217F";
-    m_CameraModelMapper["Samsung.SM-A526B"] = "Galaxy SM-A526B";
-    m_CameraModelMapper["Samsung.SM-G900F"] =
-        "Galaxy S5 SM-G900F (Factory Unlocked)";
-    m_CameraModelMapper["Samsung.SM-G900I"] =
-        "Galaxy S5 SM-G900I (Factory Unlocked)";
-    m_CameraModelMapper["Samsung.SM-G900V"] = "Galaxy S5 SM-G900V (Verizon)";
-    m_CameraModelMapper["Samsung.SM-G920I"] =
-        "Galaxy S6 SM-G920I (Factory Unlocked)";
-    m_CameraModelMapper["Samsung.SM-G930F"] =
-        "Galaxy S7 SM-G930F (Factory Unlocked)";
-    m_CameraModelMapper["Samsung.SM-G935F"] =
-        "Galaxy S7 SM-G935F (Factory Unlocked)";
-    m_CameraModelMapper["Samsung.SM-G935P"] = "Galaxy S7 SM-G935P";
-    m_CameraModelMapper["Samsung.SM-G950F"] =
-        "Galaxy S8 SM-G950F (Factory Unlocked)";
-    m_CameraModelMapper["Samsung.SM-G920F"] =
-        "Galaxy S6 SM-G920F (Factory Unlocked)";
-    m_CameraModelMapper["Samsung.SM-G920T"] = "Galaxy S6 SM-G920T (T-mobile)";
-    m_CameraModelMapper["Samsung.SM-G925F"] =
-        "Galaxy S6 SM-G925F (Factory Unlocked)";
-    m_CameraModelMapper["Samsung.SM-G928F"] =
-        "Galaxy S6 Edge+ (Factory Unlocked)";
-    m_CameraModelMapper["Samsung.SM-G930V"] = "Galaxy S7 SM-G930V (Verizon)";
-    m_CameraModelMapper["Samsung.SM-G965U"] = "Galaxy S9+ SM-G965U (Unlocked)";
-    m_CameraModelMapper["Samsung.SM-G996U"] = "Galaxy S21+ 5G SM-G996U";
-    m_CameraModelMapper["Samsung.SM-J500FN"] = "Galaxy J5 SM-J500FN";
-    m_CameraModelMapper["Samsung.SM-J500M"] = "Galaxy J5 SM-J500M";
-    m_CameraModelMapper["Samsung.SM-J727T"] = "Galaxy J7 Prima SM-J727T";
-    m_CameraModelMapper["Samsung.SM-N920T"] = "Galaxy Note 5 SM-N920T";
-    m_CameraModelMapper["Samsung.SM-N9005"] = "Galaxy Note 3 SM-N9005";
-    m_CameraModelMapper["Samsung.SM-N9020"] = "Galaxy Note 3 SM-N9020";
-    m_CameraModelMapper["Samsung.SM-S135DL"] = "Galaxy A03s SM-S135DL";
-    m_CameraModelMapper["Samsung.SM-S820L"] = "Galaxy Core Prime";
-    m_CameraModelMapper["Samsung.SM-S908E"] = "Galaxy S22 Ultra (SM-S908E)";
-    m_CameraModelMapper["Samsung.<Digimax D53>"] = "Digimax D53";
-    m_CameraModelMapper[
-        "Samsung.<Digimax S500 / Kenox S500 / Digimax Cyber 530>"] =
-        "Digimax S500, Kenox S500, Digimax Cyber 530";
-    m_CameraModelMapper[
-        "Samsung.<Digimax S600 / Kenox S600 / Digimax Cyber 630>"] =
-        "Digimax S600, Kenox S600, Digimax Cyber 630";
-    m_CameraModelMapper["Samsung.<KENOX S630  / Samsung S630>"] =
-        "Kenox S630, Digimax S630";
-    m_CameraModelMapper["Samsung.<VLUU L730  / Samsung L730>"] =
-        "Vluu L730, Digimax L739";
+    { "Samsung.<Digimax D53>", "Digimax D53" },
+    { "Samsung.<Digimax S500 / Kenox S500 / Digimax Cyber 530>",
+        "Digimax S500, Kenox S500, Digimax Cyber 530" },
+    { "Samsung.<Digimax S600 / Kenox S600 / Digimax Cyber 630>",
+        "Digimax S600, Kenox S600, Digimax Cyber 630" },
+    { "Samsung.<KENOX S630  / Samsung S630>", "Kenox S630, Digimax S630" },
+    { "Samsung.<VLUU L730  / Samsung L730>", "Vluu L730, Digimax L739" },
+    { "Samsung.Digimax L60", "Digimax L60" },
+    { "Samsung.GT-I9100", "Galaxy S II GT-I9100" },
+    { "Samsung.GT-I9295", "Galaxy S IV Active GT-I9295" },
+    { "Samsung.GT-I9300", "Galaxy S III GT-I9300" },
+    { "Samsung.GT-P5110", "Galaxy Tab 2 GT-P5110" },
+    { "Samsung.GT-S7272", "Galaxy Ace 3" },
+    { "Samsung.Galaxy S23 Ultra", "Galaxy S23 Ultra" },
+    { "Samsung.Galaxy S24 Ultra", "Galaxy S24 Ultra" },
+    { "Samsung.Galaxy S25 FE", "Galaxy S25 FE" },
+    { "Samsung.Galaxy S25 Ultra", "Galaxy S25 Ultra" },
+    { "Samsung.NX100", "NX100" },
+    { "Samsung.SAMSUNG-SGH-I337", "Galaxy S4 SGH-I337" },
+    { "Samsung.SAMSUNG-SM-G900A", "Galaxy S6 SM-G900A" },
+    { "Samsung.SAMSUNG-SM-G928A", "Galaxy S6 Edge+ SM-G928A" },
+    { "Samsung.SAMSUNG-SM-G935A", "Galaxy S7 Edge (AT&T)" },
+    { "Samsung.SGH-M919", "Galaxy S4 SGH-M919" },
+    { "Samsung.SGH-T989", "Galaxy S II SGH-T989" },
+    { "Samsung.SM-A217F", "Galaxy A21s SM-A217F" },
+    { "Samsung.SM-A526B", "Galaxy SM-A526B" },
+    { "Samsung.SM-G900F", "Galaxy S5 SM-G900F (Factory Unlocked)" },
+    { "Samsung.SM-G900I", "Galaxy S5 SM-G900I (Factory Unlocked)" },
+    { "Samsung.SM-G900V", "Galaxy S5 SM-G900V (Verizon)" },
+    { "Samsung.SM-G920F", "Galaxy S6 SM-G920F (Factory Unlocked)" },
+    { "Samsung.SM-G920I", "Galaxy S6 SM-G920I (Factory Unlocked)" },
+    { "Samsung.SM-G920T", "Galaxy S6 SM-G920T (T-mobile)" },
+    { "Samsung.SM-G925F", "Galaxy S6 SM-G925F (Factory Unlocked)" },
+    { "Samsung.SM-G928F", "Galaxy S6 Edge+ (Factory Unlocked)" },
+    { "Samsung.SM-G930F", "Galaxy S7 SM-G930F (Factory Unlocked)" },
+    { "Samsung.SM-G930V", "Galaxy S7 SM-G930V (Verizon)" },
+    { "Samsung.SM-G935F", "Galaxy S7 SM-G935F (Factory Unlocked)" },
+    { "Samsung.SM-G935P", "Galaxy S7 SM-G935P" },
+    { "Samsung.SM-G950F", "Galaxy S8 SM-G950F (Factory Unlocked)" },
+    { "Samsung.SM-G965U", "Galaxy S9+ SM-G965U (Unlocked)" },
+    { "Samsung.SM-G996U", "Galaxy S21+ 5G SM-G996U" },
+    { "Samsung.SM-J500FN", "Galaxy J5 SM-J500FN" },
+    { "Samsung.SM-J500M", "Galaxy J5 SM-J500M" },
+    { "Samsung.SM-J727T", "Galaxy J7 Prima SM-J727T" },
+    { "Samsung.SM-N9005", "Galaxy Note 3 SM-N9005" },
+    { "Samsung.SM-N9020", "Galaxy Note 3 SM-N9020" },
+    { "Samsung.SM-N920T", "Galaxy Note 5 SM-N920T" },
+    { "Samsung.SM-S135DL", "Galaxy A03s SM-S135DL" },
+    { "Samsung.SM-S820L", "Galaxy Core Prime" },
+    { "Samsung.SM-S908E", "Galaxy S22 Ultra (SM-S908E)" },
 
     // Sanyo
-    m_CameraModelMapper["Sanyo.S4"] = "Xacti DSC-S4";
-
-    // Sony
-    m_CameraModelMapper["Sony.C6603"] = "Xperia Z C6603";
-    m_CameraModelMapper["Sony.CD MAVICA"] = "CD Mavica";
-    m_CameraModelMapper["Sony.CYBERSHOT"] = "CyberShot";
-    m_CameraModelMapper["Sony.DCR-TRV20E"] = "DCR-TRV20E";
-    m_CameraModelMapper["Sony.DSC-H7"] = "CyberShot DSC-H7";
-    m_CameraModelMapper["Sony.DSC-HX100V"] = "CyberShot DSC-HX100V";
-    m_CameraModelMapper["Sony.DSC-P8"] = "CyberShot DSC-P8";
-    m_CameraModelMapper["Sony.DSC-P72"] = "CyberShot DSC-P72";
-    m_CameraModelMapper["Sony.DSC-P200"] = "CyberShot DSC-P200";
-    m_CameraModelMapper["Sony.DSC-S40"] = "CyberShot DSC-S40";
-    m_CameraModelMapper["Sony.DSC-S650"] = "CyberShot DSC-S650";
-    m_CameraModelMapper["Sony.DSC-S730"] = "CyberShot DSC-S730";
-    m_CameraModelMapper["Sony.DSC-S780"] = "CyberShot DSC-S780";
-    m_CameraModelMapper["Sony.DSC-T1"] = "CyberShot DSC-T1";
-    m_CameraModelMapper["Sony.DSC-T5"] = "CyberShot DSC-T5";
-    m_CameraModelMapper["Sony.DSC-T200"] = "CyberShot DSC-T200";
-    m_CameraModelMapper["Sony.DSC-T50"] = "CyberShot DSC-T50";
-    m_CameraModelMapper["Sony.DSC-W1"] = "CyberShot DSC-W1";
-    m_CameraModelMapper["Sony.DSC-W7"] = "CyberShot DSC-W7";
-    m_CameraModelMapper["Sony.DSC-W80"] = "CyberShot DSC-W80";
-    m_CameraModelMapper["Sony.DSC-W90"] = "CyberShot DSC-W90";
-    m_CameraModelMapper["Sony.DSC-W100"] = "CyberShot DSC-W100";
-    m_CameraModelMapper["Sony.DSC-W120"] = "CyberShot DSC-W120";
-    m_CameraModelMapper["Sony.DSC-W300"] = "CyberShot DSC-W300";
-    m_CameraModelMapper["Sony.DSLR-A100"] = "Alpha DSLR-A100";
-    m_CameraModelMapper["Sony.DSLR-A500"] = "Alpha DSLR-A500";
-    m_CameraModelMapper["Sony.DSLR-A700"] = "Alpha DSLR-A700";
-    m_CameraModelMapper["Sony.DSLR-A900"] = "Alpha DSLR-A700";
-    m_CameraModelMapper["Sony.ILCE-7M3"] = "Alpha ILCE-7 Mark 3";
-    m_CameraModelMapper["Sony.ILCE-7R"] = "Alpha ILCE-7R";
-    m_CameraModelMapper["Sony.ILCE-7RM5"] = "Alpha ILCE-7R Mark 5";
-    m_CameraModelMapper["Sony.ILCE-6000"] = "Alpha 6000";
-    m_CameraModelMapper["Sony.ILCE-6300"] = "Alpha 6300";
-    m_CameraModelMapper["Sony.ILCE-6500"] = "Alpha 6500";
-    m_CameraModelMapper["Sony.NEX-5R"] = "Alpha NEX 5R";
-    m_CameraModelMapper["Sony.SLT-A37"] = "Alpha SLT-A37";
-    m_CameraModelMapper["Sony.SLT-A57"] = "Alpha SLT-A57";
-    m_CameraModelMapper["Sony.SLT-A65V"] = "Alpha SLT-A65V";
-    m_CameraModelMapper["Sony.SLT-A77V"] = "Alpha SLT-A55V";
-    m_CameraModelMapper["Sony.SLT-A99"] = "Alpha SLT-A99";
-    m_CameraModelMapper["Sony.SLT-A99V"] = "Alpha SLT-A99V";
+    { "Sanyo.S4", "Xacti DSC-S4" },
 
     // Sony Ericsson
-    m_CameraModelMapper["Sony Ericsson.C905"] = "C905";
-    m_CameraModelMapper["Sony Ericsson.SK17a"] = "SK17a";
-    m_CameraModelMapper["Sony Ericsson.U5i"] = "U5i";
-    m_CameraModelMapper["Sony Ericsson.W595"] = "W595";
+    { "Sony Ericsson.C905", "C905" },
+    { "Sony Ericsson.SK17a", "SK17a" },
+    { "Sony Ericsson.U5i", "U5i" },
+    { "Sony Ericsson.W595", "W595" },
+
+    // Sony
+    { "Sony.C6603", "Xperia Z C6603" },
+    { "Sony.CD MAVICA", "CD Mavica" },
+    { "Sony.CYBERSHOT", "CyberShot" },
+    { "Sony.DCR-TRV20E", "DCR-TRV20E" },
+    { "Sony.DSC-H7", "CyberShot DSC-H7" },
+    { "Sony.DSC-HX100V", "CyberShot DSC-HX100V" },
+    { "Sony.DSC-P200", "CyberShot DSC-P200" },
+    { "Sony.DSC-P72", "CyberShot DSC-P72" },
+    { "Sony.DSC-P8", "CyberShot DSC-P8" },
+    { "Sony.DSC-S40", "CyberShot DSC-S40" },
+    { "Sony.DSC-S650", "CyberShot DSC-S650" },
+    { "Sony.DSC-S730", "CyberShot DSC-S730" },
+    { "Sony.DSC-S780", "CyberShot DSC-S780" },
+    { "Sony.DSC-T1", "CyberShot DSC-T1" },
+    { "Sony.DSC-T200", "CyberShot DSC-T200" },
+    { "Sony.DSC-T5", "CyberShot DSC-T5" },
+    { "Sony.DSC-T50", "CyberShot DSC-T50" },
+    { "Sony.DSC-W1", "CyberShot DSC-W1" },
+    { "Sony.DSC-W100", "CyberShot DSC-W100" },
+    { "Sony.DSC-W120", "CyberShot DSC-W120" },
+    { "Sony.DSC-W300", "CyberShot DSC-W300" },
+    { "Sony.DSC-W7", "CyberShot DSC-W7" },
+    { "Sony.DSC-W80", "CyberShot DSC-W80" },
+    { "Sony.DSC-W90", "CyberShot DSC-W90" },
+    { "Sony.DSLR-A100", "Alpha DSLR-A100" },
+    { "Sony.DSLR-A500", "Alpha DSLR-A500" },
+    { "Sony.DSLR-A700", "Alpha DSLR-A700" },
+    { "Sony.DSLR-A900", "Alpha DSLR-A700" },
+    { "Sony.ILCE-6000", "Alpha 6000" },
+    { "Sony.ILCE-6300", "Alpha 6300" },
+    { "Sony.ILCE-6500", "Alpha 6500" },
+    { "Sony.ILCE-7M3", "Alpha ILCE-7 Mark 3" },
+    { "Sony.ILCE-7R", "Alpha ILCE-7R" },
+    { "Sony.ILCE-7RM5", "Alpha ILCE-7R Mark 5" },
+    { "Sony.NEX-5R", "Alpha NEX 5R" },
+    { "Sony.SLT-A37", "Alpha SLT-A37" },
+    { "Sony.SLT-A57", "Alpha SLT-A57" },
+    { "Sony.SLT-A65V", "Alpha SLT-A65V" },
+    { "Sony.SLT-A77V", "Alpha SLT-A55V" },
+    { "Sony.SLT-A99", "Alpha SLT-A99" },
+    { "Sony.SLT-A99V", "Alpha SLT-A99V" },
 
     // Supra
-    m_CameraModelMapper["Supra.Super Slim XS70"] = "Super Slim XS 70";
+    { "Supra.Super Slim XS70", "Super Slim XS 70" },
 
     // TECNO
-    m_CameraModelMapper["TECNO.TECNO KM7k"] = "TECNO KM7k";
+    { "TECNO.TECNO KM7k", "TECNO KM7k" },
 
     // Toshiba
-    m_CameraModelMapper["Toshiba.PDRM5"] = "PDR-M5";
+    { "Toshiba.PDRM5", "PDR-M5" },
 
     // Xiaomi
-    m_CameraModelMapper["Xiaomi.2312DRA50G"] = "Redmi Note 13 Pro 5G";
-    m_CameraModelMapper["Xiaomi.Redmi Note 8 Pro"] = "Redmi Note 8 Pro";
-    m_CameraModelMapper["Xiaomi.Redmi Note 8T"] = "Redmi Note 8T";
+    { "Xiaomi.2312DRA50G", "Redmi Note 13 Pro 5G" },
+    { "Xiaomi.Redmi Note 8 Pro", "Redmi Note 8 Pro" },
+    { "Xiaomi.Redmi Note 8T", "Redmi Note 8T" },
 
     // ZTE
-    m_CameraModelMapper["ZTE.Z959"] = "Grand X3 Z959";
-
-    CALL_OUT("");
-}
+    { "ZTE.Z959", "Grand X3 Z959" },
+};
+static_assert(IsSorted(CAMERA_MODEL_MAPPER),
+    "CAMERA_MODEL_MAPPER must be sorted");
 
 
 
 ///////////////////////////////////////////////////////////////////////////////
 // Lens maker mapper
-void ExifInfo::Init_LensMakerMapper()
+static constexpr MapperEntry LENS_MAKER_MAPPER[] =
 {
-    CALL_IN("");
-
-    // Add makers
-    m_LensMakerMapper["Apple"] = "Apple";
-    m_LensMakerMapper["Google"] = "Google";
-    m_LensMakerMapper["NIKON"] = "Nikon";
-
-    CALL_OUT("");
-}
+    { "Apple", "Apple" },
+    { "Google", "Google" },
+    { "NIKON", "Nikon" },
+};
+static_assert(IsSorted(LENS_MAKER_MAPPER),
+    "LENS_MAKER_MAPPER must be sorted");
 
 
 
 ///////////////////////////////////////////////////////////////////////////////
 // Lens model mapper
-void ExifInfo::Init_LensModelMapper()
+// (key is "<normalized maker>.<model as found in the file>")
+static constexpr MapperEntry LENS_MODEL_MAPPER[] =
 {
-    CALL_IN("");
-
-    // No model information
-    m_LensModelMapper["."] = "";
-    m_LensModelMapper[".----"] = "";
-    m_LensModelMapper[".0.0 mm f/0.0"] = "";
-
-    // Unknown maker
-    m_LensModelMapper[".6.1-30.5 mm"] = "6.1-30.5mm";
-    m_LensModelMapper[".10-20mm"] = "10-20mm";
-    m_LensModelMapper[".17-70mm"] = "17-70mm";
-    m_LensModelMapper[".17.0-55.0 mm f/2.8"] = "17-55mm f/2.8";
-    m_LensModelMapper[".18-250mm"] = "18-250mm";
-    m_LensModelMapper[".18.0-105.0 mm f/3.5-5.6"] = "18-105mm f/3.5-5.6";
-    m_LensModelMapper[".28-80mm F3.5-5.6"] = "28-80mm f/3.5-5.6";
-    m_LensModelMapper[".28.0-105.0 mm"] = "28-105mm";
-    m_LensModelMapper[".28.0-300.0 mm f/3.5-5.6"] = "28-300mm f/3.5-5.6";
-    m_LensModelMapper[".50.0 mm f/1.8"] = "50mm f/1.8";
-    m_LensModelMapper[".50-500mm"] = "50-500mm";
-    m_LensModelMapper[".70-200mm"] = "70-200mm";
-    m_LensModelMapper[".70.0-200.0 mm"] = "70-200mm";
-    m_LensModelMapper[".70.0-200.0 mm f/2.8"] = "70-200mm f/2.8";
-    m_LensModelMapper[".100-200mm F4.5"] = "100-200mm f/4.5";
-    m_LensModelMapper[".105.0 mm f/2.8"] = "105mm f/2.8";
-    m_LensModelMapper[".135.0-400.0 mm f/4.5-5.6"] = "135-400mm f/4.5-5.6";
-    m_LensModelMapper[".150.0-500.0 mm f/5.0-6.3"] = "150-500mm f/5-6.3";
-    m_LensModelMapper[".180.0-400.0 mm f/4.0"] = "180-400mm f/4";
-    m_LensModelMapper[".200.0-400.0 mm f/4.0"] = "200-400mm f/4.0";
-    m_LensModelMapper[".250.0-560.0 mm f/5.6"] = "250-560mm f/5.6";
-    m_LensModelMapper[".600.0 mm f/4.0"] = "600mm f/4";
+    // No maker
+    { ".", "" },
+    { ".----", "" },
+    { ".0.0 mm f/0.0", "" },
+    { ".10-20mm", "10-20mm" },
+    { ".100-200mm F4.5", "100-200mm f/4.5" },
+    { ".105.0 mm f/2.8", "105mm f/2.8" },
+    { ".135.0-400.0 mm f/4.5-5.6", "135-400mm f/4.5-5.6" },
+    { ".150-600mm F5-6.3 DG OS HSM | Contemporary 015",
+        "Sigma 150-600mm f/5-6.3 DG OS HSM | Contemporary 015" },
+    { ".150-600mm F5-6.3 DG OS HSM | Contemporary 015 +1.4x",
+        "Sigma 150-600mm f/5-6.3 DG OS HSM | Contemporary 015 (with 1.4x "
+        "Converter)" },
+    { ".150-600mm F5-6.3 SSM", "Sony 150-600mm f/5-6.3 SSM" },
+    { ".150.0-500.0 mm f/5.0-6.3", "150-500mm f/5-6.3" },
+    { ".16-35mm F2.8 ZA SSM", "Sony Zeiss Sonar 16-35mm f/2.8 ZA SSM" },
+    { ".17-70mm", "17-70mm" },
+    { ".17.0-55.0 mm f/2.8", "17-55mm f/2.8" },
+    { ".18-250mm", "18-250mm" },
+    { ".18.0-105.0 mm f/3.5-5.6", "18-105mm f/3.5-5.6" },
+    { ".180.0-400.0 mm f/4.0", "180-400mm f/4" },
+    { ".200.0-400.0 mm f/4.0", "200-400mm f/4.0" },
+    { ".250.0-560.0 mm f/5.6", "250-560mm f/5.6" },
+    { ".28-80mm F3.5-5.6", "28-80mm f/3.5-5.6" },
+    { ".28.0-105.0 mm", "28-105mm" },
+    { ".28.0-300.0 mm f/3.5-5.6", "28-300mm f/3.5-5.6" },
+    { ".50-500mm", "50-500mm" },
+    { ".50.0 mm f/1.8", "50mm f/1.8" },
+    { ".6.1-30.5 mm", "6.1-30.5mm" },
+    { ".60-600mm F4.5-6.3 DG OS HSM | Sports 018",
+        "Sigma 60-600mm f/4.5-6.3 DG OS HSM Sports" },
+    { ".600.0 mm f/4.0", "600mm f/4" },
+    { ".70-200mm", "70-200mm" },
+    { ".70.0-200.0 mm", "70-200mm" },
+    { ".70.0-200.0 mm f/2.8", "70-200mm f/2.8" },
+    { ".85mm F1.4 ZA", "Sony Zeiss Planar 85mm f/1.4 ZA" },
+    { ".DT 18-35mm F1.8", "Sigma DT 18-35mm f/1.8" },
+    { ".DT 18-55mm F3.5-5.6 SAM", "Sony DT 18-55mm f/3.5-5.6 SAM" },
+    { ".DT 70-300mm F4-5.6 SAM", "Sony DT 70-300mm f/4-5.6 SAM" },
+    { ".E 17-70mm F2.8 B070", "Tamron 17-70mm f/2.8 B070" },
+    { ".E 18-55mm F3.5-5.6 OSS", "Sony E 18-55mm f/3.5-5.6 OSS" },
+    { ".E 35mm F1.8 OSS", "Sony E 35mm f/1.8 OSS" },
+    { ".EF-M55-200mm f/4.5-6.3 IS STM",
+        "Canon EF-M 55-200mm f/4.5-6.3 IS STM" },
+    { ".EF-S17-55mm f/2.8 IS USM", "Canon EF-S 17-55mm f/2.8 IS USM" },
+    { ".EF-S18-135mm f/3.5-5.6 IS", "Canon EF-S 18-135mm f/3.5-5.6 IS" },
+    { ".EF-S18-135mm f/3.5-5.6 IS USM",
+        "Canon EF-S 18-135mm f/3.5-5.6 IS USM" },
+    { ".EF-S18-200mm f/3.5-5.6 IS", "Canon EF-S 18-200mm f/3.5-5.6 IS" },
+    { ".EF-S18-55mm f/3.5-5.6 III", "Canon EF-S 18-55mm f/3.5-5.6 III" },
+    { ".EF-S18-55mm f/3.5-5.6 IS", "Canon EF-S 18-55mm f/3.5-5.6 IS" },
+    { ".EF-S18-55mm f/3.5-5.6 IS II", "Canon EF-S 18-55mm f/3.5-5.6 IS II" },
+    { ".EF-S55-250mm f/4-5.6 IS II", "Canon EF-S 55-250mm f/4-5.6 IS II" },
+    { ".EF100-400mm f/4.5-5.6L IS USM",
+        "Canon EF 100-400mm f/4.5-5.6L IS USM" },
+    { ".EF16-35mm f/2.8L II USM", "Canon EF 16-35mm f/2.8 L II USM" },
+    { ".EF17-40mm f/4L USM", "Canon EF 17-40mm f/4 L USM" },
+    { ".EF180mm f/3.5L Macro USM", "Canon EF 180mm f/3.5 L Macro USM" },
+    { ".EF180mm f/3.5L Macro USM +1.4x III",
+        "Canon EF 180mm f/3.5 L Macro USM (with 1.4x Converter Mark III)" },
+    { ".EF24-105mm f/4L IS USM", "Canon EF 24-105mm f/4 L IS USM" },
+    { ".EF300mm f/4L IS USM", "Canon EF 300mm f/4 L IS USM" },
+    { ".EF400mm f/5.6L USM +1.4x III",
+        "Canon EF 400mm f/5.6L USM (with 1.4x Converter III)" },
+    { ".EF500mm f/4L IS USM", "Canon EF 500mm f/4 L IS USM" },
+    { ".EF50mm f/1.4 USM", "Canon EF 50mm f/1.4 USM" },
+    { ".EF50mm f/1.8 STM", "Canon EF 50mm f/1.8 STM" },
+    { ".EF50mm f/2.5 Compact Macro", "Canon EF 50mm f/2.5 Compact Macro" },
+    { ".EF600mm f/4L IS II USM", "Canon EF 600mm f/4 L IS II USM" },
+    { ".EF600mm f/4L IS USM", "Canon EF 600mm f/4 L IS USM" },
+    { ".EF600mm f/4L IS USM +1.4x III",
+        "EF 600mm f/4 L IS USM (with 1.4x Converter III)" },
+    { ".EF70-200mm f/2.8L IS II USM", "Canon EF 70-200mm f/2.8 L IS USM II" },
+    { ".EF70-200mm f/4L USM", "Canon EF 70-200mm f/4 L USM" },
+    { ".EF70-300mm f/4-5.6 IS II USM", "Canon EF 70-300mm f/4-5.6 IS II USM" },
+    { ".EF70-300mm f/4-5.6 IS USM", "Canon EF 70-300mm f/4-5.6 IS USM" },
+    { ".EF75-300mm f/4-5.6", "Canon EF 75-300mm f/4-5.6" },
+    { ".EF75-300mm f/4-5.6 IS USM", "Canon EF 75-300mm f/4-5.6 IS USM" },
+    { ".FE 200-600mm F5.6-6.3 G OSS", "Sony FE 200-600mm f/5.6-6.3 G OSS" },
+    { ".FE 20mm F1.8 G", "Sony FE 20mm f/1.8 G" },
+    { ".FE 70-200mm F4 G OSS", "Sony FE 70-200mm f/4 G OSS" },
+    { ".LUMIX G VARIO 45-200/F4.0-5.6", "Lumix G Vario 45-200mm f/4-5.6" },
+    { ".LUMIX G VARIO PZ 45-175/F4.0-5.6",
+        "Lumix G Vario PZ 45-175mm f/4-5.6" },
+    { ".RF16mm F2.8 STM", "Canon RF 16mm f/2.8 STM" },
+    { ".XF56mmF1.2 R", "Fujifilm Fujinon XF 56mm f/1.2 R" },
 
     // Apple
-    m_LensModelMapper["Apple.iPad back camera 4.28mm f/2.4"] =
-        "Apple iPad Back Camera 4.28mm f/2.4";
-    m_LensModelMapper["Apple.iPad mini back camera 3.3mm f/2.4"] =
-        "Apple iPad Mini Back Camera 3.3mm f/2.4";
-    m_LensModelMapper[
-        "Apple.iPhone SE (2nd generation) back camera 3.99mm f/1.8"] =
-        "Apple iPhone SE (2nd Generation) Back Camera 3.99mm f/1.8";
-    m_LensModelMapper[
-        "Apple.iPhone SE (3rd generation) back camera 3.99mm f/1.8"] =
-        "Apple iPhone SE (3rd Generation) Back Camera 3.99mm f/1.8";
-    m_LensModelMapper["Apple.iPhone 5 back camera 4.12mm f/2.4"] =
-        "Apple iPhone 5 Back Camera 4.12mm f/2.4";
-    m_LensModelMapper["Apple.iPhone 5s back camera 4.15mm f/2.2"] =
-        "Apple iPhone 5s Back Camera 4.15mm f/2.2";
-    m_LensModelMapper["Apple.iPhone 6 back camera 4.15mm f/2.2"] =
-        "Apple iPhone 6 Back Camera 4.15mm f/2.2";
-    m_LensModelMapper["Apple.iPhone 6 front camera 2.65mm f/2.2"] =
-        "Apple iPhone 6 Front Camera 2.65mm f/2.2";
-    m_LensModelMapper["Apple.iPhone 6s back camera 4.15mm f/2.2"] =
-        "Apple iPhone 6s Back Camera 4.15mm f/2.2";
-    m_LensModelMapper["Apple.iPhone 6s Plus back camera 4.15mm f/2.2"] =
-        "Apple iPhone 6s Plus Back Camera 4.15mm f/2.2";
-    m_LensModelMapper["Apple.iPhone 7 back camera 3.99mm f/1.8"] =
-        "Apple iPhone 7 Back Camera 3.99mm f/1.8";
-    m_LensModelMapper["Apple.iPhone 8 back camera 3.99mm f/1.8"] =
-        "Apple iPhone 8 Back Camera 3.99mm f/1.8";
-    m_LensModelMapper["Apple.iPhone 11 Pro Max back triple camera 6mm f/2"] =
-        "Apple iPhone 11 Pro Max Back Triple Camera 6mm f/2";
-    m_LensModelMapper["Apple.iPhone 11 back dual wide camera 4.25mm f/1.8"] =
-        "Apple iPhone 11 Back Dual Wide Camera 4.25mm f/1.8";
-    m_LensModelMapper["Apple.iPhone 12 back camera 4.2mm f/1.6"] =
-        "Apple iPhone 12 Back Camera 4.2mm f/1.6";
-    m_LensModelMapper["Apple.iPhone 12 back dual wide camera 1.55mm f/2.4"] =
-        "Apple iPhone 12 Back Dual Wide Camera 1.55mm f/2.4";
-    m_LensModelMapper["Apple.iPhone 12 back dual wide camera 4.2mm f/1.6"] =
-        "Apple iPhone 12 Back Camera 4.2mm f/1.6";
-    m_LensModelMapper["Apple.iPhone 12 front camera 2.71mm f/2.2"] =
-        "Apple iPhone 12 Front Camera 2.71mm f/2.2";
-    m_LensModelMapper["Apple.iPhone 12 Pro back triple camera 4.2mm f/1.6"] =
-        "Apple iPhone 12 Pro Back Triple Camera 4.2mm f/1.6";
-    m_LensModelMapper["Apple.iPhone 12 Pro Max back camera 5.1mm f/1.6"] =
-        "Apple iPhone 12 Pro Max Back Camera 5.1mm f/1.6";
-    m_LensModelMapper["Apple.iPhone 15 back dual wide camera 5.96mm f/1.6"] =
-        "Apple iPhone 15 back Dual Wide Camera 5.96mm f/1.6";
-    m_LensModelMapper["Apple.iPhone 15 Pro back triple camera 6.765mm "
-        "f/1.78"] =
-        "Apple.iPhone 15 Pro Back Triple Camera 6.765mm f/1.78";
-    m_LensModelMapper["Apple.iPhone 15 Pro Max back triple camera 6.765mm "
-        "f/1.78"] =
-        "Apple iPhone 15 Pro Max Back Triple Camera 6.765mm f/1.78";
-    m_LensModelMapper["Apple.iPhone 16e back camera 4.2mm f/1.64"] =
-        "Apple iPhone 16e Back Camera 4.2mm f/1.64";
-    m_LensModelMapper["Apple.iPhone 16e front camera 2.69mm f/1.9"] =
-        "Apple iPhone 16e Front Camera 2.69mm f/1.9";
-    m_LensModelMapper
-        ["Apple.iPhone 16 Pro Max back triple camera 6.765mm f/1.78"] =
-        "Apple iPhone 16 Pro Max Back Triple Camera 6.765mm f/1.78";
-
-    // Canon
-    m_LensModelMapper[".EF16-35mm f/2.8L II USM"] =
-        "Canon EF 16-35mm f/2.8 L II USM";
-    m_LensModelMapper[".EF17-40mm f/4L USM"] = "Canon EF 17-40mm f/4 L USM";
-    m_LensModelMapper[".EF-M55-200mm f/4.5-6.3 IS STM"] =
-        "Canon EF-M 55-200mm f/4.5-6.3 IS STM";
-    m_LensModelMapper[".EF-S17-55mm f/2.8 IS USM"] =
-        "Canon EF-S 17-55mm f/2.8 IS USM";
-    m_LensModelMapper[".EF-S18-55mm f/3.5-5.6 IS"] =
-        "Canon EF-S 18-55mm f/3.5-5.6 IS";
-    m_LensModelMapper[".EF-S18-55mm f/3.5-5.6 IS II"] =
-        "Canon EF-S 18-55mm f/3.5-5.6 IS II";
-    m_LensModelMapper[".EF-S18-55mm f/3.5-5.6 III"] =
-        "Canon EF-S 18-55mm f/3.5-5.6 III";
-    m_LensModelMapper[".EF-S18-135mm f/3.5-5.6 IS"] =
-        "Canon EF-S 18-135mm f/3.5-5.6 IS";
-    m_LensModelMapper[".EF-S18-135mm f/3.5-5.6 IS USM"] =
-        "Canon EF-S 18-135mm f/3.5-5.6 IS USM";
-    m_LensModelMapper[".EF-S18-200mm f/3.5-5.6 IS"] =
-        "Canon EF-S 18-200mm f/3.5-5.6 IS";
-    m_LensModelMapper[".EF24-105mm f/4L IS USM"] =
-        "Canon EF 24-105mm f/4 L IS USM";
-    m_LensModelMapper[".EF50mm f/1.4 USM"] = "Canon EF 50mm f/1.4 USM";
-    m_LensModelMapper[".EF50mm f/1.8 STM"] = "Canon EF 50mm f/1.8 STM";
-    m_LensModelMapper[".EF50mm f/2.5 Compact Macro"] =
-        "Canon EF 50mm f/2.5 Compact Macro";
-    m_LensModelMapper[".EF-S55-250mm f/4-5.6 IS II"] =
-        "Canon EF-S 55-250mm f/4-5.6 IS II";
-    m_LensModelMapper[".EF70-200mm f/2.8L IS II USM"] =
-        "Canon EF 70-200mm f/2.8 L IS USM II";
-    m_LensModelMapper[".EF70-200mm f/4L USM"] = "Canon EF 70-200mm f/4 L USM";
-    m_LensModelMapper[".EF70-300mm f/4-5.6 IS USM"] =
-        "Canon EF 70-300mm f/4-5.6 IS USM";
-    m_LensModelMapper[".EF70-300mm f/4-5.6 IS II USM"] =
-        "Canon EF 70-300mm f/4-5.6 IS II USM";
-    m_LensModelMapper[".EF75-300mm f/4-5.6"] = "Canon EF 75-300mm f/4-5.6";
-    m_LensModelMapper[".EF75-300mm f/4-5.6 IS USM"] =
-        "Canon EF 75-300mm f/4-5.6 IS USM";
-    m_LensModelMapper[".EF100-400mm f/4.5-5.6L IS USM"] =
-        "Canon EF 100-400mm f/4.5-5.6L IS USM";
-    m_LensModelMapper[".EF180mm f/3.5L Macro USM"] =
-        "Canon EF 180mm f/3.5 L Macro USM";
-    m_LensModelMapper[".EF180mm f/3.5L Macro USM +1.4x III"] =
-        "Canon EF 180mm f/3.5 L Macro USM (with 1.4x Converter Mark III)";
-    m_LensModelMapper[".EF300mm f/4L IS USM"] = "Canon EF 300mm f/4 L IS USM";
-    m_LensModelMapper[".EF400mm f/5.6L USM +1.4x III"] =
-        "Canon EF 400mm f/5.6L USM (with 1.4x Converter III)";
-    m_LensModelMapper[".EF500mm f/4L IS USM"] = "Canon EF 500mm f/4 L IS USM";
-    m_LensModelMapper[".EF600mm f/4L IS USM"] = "Canon EF 600mm f/4 L IS USM";
-    m_LensModelMapper[".EF600mm f/4L IS II USM"] =
-        "Canon EF 600mm f/4 L IS II USM";
-    m_LensModelMapper[".EF600mm f/4L IS USM +1.4x III"] =
-        "EF 600mm f/4 L IS USM (with 1.4x Converter III)";
-    m_LensModelMapper[".RF16mm F2.8 STM"] = "Canon RF 16mm f/2.8 STM";
-
-    // Fujifilm
-    m_LensModelMapper[".XF56mmF1.2 R"] = "Fujifilm Fujinon XF 56mm f/1.2 R";
+    { "Apple.iPad back camera 4.28mm f/2.4",
+        "Apple iPad Back Camera 4.28mm f/2.4" },
+    { "Apple.iPad mini back camera 3.3mm f/2.4",
+        "Apple iPad Mini Back Camera 3.3mm f/2.4" },
+    { "Apple.iPhone 11 Pro Max back triple camera 6mm f/2",
+        "Apple iPhone 11 Pro Max Back Triple Camera 6mm f/2" },
+    { "Apple.iPhone 11 back dual wide camera 4.25mm f/1.8",
+        "Apple iPhone 11 Back Dual Wide Camera 4.25mm f/1.8" },
+    { "Apple.iPhone 12 Pro Max back camera 5.1mm f/1.6",
+        "Apple iPhone 12 Pro Max Back Camera 5.1mm f/1.6" },
+    { "Apple.iPhone 12 Pro back triple camera 4.2mm f/1.6",
+        "Apple iPhone 12 Pro Back Triple Camera 4.2mm f/1.6" },
+    { "Apple.iPhone 12 back camera 4.2mm f/1.6",
+        "Apple iPhone 12 Back Camera 4.2mm f/1.6" },
+    { "Apple.iPhone 12 back dual wide camera 1.55mm f/2.4",
+        "Apple iPhone 12 Back Dual Wide Camera 1.55mm f/2.4" },
+    { "Apple.iPhone 12 back dual wide camera 4.2mm f/1.6",
+        "Apple iPhone 12 Back Camera 4.2mm f/1.6" },
+    { "Apple.iPhone 12 front camera 2.71mm f/2.2",
+        "Apple iPhone 12 Front Camera 2.71mm f/2.2" },
+    { "Apple.iPhone 15 Pro Max back triple camera 6.765mm f/1.78",
+        "Apple iPhone 15 Pro Max Back Triple Camera 6.765mm f/1.78" },
+    { "Apple.iPhone 15 Pro back triple camera 6.765mm f/1.78",
+        "Apple.iPhone 15 Pro Back Triple Camera 6.765mm f/1.78" },
+    { "Apple.iPhone 15 back dual wide camera 5.96mm f/1.6",
+        "Apple iPhone 15 back Dual Wide Camera 5.96mm f/1.6" },
+    { "Apple.iPhone 16 Pro Max back triple camera 6.765mm f/1.78",
+        "Apple iPhone 16 Pro Max Back Triple Camera 6.765mm f/1.78" },
+    { "Apple.iPhone 16e back camera 4.2mm f/1.64",
+        "Apple iPhone 16e Back Camera 4.2mm f/1.64" },
+    { "Apple.iPhone 16e front camera 2.69mm f/1.9",
+        "Apple iPhone 16e Front Camera 2.69mm f/1.9" },
+    { "Apple.iPhone 5 back camera 4.12mm f/2.4",
+        "Apple iPhone 5 Back Camera 4.12mm f/2.4" },
+    { "Apple.iPhone 5s back camera 4.15mm f/2.2",
+        "Apple iPhone 5s Back Camera 4.15mm f/2.2" },
+    { "Apple.iPhone 6 back camera 4.15mm f/2.2",
+        "Apple iPhone 6 Back Camera 4.15mm f/2.2" },
+    { "Apple.iPhone 6 front camera 2.65mm f/2.2",
+        "Apple iPhone 6 Front Camera 2.65mm f/2.2" },
+    { "Apple.iPhone 6s Plus back camera 4.15mm f/2.2",
+        "Apple iPhone 6s Plus Back Camera 4.15mm f/2.2" },
+    { "Apple.iPhone 6s back camera 4.15mm f/2.2",
+        "Apple iPhone 6s Back Camera 4.15mm f/2.2" },
+    { "Apple.iPhone 7 back camera 3.99mm f/1.8",
+        "Apple iPhone 7 Back Camera 3.99mm f/1.8" },
+    { "Apple.iPhone 8 back camera 3.99mm f/1.8",
+        "Apple iPhone 8 Back Camera 3.99mm f/1.8" },
+    { "Apple.iPhone SE (2nd generation) back camera 3.99mm f/1.8",
+        "Apple iPhone SE (2nd Generation) Back Camera 3.99mm f/1.8" },
+    { "Apple.iPhone SE (3rd generation) back camera 3.99mm f/1.8",
+        "Apple iPhone SE (3rd Generation) Back Camera 3.99mm f/1.8" },
 
     // Google
-    m_LensModelMapper["Google.Pixel 6 Pro back camera 6.81mm f/1.85"] =
-        "Google Pixel 6 Pro Back Camera 6.81mm f/1.85";
-    m_LensModelMapper["Google.Pixel 10 back camera 4.53mm f/1.7"] =
-        "Google Pixel 10 Back Camera 4.53mm f/1.7";
+    { "Google.Pixel 10 back camera 4.53mm f/1.7",
+        "Google Pixel 10 Back Camera 4.53mm f/1.7" },
+    { "Google.Pixel 6 Pro back camera 6.81mm f/1.85",
+        "Google Pixel 6 Pro Back Camera 6.81mm f/1.85" },
 
     // Nikon
-    m_LensModelMapper["Nikon.AF-S NIKKOR 180-400mm f/4E TC1.4 FL ED VR"] =
-        "Nikon AF-S Nikkor 180-400mm f/4 E TC 1.4 FL ED VR";
-
-    // Lumix
-    m_LensModelMapper[".LUMIX G VARIO 45-200/F4.0-5.6"] =
-        "Lumix G Vario 45-200mm f/4-5.6";
-    m_LensModelMapper[".LUMIX G VARIO PZ 45-175/F4.0-5.6"] =
-        "Lumix G Vario PZ 45-175mm f/4-5.6";
+    { "Nikon.AF-S NIKKOR 180-400mm f/4E TC1.4 FL ED VR",
+        "Nikon AF-S Nikkor 180-400mm f/4 E TC 1.4 FL ED VR" },
 
     // Olympus
-    m_LensModelMapper["OLYMPUS M.12-40mm F2.8"] =
-        "Olympus M.Zuiko 12-40mm f/2.8";
-    m_LensModelMapper["OLYMPUS M.40-150mm F4.0-5.6"] =
-        "Olympus M.Zuiko 40-150mm f/4-5.6";
-    m_LensModelMapper["OLYMPUS M.75-300mm F4.8-6.7 II"] =
-        "Olympus M.Zuiko 75-300mm f/4.8-6.7 II";
-
-    // Sigma
-    m_LensModelMapper[".DT 18-35mm F1.8"] = "Sigma DT 18-35mm f/1.8";
-    m_LensModelMapper[".60-600mm F4.5-6.3 DG OS HSM | Sports 018"] =
-        "Sigma 60-600mm f/4.5-6.3 DG OS HSM Sports";
-    m_LensModelMapper[".150-600mm F5-6.3 DG OS HSM | Contemporary 015"] =
-        "Sigma 150-600mm f/5-6.3 DG OS HSM | Contemporary 015";
-    m_LensModelMapper[".150-600mm F5-6.3 DG OS HSM | Contemporary 015 +1.4x"] =
-        "Sigma 150-600mm f/5-6.3 DG OS HSM | Contemporary 015 "
-        "(with 1.4x Converter)";
+    { "OLYMPUS M.12-40mm F2.8", "Olympus M.Zuiko 12-40mm f/2.8" },
+    { "OLYMPUS M.40-150mm F4.0-5.6", "Olympus M.Zuiko 40-150mm f/4-5.6" },
+    { "OLYMPUS M.75-300mm F4.8-6.7 II",
+        "Olympus M.Zuiko 75-300mm f/4.8-6.7 II" },
+};
+static_assert(IsSorted(LENS_MODEL_MAPPER),
+    "LENS_MODEL_MAPPER must be sorted");
 
-    // Sony
-    m_LensModelMapper[".16-35mm F2.8 ZA SSM"] =
-        "Sony Zeiss Sonar 16-35mm f/2.8 ZA SSM";
-    m_LensModelMapper[".FE 20mm F1.8 G"] = "Sony FE 20mm f/1.8 G";
-    m_LensModelMapper[".DT 70-300mm F4-5.6 SAM"] =
-        "Sony DT 70-300mm f/4-5.6 SAM";
-    m_LensModelMapper[".85mm F1.4 ZA"] = "Sony Zeiss Planar 85mm f/1.4 ZA";
-    m_LensModelMapper[".150-600mm F5-6.3 SSM"] = "Sony 150-600mm f/5-6.3 SSM";
-    m_LensModelMapper[".DT 18-55mm F3.5-5.6 SAM"] =
-        "Sony DT 18-55mm f/3.5-5.6 SAM";
-    m_LensModelMapper[".E 18-55mm F3.5-5.6 OSS"] =
-        "Sony E 18-55mm f/3.5-5.6 OSS";
-    m_LensModelMapper[".E 35mm F1.8 OSS"] = "Sony E 35mm f/1.8 OSS";
-    m_LensModelMapper[".FE 70-200mm F4 G OSS"] = "Sony FE 70-200mm f/4 G OSS";
-    m_LensModelMapper[".FE 200-600mm F5.6-6.3 G OSS"] =
-        "Sony FE 200-600mm f/5.6-6.3 G OSS";
 
-    // Tamron
-    m_LensModelMapper[".E 17-70mm F2.8 B070"] = "Tamron 17-70mm f/2.8 B070";
 
-    CALL_OUT("");
-}
+///////////////////////////////////////////////////////////////////////////////
+// F stop mapper
+static constexpr MapperEntry F_STOP_MAPPER[] =
+{
+    { "0/1", "" },
+    { "1/1", "1" },
+    { "10/1", "10" },
+    { "100/10", "10" },
+    { "11/1", "11" },
+    { "11/5", "2.2" },
+    { "110/10", "11" },
+    { "12/1", "12" },
+    { "12/5", "2.4" },
+    { "1244236/699009", "1.8" },
+    { "13/1", "13" },
+    { "130/10", "13" },
+    { "14/1", "14" },
+    { "14/5", "2.8" },
+    { "150/100", "1.5" },
+    { "16/1", "16" },
+    { "1600/1000", "1.6" },
+    { "165/100", "1.7" },
+    { "17/10", "1.7" },
+    { "170/100", "1.7" },
+    { "17000/10000", "1.7" },
+    { "179/100", "1.8" },
+    { "18/1", "18" },
+    { "18/10", "1.8" },
+    { "180/10", "18" },
+    { "180/100", "1.8" },
+    { "185/100", "1.9" },
+    { "189/100", "1.9" },
+    { "19/10", "1.9" },
+    { "190/100", "1.9" },
+    { "19000/10000", "1.9" },
+    { "2/1", "2" },
+    { "20/1", "20" },
+    { "20/10", "2" },
+    { "200/100", "2" },
+    { "200000/100000", "2" },
+    { "2000000/1000000", "2" },
+    { "22/1", "22" },
+    { "220/10", "22" },
+    { "220/100", "2.2" },
+    { "2200/100", "22" },
+    { "22000/10000", "2.2" },
+    { "23/10", "2.3" },
+    { "24/10", "2.4" },
+    { "240/100", "2.4" },
+    { "24000/10000", "2.4" },
+    { "240000/100000", "2.4" },
+    { "25/1", "25" },
+    { "25/10", "2.5" },
+    { "250/10", "25" },
+    { "26/10", "2.6" },
+    { "260/100", "2.6" },
+    { "265/100", "2.7" },
+    { "27/10", "2.7" },
+    { "270/100", "2.7" },
+    { "28/10", "2.8" },
+    { "28/5", "5.6" },
+    { "280/100", "2.8" },
+    { "2800/1000", "28" },
+    { "288/100", "2.9" },
+    { "29/1", "29" },
+    { "29/10", "2.9" },
+    { "3/1", "3" },
+    { "30/10", "3" },
+    { "31/10", "3.1" },
+    { "310/100", "3.1" },
+    { "3100/1000", "3.1" },
+    { "317/100", "3.2" },
+    { "32/10", "3.2" },
+    { "33/10", "3.3" },
+    { "330/100", "3.3" },
+    { "34/10", "3.4" },
+    { "340/100", "3.4" },
+    { "35/10", "3.5" },
+    { "350/100", "3.5" },
+    { "358/128", "2.8" },
+    { "36/10", "3.6" },
+    { "360/100", "3.6" },
+    { "37/10", "3.7" },
+    { "38/10", "3.8" },
+    { "380/100", "3.8" },
+    { "390/100", "3.9" },
+    { "4/1", "4" },
+    { "40/10", "4" },
+    { "400/100", "4" },
+    { "403/100", "4" },
+    { "41/10", "4.1" },
+    { "41/25", "1.6" },
+    { "42/10", "4.2" },
+    { "425/100", "4.3" },
+    { "4294967295/766958458", "5.6" },
+    { "4294967295/954437176", "4.5" },
+    { "43/10", "4.3" },
+    { "44/10", "4.4" },
+    { "4400000/1000000", "4.4" },
+    { "45/10", "4.5" },
+    { "450/100", "4.5" },
+    { "4500000/1000000", "4.5" },
+    { "46/10", "4.6" },
+    { "47/10", "4.7" },
+    { "470/100", "4.7" },
+    { "48/10", "4.8" },
+    { "49/10", "4.9" },
+    { "5/1", "5" },
+    { "50/10", "5" },
+    { "500/100", "5" },
+    { "51/10", "5.1" },
+    { "53/10", "5.3" },
+    { "550/100", "5.5" },
+    { "56/10", "5.6" },
+    { "57/10", "5.7" },
+    { "58/10", "5.8" },
+    { "59/10", "5.9" },
+    { "63/10", "6.3" },
+    { "65/10", "6.5" },
+    { "66/10", "6.6" },
+    { "6606029/1048576", "6.3" },
+    { "67/10", "6.7" },
+    { "7/2", "3.5" },
+    { "70/10", "7.0" },
+    { "700/100", "7" },
+    { "71/10", "7.1" },
+    { "74/10", "7.4" },
+    { "76/10", "7.6" },
+    { "77/10", "7.7" },
+    { "8/1", "8" },
+    { "8/5", "1.6" },
+    { "80/10", "8" },
+    { "800/100", "8" },
+    { "81/10", "8.1" },
+    { "870/100", "8.7" },
+    { "9/1", "9" },
+    { "9/2", "4.5" },
+    { "9/5", "1.8" },
+    { "90/10", "9.0" },
+    { "900/100", "9" },
+    { "939524096/67108864", "14" },
+    { "95/10", "9.5" },
+    { "950/100", "9.5" },
+    { "970/100", "9.7" },
+};
+static_assert(IsSorted(F_STOP_MAPPER),
+    "F_STOP_MAPPER must be sorted");
 
 
 
 ///////////////////////////////////////////////////////////////////////////////
-// F Stop mapper
-void ExifInfo::Init_FStopMapper()
+// Focal length mapper
+// (n/1 and n/10 for n from 3 to 499 are handled by LookUpMapper())
+static constexpr MapperEntry FOCAL_LENGTH_MAPPER[] =
 {
-    CALL_IN("");
+    { "0/1", "" },
+    { "0/100", "" },
+    { "1000/10", "100" },
+    { "103/25", "4.1" },
+    { "1040/10", "104" },
+    { "1050/10", "105" },
+    { "107/25", "4.3" },
+    { "11/2", "5.5" },
+    { "1100/10", "110" },
+    { "1100/100", "11" },
+    { "12074/1000", "12.1" },
+    { "125/16", "7.8" },
+    { "12669/1000", "12.7" },
+    { "1270/100", "12.7" },
+    { "12845/1000", "12.8" },
+    { "13300/1000", "13.3" },
+    { "13600/1000", "13.6" },
+    { "1400/10", "140" },
+    { "14783/1000", "14.8" },
+    { "149/25", "6.0" },
+    { "14900/1000", "14.9" },
+    { "14926/1000", "14.9" },
+    { "15/2", "7.5" },
+    { "1500/10", "150" },
+    { "15000/100", "150" },
+    { "150000000/1000000", "150" },
+    { "1510/100", "15.1" },
+    { "15673/1000", "15.7" },
+    { "1580/10", "158" },
+    { "1600/10", "160" },
+    { "1650/10", "165" },
+    { "17/2", "8.5" },
+    { "17/4", "4.3" },
+    { "1700/100", "17" },
+    { "1712/100", "17.1" },
+    { "173/32", "5.4" },
+    { "1750/10", "175" },
+    { "1800/10", "180" },
+    { "1820/100", "18.2" },
+    { "1850/10", "185" },
+    { "186/32", "5.8" },
+    { "1860/100", "18.6" },
+    { "189/32", "5.9" },
+    { "2000/10", "200" },
+    { "20000/1000", "20" },
+    { "20100/1000", "20.1" },
+    { "21/5", "4.2" },
+    { "2100/10", "210" },
+    { "21556/1000", "21.6" },
+    { "220/100", "2.2" },
+    { "2200/10", "220" },
+    { "224/32", "7" },
+    { "2259/20", "113" },
+    { "227/32", "7.1" },
+    { "2300/10", "230" },
+    { "2300/100", "23" },
+    { "23280/1000", "23.3" },
+    { "24/5", "4.8" },
+    { "2400/10", "240" },
+    { "2497280/65536", "38.1" },
+    { "250/32", "7.8" },
+    { "2510/100", "25.1" },
+    { "251773/37217", "6.7" },
+    { "271/100", "2.7" },
+    { "279/100", "2.8" },
+    { "2800/10", "280" },
+    { "29/5", "5.8" },
+    { "290/100", "2.9" },
+    { "2900/10", "290" },
+    { "2940/1000", "2.9" },
+    { "3000/10", "300" },
+    { "301/32", "9.4" },
+    { "3097/1000", "3.1" },
+    { "31/20", "1.6" },
+    { "3100/10", "310" },
+    { "314/32", "9.8" },
+    { "3170/1000", "3.2" },
+    { "3200/1000", "3.2" },
+    { "33/5", "6.6" },
+    { "3300/10", "330" },
+    { "3302983/524283", "6.3" },
+    { "331/100", "3.3" },
+    { "3400/10", "340" },
+    { "3400/100", "34" },
+    { "342/32", "10.7" },
+    { "34900/1000", "34.9" },
+    { "350/100", "3.5" },
+    { "3500/100", "35" },
+    { "354/100", "3.5" },
+    { "360/100", "3.6" },
+    { "3600/10", "360" },
+    { "362/32", "11.3" },
+    { "3620/1000", "3.6" },
+    { "369/100", "3.7" },
+    { "370/100", "3.7" },
+    { "382/100", "3.8" },
+    { "3820/1000", "3.8" },
+    { "3830/1000", "3.8" },
+    { "3971/256", "15.5" },
+    { "399/100", "4" },
+    { "400/32", "12.5" },
+    { "4000/10", "400" },
+    { "4000/1000", "4" },
+    { "403/100", "4" },
+    { "405/100", "4.1" },
+    { "4090/1000", "4.1" },
+    { "410/100", "4.1" },
+    { "413/100", "4.1" },
+    { "420/100", "4.2" },
+    { "425/100", "4.3" },
+    { "430/100", "4.3" },
+    { "4300/1000", "4.3" },
+    { "431/100", "4.3" },
+    { "442/100", "4.4" },
+    { "44400/1000", "44.4" },
+    { "4442/1000", "4.4" },
+    { "4499/1000", "4.5" },
+    { "4500/100", "45" },
+    { "4500/1000", "4.5" },
+    { "4530/1000", "4.5" },
+    { "460/100", "4.6" },
+    { "4600/10", "460" },
+    { "4600/1000", "4.6" },
+    { "461/32", "14.4" },
+    { "467/100", "4.7" },
+    { "469865/174671", "2.7" },
+    { "4710/1000", "4.7" },
+    { "4740/1000", "4.7" },
+    { "4750/100", "47.5" },
+    { "480/100", "4.8" },
+    { "490/100", "4.9" },
+    { "4900/10", "490" },
+    { "500/1", "500" },
+    { "500/10", "50" },
+    { "500/100", "5" },
+    { "5000/10", "500" },
+    { "5000/100", "50" },
+    { "5000/1000", "5" },
+    { "50000/1000", "50" },
+    { "514/100", "5.1" },
+    { "523/100", "5.2" },
+    { "53/20", "2.7" },
+    { "5300/100", "53" },
+    { "535/100", "5.4" },
+    { "540/100", "5.4" },
+    { "5400/1000", "5.4" },
+    { "543/100", "5.4" },
+    { "550/1", "550" },
+    { "550/10", "55" },
+    { "5500/10", "550" },
+    { "5500/100", "55" },
+    { "5583/1000", "5.6" },
+    { "559/10", "55.9" },
+    { "560/1", "560" },
+    { "5600/10", "560" },
+    { "5600/100", "56" },
+    { "570/10", "5.7" },
+    { "570/100", "5.7" },
+    { "5700/1000", "5.7" },
+    { "580/100", "5.8" },
+    { "5800/1000", "5.8" },
+    { "585/100", "5.9" },
+    { "5854/1000", "5.9" },
+    { "587/100", "5.9" },
+    { "590/100", "5.9" },
+    { "5900/1000", "5.9" },
+    { "591/100", "5.9" },
+    { "5989/1000", "6" },
+    { "600/1", "600" },
+    { "600/10", "60" },
+    { "600/100", "6" },
+    { "6000/10", "600" },
+    { "6000/1000", "6" },
+    { "608/10", "61" },
+    { "610/100", "6.1" },
+    { "6100/1000", "6.1" },
+    { "6190/1000", "6.2" },
+    { "620/100", "6.2" },
+    { "6200/1000", "6.2" },
+    { "630/10", "63" },
+    { "630/100", "6.3" },
+    { "6300/1000", "6.3" },
+    { "6300000/1000000", "6.3" },
+    { "633/100", "6.3" },
+    { "6330/100", "63.3" },
+    { "640/100", "6.4" },
+    { "6447/1000", "6.4" },
+    { "650/100", "6.5" },
+    { "660/100", "6.6" },
+    { "6600/1000", "6.6" },
+    { "663/100", "6.6" },
+    { "67/5", "13.4" },
+    { "670/100", "6.7" },
+    { "6769/1000", "6.8" },
+    { "6810/1000", "6.8" },
+    { "682/32", "21.3" },
+    { "684/10", "68.4" },
+    { "693/10", "69.3" },
+    { "700/10", "70" },
+    { "72000/1000", "72" },
+    { "7300/1000", "7.3" },
+    { "736/10", "73.6" },
+    { "7400/1000", "7.4" },
+    { "750/100", "7.5" },
+    { "755/128", "5.9" },
+    { "77/20", "3.9" },
+    { "7700/1000", "7.7" },
+    { "780/100", "7.8" },
+    { "790/100", "7.9" },
+    { "7947/1000", "7.9" },
+    { "800/100", "8" },
+    { "820/100", "8.2" },
+    { "8205/1000", "8.2" },
+    { "83/20", "4.2" },
+    { "840/1", "840" },
+    { "840/100", "8.4" },
+    { "850/10", "85" },
+    { "8500/10", "850" },
+    { "870/10", "87" },
+    { "880803840/8388608", "105" },
+    { "882/100", "8.8" },
+    { "9954/1000", "10" },
+};
+static_assert(IsSorted(FOCAL_LENGTH_MAPPER),
+    "FOCAL_LENGTH_MAPPER must be sorted");
 
-    // For values from Photo.FNumber
-
-    m_FStopMapper["0/1"] = "";
-    m_FStopMapper["1/1"] = "1";
-    m_FStopMapper["2/1"] = "2";
-    m_FStopMapper["3/1"] = "3";
-    m_FStopMapper["4/1"] = "4";
-    m_FStopMapper["5/1"] = "5";
-    m_FStopMapper["8/1"] = "8";
-    m_FStopMapper["9/1"] = "9";
-    m_FStopMapper["10/1"] = "10";
-    m_FStopMapper["11/1"] = "11";
-    m_FStopMapper["12/1"] = "12";
-    m_FStopMapper["13/1"] = "13";
-    m_FStopMapper["14/1"] = "14";
-    m_FStopMapper["16/1"] = "16";
-    m_FStopMapper["18/1"] = "18";
-    m_FStopMapper["20/1"] = "20";
-    m_FStopMapper["22/1"] = "22";
-    m_FStopMapper["25/1"] = "25";
-    m_FStopMapper["29/1"] = "29";
-
-    m_FStopMapper["7/2"] = "3.5";
-    m_FStopMapper["9/2"] = "4.5";
-
-    m_FStopMapper["8/5"] = "1.6";
-    m_FStopMapper["9/5"] = "1.8";
-    m_FStopMapper["11/5"] = "2.2";
-    m_FStopMapper["12/5"] = "2.4";
-    m_FStopMapper["14/5"] = "2.8";
-    m_FStopMapper["28/5"] = "5.6";
-
-    m_FStopMapper["17/10"] = "1.7";
-    m_FStopMapper["18/10"] = "1.8";
-    m_FStopMapper["19/10"] = "1.9";
-    m_FStopMapper["20/10"] = "2";
-    m_FStopMapper["23/10"] = "2.3";
-    m_FStopMapper["24/10"] = "2.4";
-    m_FStopMapper["25/10"] = "2.5";
-    m_FStopMapper["26/10"] = "2.6";
-    m_FStopMapper["27/10"] = "2.7";
-    m_FStopMapper["28/10"] = "2.8";
-    m_FStopMapper["29/10"] = "2.9";
-    m_FStopMapper["30/10"] = "3";
-    m_FStopMapper["31/10"] = "3.1";
-    m_FStopMapper["32/10"] = "3.2";
-    m_FStopMapper["33/10"] = "3.3";
-    m_FStopMapper["34/10"] = "3.4";
-    m_FStopMapper["35/10"] = "3.5";
-    m_FStopMapper["36/10"] = "3.6";
-    m_FStopMapper["37/10"] = "3.7";
-    m_FStopMapper["38/10"] = "3.8";
-    m_FStopMapper["40/10"] = "4";
-    m_FStopMapper["41/10"] = "4.1";
-    m_FStopMapper["42/10"] = "4.2";
-    m_FStopMapper["43/10"] = "4.3";
-    m_FStopMapper["44/10"] = "4.4";
-    m_FStopMapper["45/10"] = "4.5";
-    m_FStopMapper["46/10"] = "4.6";
-    m_FStopMapper["47/10"] = "4.7";
-    m_FStopMapper["48/10"] = "4.8";
-    m_FStopMapper["49/10"] = "4.9";
-    m_FStopMapper["50/10"] = "5";
-    m_FStopMapper["51/10"] = "5.1";
-    m_FStopMapper["53/10"] = "5.3";
-    m_FStopMapper["56/10"] = "5.6";
-    m_FStopMapper["57/10"] = "5.7";
-    m_FStopMapper["58/10"] = "5.8";
-    m_FStopMapper["59/10"] = "5.9";
-    m_FStopMapper["63/10"] = "6.3";
-    m_FStopMapper["65/10"] = "6.5";
-    m_FStopMapper["66/10"] = "6.6";
-    m_FStopMapper["67/10"] = "6.7";
-    m_FStopMapper["70/10"] = "7.0";
-    m_FStopMapper["71/10"] = "7.1";
-    m_FStopMapper["74/10"] = "7.4";
-    m_FStopMapper["76/10"] = "7.6";
-    m_FStopMapper["77/10"] = "7.7";
-    m_FStopMapper["80/10"] = "8";
-    m_FStopMapper["81/10"] = "8.1";
-    m_FStopMapper["90/10"] = "9.0";
-    m_FStopMapper["95/10"] = "9.5";
-    m_FStopMapper["100/10"] = "10";
-    m_FStopMapper["110/10"] = "11";
-    m_FStopMapper["130/10"] = "13";
-    m_FStopMapper["180/10"] = "18";
-    m_FStopMapper["220/10"] = "22";
-    m_FStopMapper["250/10"] = "25";
-
-    m_FStopMapper["41/25"] = "1.6";
-
-    m_FStopMapper["150/100"] = "1.5";
-
-    m_FStopMapper["165/100"] = "1.7";
-    m_FStopMapper["170/100"] = "1.7";
-    m_FStopMapper["179/100"] = "1.8";
-    m_FStopMapper["180/100"] = "1.8";
-    m_FStopMapper["185/100"] = "1.9";
-    m_FStopMapper["189/100"] = "1.9";
-    m_FStopMapper["190/100"] = "1.9";
-    m_FStopMapper["200/100"] = "2";
-    m_FStopMapper["220/100"] = "2.2";
-    m_FStopMapper["240/100"] = "2.4";
-    m_FStopMapper["260/100"] = "2.6";
-    m_FStopMapper["265/100"] = "2.7";
-    m_FStopMapper["270/100"] = "2.7";
-    m_FStopMapper["280/100"] = "2.8";
-    m_FStopMapper["288/100"] = "2.9";
-    m_FStopMapper["310/100"] = "3.1";
-    m_FStopMapper["317/100"] = "3.2";
-    m_FStopMapper["330/100"] = "3.3";
-    m_FStopMapper["340/100"] = "3.4";
-    m_FStopMapper["350/100"] = "3.5";
-    m_FStopMapper["360/100"] = "3.6";
-    m_FStopMapper["380/100"] = "3.8";
-    m_FStopMapper["390/100"] = "3.9";
-    m_FStopMapper["400/100"] = "4";
-    m_FStopMapper["403/100"] = "4";
-    m_FStopMapper["425/100"] = "4.3";
-    m_FStopMapper["450/100"] = "4.5";
-    m_FStopMapper["470/100"] = "4.7";
-    m_FStopMapper["500/100"] = "5";
-    m_FStopMapper["550/100"] = "5.5";
-    m_FStopMapper["700/100"] = "7";
-    m_FStopMapper["800/100"] = "8";
-    m_FStopMapper["870/100"] = "8.7";
-    m_FStopMapper["900/100"] = "9";
-    m_FStopMapper["950/100"] = "9.5";
-    m_FStopMapper["970/100"] = "9.7";
-    m_FStopMapper["2200/100"] = "22";
-    m_FStopMapper["2800/1000"] = "28";
-
-    m_FStopMapper["358/128"] = "2.8";
-
-    m_FStopMapper["1600/1000"] = "1.6";
-    m_FStopMapper["3100/1000"] = "3.1";
-
-    m_FStopMapper["17000/10000"] = "1.7";
-    m_FStopMapper["19000/10000"] = "1.9";
-    m_FStopMapper["22000/10000"] = "2.2";
-    m_FStopMapper["24000/10000"] = "2.4";
-
-    m_FStopMapper["200000/100000"] = "2";
-    m_FStopMapper["240000/100000"] = "2.4";
-
-    m_FStopMapper["1244236/699009"] = "1.8";
-
-    m_FStopMapper["2000000/1000000"] = "2";
-    m_FStopMapper["4400000/1000000"] = "4.4";
-    m_FStopMapper["4500000/1000000"] = "4.5";
-
-    m_FStopMapper["6606029/1048576"] = "6.3";
-
-    m_FStopMapper["939524096/67108864"] = "14";
-
-    m_FStopMapper["4294967295/766958458"] = "5.6";
-    m_FStopMapper["4294967295/954437176"] = "4.5";
 
-    CALL_OUT("");
-}
+
+///////////////////////////////////////////////////////////////////////////////
+// Exposure time mapper
+static constexpr MapperEntry EXPOSURE_TIME_MAPPER[] =
+{
+    { "0/1", "" },
+    { "10/1", "10" },
+    { "10/10", "1" },
+    { "10/100", "1/10" },
+    { "10/1000", "1/100" },
+    { "10/10000", "1/1000" },
+    { "10/1050", "1/105" },
+    { "10/1250", "1/125" },
+    { "10/12500", "1/1250" },
+    { "10/1265", "1/127" },
+    { "10/160", "1/16" },
+    { "10/1600", "1/160" },
+    { "10/16000", "1/1600" },
+    { "10/200", "1/20" },
+    { "10/2000", "1/200" },
+    { "10/20000", "1/2000" },
+    { "10/250", "1/25" },
+    { "10/2500", "1/250" },
+    { "10/300", "1/30" },
+    { "10/320", "1/32" },
+    { "10/3200", "1/320" },
+    { "10/340", "1/34" },
+    { "10/3500", "1/350" },
+    { "10/376", "1/38" },
+    { "10/400", "1/40" },
+    { "10/4000", "1/400" },
+    { "10/450", "1/45" },
+    { "10/50", "1/5" },
+    { "10/500", "1/50" },
+    { "10/5000", "1/500" },
+    { "10/57", "1/6" },
+    { "10/60", "1/6" },
+    { "10/600", "1/60" },
+    { "10/601", "1/60" },
+    { "10/603", "1/60" },
+    { "10/6400", "1/640" },
+    { "10/70", "1/7" },
+    { "10/700", "1/70" },
+    { "10/750", "1/75" },
+    { "10/80", "1/8" },
+    { "10/800", "1/80" },
+    { "10/8000", "1/800" },
+    { "10/833", "1/83" },
+    { "100/599", "1/6" },
+    { "10000/1000000", "1/100" },
+    { "10000/3367003", "1/337" },
+    { "100000/1000000", "1/10" },
+    { "1008/1000000", "1/1000" },
+    { "10737417/4294967295", "1/400" },
+    { "11184811/67108864", "1/6" },
+    { "120/1", "120" },
+    { "1250/10000", "1/8" },
+    { "13/1", "13" },
+    { "13/10", "1.3" },
+    { "134217728/536870912", "1/4" },
+    { "15/1", "15" },
+    { "15625/1000000", "1/64" },
+    { "16/10", "1.6" },
+    { "1666/100000", "1/60" },
+    { "16666667/1000000000", "1/60" },
+    { "1666667/100000000", "1/60" },
+    { "16667/1000000", "1/60" },
+    { "17179869/4294967295", "1/250" },
+    { "196/10000", "1/50" },
+    { "2/1", "2" },
+    { "2/39", "1/20" },
+    { "20/1", "20" },
+    { "20/10", "2" },
+    { "20000/1000000", "1/50" },
+    { "20001/1000000", "1/50" },
+    { "20166/1000000", "1/50" },
+    { "20339/1000000", "1/50" },
+    { "2499/100000", "1/40" },
+    { "25/10", "2.5" },
+    { "25000/1000000", "1/40" },
+    { "285/10000", "1/35" },
+    { "29000/1000000", "1/34" },
+    { "29997000/1000000000", "1/33" },
+    { "3/10", "0.3" },
+    { "30/1", "30" },
+    { "3125/1000000", "1/300" },
+    { "32/10", "3.2" },
+    { "32062/1000000", "1/31" },
+    { "3261/100000", "1/31" },
+    { "33000/1000000", "1/30" },
+    { "33333/1000000", "1/30" },
+    { "3435973/4294967295", "1/1250" },
+    { "36/100000", "1/2700" },
+    { "360/9450", "1/26" },
+    { "38/10", "3.8" },
+    { "39926/1000000", "1/25" },
+    { "4/10", "0.4" },
+    { "400/10000", "1/25" },
+    { "4000/1000000", "1/250" },
+    { "40000/1000000", "1/25" },
+    { "40004000/1000000000", "1/25" },
+    { "403/10", "40" },
+    { "416/10000", "1/24" },
+    { "5/1", "5" },
+    { "5/10", "0.5" },
+    { "5/2", "2.5" },
+    { "5/300", "1/60" },
+    { "5000/1000000", "1/200" },
+    { "5825/1000000", "1/172" },
+    { "6/1", "6" },
+    { "6/10", "0.6" },
+    { "63151/1000000", "1/16" },
+    { "639132/19173959", "1/30" },
+    { "6604300/1000000000", "1/151" },
+    { "69951/1000000", "1/14" },
+    { "7845866/1000000000", "1/127" },
+    { "8/10", "0.8" },
+    { "8000/1000000", "1/125" },
+    { "8315366/1000000000", "1/120" },
+    { "833/100000", "1/120" },
+    { "8333333/1000000000", "1/120" },
+    { "8335/1000000", "1/120" },
+    { "8400/1000000", "1/120" },
+    { "84857/1000000", "1/12" },
+    { "866/100000", "1/115" },
+    { "89/1", "89" },
+    { "8904/1000000", "1/110" },
+    { "8947849/536870912", "1/60" },
+    { "90000/1000000", "1/11" },
+    { "9995/1000000", "1/100" },
+    { "9997/1000000", "1/100" },
+};
+static_assert(IsSorted(EXPOSURE_TIME_MAPPER),
+    "EXPOSURE_TIME_MAPPER must be sorted");
 
 
 
 ///////////////////////////////////////////////////////////////////////////////
-// Focal length mapper
-void ExifInfo::Init_FocalLengthMapper()
+// Look up a value in a mapper
+bool ExifInfo::LookUpMapper(const Mapper mcMapper, const QString & mcrValue,
+    QString & mrMappedValue)
 {
-    CALL_IN("");
+    CALL_IN(QString("mcMapper=%1, mcrValue=%2, mrMappedValue=%3")
+        .arg(CALL_SHOW(int(mcMapper)),
+             CALL_SHOW(mcrValue),
+             CALL_SHOW(mrMappedValue)));
+
+    // Mappers are sorted by their UTF-8 keys
+    const QByteArray value = mcrValue.toUtf8();
+    const std::string_view key(value.constData(), std::size_t(value.size()));
+    const MapperEntry * entry = nullptr;
+    switch (mcMapper)
+    {
+    case MapperCameraMaker:
+        entry = FindInMapper(CAMERA_MAKER_MAPPER, key);
+        break;
+
+    case MapperCameraModel:
+        entry = FindInMapper(CAMERA_MODEL_MAPPER, key);
+        break;
+
+    case MapperLensMaker:
+        entry = FindInMapper(LENS_MAKER_MAPPER, key);
+        break;
+
+    case MapperLensModel:
+        entry = FindInMapper(LENS_MODEL_MAPPER, key);
+        break;
+
+    case MapperFStop:
+        entry = FindInMapper(F_STOP_MAPPER, key);
+        break;
 
-    m_FocalLengthMapper["0/1"] = "";
-
-
-    for (int counter = 3;
-         counter < 500;
-         counter++)
-    {
-        const QString key = QString::number(counter) + "/1";
-        m_FocalLengthMapper[key] = QString::number(counter);
-    }
-    m_FocalLengthMapper["500/1"] = "500";
-    m_FocalLengthMapper["550/1"] = "550";
-    m_FocalLengthMapper["560/1"] = "560";
-    m_FocalLengthMapper["600/1"] = "600";
-    m_FocalLengthMapper["840/1"] = "840";
-
-    m_FocalLengthMapper["11/2"] = "5.5";
-    m_FocalLengthMapper["15/2"] = "7.5";
-    m_FocalLengthMapper["17/2"] = "8.5";
-
-    m_FocalLengthMapper["17/4"] = "4.3";
-
-    m_FocalLengthMapper["21/5"] = "4.2";
-    m_FocalLengthMapper["24/5"] = "4.8";
-    m_FocalLengthMapper["29/5"] = "5.8";
-    m_FocalLengthMapper["33/5"] = "6.6";
-    m_FocalLengthMapper["67/5"] = "13.4";
-
-    for (int counter = 3;
-         counter < 500;
-         counter++)
-    {
-        const QString key = QString::number(counter) + "/10";
-        m_FocalLengthMapper[key] = QString::number(counter * .1);
-    }
-    m_FocalLengthMapper["500/10"] = "50";
-    m_FocalLengthMapper["550/10"] = "55";
-    m_FocalLengthMapper["559/10"] = "55.9";
-    m_FocalLengthMapper["570/10"] = "5.7";
-    m_FocalLengthMapper["600/10"] = "60";
-    m_FocalLengthMapper["608/10"] = "61";
-    m_FocalLengthMapper["630/10"] = "63";
-    m_FocalLengthMapper["684/10"] = "68.4";
-    m_FocalLengthMapper["693/10"] = "69.3";
-    m_FocalLengthMapper["700/10"] = "70";
-    m_FocalLengthMapper["736/10"] = "73.6";
-    m_FocalLengthMapper["850/10"] = "85";
-    m_FocalLengthMapper["870/10"] = "87";
-    m_FocalLengthMapper["1000/10"] = "100";
-    m_FocalLengthMapper["1040/10"] = "104";
-    m_FocalLengthMapper["1050/10"] = "105";
-    m_FocalLengthMapper["1100/10"] = "110";
-    m_FocalLengthMapper["1400/10"] = "140";
-    m_FocalLengthMapper["1500/10"] = "150";
-    m_FocalLengthMapper["1580/10"] = "158";
-    m_FocalLengthMapper["1600/10"] = "160";
-    m_FocalLengthMapper["1650/10"] = "165";
-    m_FocalLengthMapper["1750/10"] = "175";
-    m_FocalLengthMapper["1800/10"] = "180";
-    m_FocalLengthMapper["1850/10"] = "185";
-    m_FocalLengthMapper["2000/10"] = "200";
-    m_FocalLengthMapper["2100/10"] = "210";
-    m_FocalLengthMapper["2200/10"] = "220";
-    m_FocalLengthMapper["2300/10"] = "230";
-    m_FocalLengthMapper["2400/10"] = "240";
-    m_FocalLengthMapper["2800/10"] = "280";
-    m_FocalLengthMapper["2900/10"] = "290";
-    m_FocalLengthMapper["3000/10"] = "300";
-    m_FocalLengthMapper["3100/10"] = "310";
-    m_FocalLengthMapper["3300/10"] = "330";
-    m_FocalLengthMapper["3400/10"] = "340";
-    m_FocalLengthMapper["3600/10"] = "360";
-    m_FocalLengthMapper["4000/10"] = "400";
-    m_FocalLengthMapper["4600/10"] = "460";
-    m_FocalLengthMapper["4900/10"] = "490";
-    m_FocalLengthMapper["5000/10"] = "500";
-    m_FocalLengthMapper["5500/10"] = "550";
-    m_FocalLengthMapper["5600/10"] = "560";
-    m_FocalLengthMapper["6000/10"] = "600";
-    m_FocalLengthMapper["8500/10"] = "850";
-
-    m_FocalLengthMapper["125/16"] = "7.8";
-
-    m_FocalLengthMapper["31/20"] = "1.6";
-    m_FocalLengthMapper["53/20"] = "2.7";
-    m_FocalLengthMapper["77/20"] = "3.9";
-    m_FocalLengthMapper["83/20"] = "4.2";
-    m_FocalLengthMapper["2259/20"] = "113";
-
-    m_FocalLengthMapper["103/25"] = "4.1";
-    m_FocalLengthMapper["107/25"] = "4.3";
-    m_FocalLengthMapper["149/25"] = "6.0";
-
-    m_FocalLengthMapper["173/32"] = "5.4";
-    m_FocalLengthMapper["186/32"] = "5.8";
-    m_FocalLengthMapper["189/32"] = "5.9";
-    m_FocalLengthMapper["224/32"] = "7";
-    m_FocalLengthMapper["227/32"] = "7.1";
-    m_FocalLengthMapper["250/32"] = "7.8";
-    m_FocalLengthMapper["301/32"] = "9.4";
-    m_FocalLengthMapper["314/32"] = "9.8";
-    m_FocalLengthMapper["342/32"] = "10.7";
-    m_FocalLengthMapper["362/32"] = "11.3";
-    m_FocalLengthMapper["400/32"] = "12.5";
-    m_FocalLengthMapper["461/32"] = "14.4";
-    m_FocalLengthMapper["682/32"] = "21.3";
-
-    m_FocalLengthMapper["0/100"] = "";
-    m_FocalLengthMapper["220/100"] = "2.2";
-    m_FocalLengthMapper["271/100"] = "2.7";
-    m_FocalLengthMapper["279/100"] = "2.8";
-    m_FocalLengthMapper["290/100"] = "2.9";
-    m_FocalLengthMapper["331/100"] = "3.3";
-    m_FocalLengthMapper["350/100"] = "3.5";
-    m_FocalLengthMapper["354/100"] = "3.5";
-    m_FocalLengthMapper["360/100"] = "3.6";
-    m_FocalLengthMapper["369/100"] = "3.7";
-    m_FocalLengthMapper["370/100"] = "3.7";
-    m_FocalLengthMapper["382/100"] = "3.8";
-    m_FocalLengthMapper["399/100"] = "4";
-    m_FocalLengthMapper["403/100"] = "4";
-    m_FocalLengthMapper["405/100"] = "4.1";
-    m_FocalLengthMapper["410/100"] = "4.1";
-    m_FocalLengthMapper["413/100"] = "4.1";
-    m_FocalLengthMapper["420/100"] = "4.2";
-    m_FocalLengthMapper["425/100"] = "4.3";
-    m_FocalLengthMapper["430/100"] = "4.3";
-    m_FocalLengthMapper["431/100"] = "4.3";
-    m_FocalLengthMapper["442/100"] = "4.4";
-    m_FocalLengthMapper["460/100"] = "4.6";
-    m_FocalLengthMapper["467/100"] = "4.7";
-    m_FocalLengthMapper["480/100"] = "4.8";
-    m_FocalLengthMapper["490/100"] = "4.9";
-    m_FocalLengthMapper["500/100"] = "5";
-    m_FocalLengthMapper["514/100"] = "5.1";
-    m_FocalLengthMapper["523/100"] = "5.2";
-    m_FocalLengthMapper["535/100"] = "5.4";
-    m_FocalLengthMapper["540/100"] = "5.4";
-    m_FocalLengthMapper["543/100"] = "5.4";
-    m_FocalLengthMapper["570/100"] = "5.7";
-    m_FocalLengthMapper["580/100"] = "5.8";
-    m_FocalLengthMapper["585/100"] = "5.9";
-    m_FocalLengthMapper["587/100"] = "5.9";
-    m_FocalLengthMapper["590/100"] = "5.9";
-    m_FocalLengthMapper["591/100"] = "5.9";
-    m_FocalLengthMapper["600/100"] = "6";
-    m_FocalLengthMapper["610/100"] = "6.1";
-    m_FocalLengthMapper["620/100"] = "6.2";
-    m_FocalLengthMapper["630/100"] = "6.3";
-    m_FocalLengthMapper["633/100"] = "6.3";
-    m_FocalLengthMapper["640/100"] = "6.4";
-    m_FocalLengthMapper["650/100"] = "6.5";
-    m_FocalLengthMapper["660/100"] = "6.6";
-    m_FocalLengthMapper["663/100"] = "6.6";
-    m_FocalLengthMapper["670/100"] = "6.7";
-    m_FocalLengthMapper["750/100"] = "7.5";
-    m_FocalLengthMapper["780/100"] = "7.8";
-    m_FocalLengthMapper["790/100"] = "7.9";
-    m_FocalLengthMapper["800/100"] = "8";
-    m_FocalLengthMapper["820/100"] = "8.2";
-    m_FocalLengthMapper["840/100"] = "8.4";
-    m_FocalLengthMapper["882/100"] = "8.8";
-    m_FocalLengthMapper["1100/100"] = "11";
-    m_FocalLengthMapper["1270/100"] = "12.7";
-    m_FocalLengthMapper["1510/100"] = "15.1";
-    m_FocalLengthMapper["1700/100"] = "17";
-    m_FocalLengthMapper["1712/100"] = "17.1";
-    m_FocalLengthMapper["1820/100"] = "18.2";
-    m_FocalLengthMapper["1860/100"] = "18.6";
-    m_FocalLengthMapper["2300/100"] = "23";
-    m_FocalLengthMapper["2510/100"] = "25.1";
-    m_FocalLengthMapper["3400/100"] = "34";
-    m_FocalLengthMapper["3500/100"] = "35";
-    m_FocalLengthMapper["4500/100"] = "45";
-    m_FocalLengthMapper["4750/100"] = "47.5";
-    m_FocalLengthMapper["5000/100"] = "50";
-    m_FocalLengthMapper["5300/100"] = "53";
-    m_FocalLengthMapper["5500/100"] = "55";
-    m_FocalLengthMapper["5600/100"] = "56";
-    m_FocalLengthMapper["6330/100"] = "63.3";
-    m_FocalLengthMapper["15000/100"] = "150";
-
-    m_FocalLengthMapper["755/128"] = "5.9";
-
-    m_FocalLengthMapper["3971/256"] = "15.5";
-
-    m_FocalLengthMapper["2940/1000"] = "2.9";
-    m_FocalLengthMapper["3097/1000"] = "3.1";
-    m_FocalLengthMapper["3170/1000"] = "3.2";
-    m_FocalLengthMapper["3200/1000"] = "3.2";
-    m_FocalLengthMapper["3620/1000"] = "3.6";
-    m_FocalLengthMapper["3820/1000"] = "3.8";
-    m_FocalLengthMapper["3830/1000"] = "3.8";
-    m_FocalLengthMapper["4000/1000"] = "4";
-    m_FocalLengthMapper["4090/1000"] = "4.1";
-    m_FocalLengthMapper["4300/1000"] = "4.3";
-    m_FocalLengthMapper["4442/1000"] = "4.4";
-    m_FocalLengthMapper["4499/1000"] = "4.5";
-    m_FocalLengthMapper["4500/1000"] = "4.5";
-    m_FocalLengthMapper["4530/1000"] = "4.5";
-    m_FocalLengthMapper["4600/1000"] = "4.6";
-    m_FocalLengthMapper["4710/1000"] = "4.7";
-    m_FocalLengthMapper["4740/1000"] = "4.7";
-    m_FocalLengthMapper["5000/1000"] = "5";
-    m_FocalLengthMapper["5400/1000"] = "5.4";
-    m_FocalLengthMapper["5583/1000"] = "5.6";
-    m_FocalLengthMapper["5700/1000"] = "5.7";
-    m_FocalLengthMapper["5800/1000"] = "5.8";
-    m_FocalLengthMapper["5854/1000"] = "5.9";
-    m_FocalLengthMapper["5900/1000"] = "5.9";
-    m_FocalLengthMapper["5989/1000"] = "6";
-    m_FocalLengthMapper["6000/1000"] = "6";
-    m_FocalLengthMapper["6100/1000"] = "6.1";
-    m_FocalLengthMapper["6190/1000"] = "6.2";
-    m_FocalLengthMapper["6200/1000"] = "6.2";
-    m_FocalLengthMapper["6300/1000"] = "6.3";
-    m_FocalLengthMapper["6447/1000"] = "6.4";
-    m_FocalLengthMapper["6600/1000"] = "6.6";
-    m_FocalLengthMapper["6769/1000"] = "6.8";
-    m_FocalLengthMapper["6810/1000"] = "6.8";
-    m_FocalLengthMapper["7300/1000"] = "7.3";
-    m_FocalLengthMapper["7400/1000"] = "7.4";
-    m_FocalLengthMapper["7700/1000"] = "7.7";
-    m_FocalLengthMapper["7947/1000"] = "7.9";
-    m_FocalLengthMapper["8205/1000"] = "8.2";
-    m_FocalLengthMapper["9954/1000"] = "10";
-    m_FocalLengthMapper["12074/1000"] = "12.1";
-    m_FocalLengthMapper["12669/1000"] = "12.7";
-    m_FocalLengthMapper["12845/1000"] = "12.8";
-    m_FocalLengthMapper["13300/1000"] = "13.3";
-    m_FocalLengthMapper["13600/1000"] = "13.6";
-    m_FocalLengthMapper["14783/1000"] = "14.8";
-    m_FocalLengthMapper["14900/1000"] = "14.9";
-    m_FocalLengthMapper["14926/1000"] = "14.9";
-    m_FocalLengthMapper["15673/1000"] = "15.7";
-    m_FocalLengthMapper["20000/1000"] = "20";
-    m_FocalLengthMapper["20100/1000"] = "20.1";
-    m_FocalLengthMapper["21556/1000"] = "21.6";
-    m_FocalLengthMapper["23280/1000"] = "23.3";
-    m_FocalLengthMapper["34900/1000"] = "34.9";
-    m_FocalLengthMapper["44400/1000"] = "44.4";
-    m_FocalLengthMapper["50000/1000"] = "50";
-    m_FocalLengthMapper["72000/1000"] = "72";
-
-    m_FocalLengthMapper["251773/37217"] = "6.7";
-
-    m_FocalLengthMapper["2497280/65536"] = "38.1";
-
-    m_FocalLengthMapper["469865/174671"] = "2.7";
-
-    m_FocalLengthMapper["3302983/524283"] = "6.3";
-
-    m_FocalLengthMapper["880803840/8388608"] = "105";
-
-    m_FocalLengthMapper["6300000/1000000"] = "6.3";
-    m_FocalLengthMapper["150000000/1000000"] = "150";
+    case MapperFocalLength:
+        entry = FindInMapper(FOCAL_LENGTH_MAPPER, key);
+        break;
 
+    case MapperExposureTime:
+        entry = FindInMapper(EXPOSURE_TIME_MAPPER, key);
+        break;
+    }
+    if (entry)
+    {
+        mrMappedValue = QString::fromUtf8(entry -> m_Value.data(),
+            qsizetype(entry -> m_Value.size()));
+        CALL_OUT("");
+        return true;
+    }
+
+    // Focal lengths of n/1 and n/10 (n from 3 to 499) are not listed
+    if (mcMapper == MapperFocalLength)
+    {
+        const qsizetype slash = mcrValue.indexOf('/');
+        bool counter_ok = false;
+        const int counter = mcrValue.left(slash).toInt(&counter_ok);
+        if (slash > 0 &&
+            counter_ok &&
+            counter >= 3 &&
+            counter < 500 &&
+            mcrValue.left(slash) == QString::number(counter))
+        {
+            const QStringView denominator =
+                QStringView(mcrValue).mid(slash + 1);
+            if (denominator == QLatin1String("1"))
+            {
+                mrMappedValue = QString::number(counter);
+                CALL_OUT("");
+                return true;
+            }
+            if (denominator == QLatin1String("10"))
+            {
+                mrMappedValue = QString::number(counter * .1);
+                CALL_OUT("");
+                return true;
+            }
+        }
+    }
+
+    // Not in mapper
     CALL_OUT("");
+    return false;
 }
 
 
 
 ///////////////////////////////////////////////////////////////////////////////
-// Exposure time mapper
-void ExifInfo::Init_ExposureTimeMapper()
+// Check if a value is in a mapper
+bool ExifInfo::IsInMapper(const Mapper mcMapper, const QString & mcrValue)
 {
-    CALL_IN("");
+    CALL_IN(QString("mcMapper=%1, mcrValue=%2")
+        .arg(CALL_SHOW(int(mcMapper)),
+             CALL_SHOW(mcrValue)));
+
+    QString mapped_value;
+    const bool is_in_mapper = LookUpMapper(mcMapper, mcrValue, mapped_value);
 
-    // For values from Photo.ExposureTime
-
-    m_ExposureTimeMapper["0/1"] = "";
-
-    // Note that exposure times of the format "1/n" are handled separately.
-
-    m_ExposureTimeMapper["2/1"] = "2";
-    m_ExposureTimeMapper["2/39"] = "1/20";
-    m_ExposureTimeMapper["3/10"] = "0.3";
-    m_ExposureTimeMapper["4/10"] = "0.4";
-    m_ExposureTimeMapper["5/1"] = "5";
-    m_ExposureTimeMapper["5/2"] = "2.5";
-    m_ExposureTimeMapper["5/10"] = "0.5";
-    m_ExposureTimeMapper["5/300"] = "1/60";
-    m_ExposureTimeMapper["6/1"] = "6";
-    m_ExposureTimeMapper["6/10"] = "0.6";
-    m_ExposureTimeMapper["8/10"] = "0.8";
-
-    m_ExposureTimeMapper["10/1"] = "10";
-    m_ExposureTimeMapper["10/10"] = "1";
-    m_ExposureTimeMapper["10/50"] = "1/5";
-    m_ExposureTimeMapper["10/57"] = "1/6";
-    m_ExposureTimeMapper["10/60"] = "1/6";
-    m_ExposureTimeMapper["10/70"] = "1/7";
-    m_ExposureTimeMapper["10/80"] = "1/8";
-    m_ExposureTimeMapper["10/100"] = "1/10";
-    m_ExposureTimeMapper["10/160"] = "1/16";
-    m_ExposureTimeMapper["10/200"] = "1/20";
-    m_ExposureTimeMapper["10/250"] = "1/25";
-    m_ExposureTimeMapper["10/300"] = "1/30";
-    m_ExposureTimeMapper["10/320"] = "1/32";
-    m_ExposureTimeMapper["10/340"] = "1/34";
-    m_ExposureTimeMapper["10/376"] = "1/38";
-    m_ExposureTimeMapper["10/400"] = "1/40";
-    m_ExposureTimeMapper["10/450"] = "1/45";
-    m_ExposureTimeMapper["10/500"] = "1/50";
-    m_ExposureTimeMapper["10/600"] = "1/60";
-    m_ExposureTimeMapper["10/601"] = "1/60";
-    m_ExposureTimeMapper["10/603"] = "1/60";
-    m_ExposureTimeMapper["10/700"] = "1/70";
-    m_ExposureTimeMapper["10/750"] = "1/75";
-    m_ExposureTimeMapper["10/800"] = "1/80";
-    m_ExposureTimeMapper["10/833"] = "1/83";
-    m_ExposureTimeMapper["10/1000"] = "1/100";
-    m_ExposureTimeMapper["10/1050"] = "1/105";
-    m_ExposureTimeMapper["10/1250"] = "1/125";
-    m_ExposureTimeMapper["10/1265"] = "1/127";
-    m_ExposureTimeMapper["10/1600"] = "1/160";
-    m_ExposureTimeMapper["10/2000"] = "1/200";
-    m_ExposureTimeMapper["10/2500"] = "1/250";
-    m_ExposureTimeMapper["10/3200"] = "1/320";
-    m_ExposureTimeMapper["10/3500"] = "1/350";
-    m_ExposureTimeMapper["10/4000"] = "1/400";
-    m_ExposureTimeMapper["10/5000"] = "1/500";
-    m_ExposureTimeMapper["10/6400"] = "1/640";
-    m_ExposureTimeMapper["10/8000"] = "1/800";
-    m_ExposureTimeMapper["10/10000"] = "1/1000";
-    m_ExposureTimeMapper["10/12500"] = "1/1250";
-    m_ExposureTimeMapper["10/16000"] = "1/1600";
-    m_ExposureTimeMapper["10/20000"] = "1/2000";
-
-    m_ExposureTimeMapper["13/1"] = "13";
-    m_ExposureTimeMapper["13/10"] = "1.3";
-    m_ExposureTimeMapper["15/1"] = "15";
-    m_ExposureTimeMapper["16/10"] = "1.6";
-    m_ExposureTimeMapper["20/1"] = "20";
-    m_ExposureTimeMapper["20/10"] = "2";
-    m_ExposureTimeMapper["25/10"] = "2.5";
-    m_ExposureTimeMapper["30/1"] = "30";
-    m_ExposureTimeMapper["32/10"] = "3.2";
-    m_ExposureTimeMapper["36/100000"] = "1/2700";
-    m_ExposureTimeMapper["38/10"] = "3.8";
-    m_ExposureTimeMapper["89/1"] = "89";
-
-    m_ExposureTimeMapper["100/599"] = "1/6";
-    m_ExposureTimeMapper["120/1"] = "120";
-    m_ExposureTimeMapper["196/10000"] = "1/50";
-    m_ExposureTimeMapper["285/10000"] = "1/35";
-    m_ExposureTimeMapper["360/9450"] = "1/26";
-    m_ExposureTimeMapper["400/10000"] = "1/25";
-    m_ExposureTimeMapper["403/10"] = "40";
-    m_ExposureTimeMapper["416/10000"] = "1/24";
-    m_ExposureTimeMapper["833/100000"] = "1/120";
-    m_ExposureTimeMapper["866/100000"] = "1/115";
-
-    m_ExposureTimeMapper["1008/1000000"] = "1/1000";
-    m_ExposureTimeMapper["1250/10000"] = "1/8";
-    m_ExposureTimeMapper["1666/100000"] = "1/60";
-    m_ExposureTimeMapper["2499/100000"] = "1/40";
-    m_ExposureTimeMapper["3125/1000000"] = "1/300";
-    m_ExposureTimeMapper["3261/100000"] = "1/31";
-    m_ExposureTimeMapper["4000/1000000"] = "1/250";
-    m_ExposureTimeMapper["5000/1000000"] = "1/200";
-    m_ExposureTimeMapper["5825/1000000"] = "1/172";
-    m_ExposureTimeMapper["8000/1000000"] = "1/125";
-    m_ExposureTimeMapper["8335/1000000"] = "1/120";
-    m_ExposureTimeMapper["8400/1000000"] = "1/120";
-    m_ExposureTimeMapper["8904/1000000"] = "1/110";
-    m_ExposureTimeMapper["9995/1000000"] = "1/100";
-    m_ExposureTimeMapper["9997/1000000"] = "1/100";
-
-    m_ExposureTimeMapper["10000/1000000"] = "1/100";
-    m_ExposureTimeMapper["10000/3367003"] = "1/337";
-    m_ExposureTimeMapper["15625/1000000"] = "1/64";
-    m_ExposureTimeMapper["16667/1000000"] = "1/60";
-    m_ExposureTimeMapper["20000/1000000"] = "1/50";
-    m_ExposureTimeMapper["20001/1000000"] = "1/50";
-    m_ExposureTimeMapper["20166/1000000"] = "1/50";
-    m_ExposureTimeMapper["20339/1000000"] = "1/50";
-    m_ExposureTimeMapper["25000/1000000"] = "1/40";
-    m_ExposureTimeMapper["29000/1000000"] = "1/34";
-    m_ExposureTimeMapper["32062/1000000"] = "1/31";
-    m_ExposureTimeMapper["33000/1000000"] = "1/30";
-    m_ExposureTimeMapper["33333/1000000"] = "1/30";
-    m_ExposureTimeMapper["39926/1000000"] = "1/25";
-    m_ExposureTimeMapper["40000/1000000"] = "1/25";
-    m_ExposureTimeMapper["63151/1000000"] = "1/16";
-    m_ExposureTimeMapper["69951/1000000"] = "1/14";
-    m_ExposureTimeMapper["84857/1000000"] = "1/12";
-    m_ExposureTimeMapper["90000/1000000"] = "1/11";
-
-    m_ExposureTimeMapper["100000/1000000"] = "1/10";
-
-    m_ExposureTimeMapper["1666667/100000000"] = "1/60";
-    m_ExposureTimeMapper["639132/19173959"] = "1/30";
-
-    m_ExposureTimeMapper["8947849/536870912"] = "1/60";
-
-    m_ExposureTimeMapper["16666667/1000000000"] = "1/60";
-    m_ExposureTimeMapper["134217728/536870912"] = "1/4";
-
-    m_ExposureTimeMapper["6604300/1000000000"] = "1/151";
-    m_ExposureTimeMapper["7845866/1000000000"] = "1/127";
-    m_ExposureTimeMapper["8315366/1000000000"] = "1/120";
-    m_ExposureTimeMapper["8333333/1000000000"] = "1/120";
-    m_ExposureTimeMapper["29997000/1000000000"] = "1/33";
-    m_ExposureTimeMapper["40004000/1000000000"] = "1/25";
-
-    m_ExposureTimeMapper["3435973/4294967295"] = "1/1250";
-    m_ExposureTimeMapper["10737417/4294967295"] = "1/400";
-    m_ExposureTimeMapper["11184811/67108864"] = "1/6";
-    m_ExposureTimeMapper["17179869/4294967295"] = "1/250";
-
-    CALL_OUT("");
-}
-
-
-
-///////////////////////////////////////////////////////////////////////////////
-// Mappers
-QHash < QString, QString > ExifInfo::m_CameraMakerMapper =
-    QHash < QString, QString >();
-QHash < QString, QString > ExifInfo::m_CameraModelMapper =
-    QHash < QString, QString >();
-QHash < QString, QString > ExifInfo::m_LensMakerMapper =
-    QHash < QString, QString >();
-QHash < QString, QString > ExifInfo::m_LensModelMapper =
-    QHash < QString, QString >();
-QHash < QString, QString > ExifInfo::m_FStopMapper =
-    QHash < QString, QString >();
-QHash < QString, QString > ExifInfo::m_FocalLengthMapper =
-    QHash < QString, QString >();
-QHash < QString, QString > ExifInfo::m_ExposureTimeMapper =
-    QHash < QString, QString >();
+    CALL_OUT("");
+    return is_in_mapper;
+}
 
 
 
@@ -3438,6 +4228,8 @@ void ExifInfo::Dump() const
 {
     CALL_IN("");
 
+    LoadTags();
+
     qDebug().noquote() << "==== Exif Info";
 
     // Determine field widths
@@ -3495,12 +4287,155 @@ void ExifInfo::Dump() const
 
 
 
+///////////////////////////////////////////////////////////////////////////////
+// Names of mappers (for dumping new values), in the order of Mapper
+static constexpr std::string_view MAPPER_NAMES[] =
+{
+    "CameraMaker",
+    "CameraModel",
+    "LensMaker",
+    "LensModel",
+    "FStop",
+    "FocalLength",
+    "ExposureTime"
+};
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// Statistics of one thread
+struct ExifInfo::ThreadStatistics
+{
+    // Constructor
+    ThreadStatistics()
+    {
+        QMutexLocker lock(&m_StatisticsMutex);
+        m_StatisticsThreads << this;
+    }
+
+    // Destructor
+    ~ThreadStatistics()
+    {
+        QMutexLocker lock(&m_StatisticsMutex);
+        m_StatisticsThreads.removeAll(this);
+
+        // Keep statistics of this thread
+        for (auto tag_iterator = m_TagUsage.constBegin();
+             tag_iterator != m_TagUsage.constEnd();
+             tag_iterator++)
+        {
+            ExifInfo::m_TagUsage[tag_iterator.key()]
+                .insert(tag_iterator.value());
+        }
+        for (auto mapper_iterator = m_NewMapperValues.constBegin();
+             mapper_iterator != m_NewMapperValues.constEnd();
+             mapper_iterator++)
+        {
+            ExifInfo::m_NewMapperValues[mapper_iterator.key()] +=
+                mapper_iterator.value();
+        }
+    }
+
+    // Tag IDs already looked up by this thread (no locking needed)
+    QHash < QString, int > m_TagIds;
+
+    // Held by this thread while writing, and by others while collecting
+    QMutex m_Mutex;
+
+    // Tag ID to filename and value
+    QHash < int, QHash < QString, QString > > m_TagUsage;
+
+    // Mapper to values not found in it
+    QHash < int, QSet < QString > > m_NewMapperValues;
+};
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// Statistics of the current thread
+ExifInfo::ThreadStatistics & ExifInfo::CurrentThreadStatistics()
+{
+    thread_local ThreadStatistics thread_statistics;
+    return thread_statistics;
+}
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// Collect statistics on tags and unknown mapper values
+void ExifInfo::SetCollectStatistics(const bool mcCollectStatistics)
+{
+    CALL_IN(QString("mcCollectStatistics=%1")
+        .arg(CALL_SHOW(mcCollectStatistics)));
+
+    m_CollectStatistics = mcCollectStatistics;
+
+    CALL_OUT("");
+}
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// Check if statistics are being collected
+bool ExifInfo::IsCollectingStatistics()
+{
+    CALL_IN("");
+
+    CALL_OUT("");
+    return m_CollectStatistics.load(std::memory_order_relaxed);
+}
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// ID of a tag
+int ExifInfo::GetTagId(const QString & mcrTag)
+{
+    CALL_IN(QString("mcrTag=%1")
+        .arg(CALL_SHOW(mcrTag)));
+
+    // Known in this thread
+    ThreadStatistics & statistics = CurrentThreadStatistics();
+    const auto known_iterator = statistics.m_TagIds.constFind(mcrTag);
+    if (known_iterator != statistics.m_TagIds.constEnd())
+    {
+        CALL_OUT("");
+        return known_iterator.value();
+    }
+
+    // Look up (or assign) the shared ID
+    int tag_id = -1;
+    {
+        QMutexLocker lock(&m_StatisticsMutex);
+        if (m_TagIds.contains(mcrTag))
+        {
+            tag_id = m_TagIds[mcrTag];
+        } else
+        {
+            tag_id = m_TagNames.size();
+            m_TagIds[mcrTag] = tag_id;
+            m_TagNames << mcrTag;
+        }
+    }
+    statistics.m_TagIds[mcrTag] = tag_id;
+
+    CALL_OUT("");
+    return tag_id;
+}
+
+
+
 ///////////////////////////////////////////////////////////////////////////////
 // Compile data
 void ExifInfo::RegisterData()
 {
     CALL_IN("");
 
+    LoadTags();
+
+    // Collect first, so the statistics of this thread are locked only briefly
+    QList < QPair < int, QString > > tag_values;
+    QHash < int, QSet < QString > > new_mapper_values;
     for (auto group_iterator = m_ExifData.keyBegin();
          group_iterator != m_ExifData.keyEnd();
          group_iterator++)
@@ -3513,65 +4448,133 @@ void ExifInfo::RegisterData()
             const QString tag = *tag_iterator;
             const QString key = group + "." + tag;
             const QString value = m_ExifData[group][tag].trimmed();
-            m_TagUsage[key][m_Filename] = value;
+            tag_values << qMakePair(GetTagId(key), value);
 
             if (key == "Image.Make")
             {
-                if(!m_CameraMakerMapper.contains(value))
+                if(!IsInMapper(MapperCameraMaker, value))
                 {
-                    m_NewMapperValues["CameraMaker"] += value;
+                    new_mapper_values[MapperCameraMaker] += value;
                 }
             }
             if (key == "Image.Model")
             {
                 const QString model = GetCameraMaker() + "." + value;
-                if(!m_CameraModelMapper.contains(model))
+                if(!IsInMapper(MapperCameraModel, model))
                 {
-                    m_NewMapperValues["CameraModel"] += model;
+                    new_mapper_values[MapperCameraModel] += model;
                 }
             }
             if (key == "Photo.LensMake")
             {
-                if(!m_LensMakerMapper.contains(value))
+                if(!IsInMapper(MapperLensMaker, value))
                 {
-                    m_NewMapperValues["LensMaker"] += value;
+                    new_mapper_values[MapperLensMaker] += value;
                 }
             }
             if (key == "Photo.LensModel")
             {
                 const QString model = GetLensMaker() + "." + value;
-                if(!m_LensModelMapper.contains(model))
+                if(!IsInMapper(MapperLensModel, model))
                 {
-                    m_NewMapperValues["LensModel"] += model;
+                    new_mapper_values[MapperLensModel] += model;
                 }
             }
             if (key == "Photo.FNumber")
             {
-                if (!m_FStopMapper.contains(value))
+                if (!IsInMapper(MapperFStop, value))
                 {
-                    m_NewMapperValues["FStop"] += value;
+                    new_mapper_values[MapperFStop] += value;
                 }
             }
             if (key == "Photo.FocalLength")
             {
-                if (!m_FocalLengthMapper.contains(value))
+                if (!IsInMapper(MapperFocalLength, value))
                 {
-                    m_NewMapperValues["FocalLength"] += value;
+                    new_mapper_values[MapperFocalLength] += value;
                 }
             }
             if (key == "Photo.ExposureTime")
             {
                 // Exposure times of the format "1/n" are handled separately
                 if (!value.startsWith("1/") &&
-                    !m_ExposureTimeMapper.contains(value))
+                    !IsInMapper(MapperExposureTime, value))
                 {
-                    m_NewMapperValues["ExposureTime"] += value;
+                    new_mapper_values[MapperExposureTime] += value;
                 }
             }
 
         }
     }
 
+    // Only contended while statistics are being dumped
+    ThreadStatistics & statistics = CurrentThreadStatistics();
+    QMutexLocker lock(&statistics.m_Mutex);
+    for (const QPair < int, QString > & tag_value : tag_values)
+    {
+        statistics.m_TagUsage[tag_value.first][m_Filename] =
+            tag_value.second;
+    }
+    for (auto mapper_iterator = new_mapper_values.constBegin();
+         mapper_iterator != new_mapper_values.constEnd();
+         mapper_iterator++)
+    {
+        statistics.m_NewMapperValues[mapper_iterator.key()] +=
+            mapper_iterator.value();
+    }
+
+    CALL_OUT("");
+}
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// Statistics of all threads combined
+void ExifInfo::CollectStatistics(
+    QHash < int, QHash < QString, QString > > * mpTagUsage,
+    QHash < int, QSet < QString > > * mpNewMapperValues)
+{
+    CALL_IN(QString("mpTagUsage=%1, mpNewMapperValues=%2")
+        .arg(CALL_SHOW(mpTagUsage),
+             CALL_SHOW(mpNewMapperValues)));
+
+    // Finished threads
+    if (mpTagUsage)
+    {
+        *mpTagUsage = m_TagUsage;
+    }
+    if (mpNewMapperValues)
+    {
+        *mpNewMapperValues = m_NewMapperValues;
+    }
+
+    // Running threads
+    for (ThreadStatistics * statistics : m_StatisticsThreads)
+    {
+        QMutexLocker lock(&statistics -> m_Mutex);
+        if (mpTagUsage)
+        {
+            for (auto tag_iterator = statistics -> m_TagUsage.constBegin();
+                 tag_iterator != statistics -> m_TagUsage.constEnd();
+                 tag_iterator++)
+            {
+                (*mpTagUsage)[tag_iterator.key()]
+                    .insert(tag_iterator.value());
+            }
+        }
+        if (mpNewMapperValues)
+        {
+            for (auto mapper_iterator =
+                     statistics -> m_NewMapperValues.constBegin();
+                 mapper_iterator !=
+                     statistics -> m_NewMapperValues.constEnd();
+                 mapper_iterator++)
+            {
+                (*mpNewMapperValues)[mapper_iterator.key()] +=
+                    mapper_iterator.value();
+            }
+        }
+    }
 
     CALL_OUT("");
 }
@@ -3579,8 +4582,13 @@ void ExifInfo::RegisterData()
 
 
 ///////////////////////////////////////////////////////////////////////////////
-QHash < QString, QHash < QString, QString > > ExifInfo::m_TagUsage;
-QHash < QString, QSet < QString > > ExifInfo::m_NewMapperValues;
+std::atomic < bool > ExifInfo::m_CollectStatistics(false);
+QHash < QString, int > ExifInfo::m_TagIds;
+QStringList ExifInfo::m_TagNames;
+QList < ExifInfo::ThreadStatistics * > ExifInfo::m_StatisticsThreads;
+QHash < int, QHash < QString, QString > > ExifInfo::m_TagUsage;
+QHash < int, QSet < QString > > ExifInfo::m_NewMapperValues;
+QMutex ExifInfo::m_StatisticsMutex;
 
 
 
@@ -3590,11 +4598,28 @@ void ExifInfo::Dump_CompliedStatistics()
 {
     CALL_IN("");
 
-     qDebug().noquote() << "==== Aggregate Exif Tags";
+    // Combine statistics of all threads
+    QHash < int, QHash < QString, QString > > tag_usage;
+    QHash < QString, int > tag_ids;
+    QStringList tag_names;
+    {
+        QMutexLocker lock(&m_StatisticsMutex);
+        CollectStatistics(&tag_usage, nullptr);
+        tag_ids = m_TagIds;
+        tag_names = m_TagNames;
+    }
+
+    qDebug().noquote() << "==== Aggregate Exif Tags";
 
     // Determine field widths
     int width_key = 0;
-    QStringList sorted_keys(m_TagUsage.keyBegin(), m_TagUsage.keyEnd());
+    QStringList sorted_keys;
+    for (auto tag_iterator = tag_usage.keyBegin();
+         tag_iterator != tag_usage.keyEnd();
+         tag_iterator++)
+    {
+        sorted_keys << tag_names[*tag_iterator];
+    }
     std::sort(sorted_keys.begin(), sorted_keys.end());
     for (auto key_iterator = sorted_keys.begin();
          key_iterator != sorted_keys.end();
@@ -3610,15 +4635,16 @@ void ExifInfo::Dump_CompliedStatistics()
          key_iterator++)
     {
         const QString key = *key_iterator;
+        const QHash < QString, QString > & usage = tag_usage[tag_ids[key]];
         qDebug().noquote()
             << key + QString(" ").repeated(width_key + 1 - key.size())
-            << m_TagUsage[key].size();
-        for (auto file_iterator = m_TagUsage[key].keyBegin();
-             file_iterator != m_TagUsage[key].keyEnd();
+            << usage.size();
+        for (auto file_iterator = usage.keyBegin();
+             file_iterator != usage.keyEnd();
              file_iterator++)
         {
             const QString file = *file_iterator;
-            const QString value = m_TagUsage[key][file];
+            const QString value = usage[file];
             qDebug().noquote() << "\t\t" << file << "\t\t" << value;
         }
     }
@@ -3634,7 +4660,14 @@ void ExifInfo::Dump_NewMapperValues()
 {
     CALL_IN("");
 
-    if (m_NewMapperValues.isEmpty())
+    // Combine statistics of all threads (mapper values only)
+    QHash < int, QSet < QString > > new_mapper_values;
+    {
+        QMutexLocker lock(&m_StatisticsMutex);
+        CollectStatistics(nullptr, &new_mapper_values);
+    }
+
+    if (new_mapper_values.isEmpty())
     {
         // Nothing to do
         CALL_OUT("");
@@ -3642,14 +4675,15 @@ void ExifInfo::Dump_NewMapperValues()
     }
 
     qDebug().noquote() << "==== New mapper values";
-    for (auto mapper_iterator = m_NewMapperValues.keyBegin();
-         mapper_iterator != m_NewMapperValues.keyEnd();
-         mapper_iterator++)
+    QList < int > mappers(new_mapper_values.keyBegin(),
+        new_mapper_values.keyEnd());
+    std::sort(mappers.begin(), mappers.end());
+    for (const int mapper : mappers)
     {
-        const QString mapper = *mapper_iterator;
-        qDebug().noquote() << mapper;
-        QStringList values(m_NewMapperValues[mapper].begin(),
-            m_NewMapperValues[mapper].end());
+        qDebug().noquote() << QString::fromLatin1(MAPPER_NAMES[mapper].data(),
+            qsizetype(MAPPER_NAMES[mapper].size()));
+        QStringList values(new_mapper_values[mapper].begin(),
+            new_mapper_values[mapper].end());
         std::sort(values.begin(), values.end());
         qDebug().noquote() << QString("\t%1\n").arg(values.join("\n\t"));
     }
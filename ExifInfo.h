@@ -5,12 +5,26 @@
 #ifndef EXIFINFO_H
 #define EXIFINFO_H
 
+// Project includes
+#include "FileCache.h"
+
 // Qt includes
+#include <QDateTime>
 #include <QHash>
 #include <QList>
+#include <QMutex>
 #include <QObject>
 #include <QPixmap>
+#include <QSet>
 #include <QString>
+#include <QStringList>
+#include <QtNumeric>
+
+// System includes
+#include <atomic>
+
+// Forward declarations
+class QDataStream;
 
 
 
@@ -33,18 +47,50 @@ public:
     virtual ~ExifInfo();
 
     // Factory
-    static ExifInfo * CreateExifInfo(const QString & mcrFilename);
+    // Standard EXIF tags of JPEG and TIFF based files (which includes most
+    // raw formats) are read directly from the file; everything else goes
+    // through Exiv2. Maker note groups (CanonCs, CanonSi, Nikon3, ...) are
+    // only available from Exiv2; files of cameras whose maker notes are
+    // used by the getters (Canon, Nikon) are always read with Exiv2. Set
+    // mcIncludeMakerNotes to get the maker notes of other cameras, too.
+    static ExifInfo * CreateExifInfo(const QString & mcrFilename,
+        const bool mcIncludeMakerNotes = false);
 
 private:
     // File name
     QString m_Filename;
 
-    // Exif data
+    // Exif data (filled in by LoadTags() for EXIF info from the cache)
     QHash < QString, QHash < QString, QString > > m_ExifTypes;
     QHash < QString, QHash < QString, QString > > m_ExifData;
 
 
 
+    // ========================================================== Native Reader
+private:
+    // TIFF structure being read
+    struct TIFFData;
+
+    // Read standard EXIF tags without Exiv2
+    bool ReadNativeExif();
+
+    // Check if getters need maker notes, which only Exiv2 reads
+    bool NeedsMakerNotes() const;
+
+    // Read tags of one IFD
+    bool ReadNativeIFD(const TIFFData & mcrTIFF, const quint32 mcOffset,
+        const QString & mcrGroup);
+
+    // Tag value, formatted like Exiv2 does
+    static QString FormatNativeValue(const TIFFData & mcrTIFF,
+        const quint16 mcType, const quint32 mcCount, const quint32 mcOffset);
+
+    // Tag name, as used by Exiv2
+    static QString GetNativeTagName(const QString & mcrGroup,
+        const quint16 mcTag);
+
+
+
     // ======================================================= EXIF Data Access
 public:
     // Get MIME type
@@ -173,32 +219,193 @@ public:
     // ======= Temperature
     double GetCameraTemperature() const;
 
+
+
+    // =========================================================== Typed Values
+public:
+    // Rational value as stored in the file (zero denominator if unknown)
+    struct Rational
+    {
+        qint64 m_Numerator = 0;
+        qint64 m_Denominator = 0;
+
+        // Usable value?
+        bool IsValid() const
+        {
+            return m_Denominator != 0;
+        }
+
+        // Value as double (NaN if not valid)
+        double ToDouble() const
+        {
+            return IsValid() ? double(m_Numerator) / m_Denominator : qQNaN();
+        }
+    };
+
+    // Flash
+    enum FlashMode
+    {
+        FlashUnknown,
+        FlashNotFired,
+        FlashFired
+    };
+
+    // Frequently used values, decoded once when the file is read
+    struct Record
+    {
+        // Exposure date & time (invalid if unknown)
+        QDateTime m_ExposureDateTime;
+
+        // Exposure
+        Rational m_FocalLength;
+        Rational m_FStop;
+        Rational m_ExposureTime;
+        Rational m_ExposureBias;
+
+        // ISO rating (0 if unknown)
+        qint32 m_ISORating = 0;
+
+        // Flash
+        FlashMode m_Flash = FlashUnknown;
+
+        // Orientation in degrees (-1 if unknown)
+        qint16 m_Orientation = -1;
+
+        // Lens
+        Rational m_LensMinFocalLength;
+        Rational m_LensMaxFocalLength;
+        Rational m_LensMinFStopAtMinFocalLength;
+        Rational m_LensMinFStopAtMaxFocalLength;
+
+        // GPS position (NaN if unknown)
+        double m_GPSLatitude = qQNaN();
+        double m_GPSLongitude = qQNaN();
+        double m_GPSElevation = qQNaN();
+    };
+
+    // Typed values
+    const Record & GetRecord() const;
+
 private:
+    // Decode typed values from the tags
+    void DecodeRecord();
+    Record m_Record;
+
+    // Parse a list of rationals ("n/d n/d ...")
+    QList < Rational > ParseRationals(const QString & mcrValue) const;
+
+    // Parse GPS latitude or longitude
+    double ParseGPSCoordinate(const QString & mcrTag,
+        const QString & mcrPositive, const QString & mcrNegative) const;
+
     // Convert rational to string
-    QString ConvertRational(const QString & mcrValue) const;
+    QString ConvertRational(const Rational & mcrValue) const;
+
+    // Rational as stored in the file ("n/d"); also the key in the mappers
+    QString FormatRational(const Rational & mcrValue) const;
+
+
+
+    // ========================================================== Batch Reading
+public:
+    // Read EXIF info of several files in parallel (up to mcMaxThreads
+    // threads; 0: one per core). Files that have not changed since they
+    // were last read are taken from the cache without being opened.
+    // Returns filename to EXIF info (owned by the caller); files without
+    // EXIF data are left out.
+    static QHash < QString, ExifInfo * > CreateExifInfos(
+        const QStringList & mcrFilenames,
+        const bool mcIncludeMakerNotes = false, const int mcMaxThreads = 0);
+
+    // Keep the EXIF cache in a file. It is loaded the first time it is
+    // used and saved at exit (or by SaveCache()).
+    static void SetCacheFilename(const QString mcFilename);
+
+    // Save the EXIF cache
+    static bool SaveCache();
+
+private:
+    // Cache entry
+    struct CacheEntry
+    {
+        // Read with maker notes?
+        bool m_IncludesMakerNotes = false;
+
+        // Files without EXIF data are cached, too
+        bool m_HasExifInfo = false;
+
+        // Typed values
+        Record m_Record;
+
+        // MIME type, tag types and values (compressed)
+        QByteArray m_Data;
+    };
+
+    // Cache entries in the cache file
+    friend QDataStream & operator<<(QDataStream & mrOut,
+        const CacheEntry & mcrEntry);
+    friend QDataStream & operator>>(QDataStream & mrIn,
+        CacheEntry & mrEntry);
+
+    // Look up a file in the cache; only entries for unchanged files count
+    static bool LookUpCache(const QString & mcrFilename,
+        const FileCacheBase::FileIdentity & mcrIdentity,
+        const bool mcIncludeMakerNotes, CacheEntry & mrEntry);
+
+    // Add a file to the cache
+    static void StoreInCache(const QString & mcrFilename,
+        const FileCacheBase::FileIdentity & mcrIdentity,
+        const bool mcIncludeMakerNotes, const ExifInfo * mcpInfo);
+
+    // EXIF info from a cache entry
+    static ExifInfo * CreateExifInfoFromCache(const QString & mcrFilename,
+        const CacheEntry & mcrEntry);
+
+    // Decompress tags of EXIF info taken from the cache; getters that use
+    // tags call this first (from any thread)
+    void LoadTags() const;
+
+    // MIME type, tag types and values of EXIF info from the cache, until
+    // LoadTags() is called
+    mutable QByteArray m_CompressedTags;
+
+    // m_CompressedTags is still to be decompressed; cleared (with release
+    // semantics) once the tags are there
+    mutable std::atomic < bool > m_HasCompressedTags;
+
+    // Serializes decompression of the tags
+    mutable QMutex m_LoadTagsMutex;
+
+    // Typed values in the cache file
+    static void WriteRecord(QDataStream & mrOut, const Record & mcrRecord);
+    static void ReadRecord(QDataStream & mrIn, Record & mrRecord);
+
+    // Cache: absolute filename to entry
+    static FileCache < QString, CacheEntry > m_Cache;
 
 
 
     // ================================================================ Mappers
 private:
-    static bool InitializeMappers();
-    static const bool m_MappersInitialized;
+    // Mappers from values found in the files to normalized values; these
+    // are sorted tables built at compile time
+    enum Mapper
+    {
+        MapperCameraMaker,
+        MapperCameraModel,
+        MapperLensMaker,
+        MapperLensModel,
+        MapperFStop,
+        MapperFocalLength,
+        MapperExposureTime
+    };
 
-    static void Init_CameraMakerMapper();
-    static void Init_CameraModelMapper();
-    static void Init_LensMakerMapper();
-    static void Init_LensModelMapper();
-    static void Init_FStopMapper();
-    static void Init_FocalLengthMapper();
-    static void Init_ExposureTimeMapper();
+    // Look up a value in a mapper
+    static bool LookUpMapper(const Mapper mcMapper, const QString & mcrValue,
+        QString & mrMappedValue);
 
-    static QHash < QString, QString > m_CameraMakerMapper;
-    static QHash < QString, QString > m_CameraModelMapper;
-    static QHash < QString, QString > m_LensMakerMapper;
-    static QHash < QString, QString > m_LensModelMapper;
-    static QHash < QString, QString > m_FStopMapper;
-    static QHash < QString, QString > m_FocalLengthMapper;
-    static QHash < QString, QString > m_ExposureTimeMapper;
+    // Check if a value is in a mapper
+    static bool IsInMapper(const Mapper mcMapper, const QString & mcrValue);
 
 
 
@@ -207,11 +414,41 @@ public:
     // Dump full info
     void Dump() const;
 
+public:
+    // Collect statistics on tags and unknown mapper values (default: off).
+    // This needs all tags, so while it is on, EXIF info taken from the
+    // cache has its tags decompressed right away rather than when a getter
+    // first needs them.
+    static void SetCollectStatistics(const bool mcCollectStatistics);
+    static bool IsCollectingStatistics();
+
 private:
-    // Compile data
+    // Compile data; only called when collecting statistics
     void RegisterData();
-    static QHash < QString, QHash < QString, QString > > m_TagUsage;
-    static QHash < QString, QSet < QString > > m_NewMapperValues;
+    static std::atomic < bool > m_CollectStatistics;
+
+    // Tags are counted by ID rather than by name
+    static int GetTagId(const QString & mcrTag);
+    static QHash < QString, int > m_TagIds;
+    static QStringList m_TagNames;
+
+    // Statistics of one thread; only that thread writes to them
+    struct ThreadStatistics;
+    static ThreadStatistics & CurrentThreadStatistics();
+    static QList < ThreadStatistics * > m_StatisticsThreads;
+
+    // Statistics of all threads combined; either may be nullptr if not
+    // needed. Caller holds m_StatisticsMutex.
+    static void CollectStatistics(
+        QHash < int, QHash < QString, QString > > * mpTagUsage,
+        QHash < int, QSet < QString > > * mpNewMapperValues);
+
+    // Statistics of threads that have finished
+    static QHash < int, QHash < QString, QString > > m_TagUsage;
+    static QHash < int, QSet < QString > > m_NewMapperValues;
+
+    // Protects tag IDs, the list of threads and finished threads' statistics
+    static QMutex m_StatisticsMutex;
 
 public:
     // Dump compiled statistics
@@ -0,0 +1,355 @@
+// Copyright (C) 2025 Chris von Toerne
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+//
+// Contact the author by email: christian.vontoerne@gmail.com
+
+// FileCache.cpp
+// Class implementation file
+
+// Project includes
+#include "CallTracer.h"
+#include "FileCache.h"
+#include "MessageLogger.h"
+
+// Qt includes
+#include <QDebug>
+#include <QFile>
+#include <QFileInfo>
+#include <QObject>
+#include <QSaveFile>
+
+// System includes
+#include <cstdlib>
+#ifdef Q_OS_UNIX
+#include <sys/stat.h>
+#endif
+
+
+
+// ================================================================== Lifecycle
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// Constructor
+FileCacheBase::FileCacheBase(const quint32 mcMagic, const qint32 mcVersion,
+    const qint32 mcOldestVersion, const QString mcDescription) :
+    m_IsModified(false),
+    m_Version(mcVersion),
+    m_Magic(mcMagic),
+    m_OldestVersion(mcOldestVersion),
+    m_Description(mcDescription),
+    m_IsLoaded(false)
+{
+    // Nothing to do
+}
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// Destructor
+FileCacheBase::~FileCacheBase()
+{
+    // Nothing to do; caches live until exit, when SaveAll() saves them
+}
+
+
+
+// ============================================================== File Identity
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// Size, modification time and inode of a file
+FileCacheBase::FileIdentity FileCacheBase::GetFileIdentity(
+    const QString & mcrFilename)
+{
+    CALL_IN(QString("mcrFilename=%1")
+        .arg(CALL_SHOW(mcrFilename)));
+
+    FileIdentity identity;
+    const QFileInfo file_info(mcrFilename);
+    if (!file_info.exists())
+    {
+        CALL_OUT("");
+        return identity;
+    }
+    identity.m_Size = file_info.size();
+    identity.m_ModificationTime =
+        file_info.fileTime(QFileDevice::FileModificationTime)
+            .toMSecsSinceEpoch();
+
+#ifdef Q_OS_UNIX
+    // Catches files replaced by a different file with the same size and
+    // time stamp
+    struct stat file_status;
+    if (stat(QFile::encodeName(mcrFilename).constData(), &file_status) == 0)
+    {
+        identity.m_Inode = quint64(file_status.st_ino);
+    }
+#endif
+
+    CALL_OUT("");
+    return identity;
+}
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// Identity of a file in a cache file
+QDataStream & operator<<(QDataStream & mrOut,
+    const FileCacheBase::FileIdentity & mcrIdentity)
+{
+    return mrOut << mcrIdentity.m_Size
+        << mcrIdentity.m_ModificationTime
+        << mcrIdentity.m_Inode;
+}
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// Identity of a file in a cache file
+QDataStream & operator>>(QDataStream & mrIn,
+    FileCacheBase::FileIdentity & mrIdentity)
+{
+    return mrIn >> mrIdentity.m_Size
+        >> mrIdentity.m_ModificationTime
+        >> mrIdentity.m_Inode;
+}
+
+
+
+// ================================================================ Persistence
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// Keep the cache in a file
+void FileCacheBase::SetFilename(const QString mcFilename)
+{
+    CALL_IN(QString("mcFilename=%1")
+        .arg(CALL_SHOW_FULL(mcFilename)));
+
+    {
+        QMutexLocker lock(&m_Mutex);
+
+        // Save what we have to the previous file
+        if (m_IsModified)
+        {
+            SaveWithLock();
+        }
+
+        m_Filename = mcFilename;
+        m_IsLoaded = false;
+    }
+
+    // Save at exit
+    static const bool exit_handler_installed = []()
+        {
+            std::atexit(&FileCacheBase::SaveAll);
+            return true;
+        }();
+    Q_UNUSED(exit_handler_installed);
+    QMutexLocker lock(&m_CachesWithFileMutex);
+    if (!m_CachesWithFile.contains(this))
+    {
+        m_CachesWithFile << this;
+    }
+
+    CALL_OUT("");
+}
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// Save all modified caches
+void FileCacheBase::SaveAll()
+{
+    // Runs at exit: no CallTracer, no MessageLogger
+
+    QMutexLocker lock(&m_CachesWithFileMutex);
+    for (FileCacheBase * cache : m_CachesWithFile)
+    {
+        QMutexLocker cache_lock(&cache -> m_Mutex);
+        QString reason;
+        if (cache -> m_IsModified &&
+            !cache -> WriteFile(reason))
+        {
+            qWarning().noquote() << reason;
+        }
+    }
+}
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// Load the cache file
+void FileCacheBase::Load()
+{
+    CALL_IN("");
+
+    // Caller holds m_Mutex
+    QString reason;
+    if (!ReadFile(reason))
+    {
+        MessageLogger::Error(CALL_METHOD, reason);
+        CALL_OUT(reason);
+        return;
+    }
+
+    CALL_OUT("");
+}
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// Load the cache file without tracing or logging
+bool FileCacheBase::ReadFile(QString & mrReason)
+{
+    // Caller holds m_Mutex; also called at exit
+
+    // Only once
+    if (m_IsLoaded)
+    {
+        return true;
+    }
+    m_IsLoaded = true;
+
+    // Nothing to load
+    if (m_Filename.isEmpty() ||
+        !QFile::exists(m_Filename))
+    {
+        return true;
+    }
+
+    // Open file
+    QFile in_file(m_Filename);
+    if (!in_file.open(QIODevice::ReadOnly))
+    {
+        mrReason = QObject::tr("File \"%1\" could not be opened.")
+            .arg(m_Filename);
+        return false;
+    }
+
+    // Check format
+    QDataStream in(&in_file);
+    quint32 magic = 0;
+    qint32 version = 0;
+    in >> magic >> version;
+    if (magic != m_Magic ||
+        version < m_OldestVersion ||
+        version > m_Version)
+    {
+        mrReason = QObject::tr("File \"%1\" is not %2 (or has an "
+            "incompatible version).")
+            .arg(m_Filename,
+                 m_Description);
+        return false;
+    }
+
+    // Read entries
+    if (!ReadEntries(in, version))
+    {
+        mrReason = QObject::tr("File \"%1\" is corrupt.")
+            .arg(m_Filename);
+        return false;
+    }
+
+    return true;
+}
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// Save the cache to its file
+bool FileCacheBase::Save()
+{
+    CALL_IN("");
+
+    QMutexLocker lock(&m_Mutex);
+    const bool success = SaveWithLock();
+
+    CALL_OUT("");
+    return success;
+}
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// Save the cache
+bool FileCacheBase::SaveWithLock()
+{
+    CALL_IN("");
+
+    // Caller holds m_Mutex
+    QString reason;
+    if (!WriteFile(reason))
+    {
+        MessageLogger::Error(CALL_METHOD, reason);
+        CALL_OUT(reason);
+        return false;
+    }
+
+    CALL_OUT("");
+    return true;
+}
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// Save the cache file without tracing or logging
+bool FileCacheBase::WriteFile(QString & mrReason)
+{
+    // Caller holds m_Mutex; also called at exit
+
+    // Nothing to do if we only keep the cache in memory
+    if (m_Filename.isEmpty())
+    {
+        return true;
+    }
+
+    // Don't lose entries we haven't loaded yet (a corrupt file is
+    // overwritten)
+    QString read_reason;
+    ReadFile(read_reason);
+
+    // Write to a temporary file first so a crash does not corrupt the cache
+    QSaveFile out_file(m_Filename);
+    if (!out_file.open(QIODevice::WriteOnly))
+    {
+        mrReason = QObject::tr("File \"%1\" could not be opened.")
+            .arg(m_Filename);
+        return false;
+    }
+    QDataStream out(&out_file);
+    out << m_Magic << m_Version;
+    WriteEntries(out);
+    if (!out_file.commit())
+    {
+        mrReason = QObject::tr("File \"%1\" could not be written.")
+            .arg(m_Filename);
+        return false;
+    }
+
+    m_IsModified = false;
+    return true;
+}
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// Caches that have a file
+QList < FileCacheBase * > FileCacheBase::m_CachesWithFile;
+QMutex FileCacheBase::m_CachesWithFileMutex;
@@ -0,0 +1,347 @@
+// FileCache.h
+// Class definition file
+
+/** \class FileCacheBase
+  * Persistent cache of values computed from files
+  *
+  * Values that are expensive to compute from a file (hashes, metadata) are
+  * kept together with the size, modification time and inode of the file
+  * they were computed from; a cached value only counts as long as the file
+  * has not changed.
+  *
+  * The cache can be kept in a file. It is loaded the first time it is used,
+  * merged with what has been computed in the meantime, and saved at exit
+  * (or when asked to). All methods may be used from several threads.
+  * Caches are meant to be static members; a cache with a file has to live
+  * until the program exits.
+  *
+  * This base class does the file handling; FileCache adds the entries.
+  */
+
+// Just include once
+#ifndef FILECACHE_H
+#define FILECACHE_H
+
+// Project includes
+#include "CallTracer.h"
+
+// Qt includes
+#include <QDataStream>
+#include <QHash>
+#include <QList>
+#include <QMutex>
+#include <QPair>
+#include <QString>
+
+// Class definition
+class FileCacheBase
+{
+    // ============================================================== Lifecycle
+protected:
+    /** \brief Constructor
+      * \param mcMagic Magic number identifying the cache file
+      * \param mcVersion Version of the cache file written
+      * \param mcOldestVersion Oldest version that can still be read
+      * \param mcDescription What the cache is, for error messages, e.g.
+      * "an MD5 sum cache"
+      */
+    FileCacheBase(const quint32 mcMagic, const qint32 mcVersion,
+        const qint32 mcOldestVersion, const QString mcDescription);
+
+public:
+    /** \brief Destructor
+      */
+    virtual ~FileCacheBase();
+
+
+
+    // ========================================================== File Identity
+public:
+    /** \brief What identifies the content of a file without reading it
+      */
+    struct FileIdentity
+    {
+        qint64 m_Size = -1;
+        qint64 m_ModificationTime = 0;
+        quint64 m_Inode = 0;
+
+        bool operator==(const FileIdentity & mcrOther) const
+        {
+            return m_Size == mcrOther.m_Size &&
+                m_ModificationTime == mcrOther.m_ModificationTime &&
+                m_Inode == mcrOther.m_Inode;
+        }
+    };
+
+    /** \brief Size, modification time and inode of a file
+      * \returns An identity with a negative size if the file does not exist
+      */
+    static FileIdentity GetFileIdentity(const QString & mcrFilename);
+
+
+
+    // ============================================================ Persistence
+public:
+    /** \brief Keep the cache in a file
+      * \details What has been cached so far is saved to the previous file.
+      * The new file is loaded the first time the cache is used.
+      */
+    void SetFilename(const QString mcFilename);
+
+    /** \brief Save the cache to its file
+      * \returns \c true on success (or if there is no file)
+      */
+    bool Save();
+
+protected:
+    /** \brief Load the cache file (once; caller holds m_Mutex)
+      */
+    void Load();
+
+    /** \brief Read entries and merge them with the ones in memory
+      * \details Also called at exit, so neither this nor anything it calls
+      * may use CallTracer or MessageLogger.
+      * \param mcVersion Version of the cache file
+      * \returns \c false if the stream is corrupt
+      */
+    virtual bool ReadEntries(QDataStream & mrIn, const qint32 mcVersion) = 0;
+
+    /** \brief Write all entries
+      * \details Also called at exit; see ReadEntries().
+      */
+    virtual void WriteEntries(QDataStream & mrOut) const = 0;
+
+    /** \brief Protects everything; also the entries of derived classes
+      */
+    QMutex m_Mutex;
+
+    /** \brief Entries changed since the last save (caller holds m_Mutex)
+      */
+    bool m_IsModified;
+
+    /** \brief Version of the cache file written
+      */
+    const qint32 m_Version;
+
+private:
+    /** \brief Save the cache (caller holds m_Mutex)
+      */
+    bool SaveWithLock();
+
+    /** \brief Load the cache file without tracing or logging (caller holds
+      * m_Mutex)
+      * \param mrReason Set to what went wrong
+      * \returns \c false on error
+      */
+    bool ReadFile(QString & mrReason);
+
+    /** \brief Save the cache file without tracing or logging (caller holds
+      * m_Mutex)
+      * \param mrReason Set to what went wrong
+      * \returns \c false on error
+      */
+    bool WriteFile(QString & mrReason);
+
+    /** \brief Save all modified caches; called at exit, when the call
+      * tracer state of the main thread is gone already
+      */
+    static void SaveAll();
+
+    /** \brief Caches that have a file
+      */
+    static QList < FileCacheBase * > m_CachesWithFile;
+    static QMutex m_CachesWithFileMutex;
+
+    // File format
+    const quint32 m_Magic;
+    const qint32 m_OldestVersion;
+    const QString m_Description;
+
+    // Cache file
+    QString m_Filename;
+    bool m_IsLoaded;
+};
+
+
+
+// Identity of a file in a cache file
+QDataStream & operator<<(QDataStream & mrOut,
+    const FileCacheBase::FileIdentity & mcrIdentity);
+QDataStream & operator>>(QDataStream & mrIn,
+    FileCacheBase::FileIdentity & mrIdentity);
+
+
+
+/** \class FileCache
+  * Persistent cache of values of type \c T computed from files, looked up
+  * by keys of type \c K (usually the absolute filename, possibly combined
+  * with how the value was computed)
+  *
+  * Both types need \c QDataStream operators.
+  */
+template < typename K, typename T >
+class FileCache :
+    public FileCacheBase
+{
+    // ============================================================== Lifecycle
+public:
+    /** \brief Reads an entry of an older cache file version
+      */
+    typedef void (* ReadEntryFunction)(QDataStream & mrIn,
+        const qint32 mcVersion, K & mrKey, FileIdentity & mrIdentity,
+        T & mrValue);
+
+    /** \brief Constructor
+      * \param mcMagic Magic number identifying the cache file
+      * \param mcVersion Version of the cache file written
+      * \param mcDescription What the cache is, for error messages
+      * \param mcOldestVersion Oldest version that can still be read
+      * \param mcpReadOldEntry Reads entries of versions before mcVersion
+      */
+    FileCache(const quint32 mcMagic, const qint32 mcVersion,
+        const QString mcDescription, const qint32 mcOldestVersion = -1,
+        const ReadEntryFunction mcpReadOldEntry = nullptr) :
+        FileCacheBase(mcMagic, mcVersion,
+            (mcOldestVersion < 0 ? mcVersion : mcOldestVersion),
+            mcDescription),
+        m_ReadOldEntry(mcpReadOldEntry)
+    {
+    }
+
+
+
+    // ================================================================ Entries
+public:
+    /** \brief Look up a value
+      * \param mcrIdentity Identity of the file now; the value only counts
+      * if the file has not changed since it was cached
+      * \returns \c true if there is a value for an unchanged file
+      */
+    bool LookUp(const K & mcrKey, const FileIdentity & mcrIdentity,
+        T & mrValue)
+    {
+        CALL_IN("mcrKey=..., mcrIdentity=..., mrValue=...");
+
+        if (mcrIdentity.m_Size < 0)
+        {
+            // File does not exist
+            CALL_OUT("");
+            return false;
+        }
+
+        QMutexLocker lock(&m_Mutex);
+        Load();
+        const auto entry_iterator = m_Entries.constFind(mcrKey);
+        if (entry_iterator == m_Entries.constEnd() ||
+            !(entry_iterator.value().first == mcrIdentity))
+        {
+            CALL_OUT("");
+            return false;
+        }
+        mrValue = entry_iterator.value().second;
+
+        CALL_OUT("");
+        return true;
+    }
+
+    /** \brief Add a value
+      * \param mcrIdentity Identity of the file the value was computed from;
+      * values for files that do not exist are not stored
+      */
+    void Store(const K & mcrKey, const FileIdentity & mcrIdentity,
+        const T & mcrValue)
+    {
+        CALL_IN("mcrKey=..., mcrIdentity=..., mcrValue=...");
+
+        if (mcrIdentity.m_Size < 0)
+        {
+            // File does not exist
+            CALL_OUT("");
+            return;
+        }
+
+        QMutexLocker lock(&m_Mutex);
+        Load();
+        m_Entries[mcrKey] = qMakePair(mcrIdentity, mcrValue);
+        m_IsModified = true;
+
+        CALL_OUT("");
+    }
+
+private:
+    // Key to identity of the file and value
+    QHash < K, QPair < FileIdentity, T > > m_Entries;
+
+    // How to read older versions
+    const ReadEntryFunction m_ReadOldEntry;
+
+
+
+    // ============================================================ Persistence
+protected:
+    /** \brief Read entries and merge them with the ones in memory
+      */
+    bool ReadEntries(QDataStream & mrIn, const qint32 mcVersion) override
+    {
+        // Not traced; also called at exit
+
+        // Read entries
+        qint32 number_of_entries = 0;
+        mrIn >> number_of_entries;
+        QHash < K, QPair < FileIdentity, T > > entries;
+        entries.reserve(qMax(number_of_entries, 0));
+        for (int index = 0;
+             index < number_of_entries &&
+                mrIn.status() == QDataStream::Ok;
+             index++)
+        {
+            K key;
+            FileIdentity identity;
+            T value;
+            if (mcVersion != m_Version &&
+                m_ReadOldEntry)
+            {
+                m_ReadOldEntry(mrIn, mcVersion, key, identity, value);
+            } else
+            {
+                mrIn >> key >> identity >> value;
+            }
+            entries[key] = qMakePair(identity, value);
+        }
+        if (mrIn.status() != QDataStream::Ok)
+        {
+            return false;
+        }
+
+        // Merge (values computed in this session take precedence)
+        for (auto entry_iterator = entries.constBegin();
+             entry_iterator != entries.constEnd();
+             entry_iterator++)
+        {
+            if (!m_Entries.contains(entry_iterator.key()))
+            {
+                m_Entries[entry_iterator.key()] = entry_iterator.value();
+            }
+        }
+
+        return true;
+    }
+
+    /** \brief Write all entries
+      */
+    void WriteEntries(QDataStream & mrOut) const override
+    {
+        // Not traced; also called at exit
+        mrOut << qint32(m_Entries.size());
+        for (auto entry_iterator = m_Entries.constBegin();
+             entry_iterator != m_Entries.constEnd();
+             entry_iterator++)
+        {
+            mrOut << entry_iterator.key()
+                << entry_iterator.value().first
+                << entry_iterator.value().second;
+        }
+    }
+};
+
+#endif
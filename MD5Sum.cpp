@@ -26,10 +26,32 @@
 // Qt includes
 #include <QCryptographicHash>
 #include <QDataStream>
+#include <QElapsedTimer>
 #include <QFile>
 #include <QFileInfo>
+#include <QFuture>
 #include <QObject>
+#include <QRandomGenerator>
+#include <QSet>
 #include <QString>
+#include <QThread>
+#include <QThreadPool>
+#include <QtConcurrent>
+#include <QtEndian>
+
+// System includes
+#include <cstring>
+#include <memory>
+#ifdef Q_OS_LINUX
+#include <fcntl.h>
+#endif
+
+// Cache file format
+#define CACHE_MAGIC 0x4D443543
+#define CACHE_VERSION 2
+
+// Version 1 had MD5 sums only
+#define CACHE_VERSION_MD5_ONLY 1
 
 
 
@@ -72,67 +94,828 @@ MD5Sum::~MD5Sum()
 ///////////////////////////////////////////////////////////////////////////////
 // Compute MD5 sum
 QString MD5Sum::ComputeMD5Sum(const QString mcFilename,
-    const bool mcLookUp)
+    const bool mcLookUp, const ProgressFunction & mcrProgress)
 {
     CALL_IN(QString("mcFilename=%1, mcLookUp=%2")
         .arg(CALL_SHOW(mcFilename),
              CALL_SHOW(mcLookUp)));
 
-    QFileInfo file_info(mcFilename);
-    const qint64 file_size = file_info.size();
+    const QString md5sum =
+        ComputeHash(mcFilename, HashMD5, mcLookUp, mcrProgress);
+
+    CALL_OUT("");
+    return md5sum;
+}
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// Compute MD5 sum
+QString MD5Sum::ComputeMD5Sum(const QByteArray & mcrData)
+{
+    CALL_IN(QString("mcrData=%1")
+        .arg(CALL_SHOW(mcrData)));
+
+    const QString md5sum =
+        QCryptographicHash::hash(mcrData, QCryptographicHash::Md5).toHex();
+    CALL_OUT("");
+    return md5sum;
+}
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// Compute MD5 sums of several files in parallel
+QHash < QString, QString > MD5Sum::ComputeMD5Sums(
+    const QStringList & mcrFilenames, const int mcMaxReadThreads)
+{
+    CALL_IN(QString("mcrFilenames=%1, mcMaxReadThreads=%2")
+        .arg(CALL_SHOW(mcrFilenames),
+             CALL_SHOW(mcMaxReadThreads)));
+
+    const QHash < QString, QString > filename_to_hash =
+        ComputeHashes(mcrFilenames, HashMD5, mcMaxReadThreads);
+
+    CALL_OUT("");
+    return filename_to_hash;
+}
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// Incremental xxHash64
+struct MD5Sum::XXHash64State
+{
+    // xxHash64 primes
+    static constexpr quint64 PRIME_1 = 0x9E3779B185EBCA87ULL;
+    static constexpr quint64 PRIME_2 = 0xC2B2AE3D27D4EB4FULL;
+    static constexpr quint64 PRIME_3 = 0x165667B19E3779F9ULL;
+    static constexpr quint64 PRIME_4 = 0x85EBCA77C2B2AE63ULL;
+    static constexpr quint64 PRIME_5 = 0x27D4EB2F165667C5ULL;
+
+    // Constructor
+    XXHash64State(const quint64 mcSeed)
+    {
+        m_Seed = mcSeed;
+        m_Lanes[0] = mcSeed + PRIME_1 + PRIME_2;
+        m_Lanes[1] = mcSeed + PRIME_2;
+        m_Lanes[2] = mcSeed;
+        m_Lanes[3] = mcSeed - PRIME_1;
+        m_TotalSize = 0;
+        m_PendingSize = 0;
+    }
+
+    // Helpers
+    static quint64 RotateLeft(const quint64 mcValue, const int mcBits)
+    {
+        return (mcValue << mcBits) | (mcValue >> (64 - mcBits));
+    }
+    static quint64 Round(quint64 mAccumulator, const quint64 mcInput)
+    {
+        mAccumulator += mcInput * PRIME_2;
+        mAccumulator = RotateLeft(mAccumulator, 31);
+        return mAccumulator * PRIME_1;
+    }
+    static quint64 MergeRound(quint64 mAccumulator, const quint64 mcValue)
+    {
+        mAccumulator ^= Round(0, mcValue);
+        return mAccumulator * PRIME_1 + PRIME_4;
+    }
+
+    // One stripe of 32 bytes (data is read in little endian order)
+    void ProcessStripe(const uchar * mcpData)
+    {
+        m_Lanes[0] = Round(m_Lanes[0], qFromLittleEndian < quint64 >(mcpData));
+        m_Lanes[1] =
+            Round(m_Lanes[1], qFromLittleEndian < quint64 >(mcpData + 8));
+        m_Lanes[2] =
+            Round(m_Lanes[2], qFromLittleEndian < quint64 >(mcpData + 16));
+        m_Lanes[3] =
+            Round(m_Lanes[3], qFromLittleEndian < quint64 >(mcpData + 24));
+    }
+
+    // Add data
+    void Update(const uchar * mcpData, qint64 mSize)
+    {
+        m_TotalSize += mSize;
+
+        // Complete a stripe left over from last time
+        if (m_PendingSize > 0)
+        {
+            const int take = int(qMin(qint64(32 - m_PendingSize), mSize));
+            memcpy(m_Pending + m_PendingSize, mcpData, take);
+            m_PendingSize += take;
+            mcpData += take;
+            mSize -= take;
+            if (m_PendingSize < 32)
+            {
+                return;
+            }
+            ProcessStripe(m_Pending);
+            m_PendingSize = 0;
+        }
+
+        // Full stripes
+        while (mSize >= 32)
+        {
+            ProcessStripe(mcpData);
+            mcpData += 32;
+            mSize -= 32;
+        }
+
+        // Keep the rest for later
+        if (mSize > 0)
+        {
+            memcpy(m_Pending, mcpData, size_t(mSize));
+            m_PendingSize = int(mSize);
+        }
+    }
+
+    // Hash of everything added so far
+    quint64 Digest() const
+    {
+        quint64 hash;
+        if (m_TotalSize >= 32)
+        {
+            hash = RotateLeft(m_Lanes[0], 1) + RotateLeft(m_Lanes[1], 7) +
+                RotateLeft(m_Lanes[2], 12) + RotateLeft(m_Lanes[3], 18);
+            hash = MergeRound(hash, m_Lanes[0]);
+            hash = MergeRound(hash, m_Lanes[1]);
+            hash = MergeRound(hash, m_Lanes[2]);
+            hash = MergeRound(hash, m_Lanes[3]);
+        } else
+        {
+            hash = m_Seed + PRIME_5;
+        }
+        hash += quint64(m_TotalSize);
+
+        // Remaining bytes
+        int index = 0;
+        while (index + 8 <= m_PendingSize)
+        {
+            hash ^= Round(0, qFromLittleEndian < quint64 >(m_Pending + index));
+            hash = RotateLeft(hash, 27) * PRIME_1 + PRIME_4;
+            index += 8;
+        }
+        if (index + 4 <= m_PendingSize)
+        {
+            hash ^= quint64(qFromLittleEndian < quint32 >(m_Pending + index)) *
+                PRIME_1;
+            hash = RotateLeft(hash, 23) * PRIME_2 + PRIME_3;
+            index += 4;
+        }
+        while (index < m_PendingSize)
+        {
+            hash ^= quint64(m_Pending[index]) * PRIME_5;
+            hash = RotateLeft(hash, 11) * PRIME_1;
+            index++;
+        }
+
+        // Avalanche
+        hash ^= hash >> 33;
+        hash *= PRIME_2;
+        hash ^= hash >> 29;
+        hash *= PRIME_3;
+        hash ^= hash >> 32;
+        return hash;
+    }
+
+    // Seed
+    quint64 m_Seed;
+
+    // Accumulators
+    quint64 m_Lanes[4];
+
+    // Bytes added so far
+    qint64 m_TotalSize;
+
+    // Incomplete stripe
+    uchar m_Pending[32];
+    int m_PendingSize;
+};
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// Compute fast non-cryptographic hash (xxHash64 algorithm)
+quint64 MD5Sum::ComputeXXHash64(const QByteArray & mcrData,
+    const quint64 mcSeed)
+{
+    CALL_IN(QString("mcrData=%1, mcSeed=%2")
+        .arg(CALL_SHOW(mcrData),
+             CALL_SHOW(qint64(mcSeed))));
+
+    XXHash64State state(mcSeed);
+    state.Update(reinterpret_cast < const uchar * >(mcrData.constData()),
+        mcrData.size());
+    const quint64 hash = state.Digest();
+
+    CALL_OUT("");
+    return hash;
+}
+
+
+
+// ================================================================= Algorithms
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// Incremental hashing with any algorithm
+struct MD5Sum::Hasher
+{
+    // Constructor
+    Hasher(const HashAlgorithm mcAlgorithm) :
+        m_Algorithm(mcAlgorithm),
+        m_XXHash64(0)
+    {
+        switch (mcAlgorithm)
+        {
+        case HashMD5:
+            m_CryptographicHash.reset(
+                new QCryptographicHash(QCryptographicHash::Md5));
+            break;
+        case HashSHA256:
+            m_CryptographicHash.reset(
+                new QCryptographicHash(QCryptographicHash::Sha256));
+            break;
+        case HashBLAKE2b:
+            m_CryptographicHash.reset(
+                new QCryptographicHash(QCryptographicHash::Blake2b_256));
+            break;
+        case HashXXHash64:
+            break;
+        }
+    }
+
+    // Add data
+    void AddData(const char * mcpData, const qint64 mcSize)
+    {
+        if (m_CryptographicHash)
+        {
+            m_CryptographicHash -> addData(QByteArrayView(mcpData, mcSize));
+        } else
+        {
+            m_XXHash64.Update(reinterpret_cast < const uchar * >(mcpData),
+                mcSize);
+        }
+    }
+
+    // Hash as hex string
+    QString Result()
+    {
+        if (m_CryptographicHash)
+        {
+            return m_CryptographicHash -> result().toHex();
+        }
+        return QString::number(m_XXHash64.Digest(), 16)
+            .rightJustified(16, '0');
+    }
+
+    // Algorithm
+    HashAlgorithm m_Algorithm;
+
+    // Algorithms provided by Qt
+    std::unique_ptr < QCryptographicHash > m_CryptographicHash;
+
+    // xxHash64
+    XXHash64State m_XXHash64;
+};
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// Name of an algorithm
+QString MD5Sum::GetAlgorithmName(const HashAlgorithm mcAlgorithm)
+{
+    // No CALL_IN/CALL_OUT; used in parameter lists of traced methods
+
+    switch (mcAlgorithm)
+    {
+    case HashMD5:
+        return "MD5";
+    case HashSHA256:
+        return "SHA-256";
+    case HashBLAKE2b:
+        return "BLAKE2b-256";
+    case HashXXHash64:
+        return "xxHash64";
+    }
+    return QString();
+}
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// Compute hash of a file with any algorithm
+QString MD5Sum::ComputeHash(const QString mcFilename,
+    const HashAlgorithm mcAlgorithm, const bool mcLookUp,
+    const ProgressFunction & mcrProgress)
+{
+    CALL_IN(QString("mcFilename=%1, mcAlgorithm=%2, mcLookUp=%3")
+        .arg(CALL_SHOW(mcFilename),
+             GetAlgorithmName(mcAlgorithm),
+             CALL_SHOW(mcLookUp)));
 
     // Look up if we are supposed to
-    if (!mcLookUp ||
-        !m_FilesizeToFilenameToMD5Sum.contains(file_size) ||
-        !m_FilesizeToFilenameToMD5Sum[file_size].contains(mcFilename))
+    const QString filename = QFileInfo(mcFilename).absoluteFilePath();
+    const FileIdentity identity = FileCacheBase::GetFileIdentity(filename);
+    QString cached_hash;
+    if (mcLookUp &&
+        LookUpCache(filename, mcAlgorithm, identity, cached_hash))
+    {
+        CALL_OUT("");
+        return cached_hash;
+    }
+
+    // Hash file
+    const QString hash = HashFile(mcFilename, mcAlgorithm, mcrProgress);
+    if (hash.isEmpty())
+    {
+        const QString reason =
+            QObject::tr("%1 hash of \"%2\" could not be computed.")
+                .arg(GetAlgorithmName(mcAlgorithm),
+                     mcFilename);
+        CALL_OUT(reason);
+        return QString();
+    }
+
+    // Store it.
+    StoreInCache(filename, mcAlgorithm, identity, hash);
+
+    // Return hash
+    CALL_OUT("");
+    return hash;
+}
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// Compute hashes of several files in parallel
+QHash < QString, QString > MD5Sum::ComputeHashes(
+    const QStringList & mcrFilenames, const HashAlgorithm mcAlgorithm,
+    const int mcMaxReadThreads)
+{
+    CALL_IN(QString("mcrFilenames=%1, mcAlgorithm=%2, mcMaxReadThreads=%3")
+        .arg(CALL_SHOW(mcrFilenames),
+             GetAlgorithmName(mcAlgorithm),
+             CALL_SHOW(mcMaxReadThreads)));
+
+    // Cached hashes
+    QHash < QString, QString > filename_to_hash;
+    QStringList to_hash;
+    QSet < QString > to_hash_set;
+    QList < FileIdentity > identities;
+    for (const QString & filename : mcrFilenames)
+    {
+        if (filename_to_hash.contains(filename) ||
+            to_hash_set.contains(filename))
+        {
+            continue;
+        }
+        const QString absolute_filename =
+            QFileInfo(filename).absoluteFilePath();
+        const FileIdentity identity =
+            FileCacheBase::GetFileIdentity(absolute_filename);
+        QString cached_hash;
+        if (LookUpCache(absolute_filename, mcAlgorithm, identity,
+            cached_hash))
+        {
+            filename_to_hash[filename] = cached_hash;
+        } else
+        {
+            to_hash << filename;
+            to_hash_set += filename;
+            identities << identity;
+        }
+    }
+
+    // Reading waits for the disk (or the network), so it gets more threads
+    // than there are cores; hashing gets one thread per core
+    QThreadPool read_pool;
+    read_pool.setMaxThreadCount(mcMaxReadThreads > 0 ?
+        mcMaxReadThreads : 2 * QThread::idealThreadCount());
+    QThreadPool hash_pool;
+    hash_pool.setMaxThreadCount(QThread::idealThreadCount());
+    const QStringList hashes = QtConcurrent::blockingMapped < QStringList >(
+        &read_pool, to_hash,
+        [&hash_pool, mcAlgorithm](const QString & mcrFilename)
+        {
+            return HashFile(mcrFilename, mcAlgorithm, ProgressFunction(),
+                &hash_pool);
+        });
+
+    // Collect results (files that could not be read are left out)
+    for (int index = 0; index < to_hash.size(); index++)
     {
-        // Open file
-        QFile in_file(mcFilename);
-        
-        // Check if that was successful
-        if (!in_file.open(QIODevice::ReadOnly))
+        if (hashes[index].isEmpty())
         {
-            // Nope
+            continue;
+        }
+        filename_to_hash[to_hash[index]] = hashes[index];
+        StoreInCache(QFileInfo(to_hash[index]).absoluteFilePath(),
+            mcAlgorithm, identities[index], hashes[index]);
+    }
+
+    CALL_OUT("");
+    return filename_to_hash;
+}
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// Hash a file chunk by chunk
+QString MD5Sum::HashFile(const QString & mcrFilename,
+    const HashAlgorithm mcAlgorithm, const ProgressFunction & mcrProgress,
+    QThreadPool * mpHashPool)
+{
+    CALL_IN(QString("mcrFilename=%1, mcAlgorithm=%2, mcrProgress=..., "
+        "mpHashPool=%3")
+        .arg(CALL_SHOW(mcrFilename),
+             GetAlgorithmName(mcAlgorithm),
+             CALL_SHOW(mpHashPool)));
+
+    // Open file
+    QFile in_file(mcrFilename);
+    if (!in_file.open(QIODevice::ReadOnly))
+    {
+        const QString reason =
+            QObject::tr("File \"%1\" could not be opened.")
+                .arg(mcrFilename);
+        MessageLogger::Error(CALL_METHOD, reason);
+        CALL_OUT(reason);
+        return QString();
+    }
+
+#ifdef Q_OS_LINUX
+    // We read the file once, front to back
+    posix_fadvise(in_file.handle(), 0, 0, POSIX_FADV_SEQUENTIAL);
+#endif
+
+    // Hash it chunk by chunk. With a hash pool, one chunk is hashed there
+    // while the next one is read into the other buffer.
+    Hasher hasher(mcAlgorithm);
+    const qint64 file_size = in_file.size();
+    QByteArray buffers[2] = {
+        QByteArray(int(m_ChunkSize), Qt::Uninitialized),
+        QByteArray(mpHashPool ? int(m_ChunkSize) : 0, Qt::Uninitialized) };
+    int current_buffer = 0;
+    QFuture < void > hashing;
+    qint64 bytes_done = 0;
+    while (true)
+    {
+        QByteArray & buffer = buffers[current_buffer];
+        const qint64 bytes_read = in_file.read(buffer.data(), m_ChunkSize);
+        if (bytes_read < 0)
+        {
+            hashing.waitForFinished();
             const QString reason =
-                QObject::tr("File \"%1\" could not be opened.")
-                    .arg(mcFilename);
+                QObject::tr("File \"%1\" could not be read: %2")
+                    .arg(mcrFilename,
+                         in_file.errorString());
             MessageLogger::Error(CALL_METHOD, reason);
             CALL_OUT(reason);
             return QString();
         }
-        
-        // Read entire file
-        const QByteArray data = in_file.readAll();
-        const QString hash =
-            QCryptographicHash::hash(data, QCryptographicHash::Md5).toHex();
+        if (bytes_read == 0)
+        {
+            break;
+        }
+        if (mpHashPool)
+        {
+            // Chunks have to be hashed in order
+            hashing.waitForFinished();
+            const char * chunk = buffer.constData();
+            hashing = QtConcurrent::run(mpHashPool,
+                [&hasher, chunk, bytes_read]()
+                {
+                    hasher.AddData(chunk, bytes_read);
+                });
+            current_buffer = 1 - current_buffer;
+        } else
+        {
+            hasher.AddData(buffer.constData(), bytes_read);
+        }
+        bytes_done += bytes_read;
+        if (mcrProgress)
+        {
+            mcrProgress(bytes_done, file_size);
+        }
+    }
+
+    hashing.waitForFinished();
+
+    const QString hash = hasher.Result();
+    CALL_OUT("");
+    return hash;
+}
+
 
-        // Store it.
-        m_FilesizeToFilenameToMD5Sum[file_size][mcFilename] = hash;
+
+///////////////////////////////////////////////////////////////////////////////
+// Size of chunks read from files
+const qint64 MD5Sum::m_ChunkSize = 1024 * 1024;
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// Compute hash of data with any algorithm
+QString MD5Sum::ComputeHash(const QByteArray & mcrData,
+    const HashAlgorithm mcAlgorithm)
+{
+    CALL_IN(QString("mcrData=%1, mcAlgorithm=%2")
+        .arg(CALL_SHOW(mcrData),
+             GetAlgorithmName(mcAlgorithm)));
+
+    Hasher hasher(mcAlgorithm);
+    hasher.AddData(mcrData.constData(), mcrData.size());
+    const QString hash = hasher.Result();
+
+    CALL_OUT("");
+    return hash;
+}
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// Measure throughput of all algorithms
+QHash < QString, double > MD5Sum::BenchmarkAlgorithms(const int mcDataSizeMB)
+{
+    CALL_IN(QString("mcDataSizeMB=%1")
+        .arg(CALL_SHOW(mcDataSizeMB)));
+
+    // Random data (in memory, so this measures hashing, not reading)
+    QByteArray buffer(int(m_ChunkSize), Qt::Uninitialized);
+    QRandomGenerator random_generator(42);
+    random_generator.fillRange(reinterpret_cast < quint32 * >(buffer.data()),
+        buffer.size() / int(sizeof(quint32)));
+    const qint64 total_size = qint64(qMax(1, mcDataSizeMB)) * 1024 * 1024;
+
+    QHash < QString, double > throughput;
+    QList < QString > titles;
+    QList < QString > values;
+    for (const HashAlgorithm algorithm :
+        { HashMD5, HashSHA256, HashBLAKE2b, HashXXHash64 })
+    {
+        QElapsedTimer timer;
+        timer.start();
+        Hasher hasher(algorithm);
+        for (qint64 done = 0; done < total_size; done += buffer.size())
+        {
+            hasher.AddData(buffer.constData(), buffer.size());
+        }
+        hasher.Result();
+        const double seconds = qMax(timer.nsecsElapsed(), qint64(1)) / 1e9;
+        const double megabytes_per_second =
+            total_size / (1024. * 1024.) / seconds;
+        throughput[GetAlgorithmName(algorithm)] = megabytes_per_second;
+        titles << GetAlgorithmName(algorithm);
+        values << QObject::tr("%1 MB/s")
+            .arg(QString::number(megabytes_per_second, 'f', 0));
     }
+    MessageLogger::Table(titles, values);
 
-    // Return MD5 sum
     CALL_OUT("");
-    return m_FilesizeToFilenameToMD5Sum[file_size][mcFilename];
+    return throughput;
 }
 
 
 
+// ====================================================================== Cache
+
+
+
 ///////////////////////////////////////////////////////////////////////////////
-// Compute MD5 sum
-QString MD5Sum::ComputeMD5Sum(const QByteArray & mcrData)
+// Keep the MD5 sum cache in a file
+void MD5Sum::SetCacheFilename(const QString mcFilename)
 {
-    CALL_IN(QString("mcrData=%1")
-        .arg(CALL_SHOW(mcrData)));
+    CALL_IN(QString("mcFilename=%1")
+        .arg(CALL_SHOW_FULL(mcFilename)));
+
+    m_Cache.SetFilename(mcFilename);
 
-    const QString md5sum =
-        QCryptographicHash::hash(mcrData, QCryptographicHash::Md5).toHex();
     CALL_OUT("");
-    return md5sum;
 }
 
 
 
 ///////////////////////////////////////////////////////////////////////////////
-// MD5 Sum cache
-QHash < qint64, QHash < QString, QString > >
-    MD5Sum::m_FilesizeToFilenameToMD5Sum;
+// Look up a file in the MD5 sum cache
+bool MD5Sum::LookUpCache(const QString & mcrFilename,
+    const HashAlgorithm mcAlgorithm, const FileIdentity & mcrIdentity,
+    QString & mrHash)
+{
+    CALL_IN(QString("mcrFilename=%1, mcAlgorithm=%2, mcrIdentity=..., "
+        "mrHash=%3")
+        .arg(CALL_SHOW(mcrFilename),
+             GetAlgorithmName(mcAlgorithm),
+             CALL_SHOW(mrHash)));
+
+    const bool found = m_Cache.LookUp(
+        qMakePair(mcrFilename, int(mcAlgorithm)), mcrIdentity, mrHash);
+
+    CALL_OUT("");
+    return found;
+}
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// Add a file to the MD5 sum cache
+void MD5Sum::StoreInCache(const QString & mcrFilename,
+    const HashAlgorithm mcAlgorithm, const FileIdentity & mcrIdentity,
+    const QString & mcrHash)
+{
+    CALL_IN(QString("mcrFilename=%1, mcAlgorithm=%2, mcrIdentity=..., "
+        "mcrHash=%3")
+        .arg(CALL_SHOW(mcrFilename),
+             GetAlgorithmName(mcAlgorithm),
+             CALL_SHOW(mcrHash)));
+
+    m_Cache.Store(qMakePair(mcrFilename, int(mcAlgorithm)), mcrIdentity,
+        mcrHash);
+
+    CALL_OUT("");
+}
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// Read entries of cache files from before there was a choice of algorithm
+void MD5Sum::ReadOldCacheEntry(QDataStream & mrIn, const qint32 mcVersion,
+    QPair < QString, int > & mrKey, FileIdentity & mrIdentity,
+    QString & mrHash)
+{
+    // Not traced; also called when the cache is saved at exit
+
+    // Version 1 had MD5 sums only
+    Q_UNUSED(mcVersion);
+    mrIn >> mrKey.first >> mrIdentity >> mrHash;
+    mrKey.second = HashMD5;
+}
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// Save the MD5 sum cache
+bool MD5Sum::SaveCache()
+{
+    CALL_IN("");
+
+    const bool success = m_Cache.Save();
+
+    CALL_OUT("");
+    return success;
+}
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// MD5 sum cache
+FileCache < QPair < QString, int >, QString > MD5Sum::m_Cache(CACHE_MAGIC,
+    CACHE_VERSION, "an MD5 sum cache", CACHE_VERSION_MD5_ONLY,
+    &MD5Sum::ReadOldCacheEntry);
+
+
+
+// ================================================================= Duplicates
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// Find files with identical content
+QList < QStringList > MD5Sum::FindDuplicates(const QStringList & mcrFilenames,
+    const HashAlgorithm mcAlgorithm)
+{
+    CALL_IN(QString("mcrFilenames=%1, mcAlgorithm=%2")
+        .arg(CALL_SHOW(mcrFilenames),
+             GetAlgorithmName(mcAlgorithm)));
+
+    // Group by size; files with a unique size have no duplicates
+    QHash < qint64, QStringList > size_to_filenames;
+    for (const QString & filename : mcrFilenames)
+    {
+        const QFileInfo file_info(filename);
+        if (file_info.isFile())
+        {
+            size_to_filenames[file_info.size()] << filename;
+        }
+    }
+    QList < QStringList > duplicates;
+    QStringList candidates;
+    QList < qint64 > candidate_sizes;
+    for (auto size_iterator = size_to_filenames.constBegin();
+         size_iterator != size_to_filenames.constEnd();
+         size_iterator++)
+    {
+        if (size_iterator.value().size() < 2)
+        {
+            continue;
+        }
+        if (size_iterator.key() == 0)
+        {
+            // Empty files are all the same
+            duplicates << size_iterator.value();
+            continue;
+        }
+        for (const QString & filename : size_iterator.value())
+        {
+            candidates << filename;
+            candidate_sizes << size_iterator.key();
+        }
+    }
+
+    // Quick hash of beginning and end (reading is what takes time)
+    QThreadPool read_pool;
+    read_pool.setMaxThreadCount(2 * QThread::idealThreadCount());
+    const QList < quint64 > partial_hashes =
+        QtConcurrent::blockingMapped < QList < quint64 > >(&read_pool,
+            candidates, &ComputePartialHash);
+
+    // Files that still collide
+    QHash < QPair < qint64, quint64 >, QStringList > partial_to_filenames;
+    for (int index = 0; index < candidates.size(); index++)
+    {
+        partial_to_filenames[qMakePair(candidate_sizes[index],
+            partial_hashes[index])] << candidates[index];
+    }
+    QStringList to_hash;
+    for (auto partial_iterator = partial_to_filenames.constBegin();
+         partial_iterator != partial_to_filenames.constEnd();
+         partial_iterator++)
+    {
+        if (partial_iterator.value().size() > 1)
+        {
+            to_hash << partial_iterator.value();
+        }
+    }
+
+    // Full hashes for those
+    const QHash < QString, QString > filename_to_hash =
+        ComputeHashes(to_hash, mcAlgorithm);
+    QHash < QString, QStringList > hash_to_filenames;
+    for (const QString & filename : to_hash)
+    {
+        if (filename_to_hash.contains(filename))
+        {
+            hash_to_filenames[filename_to_hash[filename]] << filename;
+        }
+    }
+    for (auto hash_iterator = hash_to_filenames.constBegin();
+         hash_iterator != hash_to_filenames.constEnd();
+         hash_iterator++)
+    {
+        if (hash_iterator.value().size() > 1)
+        {
+            duplicates << hash_iterator.value();
+        }
+    }
+
+    CALL_OUT("");
+    return duplicates;
+}
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// Quick hash of the beginning and the end of a file
+quint64 MD5Sum::ComputePartialHash(const QString & mcrFilename)
+{
+    CALL_IN(QString("mcrFilename=%1")
+        .arg(CALL_SHOW(mcrFilename)));
+
+    // Open file (files that can't be read end up in a group of their own
+    // when they are hashed completely)
+    QFile in_file(mcrFilename);
+    if (!in_file.open(QIODevice::ReadOnly))
+    {
+        const QString reason =
+            QObject::tr("File \"%1\" could not be opened.")
+                .arg(mcrFilename);
+        CALL_OUT(reason);
+        return 0;
+    }
+
+    // Beginning
+    const QByteArray head = in_file.read(m_PartialHashSize);
+    quint64 hash = ComputeXXHash64(head);
+
+    // End (unless the beginning already covered it)
+    const qint64 file_size = in_file.size();
+    if (file_size > m_PartialHashSize)
+    {
+        const qint64 tail_start =
+            qMax(m_PartialHashSize, file_size - m_PartialHashSize);
+        in_file.seek(tail_start);
+        hash = ComputeXXHash64(in_file.read(m_PartialHashSize), hash);
+    }
+
+    CALL_OUT("");
+    return hash;
+}
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// Size of the beginning and end used by the quick hash
+const qint64 MD5Sum::m_PartialHashSize = 64 * 1024;
@@ -5,10 +5,22 @@
 #ifndef MD5SUM_H
 #define MD5SUM_H
 
+// Project includes
+#include "FileCache.h"
+
 // Qt includes
 #include <QByteArray>
 #include <QHash>
+#include <QMutex>
+#include <QPair>
 #include <QString>
+#include <QStringList>
+
+// System includes
+#include <functional>
+
+// Forward declarations
+class QThreadPool;
 
 // Class definition
 class MD5Sum
@@ -26,15 +38,134 @@ public:
     
     // ============================================================== MD5 Stuff
 public:
-    // Compute MD5 sum
+    // Progress while hashing a file: bytes done, file size
+    typedef std::function < void (const qint64, const qint64) >
+        ProgressFunction;
+
+    // Compute MD5 sum (the file is read in chunks, so memory use does not
+    // depend on the file size)
     static QString ComputeMD5Sum(const QString mcFilename,
-        const bool mcLookUp = true);
+        const bool mcLookUp = true,
+        const ProgressFunction & mcrProgress = ProgressFunction());
     static QString ComputeMD5Sum(const QByteArray & mcrData);
 
+    // Compute MD5 sums of several files in parallel (cached sums are used
+    // where possible). Files are read by up to mcMaxReadThreads threads
+    // (0: twice the number of cores), and hashed by one thread per core
+    // while the next chunk is being read. Returns filename to MD5 sum;
+    // files that could not be read are left out.
+    static QHash < QString, QString > ComputeMD5Sums(
+        const QStringList & mcrFilenames, const int mcMaxReadThreads = 0);
+
+    // Compute fast non-cryptographic hash (xxHash64 algorithm)
+    static quint64 ComputeXXHash64(const QByteArray & mcrData,
+        const quint64 mcSeed = 0);
+
+private:
+    // Incremental xxHash64
+    struct XXHash64State;
+
+
+
+    // ============================================================= Algorithms
+public:
+    // Available hash algorithms (MD5 for compatibility, the others for
+    // speed or strength)
+    enum HashAlgorithm {
+        HashMD5,
+        HashSHA256,
+        HashBLAKE2b,
+        HashXXHash64
+    };
+
+    // Name of an algorithm
+    static QString GetAlgorithmName(const HashAlgorithm mcAlgorithm);
+
+    // Compute hash of a file or of data with any algorithm (file hashes
+    // are cached per algorithm)
+    static QString ComputeHash(const QString mcFilename,
+        const HashAlgorithm mcAlgorithm, const bool mcLookUp = true,
+        const ProgressFunction & mcrProgress = ProgressFunction());
+    static QString ComputeHash(const QByteArray & mcrData,
+        const HashAlgorithm mcAlgorithm);
+
+    // Compute hashes of several files in parallel, like ComputeMD5Sums()
+    static QHash < QString, QString > ComputeHashes(
+        const QStringList & mcrFilenames, const HashAlgorithm mcAlgorithm,
+        const int mcMaxReadThreads = 0);
+
+    // Measure throughput of all algorithms on data in memory; returns
+    // algorithm name to MB/s
+    static QHash < QString, double > BenchmarkAlgorithms(
+        const int mcDataSizeMB = 256);
+
+private:
+    // Incremental hashing with any algorithm
+    struct Hasher;
+
+    // Hash a file chunk by chunk; if a hash pool is given, chunks are
+    // hashed there while the next one is read
+    static QString HashFile(const QString & mcrFilename,
+        const HashAlgorithm mcAlgorithm,
+        const ProgressFunction & mcrProgress,
+        QThreadPool * mpHashPool = nullptr);
+
+    // Size of chunks read from files
+    static const qint64 m_ChunkSize;
+
+
+
+    // ================================================================== Cache
+public:
+    // Keep the MD5 sum cache in a file. It is loaded the first time a sum
+    // is looked up and saved at exit (or by SaveCache()).
+    static void SetCacheFilename(const QString mcFilename);
+
+    // Save the MD5 sum cache
+    static bool SaveCache();
+
+private:
+    // What identifies the content of a file without reading it
+    typedef FileCacheBase::FileIdentity FileIdentity;
+
+    // Look up a file in the MD5 sum cache; only entries for unchanged
+    // files count
+    static bool LookUpCache(const QString & mcrFilename,
+        const HashAlgorithm mcAlgorithm, const FileIdentity & mcrIdentity,
+        QString & mrHash);
+
+    // Add a file to the MD5 sum cache
+    static void StoreInCache(const QString & mcrFilename,
+        const HashAlgorithm mcAlgorithm, const FileIdentity & mcrIdentity,
+        const QString & mcrHash);
+
+    // Reads entries of cache files from before there was a choice of
+    // algorithm
+    static void ReadOldCacheEntry(QDataStream & mrIn, const qint32 mcVersion,
+        QPair < QString, int > & mrKey, FileIdentity & mrIdentity,
+        QString & mrHash);
+
+    // MD5 sum cache: absolute filename and algorithm to hash
+    static FileCache < QPair < QString, int >, QString > m_Cache;
+
+
+
+    // ============================================================= Duplicates
+public:
+    // Find files with identical content. Files are grouped by size first,
+    // then by a quick hash of their first and last 64 KiB; only files
+    // that still collide are hashed completely. Returns groups of two or
+    // more identical files.
+    static QList < QStringList > FindDuplicates(
+        const QStringList & mcrFilenames,
+        const HashAlgorithm mcAlgorithm = HashMD5);
+
 private:
-    // MD5 Sum cache
-    static QHash < qint64, QHash < QString, QString > >
-        m_FilesizeToFilenameToMD5Sum;
+    // Quick hash of the beginning and the end of a file
+    static quint64 ComputePartialHash(const QString & mcrFilename);
+
+    // Size of the beginning and end used by the quick hash
+    static const qint64 m_PartialHashSize;
 };
 
 #endif
@@ -24,7 +24,27 @@
 #include "StringHelper.h"
 
 // Qt includes
+#include <QDateTime>
 #include <QDebug>
+#include <QFile>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QLocale>
+#include <QStringList>
+#include <QThread>
+
+// System includes
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+
+// Maximum number of no-repeat tags remembered
+#define MAX_NO_REPEAT_TAGS 100000
+
+// Maximum number of distinct similar-message counters
+#define MAX_RATE_LIMIT_COUNTERS 10000
 
 
 
@@ -89,15 +109,31 @@ MessageLogger::~MessageLogger()
 // Add error line
 void MessageLogger::Error(const QString mcMethod, const QString mcReason)
 {
-    // Dump to console
-    qDebug().noquote() << StringHelper::ANSI_RedFont;
-    qDebug().noquote()
-        << tr("ERROR: %1:\n\t%2")
-        .arg(mcMethod,
-             mcReason);
-    qDebug().noquote() << tr("Callback stack:\n%1")
-        .arg(CALL_STACK());
-    qDebug().noquote() << StringHelper::ANSI_ResetColor;
+    Record("error", mcMethod, QString(), QStringList(), mcReason);
+    ShowError(mcMethod, mcReason);
+}
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// Show error line on the console
+void MessageLogger::ShowError(const QString & mcrMethod,
+    const QString & mcrReason)
+{
+    if (!m_ConsoleOutput.load(std::memory_order_relaxed))
+    {
+        return;
+    }
+
+    // Dump to console (the call stack has to be taken right here)
+    Output(QString("%1\n%2\n%3\n%4")
+        .arg(StringHelper::ANSI_RedFont,
+             tr("ERROR: %1:\n\t%2")
+                .arg(mcrMethod,
+                     mcrReason),
+             tr("Callback stack:\n%1")
+                .arg(CALL_STACK()),
+             StringHelper::ANSI_ResetColor));
 }
 
 
@@ -108,15 +144,12 @@ void MessageLogger::Error(const QString mcMethod, const QString mcNoRepeatTag,
     const QString mcReason)
 {
     // Check if this is a repetition
-    if (m_NoRepeatTags.contains(mcNoRepeatTag))
+    if (IsRepetition(mcNoRepeatTag))
     {
         // Yup. Ignore.
         return;
     }
-    
-    // This will be a repetition next time around
-    m_NoRepeatTags += mcNoRepeatTag;
-    
+
     // Use normal method
     Error(mcMethod, mcReason);
 }
@@ -127,9 +160,10 @@ void MessageLogger::Error(const QString mcMethod, const QString mcNoRepeatTag,
 // Add message line
 void MessageLogger::Message(const QString mcMethod, const QString mcReason)
 {
-    qDebug().noquote() << QString("%1:\n\t%2")
+    Record("message", mcMethod, QString(), QStringList(), mcReason);
+    Output(QString("%1:\n\t%2")
         .arg(mcMethod,
-             mcReason);
+             mcReason));
 }
 
 
@@ -140,15 +174,12 @@ void MessageLogger::Message(const QString mcMethod,
     const QString mcNoRepeatTag, const QString mcReason)
 {
     // Check if this is a repetition
-    if (m_NoRepeatTags.contains(mcNoRepeatTag))
+    if (IsRepetition(mcNoRepeatTag))
     {
         // Yup. Ignore.
         return;
     }
-    
-    // This will be a repetition next time around
-    m_NoRepeatTags += mcNoRepeatTag;
-    
+
     // Use normal method
     Message(mcMethod, mcReason);
 }
@@ -159,9 +190,10 @@ void MessageLogger::Message(const QString mcMethod,
 // Add debug line
 void MessageLogger::Debug(const QString mcMethod, const QString mcReason)
 {
-    qDebug().noquote() << tr("DEBUG: %1: %2")
+    Record("debug", mcMethod, QString(), QStringList(), mcReason);
+    Output(tr("DEBUG: %1: %2")
         .arg(mcMethod,
-             mcReason);
+             mcReason));
 }
 
 
@@ -181,20 +213,24 @@ void MessageLogger::Table(const QList < QString > mcTitles,
     }
     
     // Dump to console
+    QStringList lines;
     for (int idx = 0; idx < mcValues.size(); idx++)
     {
         if (mcTitles.size() > idx)
         {
-            qDebug().noquote() << QString("%1: %2")
+            lines << QString("%1: %2")
                 .arg(mcTitles[idx],
                      mcValues[idx]);
         } else
         {
-            qDebug().noquote() << QString("%1")
+            lines << QString("%1")
                 .arg(mcValues[idx]);
         }
     }
-    qDebug().noquote() << "";
+    lines << "";
+    const QString text = lines.join("\n");
+    Record("table", QString(), QString(), QStringList(), text);
+    Output(text);
 }
 
 
@@ -203,7 +239,31 @@ void MessageLogger::Table(const QList < QString > mcTitles,
 // Add message line
 void MessageLogger::Print(const QString mcMessage)
 {
-    qDebug().noquote() << mcMessage;
+    Record("print", QString(), QString(), QStringList(), mcMessage);
+    Output(mcMessage);
+}
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// Check if a tag has been used before (and remember it)
+bool MessageLogger::IsRepetition(const QString & mcrNoRepeatTag)
+{
+    QMutexLocker lock(&m_NoRepeatTagsMutex);
+    if (m_NoRepeatTags.contains(mcrNoRepeatTag))
+    {
+        return true;
+    }
+
+    // Don't grow without bounds; forgetting the oldest tag means its
+    // message may be shown once more
+    if (m_NoRepeatTags.size() >= MAX_NO_REPEAT_TAGS)
+    {
+        m_NoRepeatTags.remove(m_NoRepeatTagsOrder.dequeue());
+    }
+    m_NoRepeatTags += mcrNoRepeatTag;
+    m_NoRepeatTagsOrder.enqueue(mcrNoRepeatTag);
+    return false;
 }
 
 
@@ -211,3 +271,885 @@ void MessageLogger::Print(const QString mcMessage)
 ///////////////////////////////////////////////////////////////////////////////
 // Remember what warning has already been shown
 QSet < QString > MessageLogger::m_NoRepeatTags = QSet < QString >();
+QQueue < QString > MessageLogger::m_NoRepeatTagsOrder;
+QMutex MessageLogger::m_NoRepeatTagsMutex;
+
+
+
+// ============================================================== Rate limiting
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// Add error line (rate limited)
+void MessageLogger::Error(const QString mcMethod, const QString mcFormat,
+    const QStringList & mcrArguments)
+{
+    // The structured log gets everything
+    Record("error", mcMethod, mcFormat, mcrArguments, QString());
+    if (!m_ConsoleOutput.load(std::memory_order_relaxed))
+    {
+        return;
+    }
+
+    // Console
+    QStringList summaries;
+    const bool show = PassesRateLimit(true, mcMethod, mcFormat, summaries);
+    for (const QString & summary : summaries)
+    {
+        Output(summary);
+    }
+    if (show)
+    {
+        ShowError(mcMethod, Render(mcFormat, mcrArguments));
+    }
+}
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// Add message line (rate limited)
+void MessageLogger::Message(const QString mcMethod, const QString mcFormat,
+    const QStringList & mcrArguments)
+{
+    // The structured log gets everything
+    Record("message", mcMethod, mcFormat, mcrArguments, QString());
+    if (!m_ConsoleOutput.load(std::memory_order_relaxed))
+    {
+        return;
+    }
+
+    // Console
+    QStringList summaries;
+    const bool show = PassesRateLimit(false, mcMethod, mcFormat, summaries);
+    for (const QString & summary : summaries)
+    {
+        Output(summary);
+    }
+    if (show)
+    {
+        Output(QString("%1:\n\t%2")
+            .arg(mcMethod,
+                 Render(mcFormat, mcrArguments)));
+    }
+}
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// Set limits for similar messages
+void MessageLogger::SetRateLimit(const int mcMaxMessages,
+    const int mcIntervalMS)
+{
+    // Report what has been counted under the old limits
+    ReportSuppressed();
+
+    QMutexLocker lock(&m_RateLimitMutex);
+    m_RateLimitMessages = qMax(0, mcMaxMessages);
+    m_RateLimitInterval = qMax(1, mcIntervalMS);
+}
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// Summarize everything that has been suppressed and not reported yet
+void MessageLogger::ReportSuppressed()
+{
+    QStringList summaries;
+    {
+        QMutexLocker lock(&m_RateLimitMutex);
+        for (auto counter_iterator = m_RateLimitCounters.begin();
+             counter_iterator != m_RateLimitCounters.end();
+             counter_iterator++)
+        {
+            if (counter_iterator.value().m_NumberSuppressed > 0)
+            {
+                summaries << Summary(counter_iterator.key(),
+                    counter_iterator.value());
+                counter_iterator.value().m_NumberSuppressed = 0;
+            }
+        }
+    }
+    for (const QString & summary : summaries)
+    {
+        Output(summary);
+    }
+}
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// Check if a message is to be shown
+bool MessageLogger::PassesRateLimit(const bool mcIsError,
+    const QString & mcrMethod, const QString & mcrFormat,
+    QStringList & mrSummaries)
+{
+    QMutexLocker lock(&m_RateLimitMutex);
+
+    // No limit
+    if (m_RateLimitMessages == 0)
+    {
+        return true;
+    }
+
+    const qint64 now = Now();
+    const QPair < QString, QString > key(mcrMethod, mcrFormat);
+
+    // Every now and then, summarize counters that nobody has touched for a
+    // while, and forget quiet ones
+    if (now - m_LastSummaryCheck >= m_RateLimitInterval ||
+        (m_RateLimitCounters.size() >= MAX_RATE_LIMIT_COUNTERS &&
+         !m_RateLimitCounters.contains(key)))
+    {
+        m_LastSummaryCheck = now;
+        for (auto counter_iterator = m_RateLimitCounters.begin();
+             counter_iterator != m_RateLimitCounters.end();)
+        {
+            RateLimitCounter & counter = counter_iterator.value();
+            if (now - counter.m_IntervalStart < m_RateLimitInterval &&
+                m_RateLimitCounters.size() < MAX_RATE_LIMIT_COUNTERS)
+            {
+                counter_iterator++;
+                continue;
+            }
+            if (counter.m_NumberSuppressed > 0)
+            {
+                mrSummaries << Summary(counter_iterator.key(), counter);
+            }
+            counter_iterator = m_RateLimitCounters.erase(counter_iterator);
+        }
+    }
+
+    // New interval for this message?
+    RateLimitCounter & counter = m_RateLimitCounters[key];
+    if (counter.m_IntervalStart == 0 ||
+        now - counter.m_IntervalStart >= m_RateLimitInterval)
+    {
+        if (counter.m_NumberSuppressed > 0)
+        {
+            mrSummaries << Summary(key, counter);
+        }
+        counter.m_IsError = mcIsError;
+        counter.m_IntervalStart = now;
+        counter.m_NumberShown = 0;
+        counter.m_NumberSuppressed = 0;
+    }
+
+    // Check limit
+    if (counter.m_NumberShown < m_RateLimitMessages)
+    {
+        counter.m_NumberShown++;
+        return true;
+    }
+    counter.m_NumberSuppressed++;
+
+    // Make sure the count is shown eventually
+    static const bool exit_handler_installed = []()
+        {
+            std::atexit(&MessageLogger::ReportSuppressed);
+            return true;
+        }();
+    Q_UNUSED(exit_handler_installed);
+
+    return false;
+}
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// Summary line for suppressed messages
+QString MessageLogger::Summary(const QPair < QString, QString > & mcrKey,
+    const RateLimitCounter & mcrCounter)
+{
+    const QString count = QLocale::system()
+        .toString(mcrCounter.m_NumberSuppressed);
+    const QString summary = mcrCounter.m_IsError
+        ? tr("%1:\n\tSuppressed %2 similar error(s): \"%3\"")
+        : tr("%1:\n\tSuppressed %2 similar message(s): \"%3\"");
+    return summary.arg(mcrKey.first,
+        count,
+        mcrKey.second);
+}
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// Put format and arguments together
+QString MessageLogger::Render(const QString & mcrFormat,
+    const QStringList & mcrArguments)
+{
+    // Single pass, so arguments containing "%1" etc. are left alone
+    QString text;
+    text.reserve(mcrFormat.size() + 16 * mcrArguments.size());
+    const int length = mcrFormat.size();
+    for (int index = 0; index < length; index++)
+    {
+        const QChar this_char = mcrFormat.at(index);
+        if (this_char != '%' ||
+            index + 1 >= length ||
+            !mcrFormat.at(index + 1).isDigit())
+        {
+            text += this_char;
+            continue;
+        }
+
+        // Placeholder (up to two digits)
+        int number = mcrFormat.at(index + 1).digitValue();
+        int end = index + 2;
+        if (end < length &&
+            mcrFormat.at(end).isDigit())
+        {
+            number = 10 * number + mcrFormat.at(end).digitValue();
+            end++;
+        }
+        if (number >= 1 &&
+            number <= mcrArguments.size())
+        {
+            text += mcrArguments[number - 1];
+        } else
+        {
+            text += mcrFormat.mid(index, end - index);
+        }
+        index = end - 1;
+    }
+    return text;
+}
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// Monotonic clock in milliseconds
+qint64 MessageLogger::Now()
+{
+    return std::chrono::duration_cast < std::chrono::milliseconds >(
+        std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// Method and format to counters
+QHash < QPair < QString, QString >, MessageLogger::RateLimitCounter >
+    MessageLogger::m_RateLimitCounters;
+QMutex MessageLogger::m_RateLimitMutex;
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// Limits
+int MessageLogger::m_RateLimitMessages = 5;
+qint64 MessageLogger::m_RateLimitInterval = 10000;
+qint64 MessageLogger::m_LastSummaryCheck = 0;
+
+
+
+
+// ========================================================= Background writer
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// Entry in the queue
+struct MessageLogger::QueueEntry
+{
+    // Next (newer) entry
+    std::atomic < QueueEntry * > m_Next;
+
+    // Text
+    QByteArray m_Text;
+};
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// Write text
+void MessageLogger::Output(const QString & mcrText)
+{
+    // Console switched off
+    if (!m_ConsoleOutput.load(std::memory_order_relaxed))
+    {
+        return;
+    }
+
+    // No background writer; StopBackgroundWriter() waits for producers
+    // that have seen it running
+    m_ActiveProducers.fetch_add(1);
+    if (!m_WriterRunning.load())
+    {
+        m_ActiveProducers.fetch_sub(1, std::memory_order_release);
+        qDebug().noquote() << mcrText;
+        return;
+    }
+
+    // Check memory limit
+    const QByteArray text = (mcrText + "\n").toUtf8();
+    if (m_QueuedBytes.fetch_add(text.size(), std::memory_order_relaxed) +
+        text.size() > m_MaxQueuedBytes)
+    {
+        m_QueuedBytes.fetch_sub(text.size(), std::memory_order_relaxed);
+        m_NumberDropped.fetch_add(1, std::memory_order_relaxed);
+        m_ActiveProducers.fetch_sub(1, std::memory_order_release);
+        return;
+    }
+
+    // Add to queue
+    QueueEntry * entry = new QueueEntry;
+    entry -> m_Text = text;
+    entry -> m_Next.store(nullptr, std::memory_order_relaxed);
+    QueueEntry * previous =
+        m_QueueHead.exchange(entry, std::memory_order_acq_rel);
+    previous -> m_Next.store(entry, std::memory_order_release);
+    m_NumberQueued.fetch_add(1, std::memory_order_release);
+    m_ActiveProducers.fetch_sub(1, std::memory_order_release);
+
+    // Wake up writer if it's waiting
+    if (m_WriterIdle.load(std::memory_order_acquire))
+    {
+        QMutexLocker lock(&m_WriterMutex);
+        m_WriterWakeUp.wakeOne();
+    }
+}
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// Start writing output from a background thread
+bool MessageLogger::StartBackgroundWriter(const QString mcFilename,
+    const qint64 mcMaxQueuedBytes)
+{
+    // Check if we're already running
+    if (m_WriterRunning)
+    {
+        StopBackgroundWriter();
+    }
+
+    // Open output
+    QFile * output_file = new QFile();
+    bool success;
+    if (mcFilename.isEmpty())
+    {
+        success = output_file -> open(stderr, QIODevice::WriteOnly);
+    } else
+    {
+        output_file -> setFileName(mcFilename);
+        success = output_file -> open(QIODevice::WriteOnly |
+            QIODevice::Append);
+    }
+    if (!success)
+    {
+        delete output_file;
+        const QString reason = tr("File \"%1\" could not be opened.")
+            .arg(mcFilename);
+        Error(CALL_METHOD, reason);
+        return false;
+    }
+    m_OutputFile = output_file;
+
+    // Empty queue (a single placeholder entry)
+    QueueEntry * placeholder = new QueueEntry;
+    placeholder -> m_Next.store(nullptr, std::memory_order_relaxed);
+    m_QueueTail = placeholder;
+    m_QueueHead.store(placeholder, std::memory_order_release);
+    m_QueuedBytes = 0;
+    m_MaxQueuedBytes = mcMaxQueuedBytes;
+    m_NumberQueued = 0;
+    m_NumberWritten = 0;
+    m_NumberDropped = 0;
+
+    // Start thread
+    m_StopWriter = false;
+    m_WriterIdle = false;
+    m_WriterThread = QThread::create(&MessageLogger::WriterLoop);
+    m_WriterThread -> start();
+    m_WriterRunning.store(true, std::memory_order_release);
+
+    // Make sure nothing gets lost at exit
+    static const bool exit_handler_installed = []()
+        {
+            std::atexit(&MessageLogger::StopBackgroundWriter);
+            return true;
+        }();
+    Q_UNUSED(exit_handler_installed);
+
+    return true;
+}
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// Write everything still queued and stop the background thread
+void MessageLogger::StopBackgroundWriter()
+{
+    if (!m_WriterRunning.exchange(false))
+    {
+        return;
+    }
+
+    // Let the writer finish
+    {
+        QMutexLocker lock(&m_WriterMutex);
+        m_StopWriter = true;
+        m_WriterWakeUp.wakeOne();
+    }
+    m_WriterThread -> wait();
+    delete m_WriterThread;
+    m_WriterThread = nullptr;
+
+    // Messages still being queued by threads that saw the writer running;
+    // everyone else writes to the console now
+    while (m_ActiveProducers.load() > 0)
+    {
+        QThread::yieldCurrentThread();
+    }
+
+    // Anything that came in while stopping
+    QByteArray text;
+    while (Dequeue(text))
+    {
+        m_OutputFile -> write(text);
+    }
+    m_OutputFile -> close();
+    delete m_OutputFile;
+    m_OutputFile = nullptr;
+
+    // Nobody can add to the queue any more
+    delete m_QueueTail;
+    m_QueueTail = nullptr;
+    m_QueueHead.store(nullptr, std::memory_order_relaxed);
+}
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// Wait until everything queued so far has been written
+void MessageLogger::Flush()
+{
+    const qint64 target = m_NumberQueued.load(std::memory_order_acquire);
+    QMutexLocker lock(&m_WriterMutex);
+    m_WriterWakeUp.wakeOne();
+    while (m_WriterRunning.load(std::memory_order_acquire) &&
+        m_NumberWritten.load(std::memory_order_acquire) < target)
+    {
+        m_WriterProgress.wait(&m_WriterMutex, 100);
+    }
+}
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// Background thread
+void MessageLogger::WriterLoop()
+{
+    QByteArray buffer;
+    QByteArray text;
+    while (true)
+    {
+        const bool stop = m_StopWriter.load(std::memory_order_acquire);
+
+        // Collect everything queued
+        qint64 number_written = 0;
+        while (Dequeue(text))
+        {
+            buffer += text;
+            number_written++;
+
+            // Write in chunks
+            if (buffer.size() > 64 * 1024)
+            {
+                m_OutputFile -> write(buffer);
+                buffer.clear();
+            }
+        }
+        const qint64 number_dropped =
+            m_NumberDropped.exchange(0, std::memory_order_relaxed);
+        if (number_dropped > 0)
+        {
+            buffer += tr("(%1 log message(s) dropped - output queue full)\n")
+                .arg(QString::number(number_dropped))
+                .toUtf8();
+        }
+        if (!buffer.isEmpty())
+        {
+            m_OutputFile -> write(buffer);
+            m_OutputFile -> flush();
+            buffer.clear();
+        }
+
+        // Report progress
+        QMutexLocker lock(&m_WriterMutex);
+        if (number_written > 0)
+        {
+            m_NumberWritten.fetch_add(number_written,
+                std::memory_order_release);
+            m_WriterProgress.wakeAll();
+        }
+        if (stop)
+        {
+            break;
+        }
+
+        // Wait for more (a lost wake-up only delays output a little)
+        if (!m_QueueTail -> m_Next.load(std::memory_order_acquire) &&
+            !m_StopWriter)
+        {
+            m_WriterIdle.store(true, std::memory_order_release);
+            m_WriterWakeUp.wait(&m_WriterMutex, 100);
+            m_WriterIdle.store(false, std::memory_order_release);
+        }
+    }
+}
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// Take the oldest entry off the queue
+bool MessageLogger::Dequeue(QByteArray & mrText)
+{
+    // The tail is always an entry that has already been taken (or the
+    // initial placeholder)
+    QueueEntry * tail = m_QueueTail;
+    QueueEntry * next = tail -> m_Next.load(std::memory_order_acquire);
+    if (!next)
+    {
+        return false;
+    }
+    m_QueueTail = next;
+    mrText = std::move(next -> m_Text);
+    m_QueuedBytes.fetch_sub(mrText.size(), std::memory_order_relaxed);
+    delete tail;
+
+    return true;
+}
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// Queue
+std::atomic < MessageLogger::QueueEntry * >
+    MessageLogger::m_QueueHead(nullptr);
+MessageLogger::QueueEntry * MessageLogger::m_QueueTail = nullptr;
+std::atomic < qint64 > MessageLogger::m_QueuedBytes(0);
+qint64 MessageLogger::m_MaxQueuedBytes = 0;
+std::atomic < int > MessageLogger::m_ActiveProducers(0);
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// Statistics
+std::atomic < qint64 > MessageLogger::m_NumberQueued(0);
+std::atomic < qint64 > MessageLogger::m_NumberWritten(0);
+std::atomic < qint64 > MessageLogger::m_NumberDropped(0);
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// Writer state
+std::atomic < bool > MessageLogger::m_WriterRunning(false);
+std::atomic < bool > MessageLogger::m_StopWriter(false);
+std::atomic < bool > MessageLogger::m_WriterIdle(false);
+QThread * MessageLogger::m_WriterThread = nullptr;
+QFile * MessageLogger::m_OutputFile = nullptr;
+QMutex MessageLogger::m_WriterMutex;
+QWaitCondition MessageLogger::m_WriterWakeUp;
+QWaitCondition MessageLogger::m_WriterProgress;
+
+
+
+// ============================================================= Structured log
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// Start recording every log entry in a file
+bool MessageLogger::StartStructuredLog(const QString mcFilename)
+{
+    StopStructuredLog();
+
+    QFile * log_file = new QFile(mcFilename);
+    if (!log_file -> open(QIODevice::WriteOnly | QIODevice::Append))
+    {
+        delete log_file;
+        const QString reason = tr("File \"%1\" could not be opened.")
+            .arg(mcFilename);
+        Error(CALL_METHOD, reason);
+        return false;
+    }
+
+    QMutexLocker lock(&m_StructuredLogMutex);
+    m_StructuredLogFile = log_file;
+    m_MethodIDs.clear();
+    m_FormatIDs.clear();
+
+    // New session; numbers start over
+    QJsonObject session;
+    session["session"] =
+        QDateTime::currentDateTime().toString(Qt::ISODateWithMs);
+    m_StructuredLogFile -> write(
+        QJsonDocument(session).toJson(QJsonDocument::Compact) + "\n");
+    m_StructuredLogRunning.store(true, std::memory_order_release);
+
+    // Make sure nothing gets lost at exit
+    static const bool exit_handler_installed = []()
+        {
+            std::atexit(&MessageLogger::StopStructuredLog);
+            return true;
+        }();
+    Q_UNUSED(exit_handler_installed);
+
+    return true;
+}
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// Close structured log
+void MessageLogger::StopStructuredLog()
+{
+    QMutexLocker lock(&m_StructuredLogMutex);
+    if (!m_StructuredLogRunning.exchange(false, std::memory_order_acq_rel))
+    {
+        return;
+    }
+    m_StructuredLogFile -> close();
+    delete m_StructuredLogFile;
+    m_StructuredLogFile = nullptr;
+}
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// Switch human-readable output on or off
+void MessageLogger::SetConsoleOutput(const bool mcIsEnabled)
+{
+    m_ConsoleOutput.store(mcIsEnabled, std::memory_order_relaxed);
+}
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// Add entry to the structured log
+void MessageLogger::Record(const char * mcpLevel, const QString & mcrMethod,
+    const QString & mcrFormat, const QStringList & mcrArguments,
+    const QString & mcrText)
+{
+    if (!m_StructuredLogRunning.load(std::memory_order_acquire))
+    {
+        return;
+    }
+
+    QJsonObject record;
+    record["t"] = QDateTime::currentMSecsSinceEpoch();
+    record["level"] = QString(mcpLevel);
+
+    QMutexLocker lock(&m_StructuredLogMutex);
+    if (!m_StructuredLogFile)
+    {
+        // Stopped in the meantime
+        return;
+    }
+    if (!mcrMethod.isEmpty())
+    {
+        record["method"] =
+            GetStructuredLogID(m_MethodIDs, "define_method", mcrMethod);
+    }
+    if (mcrFormat.isEmpty())
+    {
+        record["text"] = mcrText;
+    } else
+    {
+        record["format"] =
+            GetStructuredLogID(m_FormatIDs, "define_format", mcrFormat);
+        record["args"] = QJsonArray::fromStringList(mcrArguments);
+    }
+    m_StructuredLogFile -> write(
+        QJsonDocument(record).toJson(QJsonDocument::Compact) + "\n");
+}
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// Number of a method or format
+int MessageLogger::GetStructuredLogID(QHash < QString, int > & mrIDs,
+    const char * mcpKind, const QString & mcrName)
+{
+    // Caller holds m_StructuredLogMutex
+    auto id_iterator = mrIDs.constFind(mcrName);
+    if (id_iterator != mrIDs.constEnd())
+    {
+        return id_iterator.value();
+    }
+
+    // New one: write definition
+    const int id = mrIDs.size();
+    mrIDs[mcrName] = id;
+    QJsonObject definition;
+    definition[QString(mcpKind)] = id;
+    definition["name"] = mcrName;
+    m_StructuredLogFile -> write(
+        QJsonDocument(definition).toJson(QJsonDocument::Compact) + "\n");
+    return id;
+}
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// Read a structured log
+QList < MessageLogger::LogRecord > MessageLogger::ReadStructuredLog(
+    const QString mcFilename, const QString mcLevel)
+{
+    QFile log_file(mcFilename);
+    if (!log_file.open(QIODevice::ReadOnly))
+    {
+        const QString reason = tr("File \"%1\" could not be opened.")
+            .arg(mcFilename);
+        Error(CALL_METHOD, reason);
+        return QList < LogRecord >();
+    }
+
+    // Definitions of the current session
+    QHash < int, QString > methods;
+    QHash < int, QString > formats;
+
+    QList < LogRecord > records;
+    int line_number = 0;
+    while (!log_file.atEnd())
+    {
+        const QByteArray line = log_file.readLine();
+        line_number++;
+        if (line.trimmed().isEmpty())
+        {
+            continue;
+        }
+        QJsonParseError parse_error;
+        const QJsonObject entry =
+            QJsonDocument::fromJson(line, &parse_error).object();
+        if (parse_error.error != QJsonParseError::NoError)
+        {
+            const QString reason = tr("Line %1 of \"%2\" is corrupt.")
+                .arg(QString::number(line_number),
+                     mcFilename);
+            Error(CALL_METHOD, reason);
+            continue;
+        }
+
+        // Session start and definitions
+        if (entry.contains("session"))
+        {
+            methods.clear();
+            formats.clear();
+            continue;
+        }
+        if (entry.contains("define_method"))
+        {
+            methods[entry["define_method"].toInt()] =
+                entry["name"].toString();
+            continue;
+        }
+        if (entry.contains("define_format"))
+        {
+            formats[entry["define_format"].toInt()] =
+                entry["name"].toString();
+            continue;
+        }
+
+        // Log entry
+        const QString level = entry["level"].toString();
+        if (!mcLevel.isEmpty() &&
+            level != mcLevel)
+        {
+            continue;
+        }
+        LogRecord record;
+        record.m_Timestamp = qint64(entry["t"].toDouble());
+        record.m_Level = level;
+        if (entry.contains("method"))
+        {
+            record.m_Method = methods.value(entry["method"].toInt());
+        }
+        if (entry.contains("format"))
+        {
+            record.m_Format = formats.value(entry["format"].toInt());
+            for (const QJsonValue & argument : entry["args"].toArray())
+            {
+                record.m_Arguments << argument.toString();
+            }
+            record.m_Text = Render(record.m_Format, record.m_Arguments);
+        } else
+        {
+            record.m_Text = entry["text"].toString();
+        }
+        records << record;
+    }
+
+    return records;
+}
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// Show most frequent entries in a structured log
+void MessageLogger::ShowStructuredLogSummary(const QString mcFilename,
+    const int mcMaxLines)
+{
+    const QList < LogRecord > records = ReadStructuredLog(mcFilename);
+
+    // Count by level, method and format (plain text entries by text)
+    QHash < QString, int > counts;
+    for (const LogRecord & record : records)
+    {
+        const QString key = QString("%1 | %2 | %3")
+            .arg(record.m_Level,
+                 record.m_Method,
+                 record.m_Format.isEmpty()
+                    ? record.m_Text
+                    : record.m_Format);
+        counts[key]++;
+    }
+
+    // Most frequent first
+    QList < QPair < int, QString > > sorted;
+    for (auto count_iterator = counts.constBegin();
+         count_iterator != counts.constEnd();
+         count_iterator++)
+    {
+        sorted << QPair < int, QString >(count_iterator.value(),
+            count_iterator.key());
+    }
+    std::sort(sorted.begin(), sorted.end(),
+        [](const QPair < int, QString > & mcrLeft,
+            const QPair < int, QString > & mcrRight)
+        {
+            return mcrLeft.first > mcrRight.first;
+        });
+
+    QStringList lines;
+    lines << tr("%1 entries in \"%2\":")
+        .arg(QLocale::system().toString(records.size()),
+             mcFilename);
+    for (int index = 0;
+         index < sorted.size() &&
+            (mcMaxLines <= 0 || index < mcMaxLines);
+         index++)
+    {
+        lines << QString("%1  %2")
+            .arg(QLocale::system().toString(sorted[index].first), 12)
+            .arg(sorted[index].second);
+    }
+    Print(lines.join("\n"));
+}
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// Structured log file
+std::atomic < bool > MessageLogger::m_StructuredLogRunning(false);
+QFile * MessageLogger::m_StructuredLogFile = nullptr;
+QMutex MessageLogger::m_StructuredLogMutex;
+QHash < QString, int > MessageLogger::m_MethodIDs;
+QHash < QString, int > MessageLogger::m_FormatIDs;
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// Console output
+std::atomic < bool > MessageLogger::m_ConsoleOutput(true);
@@ -10,10 +10,24 @@
 #define MESSAGELOGGER_H
 
 // Qt includes
+#include <QByteArray>
+#include <QHash>
 #include <QList>
+#include <QMutex>
 #include <QObject>
+#include <QPair>
+#include <QQueue>
 #include <QSet>
 #include <QString>
+#include <QStringList>
+#include <QWaitCondition>
+
+// System includes
+#include <atomic>
+
+// Forward declarations
+class QFile;
+class QThread;
 
 // Class definition
 class MessageLogger
@@ -65,8 +79,196 @@ public:
     static void Print(const QString mcMessage);
 
 private:
-    // Remember what warning has already been shown
+    // Remember what warning has already been shown (bounded; once full,
+    // the oldest tags are forgotten)
     static QSet < QString > m_NoRepeatTags;
+    static QQueue < QString > m_NoRepeatTagsOrder;
+    static QMutex m_NoRepeatTagsMutex;
+
+    // Check if a tag has been used before (and remember it)
+    static bool IsRepetition(const QString & mcrNoRepeatTag);
+
+    // Write text (synchronously, or queue it for the background writer)
+    static void Output(const QString & mcrText);
+
+    // Show error line on the console
+    static void ShowError(const QString & mcrMethod,
+        const QString & mcrReason);
+
+
+
+    // ========================================================== Rate limiting
+public:
+    // Add error or message line. Similar messages - same method and same
+    // format string (with %1, %2, ... placeholders for the arguments) -
+    // are only shown a few times per interval; the rest are counted and
+    // summarized. Message text is only put together if it is shown.
+    static void Error(const QString mcMethod, const QString mcFormat,
+        const QStringList & mcrArguments);
+    static void Message(const QString mcMethod, const QString mcFormat,
+        const QStringList & mcrArguments);
+
+    // Show at most mcMaxMessages similar messages every mcIntervalMS
+    // milliseconds (0 messages: no limit)
+    static void SetRateLimit(const int mcMaxMessages,
+        const int mcIntervalMS = 10000);
+
+    // Summarize everything that has been suppressed and not reported yet
+    static void ReportSuppressed();
+
+private:
+    // Counters for similar messages
+    struct RateLimitCounter
+    {
+        bool m_IsError = false;
+        qint64 m_IntervalStart = 0;
+        int m_NumberShown = 0;
+        qint64 m_NumberSuppressed = 0;
+    };
+
+    // Check if a message is to be shown; summaries of messages suppressed
+    // before are added to mrSummaries
+    static bool PassesRateLimit(const bool mcIsError,
+        const QString & mcrMethod, const QString & mcrFormat,
+        QStringList & mrSummaries);
+
+    // Summary line for suppressed messages
+    static QString Summary(const QPair < QString, QString > & mcrKey,
+        const RateLimitCounter & mcrCounter);
+
+    // Put format and arguments together
+    static QString Render(const QString & mcrFormat,
+        const QStringList & mcrArguments);
+
+    // Monotonic clock in milliseconds
+    static qint64 Now();
+
+    // Method and format to counters
+    static QHash < QPair < QString, QString >, RateLimitCounter >
+        m_RateLimitCounters;
+    static QMutex m_RateLimitMutex;
+
+    // Limits
+    static int m_RateLimitMessages;
+    static qint64 m_RateLimitInterval;
+
+    // Last time all counters were checked for pending summaries
+    static qint64 m_LastSummaryCheck;
+
+
+
+    // ====================================================== Background writer
+public:
+    // Write all output from a background thread, to a file or (if no
+    // filename is given) to stderr. Output is queued without locking;
+    // once more than mcMaxQueuedBytes are waiting, further messages are
+    // dropped (and counted). Queued output is written at exit.
+    static bool StartBackgroundWriter(const QString mcFilename = QString(),
+        const qint64 mcMaxQueuedBytes = 16 * 1024 * 1024);
+
+    // Write everything still queued and stop the background thread
+    static void StopBackgroundWriter();
+
+    // Wait until everything queued so far has been written
+    static void Flush();
+
+private:
+    // Background thread
+    static void WriterLoop();
+
+    // Entry in the queue
+    struct QueueEntry;
+
+    // Take the oldest entry off the queue (writer thread only)
+    static bool Dequeue(QByteArray & mrText);
+
+    // Multiple producer, single consumer queue: producers add at the head,
+    // the writer takes from the tail
+    static std::atomic < QueueEntry * > m_QueueHead;
+    static QueueEntry * m_QueueTail;
+
+    // Memory limit
+    static std::atomic < qint64 > m_QueuedBytes;
+    static qint64 m_MaxQueuedBytes;
+
+    // Threads currently adding to the queue
+    static std::atomic < int > m_ActiveProducers;
+
+    // Statistics
+    static std::atomic < qint64 > m_NumberQueued;
+    static std::atomic < qint64 > m_NumberWritten;
+    static std::atomic < qint64 > m_NumberDropped;
+
+    // Writer state
+    static std::atomic < bool > m_WriterRunning;
+    static std::atomic < bool > m_StopWriter;
+    static std::atomic < bool > m_WriterIdle;
+    static QThread * m_WriterThread;
+    static QFile * m_OutputFile;
+
+    // For waking up the writer and waiting for it
+    static QMutex m_WriterMutex;
+    static QWaitCondition m_WriterWakeUp;
+    static QWaitCondition m_WriterProgress;
+
+
+
+    // ========================================================= Structured log
+public:
+    // Record every log entry in a file, one JSON object per line:
+    // timestamp, level, method, format and arguments. Methods and format
+    // strings are written once and referred to by number afterwards.
+    // Appends to existing files.
+    static bool StartStructuredLog(const QString mcFilename);
+
+    // Close structured log
+    static void StopStructuredLog();
+
+    // Switch human-readable (console) output on or off
+    static void SetConsoleOutput(const bool mcIsEnabled);
+
+    // Entry in a structured log
+    struct LogRecord
+    {
+        qint64 m_Timestamp = 0;
+        QString m_Level;
+        QString m_Method;
+        QString m_Format;
+        QStringList m_Arguments;
+        QString m_Text;
+    };
+
+    // Read a structured log (optionally only one level, e.g. "error")
+    static QList < LogRecord > ReadStructuredLog(const QString mcFilename,
+        const QString mcLevel = QString());
+
+    // Count entries in a structured log by level, method and format, and
+    // show the most frequent ones
+    static void ShowStructuredLogSummary(const QString mcFilename,
+        const int mcMaxLines = 50);
+
+private:
+    // Add entry to the structured log; either a format with arguments or a
+    // plain text
+    static void Record(const char * mcpLevel, const QString & mcrMethod,
+        const QString & mcrFormat, const QStringList & mcrArguments,
+        const QString & mcrText);
+
+    // Number of a method or format, writing its definition if it's new
+    static int GetStructuredLogID(QHash < QString, int > & mrIDs,
+        const char * mcpKind, const QString & mcrName);
+
+    // Structured log file
+    static std::atomic < bool > m_StructuredLogRunning;
+    static QFile * m_StructuredLogFile;
+    static QMutex m_StructuredLogMutex;
+
+    // Numbers of methods and formats
+    static QHash < QString, int > m_MethodIDs;
+    static QHash < QString, int > m_FormatIDs;
+
+    // Console output
+    static std::atomic < bool > m_ConsoleOutput;
 };
 
 #endif
@@ -29,6 +29,9 @@
 #include <QFile>
 #include <QTextStream>
 
+// System includes
+#include <algorithm>
+
 
 
 // ================================================================== Lifecycle
@@ -45,6 +48,7 @@ NavigatedTextFile::NavigatedTextFile(const QString mcFilename)
 
     // Initilize current line
     m_LineNumber = 0;
+    m_EndLineNumber = 0;
     
     // Open file
     QFile input_file(mcFilename);
@@ -77,6 +81,67 @@ NavigatedTextFile::NavigatedTextFile(const QString mcFilename)
     }
     
     // Split up in lines
+    SplitIntoLines();
+    
+    // Successfully opened file
+    m_IsOpen = true;
+    
+    // At start
+    m_LineNumber = 0;
+
+    CALL_OUT("");
+}
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// Constructor from content that has already been read
+NavigatedTextFile::NavigatedTextFile(const QString mcFilename,
+    const QByteArray & mcrContent)
+{
+    CALL_IN(QString("mcFilename=%1, mcrContent=%2")
+        .arg(CALL_SHOW(mcFilename),
+             CALL_SHOW(mcrContent)));
+    REGISTER_INSTANCE;
+
+    // Filename (for reference only; file will not be opened)
+    m_Filename = mcFilename;
+    m_FileContent = mcrContent;
+
+    // Split up in lines
+    SplitIntoLines();
+
+    // Content is available
+    m_IsOpen = true;
+
+    // At start
+    m_LineNumber = 0;
+
+    CALL_OUT("");
+}
+    
+
+
+///////////////////////////////////////////////////////////////////////////////
+// Destructor
+NavigatedTextFile::~NavigatedTextFile()
+{
+    CALL_IN("");
+    UNREGISTER_INSTANCE;
+
+    // Nothing to do.
+
+    CALL_OUT("");
+}
+   
+
+
+///////////////////////////////////////////////////////////////////////////////
+// Split content into lines
+void NavigatedTextFile::SplitIntoLines()
+{
+    CALL_IN("");
+
     int index = 0;
     m_LineFirstCharacter << index;
     while (index < m_FileContent.size())
@@ -91,10 +156,14 @@ NavigatedTextFile::NavigatedTextFile(const QString mcFilename)
             m_FileContent.at(index) == '\r' &&
             m_FileContent.at(index+1) == '\n')
         {
+            m_LineBreakOffsets << index;
+            m_LineBreakCharacters += '\r';
             m_FileContent[index] = '\0';
             index++;
             continue;
         }
+        m_LineBreakOffsets << index;
+        m_LineBreakCharacters += m_FileContent.at(index);
         m_FileContent[index] = '\0';
         index++;
         if (index < m_FileContent.size())
@@ -102,30 +171,13 @@ NavigatedTextFile::NavigatedTextFile(const QString mcFilename)
             m_LineFirstCharacter << index;
         }
     }
-    
-    // Successfully opened file
-    m_IsOpen = true;
-    
-    // At start
-    m_LineNumber = 0;
 
-    CALL_OUT("");
-}
-    
-
-
-///////////////////////////////////////////////////////////////////////////////
-// Destructor
-NavigatedTextFile::~NavigatedTextFile()
-{
-    CALL_IN("");
-    UNREGISTER_INSTANCE;
-
-    // Nothing to do.
+    // No limit
+    m_EndLineNumber = m_LineFirstCharacter.size();
 
     CALL_OUT("");
 }
-   
+
 
 
 // ===================================================================== Access
@@ -139,7 +191,7 @@ const char * NavigatedTextFile::GetCurrentLine()
     CALL_IN("");
 
     // Return valid line
-    if (m_LineNumber < m_LineFirstCharacter.size())
+    if (m_LineNumber < m_EndLineNumber)
     {
         CALL_OUT("");
         return m_FileContent.data() + m_LineFirstCharacter[m_LineNumber];
@@ -197,7 +249,7 @@ const char * NavigatedTextFile::ReadLine()
     CALL_IN("");
 
     // Return valid line
-    if (m_LineNumber < m_LineFirstCharacter.size())
+    if (m_LineNumber < m_EndLineNumber)
     {
         CALL_OUT("");
         return m_FileContent.data() + m_LineFirstCharacter[m_LineNumber++];
@@ -308,7 +360,7 @@ void NavigatedTextFile::MoveToEnd()
 {
     CALL_IN("");
 
-    m_LineNumber = m_LineFirstCharacter.size();
+    m_LineNumber = m_EndLineNumber;
 
     CALL_OUT("");
 }
@@ -322,7 +374,141 @@ bool NavigatedTextFile::AtEnd()
     CALL_IN("");
 
     CALL_OUT("");
-    return (m_LineNumber >= m_LineFirstCharacter.size());
+    return (m_LineNumber >= m_EndLineNumber);
+}
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// Limit navigation to the lines before a given line
+void NavigatedTextFile::SetEndLine(const int mcLineNumber)
+{
+    CALL_IN(QString("mcLineNumber=%1")
+        .arg(CALL_SHOW(mcLineNumber)));
+
+    // Check if this is a valid line number
+    if (mcLineNumber < 0 ||
+        mcLineNumber > m_LineFirstCharacter.size())
+    {
+        const QString reason = tr("Invalid line number %1 (should be 0 to %2)")
+            .arg(QString::number(mcLineNumber),
+                 QString::number(m_LineFirstCharacter.size()));
+        MessageLogger::Error(CALL_METHOD, reason);
+        CALL_OUT(reason);
+        return;
+    }
+
+    m_EndLineNumber = mcLineNumber;
+
+    CALL_OUT("");
+}
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// Size of the content in bytes
+qint64 NavigatedTextFile::GetContentSize() const
+{
+    CALL_IN("");
+
+    CALL_OUT("");
+    return m_FileContent.size();
+}
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// Byte offset of the start of a line
+qint64 NavigatedTextFile::GetLineOffset(const int mcLineNumber) const
+{
+    CALL_IN(QString("mcLineNumber=%1")
+        .arg(CALL_SHOW(mcLineNumber)));
+
+    // One past the last line is the end of the content
+    if (mcLineNumber == m_LineFirstCharacter.size())
+    {
+        CALL_OUT("");
+        return m_FileContent.size();
+    }
+
+    // Check if this is a valid line number
+    if (mcLineNumber < 0 ||
+        mcLineNumber > m_LineFirstCharacter.size())
+    {
+        const QString reason = tr("Invalid line number %1 (should be 0 to %2)")
+            .arg(QString::number(mcLineNumber),
+                 QString::number(m_LineFirstCharacter.size()));
+        MessageLogger::Error(CALL_METHOD, reason);
+        CALL_OUT(reason);
+        return -1;
+    }
+
+    CALL_OUT("");
+    return m_LineFirstCharacter[mcLineNumber];
+}
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// First line starting at or after a byte offset
+int NavigatedTextFile::GetLineNumberFromOffset(const qint64 mcOffset) const
+{
+    CALL_IN(QString("mcOffset=%1")
+        .arg(CALL_SHOW(mcOffset)));
+
+    // Line starts are sorted
+    const auto line_iterator = std::lower_bound(m_LineFirstCharacter.begin(),
+        m_LineFirstCharacter.end(), mcOffset);
+
+    CALL_OUT("");
+    return line_iterator - m_LineFirstCharacter.begin();
+}
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// Content between two byte offsets (with line breaks)
+QByteArray NavigatedTextFile::GetRawContent(const qint64 mcStartOffset,
+    const qint64 mcEndOffset) const
+{
+    CALL_IN(QString("mcStartOffset=%1, mcEndOffset=%2")
+        .arg(CALL_SHOW(mcStartOffset),
+             CALL_SHOW(mcEndOffset)));
+
+    // Check range
+    const qint64 end_offset =
+        (mcEndOffset == -1 ? m_FileContent.size() : mcEndOffset);
+    if (mcStartOffset < 0 ||
+        mcStartOffset > end_offset ||
+        end_offset > m_FileContent.size())
+    {
+        const QString reason = tr("Invalid range %1 to %2 (should be within "
+            "0 to %3)")
+            .arg(QString::number(mcStartOffset),
+                 QString::number(end_offset),
+                 QString::number(m_FileContent.size()));
+        MessageLogger::Error(CALL_METHOD, reason);
+        CALL_OUT(reason);
+        return QByteArray();
+    }
+
+    // Line breaks have been replaced by '\0' when splitting into lines;
+    // put the original characters back
+    QByteArray ret = m_FileContent.mid(mcStartOffset,
+        end_offset - mcStartOffset);
+    for (auto break_iterator = std::lower_bound(m_LineBreakOffsets.begin(),
+             m_LineBreakOffsets.end(), mcStartOffset);
+         break_iterator != m_LineBreakOffsets.end() &&
+             *break_iterator < end_offset;
+         break_iterator++)
+    {
+        const int break_index = break_iterator - m_LineBreakOffsets.begin();
+        ret[*break_iterator - mcStartOffset] =
+            m_LineBreakCharacters.at(break_index);
+    }
+
+    CALL_OUT("");
+    return ret;
 }
 
 
@@ -9,6 +9,7 @@
 #define NAVIGATEDTEXTFILE_H
 
 // Qt includes
+#include <QByteArray>
 #include <QList>
 #include <QObject>
 #include <QString>
@@ -25,6 +26,9 @@ class NavigatedTextFile:
 public:
     // Constructor
     NavigatedTextFile(const QString mcFilename);
+
+    // Constructor from content that has already been read
+    NavigatedTextFile(const QString mcFilename, const QByteArray & mcrContent);
     
     // Destructor
     ~NavigatedTextFile();
@@ -42,10 +46,28 @@ public:
     bool Rewind(const int mcNumberOfLines);
     void MoveToEnd();
     bool AtEnd();
+
+    // Limit navigation to the lines before mcLineNumber
+    void SetEndLine(const int mcLineNumber);
+
+    // Byte offsets
+    qint64 GetContentSize() const;
+    qint64 GetLineOffset(const int mcLineNumber) const;
+    int GetLineNumberFromOffset(const qint64 mcOffset) const;
+    QByteArray GetRawContent(const qint64 mcStartOffset,
+        const qint64 mcEndOffset = -1) const;
 private:
+    // Split content into lines
+    void SplitIntoLines();
+
     // Lines
     QList < int > m_LineFirstCharacter;
     QByteArray m_FileContent;
+    int m_EndLineNumber;
+
+    // Original line break characters replaced by '\0', and where they were
+    QList < int > m_LineBreakOffsets;
+    QByteArray m_LineBreakCharacters;
 
 public:
     // Filename
@@ -1687,63 +1687,7 @@ QByteArray StringHelper::DecodeText(const QByteArray mcBody,
     QByteArray decoded;
     if (mcTransferEncoding == "quoted-printable")
     {
-        int index = 0;
-        while (index < mcBody.size())
-        {
-            if (mcBody.at(index) == '=')
-            {
-                // Check for end of line
-                if (index < mcBody.size() - 1 &&
-                    mcBody.at(index+1) == '\n')
-                {
-                    // Remove line continuation ("=\n")
-                    index += 2;
-                    continue;
-                }
-                if (index < mcBody.size() - 2 &&
-                    mcBody.at(index+1) == '\r' &&
-                    mcBody.at(index+2) == '\n')
-                {
-                    // Remove line continuation ("=\r\n")
-                    index += 3;
-                    continue;
-                }
-
-                // Check for something to decode
-                if (index < mcBody.size() - 2)
-                {
-                    QChar char_1 = mcBody.at(index+1);
-                    if ((char_1 >= '0' && char_1 <= '9') ||
-                        (char_1 >= 'A' && char_1 <= 'F'))
-                    {
-                        QChar char_2 = mcBody.at(index+2);
-                        if ((char_2 >= '0' && char_2 <= '9') ||
-                            (char_2 >= 'A' && char_2 <= 'F'))
-                        {
-                            // Decode
-                            const QString hex_value = QString("%1%2")
-                                .arg(char_1,
-                                     char_2);
-                            bool status = false;
-                            unsigned short char_value =
-                                hex_value.toUShort(&status, 16);
-                            decoded += (char)char_value;
-                            index += 3;
-                            continue;
-                        }
-                    }
-                }
-
-                // Just an equal sign, not an encoded character.
-                decoded += '=';
-                index++;
-            } else
-            {
-                // No decoding
-                decoded += mcBody.at(index);
-                index++;
-            }
-        }
+        decoded = DecodeQuotedPrintable(mcBody);
     } else if (mcTransferEncoding == "7bit" ||
         mcTransferEncoding == "8bit" ||
         mcTransferEncoding == "binary" ||
@@ -1884,6 +1828,185 @@ QByteArray StringHelper::DecodeText(const QByteArray mcBody,
 
 
 
+///////////////////////////////////////////////////////////////////////////////
+// Reverse quoted-printable transfer encoding
+QByteArray StringHelper::DecodeQuotedPrintable(const QByteArray & mcrBody)
+{
+    CALL_IN(QString("mcrBody=%1")
+        .arg(CALL_SHOW(mcrBody)));
+
+    QByteArray decoded;
+    decoded.reserve(mcrBody.size());
+    int index = 0;
+    while (index < mcrBody.size())
+    {
+        if (mcrBody.at(index) == '=')
+        {
+            // Check for end of line
+            if (index < mcrBody.size() - 1 &&
+                mcrBody.at(index+1) == '\n')
+            {
+                // Remove line continuation ("=\n")
+                index += 2;
+                continue;
+            }
+            if (index < mcrBody.size() - 2 &&
+                mcrBody.at(index+1) == '\r' &&
+                mcrBody.at(index+2) == '\n')
+            {
+                // Remove line continuation ("=\r\n")
+                index += 3;
+                continue;
+            }
+
+            // Check for something to decode
+            if (index < mcrBody.size() - 2)
+            {
+                QChar char_1 = mcrBody.at(index+1);
+                if ((char_1 >= '0' && char_1 <= '9') ||
+                    (char_1 >= 'A' && char_1 <= 'F'))
+                {
+                    QChar char_2 = mcrBody.at(index+2);
+                    if ((char_2 >= '0' && char_2 <= '9') ||
+                        (char_2 >= 'A' && char_2 <= 'F'))
+                    {
+                        // Decode
+                        const QString hex_value = QString("%1%2")
+                            .arg(char_1,
+                                 char_2);
+                        bool status = false;
+                        unsigned short char_value =
+                            hex_value.toUShort(&status, 16);
+                        decoded += (char)char_value;
+                        index += 3;
+                        continue;
+                    }
+                }
+            }
+
+            // Just an equal sign, not an encoded character.
+            decoded += '=';
+            index++;
+        } else
+        {
+            // No decoding
+            decoded += mcrBody.at(index);
+            index++;
+        }
+    }
+
+    CALL_OUT("");
+    return decoded;
+}
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// Reverse transfer encoding chunk by chunk from one device to another
+bool StringHelper::DecodeTransferEncoding(QIODevice & mrInput,
+    const qint64 mcSize, const QString mcTransferEncoding,
+    QIODevice & mrOutput)
+{
+    CALL_IN(QString("mrInput=..., mcSize=%1, mcTransferEncoding=%2, "
+        "mrOutput=...")
+        .arg(CALL_SHOW(mcSize),
+             CALL_SHOW(mcTransferEncoding)));
+
+    // Check encoding
+    const bool is_base64 = (mcTransferEncoding == "base64");
+    const bool is_quoted_printable =
+        (mcTransferEncoding == "quoted-printable");
+    if (!is_base64 &&
+        !is_quoted_printable &&
+        mcTransferEncoding != "7bit" &&
+        mcTransferEncoding != "8bit" &&
+        mcTransferEncoding != "binary" &&
+        !mcTransferEncoding.isEmpty())
+    {
+        const QString reason =
+            tr("Unknown transfer encoding \"%1\".").arg(mcTransferEncoding);
+        MessageLogger::Error(CALL_METHOD, reason);
+        CALL_OUT(reason);
+        return false;
+    }
+
+    // Read in chunks; anything that cannot be decoded yet (incomplete
+    // base64 quadruple, escape sequence cut in half) is carried over to the
+    // next chunk
+    const qint64 chunk_size = 256 * 1024;
+    qint64 remaining = mcSize;
+    QByteArray carry;
+    while (remaining > 0)
+    {
+        const QByteArray chunk = mrInput.read(qMin(chunk_size, remaining));
+        if (chunk.isEmpty())
+        {
+            const QString reason =
+                tr("Unexpected end of input (%1 bytes missing).")
+                    .arg(remaining);
+            MessageLogger::Error(CALL_METHOD, reason);
+            CALL_OUT(reason);
+            return false;
+        }
+        remaining -= chunk.size();
+        const bool is_last_chunk = (remaining == 0);
+
+        QByteArray decoded;
+        if (is_base64)
+        {
+            // Drop line breaks and other white space
+            QByteArray data = carry;
+            data.reserve(carry.size() + chunk.size());
+            for (const char this_char : chunk)
+            {
+                if (this_char != '\n' &&
+                    this_char != '\r' &&
+                    this_char != ' ' &&
+                    this_char != '\t')
+                {
+                    data += this_char;
+                }
+            }
+            const qsizetype usable =
+                (is_last_chunk ? data.size() : data.size() - data.size() % 4);
+            carry = data.mid(usable);
+            data.truncate(usable);
+            decoded = QByteArray::fromBase64(data);
+        } else if (is_quoted_printable)
+        {
+            QByteArray data = carry + chunk;
+            carry.clear();
+            const qsizetype escape_index = data.lastIndexOf('=');
+            if (!is_last_chunk &&
+                escape_index != -1 &&
+                escape_index >= data.size() - 2)
+            {
+                carry = data.mid(escape_index);
+                data.truncate(escape_index);
+            }
+            decoded = DecodeQuotedPrintable(data);
+        } else
+        {
+            decoded = chunk;
+        }
+
+        // Write
+        if (mrOutput.write(decoded) != decoded.size())
+        {
+            const QString reason = tr("Could not write decoded data: %1")
+                .arg(mrOutput.errorString());
+            MessageLogger::Error(CALL_METHOD, reason);
+            CALL_OUT(reason);
+            return false;
+        }
+    }
+
+    CALL_OUT("");
+    return true;
+}
+
+
+
 ///////////////////////////////////////////////////////////////////////////////
 // Guess charset from text
 QString StringHelper::GuessCharset(const QByteArray mcText)
@@ -1902,21 +2025,22 @@ QString StringHelper::GuessCharset(const QByteArray mcText)
     }
 
     // Set for plain ASCII
-    static QSet < int > ascii;
-    if (ascii.isEmpty())
+    static const QSet < int > ascii = []()
     {
+        QSet < int > ascii;
         for (int char_value = 0;
              char_value < 128;
              char_value++)
         {
             ascii += char_value;
         }
-    }
+        return ascii;
+    }();
 
     // Set for ISO-8859-1 (Latin-1)
-    static QSet < int > iso_8859_1;
-    if (iso_8859_1.isEmpty())
+    static const QSet < int > iso_8859_1 = []()
     {
+        QSet < int > iso_8859_1;
         iso_8859_1 += ascii;
         for (int char_value = 160;
              char_value < 255;
@@ -1924,12 +2048,13 @@ QString StringHelper::GuessCharset(const QByteArray mcText)
         {
             iso_8859_1 += char_value;
         }
-    }
+        return iso_8859_1;
+    }();
 
     // Set for Windows-1252
-    static QSet < int > windows_1252;
-    if (windows_1252.isEmpty())
+    static const QSet < int > windows_1252 = []()
     {
+        QSet < int > windows_1252;
         windows_1252 += iso_8859_1;
         for (int char_value = 128;
              char_value < 160;
@@ -1944,7 +2069,8 @@ QString StringHelper::GuessCharset(const QByteArray mcText)
             }
             windows_1252 += char_value;
         }
-    }
+        return windows_1252;
+    }();
 
     // Now guess character set
     const QSet < int > used_characters(char_count.keyBegin(),
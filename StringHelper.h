@@ -12,6 +12,7 @@
 // Qt includes
 #include <QDateTime>
 #include <QHash>
+#include <QIODevice>
 #include <QList>
 #include <QObject>
 #include <QPair>
@@ -162,6 +163,14 @@ public:
     static QByteArray DecodeText(const QByteArray mcBody,
         const QString mcCharset, const QString mcTransferEncoding);
 
+    // Reverse quoted-printable transfer encoding
+    static QByteArray DecodeQuotedPrintable(const QByteArray & mcrBody);
+
+    // Reverse transfer encoding chunk by chunk from one device to another
+    static bool DecodeTransferEncoding(QIODevice & mrInput,
+        const qint64 mcSize, const QString mcTransferEncoding,
+        QIODevice & mrOutput);
+
     // Guess charset from text
     static QString GuessCharset(const QByteArray mcText);
 